@@ -0,0 +1,150 @@
+#include "ArrayList.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Each benchmark purges 10% of the list: the items whose value is a
+// multiple of 10. BM_RemoveAllDistinct's list holds distinct items, so it
+// has as many items to remove as it removes.
+
+ArrayList<int> makeList(int numItems)
+{
+    ArrayList<int> list(numItems);
+    for (int i = 0; i < numItems; i++)
+    {
+        list.add(i % 100);
+    }
+
+    return list;
+}
+
+// one remove() per item, each shifting the rest of the list down
+void BM_RemoveEach(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<int> original = makeList(numItems);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ArrayList<int> list(original);
+        state.ResumeTiming();
+
+        for (int value = 0; value < 100; value += 10)
+        {
+            while (list.remove(value))
+            {
+
+            }
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_RemoveEach)->RangeMultiplier(10)->Range(10000, 100000)
+    ->Iterations(3)->Unit(benchmark::kMillisecond);
+
+void BM_RemoveIf(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<int> original = makeList(numItems);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ArrayList<int> list(original);
+        state.ResumeTiming();
+
+        list.removeIf([](const int& item) { return item % 10 == 0; });
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_RemoveIf)->RangeMultiplier(10)->Range(10000, 10000000)
+    ->Iterations(5)->Unit(benchmark::kMillisecond);
+
+void BM_RemoveAll(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<int> original = makeList(numItems);
+    std::vector<int> removed = { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ArrayList<int> list(original);
+        state.ResumeTiming();
+
+        list.removeAll(removed);
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_RemoveAll)->RangeMultiplier(10)->Range(10000, 10000000)
+    ->Iterations(5)->Unit(benchmark::kMillisecond);
+
+// purges 10% of 1e7 distinct items with about 1e6 items to remove, which
+// are too many to compare each item of the list with
+void BM_RemoveAllDistinct(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    std::mt19937 random(42);
+    std::vector<int> items(numItems);
+    for (int i = 0; i < numItems; i++)
+    {
+        items[i] = i;
+    }
+    std::shuffle(items.begin(), items.end(), random);
+
+    ArrayList<int> original(numItems);
+    std::vector<int> removed;
+    for (int item : items)
+    {
+        original.add(item);
+        if (item % 10 == 0)
+        {
+            removed.push_back(item);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ArrayList<int> list(original);
+        state.ResumeTiming();
+
+        list.removeAll(removed);
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_RemoveAllDistinct)->RangeMultiplier(10)->Range(10000, 10000000)
+    ->Iterations(5)->Unit(benchmark::kMillisecond);
+
+// removes 10% of the items at random positions, without keeping order
+void BM_SwapRemove(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<int> original = makeList(numItems);
+    std::mt19937 random(42);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ArrayList<int> list(original);
+        state.ResumeTiming();
+
+        for (int i = 0; i < numItems / 10; i++)
+        {
+            list.swapRemove(random() % list.size());
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_SwapRemove)->RangeMultiplier(10)->Range(10000, 10000000)
+    ->Iterations(5)->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+#include "ArrayList.h"
+#include "SimdSearch.h"
+#include "benchmark/benchmark.h"
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+// Every search misses, so each one scans the whole list, as a contains()
+// on a membership set does for an absent key.
+
+template <class T>
+ArrayList<T> makeList(int numItems)
+{
+    ArrayList<T> list(numItems);
+    for (int i = 0; i < numItems; i++)
+    {
+        list.add(static_cast<T>(i));
+    }
+
+    return list;
+}
+
+template <class T>
+std::vector<T> makeVector(int numItems)
+{
+    std::vector<T> items;
+    for (int i = 0; i < numItems; i++)
+    {
+        items.push_back(static_cast<T>(i));
+    }
+
+    return items;
+}
+
+// the loop ArrayList::contains used before
+template <class T>
+void BM_ScalarContains(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    std::vector<T> items = makeVector<T>(numItems);
+    T missing = static_cast<T>(numItems);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            scalarIndexOf(items.data(), numItems, missing) >= 0);
+    }
+    state.SetBytesProcessed(state.iterations() * numItems * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ScalarContains, int32_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_ScalarContains, uint64_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+
+template <class T>
+void BM_Contains(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<T> list = makeList<T>(numItems);
+    T missing = static_cast<T>(numItems);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.contains(missing));
+    }
+    state.SetBytesProcessed(state.iterations() * numItems * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Contains, int32_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Contains, uint64_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Contains, float)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+
+template <class T>
+void BM_Count(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<T> list = makeList<T>(numItems);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.count(static_cast<T>(1)));
+    }
+    state.SetBytesProcessed(state.iterations() * numItems * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_Count, int32_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+
+template <class T>
+void BM_ScalarIndexOfAny(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    std::vector<T> items = makeVector<T>(numItems);
+    std::vector<T> targets = { static_cast<T>(-1), static_cast<T>(-2),
+                               static_cast<T>(-3), static_cast<T>(-4) };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scalarIndexOfAny(items.data(), numItems,
+            targets.data(), static_cast<int>(targets.size())));
+    }
+    state.SetBytesProcessed(state.iterations() * numItems * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_ScalarIndexOfAny, int32_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+
+template <class T>
+void BM_IndexOfAny(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    ArrayList<T> list = makeList<T>(numItems);
+    std::vector<T> targets = { static_cast<T>(-1), static_cast<T>(-2),
+                               static_cast<T>(-3), static_cast<T>(-4) };
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.indexOfAny(targets));
+    }
+    state.SetBytesProcessed(state.iterations() * numItems * sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_IndexOfAny, int32_t)->RangeMultiplier(8)
+    ->Range(8, 1 << 20);
+
+}
+
+BENCHMARK_MAIN();
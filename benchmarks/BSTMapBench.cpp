@@ -0,0 +1,304 @@
+#include "BSTMap.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Builds a corpus of @c numWords words drawn from a vocabulary of
+ * @c vocabularySize distinct words with a Zipf-like (1/rank) distribution,
+ * which is roughly how word frequencies in natural text behave.
+ */
+std::vector<std::string> makeCorpus(int numWords, int vocabularySize)
+{
+    std::vector<std::string> vocabulary;
+    vocabulary.reserve(vocabularySize);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> length(3, 10);
+    for (int i = 0; i < vocabularySize; i++)
+    {
+        std::string word;
+        int wordLength = length(rng);
+        for (int j = 0; j < wordLength; j++)
+        {
+            word.push_back(static_cast<char>(letter(rng)));
+        }
+        vocabulary.push_back(word + std::to_string(i));
+    }
+
+    std::vector<double> weights;
+    weights.reserve(vocabularySize);
+    for (int i = 0; i < vocabularySize; i++)
+    {
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::discrete_distribution<int> rank(weights.begin(), weights.end());
+
+    std::vector<std::string> corpus;
+    corpus.reserve(numWords);
+    for (int i = 0; i < numWords; i++)
+    {
+        corpus.push_back(vocabulary[rank(rng)]);
+    }
+
+    return corpus;
+}
+
+const std::vector<std::string>& getCorpus(int numWords)
+{
+    static std::vector<std::string> corpus;
+    if (static_cast<int>(corpus.size()) != numWords)
+    {
+        corpus = makeCorpus(numWords, numWords / 10);
+    }
+
+    return corpus;
+}
+
+// The only way to update a count with the original Dictionary API: look the
+// key up, read the old value, remove the entry and add it back.
+void BM_WordCount_ContainsGetRemoveAdd(benchmark::State& state)
+{
+    const std::vector<std::string>& corpus = getCorpus(state.range(0));
+    for (auto _ : state)
+    {
+        BSTMap<std::string, int> counts;
+        for (const std::string& word : corpus)
+        {
+            if (counts.contains(word))
+            {
+                int count = counts.getValue(word);
+                counts.remove(word);
+                counts.add(word, count + 1);
+            }
+            else
+            {
+                counts.add(word, 1);
+            }
+        }
+        benchmark::DoNotOptimize(counts.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_WordCount_ContainsGetRemoveAdd)->Arg(1 << 16)->Arg(1 << 20);
+
+// Two descents per new word: a failed lookup followed by an insert.
+void BM_WordCount_FindPtrThenAdd(benchmark::State& state)
+{
+    const std::vector<std::string>& corpus = getCorpus(state.range(0));
+    for (auto _ : state)
+    {
+        BSTMap<std::string, int> counts;
+        for (const std::string& word : corpus)
+        {
+            int* countPtr = counts.findPtr(word);
+            if (countPtr != nullptr)
+            {
+                (*countPtr)++;
+            }
+            else
+            {
+                counts.add(word, 1);
+            }
+        }
+        benchmark::DoNotOptimize(counts.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_WordCount_FindPtrThenAdd)->Arg(1 << 16)->Arg(1 << 20);
+
+// One descent per word.
+void BM_WordCount_GetOrInsert(benchmark::State& state)
+{
+    const std::vector<std::string>& corpus = getCorpus(state.range(0));
+    for (auto _ : state)
+    {
+        BSTMap<std::string, int> counts;
+        for (const std::string& word : corpus)
+        {
+            counts.getOrInsert(word, []() { return 0; })++;
+        }
+        benchmark::DoNotOptimize(counts.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_WordCount_GetOrInsert)->Arg(1 << 16)->Arg(1 << 20);
+
+const int LOOKUP_TABLE_SIZE = 1 << 20;
+
+/**
+ * A map of LOOKUP_TABLE_SIZE integer keys inserted in random order, so that
+ * the tree is reasonably balanced and far larger than the cache.
+ */
+const BSTMap<int, int>& getLookupTable()
+{
+    static BSTMap<int, int> table;
+    if (table.isEmpty())
+    {
+        std::vector<int> keys(LOOKUP_TABLE_SIZE);
+        for (int i = 0; i < LOOKUP_TABLE_SIZE; i++)
+        {
+            keys[i] = i;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+        for (int key : keys)
+        {
+            table.add(key, key);
+        }
+    }
+
+    return table;
+}
+
+/**
+ * A pool of random lookup keys, half of which are in the table. Each
+ * benchmark iteration takes the next batch from the pool so that the batch's
+ * search paths are not already in the cache from the previous iteration.
+ */
+const std::vector<int>& getLookupKeys()
+{
+    static std::vector<int> keys;
+    if (keys.empty())
+    {
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<int> key(0, 2 * LOOKUP_TABLE_SIZE - 1);
+        keys.resize(1 << 22);
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            keys[i] = key(rng);
+        }
+    }
+
+    return keys;
+}
+
+void BM_Lookup_FindPtrLoop(benchmark::State& state)
+{
+    const BSTMap<int, int>& table = getLookupTable();
+    const std::vector<int>& pool = getLookupKeys();
+    const std::size_t batchSize = state.range(0);
+    std::vector<int> values(batchSize);
+    std::size_t offset = 0;
+    for (auto _ : state)
+    {
+        if (offset + batchSize > pool.size())
+        {
+            offset = 0;
+        }
+
+        for (std::size_t i = 0; i < batchSize; i++)
+        {
+            const int* valuePtr = table.findPtr(pool[offset + i]);
+            values[i] = (valuePtr != nullptr) ? *valuePtr : 0;
+        }
+        benchmark::DoNotOptimize(values.data());
+        offset += batchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Lookup_FindPtrLoop)->RangeMultiplier(2)->Range(1, 512);
+
+void BM_Lookup_MultiGet(benchmark::State& state)
+{
+    const BSTMap<int, int>& table = getLookupTable();
+    const std::vector<int>& pool = getLookupKeys();
+    const std::size_t batchSize = state.range(0);
+    std::vector<int> keys(batchSize);
+    std::vector<int> values;
+    std::vector<bool> found;
+    std::size_t offset = 0;
+    for (auto _ : state)
+    {
+        if (offset + batchSize > pool.size())
+        {
+            offset = 0;
+        }
+
+        keys.assign(pool.begin() + offset, pool.begin() + offset + batchSize);
+        table.multiGet(keys, values, found);
+        benchmark::DoNotOptimize(values.data());
+        offset += batchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK(BM_Lookup_MultiGet)->RangeMultiplier(2)->Range(1, 512);
+
+/**
+ * An entry whose batched searches prefetch only the nodes, since
+ * KeyPrefetch is not specialized for it, to measure what prefetching the
+ * separately allocated keys gains.
+ */
+class NodePrefetchOnlyEntry : public Entry<int, int>
+{
+public:
+    NodePrefetchOnlyEntry()
+    {
+
+    }
+
+    NodePrefetchOnlyEntry(int key, int value) : Entry<int, int>(key, value)
+    {
+
+    }
+};
+
+/**
+ * Builds a tree of LOOKUP_TABLE_SIZE entries in random order, the same as
+ * getLookupTable. The nodes come from an arena, so that each key, which the
+ * entry allocates from the heap, is not next to its node in memory.
+ */
+template <class EntryType>
+const BinarySearchTree<EntryType>& getEntryTree()
+{
+    static BinarySearchTree<EntryType> tree;
+    if (tree.empty())
+    {
+        tree.useArena();
+        std::vector<int> keys(LOOKUP_TABLE_SIZE);
+        for (int i = 0; i < LOOKUP_TABLE_SIZE; i++)
+        {
+            keys[i] = i;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+        for (int key : keys)
+        {
+            tree.add(EntryType(key, key));
+        }
+    }
+
+    return tree;
+}
+
+template <class EntryType>
+void BM_GroupLookup(benchmark::State& state)
+{
+    const BinarySearchTree<EntryType>& tree = getEntryTree<EntryType>();
+    const std::vector<int>& pool = getLookupKeys();
+    const std::size_t batchSize = state.range(0);
+    std::vector<const EntryType*> results(batchSize);
+    std::size_t offset = 0;
+    for (auto _ : state)
+    {
+        if (offset + batchSize > pool.size())
+        {
+            offset = 0;
+        }
+
+        tree.findItems(pool.data() + offset, static_cast<int>(batchSize),
+                       results.data());
+        benchmark::DoNotOptimize(results.data());
+        offset += batchSize;
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+BENCHMARK_TEMPLATE(BM_GroupLookup, NodePrefetchOnlyEntry)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_GroupLookup, Entry<int, int>)->Arg(16)->Arg(256);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+#include "BinarySearchTree.h"
+#include "CompactBinarySearchTree.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <malloc.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const std::vector<int>& getKeys(int numKeys)
+{
+    static std::vector<int> keys;
+    if (static_cast<int>(keys.size()) != numKeys)
+    {
+        keys.resize(numKeys);
+        for (int i = 0; i < numKeys; i++)
+        {
+            keys[i] = 2 * i;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+    }
+
+    return keys;
+}
+
+std::size_t getHeapInUse()
+{
+    return mallinfo2().uordblks;
+}
+
+/**
+ * Builds a tree of the given number of keys, inserted in random order, and
+ * reports the heap memory it occupies per key.
+ */
+template <class Tree>
+void BM_Build(benchmark::State& state)
+{
+    const std::vector<int>& keys = getKeys(state.range(0));
+    for (auto _ : state)
+    {
+        std::size_t heapBefore = getHeapInUse();
+        Tree tree;
+        for (int key : keys)
+        {
+            tree.add(key);
+        }
+        state.counters["bytes_per_key"] =
+            static_cast<double>(getHeapInUse() - heapBefore) / keys.size();
+        state.counters["height"] = tree.getTreeHeight();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK_TEMPLATE(BM_Build, BinarySearchTree<int>)->Arg(1 << 20)
+    ->Arg(1 << 22)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Build, CompactBinarySearchTree<int>)->Arg(1 << 20)
+    ->Arg(1 << 22)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+template <class Tree>
+const Tree& getTree(int numKeys)
+{
+    static Tree tree;
+    static int treeSize = 0;
+    if (treeSize != numKeys)
+    {
+        tree.clear();
+        for (int key : getKeys(numKeys))
+        {
+            tree.add(key);
+        }
+        treeSize = numKeys;
+    }
+
+    return tree;
+}
+
+// Random lookups, half of which miss.
+template <class Tree>
+void BM_Lookup(benchmark::State& state)
+{
+    const int numKeys = state.range(0);
+    const Tree& tree = getTree<Tree>(numKeys);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> key(0, 2 * numKeys - 1);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.findItem(key(rng)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Lookup, BinarySearchTree<int>)->Arg(1 << 16)
+    ->Arg(1 << 22);
+BENCHMARK_TEMPLATE(BM_Lookup, CompactBinarySearchTree<int>)->Arg(1 << 16)
+    ->Arg(1 << 22);
+
+template <class Tree>
+void BM_InorderSum(benchmark::State& state)
+{
+    const Tree& tree = getTree<Tree>(state.range(0));
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        tree.inorderForEach([&sum](const int& item) { sum += item; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_InorderSum, BinarySearchTree<int>)->Arg(1 << 22)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_InorderSum, CompactBinarySearchTree<int>)->Arg(1 << 22)
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#include "BinaryTree.h"
+#include "CompleteBinaryTree.h"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+
+// Both trees stay balanced as items are added (BinaryTree by adding to the
+// shorter subtree), so they have the same height; what differs is the cost
+// of keeping them that way.
+
+template <class Tree>
+void BM_Add(benchmark::State& state)
+{
+    int numNodes = state.range(0);
+    for (auto _ : state)
+    {
+        Tree tree;
+        for (int i = 0; i < numNodes; i++)
+        {
+            tree.add(i);
+        }
+        benchmark::DoNotOptimize(tree.getNumNodes());
+    }
+    state.SetItemsProcessed(state.iterations() * numNodes);
+}
+BENCHMARK_TEMPLATE(BM_Add, BinaryTree<int>)->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 13);
+BENCHMARK_TEMPLATE(BM_Add, CompleteBinaryTree<int>)->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 13);
+
+// Empties the tree by repeatedly removing its root, which is the worst case
+// for BinaryTree's shifting of items up, and a constant time removal here.
+template <class Tree>
+void BM_RemoveRoot(benchmark::State& state)
+{
+    int numNodes = state.range(0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Tree tree;
+        for (int i = 0; i < numNodes; i++)
+        {
+            tree.add(i);
+        }
+        state.ResumeTiming();
+
+        while (!tree.empty())
+        {
+            tree.remove(tree.getRootData());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numNodes);
+}
+BENCHMARK_TEMPLATE(BM_RemoveRoot, BinaryTree<int>)->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 13)->Iterations(5);
+BENCHMARK_TEMPLATE(BM_RemoveRoot, CompleteBinaryTree<int>)->RangeMultiplier(4)
+    ->Range(1 << 7, 1 << 13)->Iterations(5);
+
+template <class Tree>
+void BM_InorderSum(benchmark::State& state)
+{
+    int numNodes = state.range(0);
+    Tree tree;
+    for (int i = 0; i < numNodes; i++)
+    {
+        tree.add(i);
+    }
+
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        tree.inorderForEach([&sum](const int& item) { sum += item; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numNodes);
+}
+BENCHMARK_TEMPLATE(BM_InorderSum, BinaryTree<int>)->Arg(1 << 13);
+BENCHMARK_TEMPLATE(BM_InorderSum, CompleteBinaryTree<int>)->Arg(1 << 13);
+
+void BM_LevelorderSum(benchmark::State& state)
+{
+    int numNodes = state.range(0);
+    CompleteBinaryTree<int> tree;
+    for (int i = 0; i < numNodes; i++)
+    {
+        tree.add(i);
+    }
+
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        tree.levelorderForEach([&sum](const int& item) { sum += item; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numNodes);
+}
+BENCHMARK(BM_LevelorderSum)->Arg(1 << 13);
+
+}
+
+BENCHMARK_MAIN();
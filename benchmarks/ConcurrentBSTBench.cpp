@@ -0,0 +1,160 @@
+#include "ConcurrentBinarySearchTree.h"
+#include "BinarySearchTree.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <vector>
+
+namespace
+{
+
+const int NUM_KEYS = 1 << 18;
+
+/**
+ * The baseline: a single BinarySearchTree behind a single lock.
+ */
+class LockedTree
+{
+private:
+    std::mutex lock;
+    BinarySearchTree<int> tree;
+
+public:
+    bool add(int item)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return tree.add(item);
+    }
+
+    bool remove(int item)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return tree.remove(item);
+    }
+
+    bool contains(int item)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return tree.contains(item);
+    }
+};
+
+/**
+ * A BinarySearchTree behind a readers-writer lock, so lookups can proceed
+ * in parallel but still write to the lock's shared counter.
+ */
+class SharedLockedTree
+{
+private:
+    std::shared_mutex lock;
+    BinarySearchTree<int> tree;
+
+public:
+    bool add(int item)
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        return tree.add(item);
+    }
+
+    bool remove(int item)
+    {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        return tree.remove(item);
+    }
+
+    bool contains(int item)
+    {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return tree.contains(item);
+    }
+};
+
+/**
+ * Fills a tree with every other item in [0, 2 * NUM_KEYS), in random order.
+ */
+template <class Tree>
+void populate(Tree& tree)
+{
+    std::vector<int> items;
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        items.push_back(2 * i);
+    }
+    std::shuffle(items.begin(), items.end(), std::mt19937(3));
+    for (int item : items)
+    {
+        tree.add(item);
+    }
+}
+
+/**
+ * The trees are shared by every thread of every run, and are populated
+ * once. Writes alternate between adds and removes of random items, so the
+ * trees stay at roughly their initial size from run to run.
+ */
+template <class Tree>
+Tree& getSharedTree()
+{
+    static Tree tree;
+    static std::once_flag populated;
+    std::call_once(populated, [&]() { populate(tree); });
+    return tree;
+}
+
+/**
+ * Runs a mix of lookups and writes against a tree shared by all benchmark
+ * threads. @c WRITE_PERCENT of the operations alternate between adding and
+ * removing a random item; the rest are lookups.
+ */
+template <class Tree, int WRITE_PERCENT>
+void BM_Mixed(benchmark::State& state)
+{
+    Tree& tree = getSharedTree<Tree>();
+    std::mt19937 rng(state.thread_index() + 1);
+    std::uniform_int_distribution<int> item(0, 2 * NUM_KEYS - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    bool addNext = true;
+    for (auto _ : state)
+    {
+        int i = item(rng);
+        if (percent(rng) < WRITE_PERCENT)
+        {
+            if (addNext)
+            {
+                tree.add(i);
+            }
+            else
+            {
+                tree.remove(i);
+            }
+            addNext = !addNext;
+        }
+        else
+        {
+            benchmark::DoNotOptimize(tree.contains(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// read-heavy: 5% writes
+BENCHMARK_TEMPLATE(BM_Mixed, LockedTree, 5)->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mixed, SharedLockedTree, 5)->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mixed, ConcurrentBinarySearchTree<int>, 5)
+    ->ThreadRange(1, 16)->UseRealTime();
+
+// write-heavy: 50% writes
+BENCHMARK_TEMPLATE(BM_Mixed, LockedTree, 50)->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mixed, SharedLockedTree, 50)->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Mixed, ConcurrentBinarySearchTree<int>, 50)
+    ->ThreadRange(1, 16)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,406 @@
+/**
+ * The core operations of every container, for a range of sizes and for a
+ * cheap (int) and an expensive (std::string) item type.
+ *
+ * This is the suite that guards against regressions: `make bench-json`
+ * writes its results to JSON, and `make bench-compare` compares them with
+ * the stored baseline (see compare.py). Benchmarks which build a container
+ * include its destruction, so that no timing is paused for small sizes.
+ */
+
+#include "ArrayList.h"
+#include "BSTMap.h"
+#include "BinarySearchTree.h"
+#include "BinaryTree.h"
+#include "Heap.h"
+#include "LinkedList.h"
+#include "PriorityQueue.h"
+#include "Queue.h"
+#include "Stack.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+template <class T>
+T makeItem(int n);
+
+template <>
+int makeItem<int>(int n)
+{
+    return n;
+}
+
+// long enough that the string is allocated on the heap
+template <>
+std::string makeItem<std::string>(int n)
+{
+    return "container item " + std::to_string(n);
+}
+
+/**
+ * @return The items made from 0, ..., numItems - 1, in a random order
+ *         which is the same for every run.
+ */
+template <class T>
+const std::vector<T>& getItems(int numItems)
+{
+    static std::map<int, std::vector<T>> itemsBySize;
+    std::vector<T>& items = itemsBySize[numItems];
+    if (items.empty())
+    {
+        for (int i = 0; i < numItems; i++)
+        {
+            items.push_back(makeItem<T>(i));
+        }
+        std::shuffle(items.begin(), items.end(), std::mt19937(42));
+    }
+
+    return items;
+}
+
+// Lists
+
+template <class ListType, class T>
+void BM_ListAdd(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        ListType list;
+        for (const T& item : items)
+        {
+            list.add(item);
+        }
+        benchmark::DoNotOptimize(list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+// one search per iteration, for each item in turn
+template <class ListType, class T>
+void BM_ListContains(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    ListType list;
+    for (const T& item : items)
+    {
+        list.add(item);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.contains(items[i]));
+        i = (i + 1 == items.size()) ? 0 : i + 1;
+    }
+}
+
+template <class ListType, class T>
+void BM_ListIterate(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    ListType list;
+    for (const T& item : items)
+    {
+        list.add(item);
+    }
+
+    for (auto _ : state)
+    {
+        for (const T& item : list)
+        {
+            benchmark::DoNotOptimize(&item);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+// every item is removed, in a random order
+template <class ListType, class T>
+void BM_ListRemove(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        ListType list;
+        for (int i = 0; i < static_cast<int>(items.size()); i++)
+        {
+            list.add(makeItem<T>(i));
+        }
+        for (const T& item : items)
+        {
+            list.remove(item);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+#define LIST_BENCHMARKS(LIST, T) \
+    BENCHMARK_TEMPLATE(BM_ListAdd, LIST<T>, T) \
+        ->RangeMultiplier(8)->Range(64, 32768); \
+    BENCHMARK_TEMPLATE(BM_ListContains, LIST<T>, T) \
+        ->RangeMultiplier(8)->Range(64, 32768); \
+    BENCHMARK_TEMPLATE(BM_ListIterate, LIST<T>, T) \
+        ->RangeMultiplier(8)->Range(64, 32768); \
+    BENCHMARK_TEMPLATE(BM_ListRemove, LIST<T>, T) \
+        ->RangeMultiplier(8)->Range(64, 4096)
+
+LIST_BENCHMARKS(ArrayList, int);
+LIST_BENCHMARKS(ArrayList, std::string);
+LIST_BENCHMARKS(LinkedList, int);
+LIST_BENCHMARKS(LinkedList, std::string);
+
+// Stacks, queues and heaps: push every item, then pop them all
+
+template <class T>
+void BM_Stack(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        Stack<T> stack;
+        for (const T& item : items)
+        {
+            stack.push(item);
+        }
+        while (!stack.empty())
+        {
+            benchmark::DoNotOptimize(&stack.top());
+            stack.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+template <class T>
+void BM_Queue(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        Queue<T> queue;
+        for (const T& item : items)
+        {
+            queue.push(item);
+        }
+        while (!queue.empty())
+        {
+            benchmark::DoNotOptimize(&queue.front());
+            queue.pop();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+template <class T>
+void BM_Heap(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        Heap<T> heap;
+        for (const T& item : items)
+        {
+            heap.add(item);
+        }
+        while (!heap.isEmpty())
+        {
+            benchmark::DoNotOptimize(&heap.peekTop());
+            heap.remove();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+// building a heap from an array, which heapifies it in linear time
+template <class T>
+void BM_HeapFromArray(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        Heap<T> heap(items.data(), static_cast<int>(items.size()));
+        benchmark::DoNotOptimize(&heap.peekTop());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+template <class T>
+void BM_PriorityQueue(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        PriorityQueue<T> queue;
+        for (const T& item : items)
+        {
+            queue.add(item);
+        }
+        while (!queue.isEmpty())
+        {
+            benchmark::DoNotOptimize(&queue.peek());
+            queue.remove();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+#define POP_BENCHMARKS(NAME, T) \
+    BENCHMARK_TEMPLATE(NAME, T)->RangeMultiplier(8)->Range(64, 32768)
+
+POP_BENCHMARKS(BM_Stack, int);
+POP_BENCHMARKS(BM_Stack, std::string);
+POP_BENCHMARKS(BM_Queue, int);
+POP_BENCHMARKS(BM_Queue, std::string);
+POP_BENCHMARKS(BM_Heap, int);
+POP_BENCHMARKS(BM_Heap, std::string);
+POP_BENCHMARKS(BM_HeapFromArray, int);
+POP_BENCHMARKS(BM_HeapFromArray, std::string);
+POP_BENCHMARKS(BM_PriorityQueue, int);
+POP_BENCHMARKS(BM_PriorityQueue, std::string);
+
+// Trees
+
+template <class TreeType, class T>
+void BM_TreeAdd(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        TreeType tree;
+        for (const T& item : items)
+        {
+            tree.add(item);
+        }
+        benchmark::DoNotOptimize(tree.getNumNodes());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+// one search per iteration, for each item in turn
+template <class TreeType, class T>
+void BM_TreeContains(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    TreeType tree;
+    for (const T& item : items)
+    {
+        tree.add(item);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.contains(items[i]));
+        i = (i + 1 == items.size()) ? 0 : i + 1;
+    }
+}
+
+// every item is removed, in the reverse of the order they were added
+template <class TreeType, class T>
+void BM_TreeRemove(benchmark::State& state)
+{
+    const std::vector<T>& items = getItems<T>(state.range(0));
+    for (auto _ : state)
+    {
+        TreeType tree;
+        for (const T& item : items)
+        {
+            tree.add(item);
+        }
+        for (auto it = items.rbegin(); it != items.rend(); ++it)
+        {
+            tree.remove(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+// BinaryTree keeps no order, so each search and removal visits the whole
+// tree; its sizes stop lower
+#define TREE_BENCHMARKS(TREE, T, MAX_SIZE) \
+    BENCHMARK_TEMPLATE(BM_TreeAdd, TREE<T>, T) \
+        ->RangeMultiplier(8)->Range(64, MAX_SIZE); \
+    BENCHMARK_TEMPLATE(BM_TreeContains, TREE<T>, T) \
+        ->RangeMultiplier(8)->Range(64, MAX_SIZE); \
+    BENCHMARK_TEMPLATE(BM_TreeRemove, TREE<T>, T) \
+        ->RangeMultiplier(8)->Range(64, MAX_SIZE)
+
+TREE_BENCHMARKS(BinaryTree, int, 4096);
+TREE_BENCHMARKS(BinaryTree, std::string, 4096);
+TREE_BENCHMARKS(BinarySearchTree, int, 32768);
+TREE_BENCHMARKS(BinarySearchTree, std::string, 32768);
+
+// Maps, from each item to its position
+
+template <class K>
+void BM_MapAdd(benchmark::State& state)
+{
+    const std::vector<K>& keys = getItems<K>(state.range(0));
+    for (auto _ : state)
+    {
+        BSTMap<K, int> map;
+        for (int i = 0; i < static_cast<int>(keys.size()); i++)
+        {
+            map.add(keys[i], i);
+        }
+        benchmark::DoNotOptimize(map.getSize());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <class K>
+void BM_MapGetValue(benchmark::State& state)
+{
+    const std::vector<K>& keys = getItems<K>(state.range(0));
+    BSTMap<K, int> map;
+    for (int i = 0; i < static_cast<int>(keys.size()); i++)
+    {
+        map.add(keys[i], i);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(map.getValue(keys[i]));
+        i = (i + 1 == keys.size()) ? 0 : i + 1;
+    }
+}
+
+template <class K>
+void BM_MapRemove(benchmark::State& state)
+{
+    const std::vector<K>& keys = getItems<K>(state.range(0));
+    for (auto _ : state)
+    {
+        BSTMap<K, int> map;
+        for (int i = 0; i < static_cast<int>(keys.size()); i++)
+        {
+            map.add(keys[i], i);
+        }
+        for (auto it = keys.rbegin(); it != keys.rend(); ++it)
+        {
+            map.remove(*it);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+#define MAP_BENCHMARKS(K) \
+    BENCHMARK_TEMPLATE(BM_MapAdd, K)->RangeMultiplier(8)->Range(64, 32768); \
+    BENCHMARK_TEMPLATE(BM_MapGetValue, K) \
+        ->RangeMultiplier(8)->Range(64, 32768); \
+    BENCHMARK_TEMPLATE(BM_MapRemove, K)->RangeMultiplier(8)->Range(64, 32768)
+
+MAP_BENCHMARKS(int);
+MAP_BENCHMARKS(std::string);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+/**
+ * The cost of instrumenting a container with ContainerStats, against the
+ * default NoStats policy, which should cost nothing.
+ */
+
+#include "ArrayList.h"
+#include "BinarySearchTree.h"
+#include "ContainerStats.h"
+#include "Heap.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_ITEMS = 1 << 16;
+
+std::vector<int> getShuffledItems()
+{
+    std::vector<int> items(NUM_ITEMS);
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        items[i] = i;
+    }
+    std::shuffle(items.begin(), items.end(), std::mt19937(42));
+    return items;
+}
+
+template <class Stats>
+void BM_ArrayListAdd(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ArrayList<int, Stats> list;
+        for (int i = 0; i < NUM_ITEMS; i++)
+        {
+            list.add(i);
+        }
+        benchmark::DoNotOptimize(list.data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+
+template <class Stats>
+void BM_HeapPushPop(benchmark::State& state)
+{
+    std::vector<int> items = getShuffledItems();
+    for (auto _ : state)
+    {
+        Heap<int, Stats> heap;
+        for (int item : items)
+        {
+            heap.add(item);
+        }
+        while (!heap.isEmpty())
+        {
+            heap.remove();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+
+template <class Stats>
+void BM_TreeContains(benchmark::State& state)
+{
+    std::vector<int> items = getShuffledItems();
+    BinarySearchTree<int, Stats> tree;
+    for (int item : items)
+    {
+        tree.add(item);
+    }
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.contains(items[i]));
+        i = (i + 1) % NUM_ITEMS;
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayListAdd, NoStats);
+BENCHMARK_TEMPLATE(BM_ArrayListAdd, ContainerStats);
+BENCHMARK_TEMPLATE(BM_HeapPushPop, NoStats);
+BENCHMARK_TEMPLATE(BM_HeapPushPop, ContainerStats);
+BENCHMARK_TEMPLATE(BM_TreeContains, NoStats);
+BENCHMARK_TEMPLATE(BM_TreeContains, ContainerStats);
+
+}
+
+BENCHMARK_MAIN();
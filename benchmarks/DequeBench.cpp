@@ -0,0 +1,215 @@
+/**
+ * Deque against the containers it can stand in for: Stack and Queue, which
+ * allocate a node per item, and ArrayList, which reallocates and copies its
+ * array as it grows.
+ */
+
+#include "ArrayList.h"
+#include "Deque.h"
+#include "Queue.h"
+#include "Stack.h"
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Pushes state.range(0) items, then pops them all.
+template <class StackType>
+void BM_StackPushPop(benchmark::State& state)
+{
+    const int numItems = state.range(0);
+    for (auto _ : state)
+    {
+        StackType stack;
+        for (int i = 0; i < numItems; i++)
+        {
+            stack.push(i);
+        }
+
+        long long sum = 0;
+        while (!stack.empty())
+        {
+            sum += stack.top();
+            stack.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK_TEMPLATE(BM_StackPushPop, Stack<int>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_StackPushPop, Stack<int, Deque<int>>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+template <class QueueType>
+void BM_QueuePushPop(benchmark::State& state)
+{
+    const int numItems = state.range(0);
+    for (auto _ : state)
+    {
+        QueueType queue;
+        for (int i = 0; i < numItems; i++)
+        {
+            queue.push(i);
+        }
+
+        long long sum = 0;
+        while (!queue.empty())
+        {
+            sum += queue.front();
+            queue.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK_TEMPLATE(BM_QueuePushPop, Queue<int>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_QueuePushPop, Queue<int, Deque<int>>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+// A queue holding state.range(0) items, which pushes one and pops one per
+// iteration, as a work queue in a steady state does. The deque reuses its
+// spare block, so it does not allocate at all.
+template <class QueueType>
+void BM_QueueSteadyState(benchmark::State& state)
+{
+    const int numItems = state.range(0);
+    QueueType queue;
+    for (int i = 0; i < numItems; i++)
+    {
+        queue.push(i);
+    }
+
+    int i = 0;
+    for (auto _ : state)
+    {
+        queue.push(i++);
+        benchmark::DoNotOptimize(queue.front());
+        queue.pop();
+    }
+}
+BENCHMARK_TEMPLATE(BM_QueueSteadyState, Queue<int>)->Arg(1 << 10);
+BENCHMARK_TEMPLATE(BM_QueueSteadyState, Queue<int, Deque<int>>)
+    ->Arg(1 << 10);
+
+// Appends state.range(0) items, then sums them by index.
+void BM_ArrayListAppendIndex(benchmark::State& state)
+{
+    const int numItems = state.range(0);
+    for (auto _ : state)
+    {
+        ArrayList<int> list;
+        for (int i = 0; i < numItems; i++)
+        {
+            list.add(i);
+        }
+
+        const int* items = list.data();
+        long long sum = 0;
+        for (int i = 0; i < numItems; i++)
+        {
+            sum += items[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_ArrayListAppendIndex)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+void BM_DequeAppendIndex(benchmark::State& state)
+{
+    const int numItems = state.range(0);
+    for (auto _ : state)
+    {
+        Deque<int> deque;
+        for (int i = 0; i < numItems; i++)
+        {
+            deque.pushBack(i);
+        }
+
+        long long sum = 0;
+        for (int i = 0; i < numItems; i++)
+        {
+            sum += deque[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK(BM_DequeAppendIndex)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+// Reads items at random indices of a container of 2^20 items.
+std::vector<int> getRandomIndices(int numItems)
+{
+    std::mt19937 random(7);
+    std::vector<int> indices(1 << 12);
+    for (int& index : indices)
+    {
+        index = random() % numItems;
+    }
+    return indices;
+}
+
+void BM_ArrayListRandomAccess(benchmark::State& state)
+{
+    const int numItems = 1 << 20;
+    ArrayList<int> list;
+    for (int i = 0; i < numItems; i++)
+    {
+        list.add(i);
+    }
+    std::vector<int> indices = getRandomIndices(numItems);
+
+    const int* items = list.data();
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int index : indices)
+        {
+            sum += items[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(BM_ArrayListRandomAccess);
+
+void BM_DequeRandomAccess(benchmark::State& state)
+{
+    const int numItems = 1 << 20;
+    Deque<int> deque;
+    for (int i = 0; i < numItems; i++)
+    {
+        // half the items at each end, so the front block is partly empty
+        if (i % 2 == 0)
+        {
+            deque.pushBack(i);
+        }
+        else
+        {
+            deque.pushFront(i);
+        }
+    }
+    std::vector<int> indices = getRandomIndices(numItems);
+
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int index : indices)
+        {
+            sum += deque[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(BM_DequeRandomAccess);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+#include "BinarySearchTree.h"
+#include "EytzingerIndex.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_QUERIES = 1 << 20;
+
+/**
+ * Random search keys among 0, ..., 2 * numKeys - 1, half of which miss when
+ * the keys are the even numbers.
+ */
+std::vector<int> makeQueries(int numKeys)
+{
+    std::vector<int> queries(NUM_QUERIES);
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> key(0, 2 * numKeys - 1);
+    for (int& query : queries)
+    {
+        query = key(rng);
+    }
+
+    return queries;
+}
+
+std::vector<int> makeSortedKeys(int numKeys)
+{
+    std::vector<int> keys(numKeys);
+    for (int i = 0; i < numKeys; i++)
+    {
+        keys[i] = 2 * i;
+    }
+
+    return keys;
+}
+
+/**
+ * A pointer tree of the given number of keys, inserted in random order.
+ */
+const BinarySearchTree<int>& getTree(int numKeys)
+{
+    static BinarySearchTree<int> tree;
+    static int treeSize = 0;
+    if (treeSize != numKeys)
+    {
+        std::vector<int> keys = makeSortedKeys(numKeys);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+        tree.clear();
+        for (int key : keys)
+        {
+            tree.add(key);
+        }
+        treeSize = numKeys;
+    }
+
+    return tree;
+}
+
+const std::vector<int>& getSortedArray(int numKeys)
+{
+    static std::vector<int> keys;
+    if (static_cast<int>(keys.size()) != numKeys)
+    {
+        keys = makeSortedKeys(numKeys);
+    }
+
+    return keys;
+}
+
+const EytzingerIndex<int>& getIndex(int numKeys)
+{
+    static EytzingerIndex<int> index;
+    if (index.getNumItems() != numKeys)
+    {
+        index = EytzingerIndex<int>();
+        index = EytzingerIndex<int>(makeSortedKeys(numKeys));
+    }
+
+    return index;
+}
+
+void BM_TreeLookup(benchmark::State& state)
+{
+    const BinarySearchTree<int>& tree = getTree(state.range(0));
+    std::vector<int> queries = makeQueries(state.range(0));
+    int next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.findItem(queries[next]));
+        next = (next + 1) & (NUM_QUERIES - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TreeLookup)->Arg(1 << 20)->Arg(1 << 22);
+
+// std::lower_bound on the sorted keys, for reference.
+void BM_SortedArrayLookup(benchmark::State& state)
+{
+    const std::vector<int>& keys = getSortedArray(state.range(0));
+    std::vector<int> queries = makeQueries(state.range(0));
+    int next = 0;
+    for (auto _ : state)
+    {
+        auto it = std::lower_bound(keys.begin(), keys.end(), queries[next]);
+        benchmark::DoNotOptimize(it != keys.end() && *it == queries[next]);
+        next = (next + 1) & (NUM_QUERIES - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SortedArrayLookup)->Arg(1 << 20)->Arg(1 << 22)->Arg(1 << 24)
+    ->Arg(1 << 26);
+
+void BM_IndexLookup(benchmark::State& state)
+{
+    const EytzingerIndex<int>& index = getIndex(state.range(0));
+    std::vector<int> queries = makeQueries(state.range(0));
+    int next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.findItem(queries[next]));
+        next = (next + 1) & (NUM_QUERIES - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IndexLookup)->Arg(1 << 20)->Arg(1 << 22)->Arg(1 << 24)
+    ->Arg(1 << 26);
+
+// Lookups of 1024 keys at a time through findItems.
+void BM_IndexBatchLookup(benchmark::State& state)
+{
+    const int BATCH_SIZE = 1024;
+    const EytzingerIndex<int>& index = getIndex(state.range(0));
+    std::vector<int> queries = makeQueries(state.range(0));
+    std::vector<const int*> results(BATCH_SIZE);
+    int next = 0;
+    for (auto _ : state)
+    {
+        index.findItems(queries.data() + next, BATCH_SIZE, results.data());
+        benchmark::DoNotOptimize(results.data());
+        next = (next + BATCH_SIZE) & (NUM_QUERIES - 1);
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(BM_IndexBatchLookup)->Arg(1 << 20)->Arg(1 << 22)->Arg(1 << 24)
+    ->Arg(1 << 26);
+
+void BM_Freeze(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        BinarySearchTree<int> tree(getTree(state.range(0)));
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(tree.freeze());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Freeze)->Arg(1 << 20)->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
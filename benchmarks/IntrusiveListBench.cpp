@@ -0,0 +1,139 @@
+#include "IntrusiveList.h"
+#include "IntrusiveQueue.h"
+#include "LinkedList.h"
+#include "Queue.h"
+#include "benchmark/benchmark.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_ITEMS = 1000000;
+
+/**
+ * A pooled object of about a cache line, as a queue of work items would
+ * hold.
+ */
+struct Job
+{
+    int id;
+    int payload[11];
+    IntrusiveListHook<Job> listHook;
+
+    Job(int id) : id(id), payload()
+    {
+
+    }
+
+    bool operator==(const Job& other) const
+    {
+        return id == other.id;
+    }
+};
+
+std::vector<Job>& getPool()
+{
+    static std::vector<Job> pool;
+    if (pool.empty())
+    {
+        for (int i = 0; i < NUM_ITEMS; i++)
+        {
+            pool.emplace_back(i);
+        }
+    }
+
+    return pool;
+}
+
+// Queues every object of the pool, then dequeues them all. Queue<Job>
+// copies each object into a new node.
+template <class QueueType>
+void BM_PushPop(benchmark::State& state)
+{
+    std::vector<Job>& pool = getPool();
+    QueueType queue;
+    for (auto _ : state)
+    {
+        for (Job& job : pool)
+        {
+            queue.push(job);
+        }
+
+        long long sum = 0;
+        while (!queue.empty())
+        {
+            sum += queue.front().id;
+            queue.pop();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_PushPop, Queue<Job>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PushPop, IntrusiveQueue<Job>)
+    ->Unit(benchmark::kMillisecond);
+
+// Removes 1000 random objects from a list of state.range(0); LinkedList
+// has to search for each one.
+void BM_RemoveLinkedList(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    std::vector<Job>& pool = getPool();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LinkedList<Job>* list = new LinkedList<Job>();
+        for (int i = 0; i < numItems; i++)
+        {
+            list->add(pool[i]);
+        }
+        std::mt19937 random(42);
+        state.ResumeTiming();
+
+        for (int i = 0; i < 1000; i++)
+        {
+            list->remove(pool[random() % numItems]);
+        }
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_RemoveLinkedList)->Arg(100000)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_RemoveIntrusiveList(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    std::vector<Job>& pool = getPool();
+    IntrusiveList<Job> list;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (int i = 0; i < numItems; i++)
+        {
+            list.pushBack(pool[i]);
+        }
+        std::mt19937 random(42);
+        state.ResumeTiming();
+
+        for (int i = 0; i < 1000; i++)
+        {
+            list.remove(pool[random() % numItems]);
+        }
+
+        state.PauseTiming();
+        list.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(BM_RemoveIntrusiveList)->Arg(100000)->Arg(NUM_ITEMS)
+    ->Iterations(5)->Unit(benchmark::kMicrosecond);
+
+}
+
+BENCHMARK_MAIN();
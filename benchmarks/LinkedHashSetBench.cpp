@@ -0,0 +1,118 @@
+#include "LinkedHashSet.h"
+#include "LinkedList.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_ITEMS = 1000000;
+
+/**
+ * The items 0, ..., NUM_ITEMS - 1 in a random order.
+ */
+const std::vector<int>& getShuffledItems()
+{
+    static std::vector<int> items;
+    if (items.empty())
+    {
+        for (int i = 0; i < NUM_ITEMS; i++)
+        {
+            items.push_back(i);
+        }
+        std::shuffle(items.begin(), items.end(), std::mt19937(42));
+    }
+
+    return items;
+}
+
+template <class ListType>
+void fill(ListType& list)
+{
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        list.add(i);
+    }
+}
+
+// Removes state.range(0) items, in random order, from a list of NUM_ITEMS.
+// A plain LinkedList scans for each one, so it only removes a few.
+template <class ListType>
+void BM_RandomRemove(benchmark::State& state)
+{
+    int numRemoved = state.range(0);
+    const std::vector<int>& items = getShuffledItems();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType* list = new ListType();
+        fill(*list);
+        state.ResumeTiming();
+
+        for (int i = 0; i < numRemoved; i++)
+        {
+            list->remove(items[i]);
+        }
+        benchmark::DoNotOptimize(list->size());
+
+        // freeing a million nodes also returns memory to the system, which
+        // would otherwise be timed when the next iteration's list is built
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * numRemoved);
+}
+BENCHMARK_TEMPLATE(BM_RandomRemove, LinkedList<int>)->Arg(1000)
+    ->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RandomRemove, LinkedHashSet<int>)->Arg(1000)
+    ->Arg(NUM_ITEMS)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+template <class ListType>
+void BM_RandomContains(benchmark::State& state)
+{
+    int numLookups = state.range(0);
+    const std::vector<int>& items = getShuffledItems();
+    ListType list;
+    fill(list);
+    for (auto _ : state)
+    {
+        int numFound = 0;
+        for (int i = 0; i < numLookups; i++)
+        {
+            numFound += list.contains(items[i]);
+        }
+        benchmark::DoNotOptimize(numFound);
+    }
+    state.SetItemsProcessed(state.iterations() * numLookups);
+}
+BENCHMARK_TEMPLATE(BM_RandomContains, LinkedList<int>)->Arg(1000)
+    ->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_RandomContains, LinkedHashSet<int>)->Arg(1000)
+    ->Arg(NUM_ITEMS)->Unit(benchmark::kMillisecond);
+
+template <class ListType>
+void BM_Add(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ListType* list = new ListType();
+        fill(*list);
+        benchmark::DoNotOptimize(list->size());
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_Add, LinkedList<int>)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Add, LinkedHashSet<int>)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include "ArrayList.h"
+#include "LinkedList.h"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+
+const int NUM_ITEMS = 1000000;
+
+template <class ListType>
+const ListType& getList()
+{
+    static ListType list;
+    if (list.empty())
+    {
+        for (int i = 0; i < NUM_ITEMS; i++)
+        {
+            list.add(i);
+        }
+    }
+
+    return list;
+}
+
+// Reading every item the only way there was before: by copying the list into
+// a new vector.
+template <class ListType>
+void BM_SumToVector(benchmark::State& state)
+{
+    const ListType& list = getList<ListType>();
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int item : list.toVector())
+        {
+            sum += item;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_SumToVector, ArrayList<int>)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SumToVector, LinkedList<int>)
+    ->Unit(benchmark::kMicrosecond);
+
+template <class ListType>
+void BM_SumIterator(benchmark::State& state)
+{
+    const ListType& list = getList<ListType>();
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int item : list)
+        {
+            sum += item;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_SumIterator, ArrayList<int>)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_SumIterator, LinkedList<int>)
+    ->Unit(benchmark::kMicrosecond);
+
+}
+
+BENCHMARK_MAIN();
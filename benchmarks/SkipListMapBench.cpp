@@ -0,0 +1,178 @@
+#include "SkipListMap.h"
+#include "BSTMap.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_KEYS = 1 << 16;
+
+/**
+ * The baseline: a single BSTMap behind a single lock.
+ */
+class LockedBSTMap
+{
+private:
+    mutable std::mutex lock;
+    BSTMap<int, int> map;
+
+public:
+    bool add(int key, int value)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return map.add(key, value);
+    }
+
+    bool remove(int key)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return map.remove(key);
+    }
+
+    bool tryGetValue(int key, int& value) const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        const int* valuePtr = map.findPtr(key);
+        if (valuePtr == nullptr)
+        {
+            return false;
+        }
+
+        value = *valuePtr;
+        return true;
+    }
+};
+
+/**
+ * Fills a map with every other key in [0, 2 * NUM_KEYS), in random order.
+ */
+template <class Map>
+void populate(Map& map)
+{
+    std::vector<int> keys;
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        keys.push_back(2 * i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    for (int key : keys)
+    {
+        map.add(key, key);
+    }
+}
+
+/**
+ * Runs a mix of lookups and writes against a map shared by all benchmark
+ * threads. @c writePercent of the operations alternate between adding and
+ * removing a random key; the rest are lookups.
+ */
+template <class Map>
+void runMixedWorkload(benchmark::State& state, Map& map, int writePercent)
+{
+    std::mt19937 rng(state.thread_index() + 1);
+    std::uniform_int_distribution<int> key(0, 2 * NUM_KEYS - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    int value = 0;
+    bool addNext = true;
+    for (auto _ : state)
+    {
+        int k = key(rng);
+        if (percent(rng) < writePercent)
+        {
+            if (addNext)
+            {
+                map.add(k, k);
+            }
+            else
+            {
+                map.remove(k);
+            }
+            addNext = !addNext;
+        }
+        else
+        {
+            benchmark::DoNotOptimize(map.tryGetValue(k, value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * The maps are shared by every thread of every run, and are populated once.
+ * Writes alternate between adds and removes of random keys, so the maps stay
+ * at roughly their initial size from run to run.
+ */
+template <class Map>
+Map& getSharedMap()
+{
+    static Map map;
+    static std::once_flag populated;
+    std::call_once(populated, [&]() { populate(map); });
+    return map;
+}
+
+template <int WRITE_PERCENT>
+void BM_LockedBSTMap(benchmark::State& state)
+{
+    runMixedWorkload(state, getSharedMap<LockedBSTMap>(), WRITE_PERCENT);
+}
+
+template <int WRITE_PERCENT>
+void BM_SkipListMap(benchmark::State& state)
+{
+    runMixedWorkload(state, getSharedMap<SkipListMap<int, int>>(),
+                     WRITE_PERCENT);
+}
+
+// read-heavy: 5% writes
+BENCHMARK_TEMPLATE(BM_LockedBSTMap, 5)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SkipListMap, 5)->ThreadRange(1, 32)->UseRealTime();
+
+// write-heavy: 50% writes
+BENCHMARK_TEMPLATE(BM_LockedBSTMap, 50)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SkipListMap, 50)->ThreadRange(1, 32)->UseRealTime();
+
+/**
+ * The first thread scans ranges of about 64 entries while the others write,
+ * which a locked map would have to block for the whole scan.
+ */
+void BM_SkipListMap_RangeScan(benchmark::State& state)
+{
+    SkipListMap<int, int>& map = getSharedMap<SkipListMap<int, int>>();
+    std::mt19937 rng(state.thread_index() + 1);
+    std::uniform_int_distribution<int> key(0, 2 * NUM_KEYS - 1);
+    bool addNext = true;
+    for (auto _ : state)
+    {
+        int k = key(rng);
+        if (state.thread_index() == 0)
+        {
+            long long sum = 0;
+            map.forEachInRange(k, k + 128, [&sum](const int&, const int& v)
+            {
+                sum += v;
+            });
+            benchmark::DoNotOptimize(sum);
+        }
+        else if (addNext)
+        {
+            map.add(k, k);
+            addNext = false;
+        }
+        else
+        {
+            map.remove(k);
+            addNext = true;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SkipListMap_RangeScan)->ThreadRange(1, 32)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
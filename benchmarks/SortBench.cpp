@@ -0,0 +1,249 @@
+#include "ArrayList.h"
+#include "LinkedList.h"
+#include "ThreadPool.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int NUM_ITEMS = 100000000;
+const int NUM_LIST_ITEMS = 1000000;
+
+const std::vector<int>& getRandomItems()
+{
+    static std::vector<int> items;
+    if (items.empty())
+    {
+        std::mt19937 random(42);
+        items.resize(NUM_ITEMS);
+        for (int& item : items)
+        {
+            item = static_cast<int>(random());
+        }
+    }
+
+    return items;
+}
+
+/**
+ * A list of the random items, restored before every iteration.
+ */
+ArrayList<int>& getList()
+{
+    static ArrayList<int>* list = nullptr;
+    if (list == nullptr)
+    {
+        list = new ArrayList<int>(NUM_ITEMS);
+        for (int item : getRandomItems())
+        {
+            list->add(item);
+        }
+    }
+
+    return *list;
+}
+
+void restoreList(ArrayList<int>& list)
+{
+    const std::vector<int>& items = getRandomItems();
+    std::copy(items.begin(), items.end(), list.data());
+}
+
+void checkSorted(benchmark::State& state, const ArrayList<int>& list)
+{
+    if (!std::is_sorted(list.begin(), list.end()))
+    {
+        state.SkipWithError("not sorted");
+    }
+}
+
+// the way to sort a list before ArrayList::sort: copy the items out, sort
+// them and add them back
+void BM_SortThroughVector(benchmark::State& state)
+{
+    ArrayList<int>& list = getList();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restoreList(list);
+        state.ResumeTiming();
+
+        std::vector<int> items = list.toVector();
+        std::sort(items.begin(), items.end());
+        list.clear();
+        for (int item : items)
+        {
+            list.add(item);
+        }
+    }
+    checkSorted(state, list);
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_SortThroughVector)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// the radix sort
+void BM_Sort(benchmark::State& state)
+{
+    ArrayList<int>& list = getList();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restoreList(list);
+        state.ResumeTiming();
+
+        list.sort();
+    }
+    checkSorted(state, list);
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_Sort)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// a comparison sort, since the comparison is not std::less
+void BM_SortWithComparison(benchmark::State& state)
+{
+    ArrayList<int>& list = getList();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restoreList(list);
+        state.ResumeTiming();
+
+        list.sort([](int first, int second) { return first < second; });
+    }
+    checkSorted(state, list);
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_SortWithComparison)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+// the parallel radix sort, on state.range(0) threads
+void BM_ParallelSort(benchmark::State& state)
+{
+    ArrayList<int>& list = getList();
+    ThreadPool pool(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restoreList(list);
+        state.ResumeTiming();
+
+        list.parallelSort(std::less<int>(), pool);
+    }
+    checkSorted(state, list);
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_ParallelSort)->RangeMultiplier(2)->Range(1, 16)->Iterations(1)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// the parallel merge sort, on state.range(0) threads
+void BM_ParallelMergeSort(benchmark::State& state)
+{
+    ArrayList<int>& list = getList();
+    ThreadPool pool(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restoreList(list);
+        state.ResumeTiming();
+
+        list.parallelSort([](int first, int second) { return first < second; },
+                          pool);
+    }
+    checkSorted(state, list);
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK(BM_ParallelMergeSort)->RangeMultiplier(2)->Range(1, 16)
+    ->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+/**
+ * The first NUM_LIST_ITEMS random items, as @c T: an @c int, or a string
+ * long enough to be allocated on the heap.
+ */
+template <class T>
+T makeListItem(int item);
+
+template <>
+int makeListItem<int>(int item)
+{
+    return item;
+}
+
+template <>
+std::string makeListItem<std::string>(int item)
+{
+    return "item number " + std::to_string(item);
+}
+
+template <class T>
+LinkedList<T>* makeLinkedList()
+{
+    const std::vector<int>& items = getRandomItems();
+    LinkedList<T>* list = new LinkedList<T>();
+    for (int i = 0; i < NUM_LIST_ITEMS; i++)
+    {
+        list->add(makeListItem<T>(items[i]));
+    }
+
+    return list;
+}
+
+// LinkedList::sort relinks the nodes it has
+template <class T>
+void BM_LinkedListSort(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LinkedList<T>* list = makeLinkedList<T>();
+        state.ResumeTiming();
+
+        list->sort();
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_LIST_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_LinkedListSort, int)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LinkedListSort, std::string)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+// against copying the items out, sorting them and building a new list
+template <class T>
+void BM_LinkedListSortThroughVector(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LinkedList<T>* list = makeLinkedList<T>();
+        state.ResumeTiming();
+
+        std::vector<T> sorted = list->toVector();
+        std::sort(sorted.begin(), sorted.end());
+        list->clear();
+        for (const T& item : sorted)
+        {
+            list->add(item);
+        }
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_LIST_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_LinkedListSortThroughVector, int)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_LinkedListSortThroughVector, std::string)
+    ->Iterations(3)->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,106 @@
+#include "BinarySearchTree.h"
+#include "CompactBinarySearchTree.h"
+#include "SplayTree.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const int NUM_KEYS = 1 << 20;
+const int NUM_QUERIES = 1 << 20;
+
+/**
+ * The keys 0, 2, ..., 2 * (NUM_KEYS - 1) in random order. Key i in this
+ * order has popularity rank i, so the hot keys are scattered through the
+ * key space rather than adjacent.
+ */
+const std::vector<int>& getKeys()
+{
+    static std::vector<int> keys;
+    if (keys.empty())
+    {
+        keys.resize(NUM_KEYS);
+        for (int i = 0; i < NUM_KEYS; i++)
+        {
+            keys[i] = 2 * i;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+    }
+
+    return keys;
+}
+
+/**
+ * Search keys whose popularity ranks follow a Zipf distribution with the
+ * given exponent, or are uniform if the exponent is 0.
+ */
+std::vector<int> makeQueries(double exponent)
+{
+    const std::vector<int>& keys = getKeys();
+    std::vector<double> cumulative(NUM_KEYS);
+    double total = 0;
+    for (int rank = 0; rank < NUM_KEYS; rank++)
+    {
+        total += 1.0 / std::pow(rank + 1.0, exponent);
+        cumulative[rank] = total;
+    }
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<int> queries(NUM_QUERIES);
+    for (int& query : queries)
+    {
+        int rank = std::lower_bound(cumulative.begin(), cumulative.end(),
+                                    uniform(rng)) - cumulative.begin();
+        query = keys[std::min(rank, NUM_KEYS - 1)];
+    }
+
+    return queries;
+}
+
+/**
+ * A tree of every key, inserted in random order.
+ */
+template <class Tree>
+Tree& getTree()
+{
+    static Tree tree;
+    if (tree.empty())
+    {
+        for (int key : getKeys())
+        {
+            tree.add(key);
+        }
+    }
+
+    return tree;
+}
+
+// Argument: the Zipf exponent, times 100 (0 for uniform lookups).
+template <class Tree>
+void BM_Lookup(benchmark::State& state)
+{
+    Tree& tree = getTree<Tree>();
+    std::vector<int> queries = makeQueries(state.range(0) / 100.0);
+    int next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tree.contains(queries[next]));
+        next = (next + 1) & (NUM_QUERIES - 1);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Lookup, BinarySearchTree<int>)->Arg(0)->Arg(80)
+    ->Arg(99)->Arg(120)->ArgName("zipf");
+BENCHMARK_TEMPLATE(BM_Lookup, CompactBinarySearchTree<int>)->Arg(0)->Arg(80)
+    ->Arg(99)->Arg(120)->ArgName("zipf");
+BENCHMARK_TEMPLATE(BM_Lookup, SplayTree<int>)->Arg(0)->Arg(80)->Arg(99)
+    ->Arg(120)->ArgName("zipf");
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,118 @@
+#include "BinarySearchTree.h"
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const std::vector<int>& getKeys(int numKeys)
+{
+    static std::vector<int> keys;
+    if (static_cast<int>(keys.size()) != numKeys)
+    {
+        keys.resize(numKeys);
+        for (int i = 0; i < numKeys; i++)
+        {
+            keys[i] = i;
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    }
+
+    return keys;
+}
+
+/**
+ * One build-query-discard cycle: add every key in random order, look every
+ * key up once, and clear the tree.
+ */
+void runCycle(BinarySearchTree<int>& tree, const std::vector<int>& keys)
+{
+    for (int key : keys)
+    {
+        tree.add(key);
+    }
+
+    int numFound = 0;
+    for (int key : keys)
+    {
+        numFound += (tree.findItem(key) != nullptr);
+    }
+    benchmark::DoNotOptimize(numFound);
+
+    tree.clear();
+}
+
+void BM_Cycle_Heap(benchmark::State& state)
+{
+    const std::vector<int>& keys = getKeys(state.range(0));
+    BinarySearchTree<int> tree;
+    for (auto _ : state)
+    {
+        runCycle(tree, keys);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Cycle_Heap)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Cycle_Arena(benchmark::State& state)
+{
+    const std::vector<int>& keys = getKeys(state.range(0));
+    BinarySearchTree<int> tree;
+    tree.useArena();
+    for (auto _ : state)
+    {
+        runCycle(tree, keys);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Cycle_Arena)->Arg(1 << 12)->Arg(1 << 16)->Arg(1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+// Only the teardown, which the arena turns from n frees into one per chunk.
+void BM_Clear_Heap(benchmark::State& state)
+{
+    const std::vector<int>& keys = getKeys(state.range(0));
+    BinarySearchTree<int> tree;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (int key : keys)
+        {
+            tree.add(key);
+        }
+        state.ResumeTiming();
+
+        tree.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Clear_Heap)->Arg(1 << 20)->Iterations(10)
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Clear_Arena(benchmark::State& state)
+{
+    const std::vector<int>& keys = getKeys(state.range(0));
+    BinarySearchTree<int> tree;
+    tree.useArena();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (int key : keys)
+        {
+            tree.add(key);
+        }
+        state.ResumeTiming();
+
+        tree.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Clear_Arena)->Arg(1 << 20)->Iterations(10)
+    ->Unit(benchmark::kMicrosecond);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,148 @@
+#include "BinaryTree.h"
+#include "ThreadPool.h"
+#include "benchmark/benchmark.h"
+
+namespace
+{
+
+const int NUM_NODES = 10000000;
+
+/**
+ * Trees whose nodes are linked together directly, since building a tree of
+ * NUM_NODES items through BinaryTree::add would take far too long.
+ */
+class LinkedTree : public BinaryTree<int>
+{
+private:
+    static BinaryTreeNode<int>* buildBalanced(int first, int last)
+    {
+        if (first > last)
+        {
+            return nullptr;
+        }
+
+        int middle = first + (last - first) / 2;
+        BinaryTreeNode<int>* nodePtr = new BinaryTreeNode<int>(middle);
+        nodePtr->setLeft(buildBalanced(first, middle - 1));
+        nodePtr->setRight(buildBalanced(middle + 1, last));
+        return nodePtr;
+    }
+
+    /**
+     * The recursive copy that BinaryTree used to have, for comparison. It
+     * overflows the call stack on the degenerate tree.
+     */
+    static BinaryTreeNode<int>* recursiveCopy(const BinaryTreeNode<int>* treePtr)
+    {
+        if (treePtr == nullptr)
+        {
+            return nullptr;
+        }
+
+        BinaryTreeNode<int>* newNodePtr =
+            new BinaryTreeNode<int>(treePtr->getItem());
+        newNodePtr->setLeft(recursiveCopy(treePtr->getLeft()));
+        newNodePtr->setRight(recursiveCopy(treePtr->getRight()));
+        return newNodePtr;
+    }
+
+public:
+    LinkedTree()
+    {
+
+    }
+
+    /**
+     * Builds either a perfectly balanced tree or a right spine (the shape a
+     * BinarySearchTree takes when its items are added in sorted order)
+     * holding 1, ..., numNodes.
+     */
+    LinkedTree(int numNodes, bool balanced)
+    {
+        if (balanced)
+        {
+            rootPtr = buildBalanced(1, numNodes);
+            return;
+        }
+
+        for (int i = numNodes; i >= 1; i--)
+        {
+            BinaryTreeNode<int>* nodePtr = new BinaryTreeNode<int>(i);
+            nodePtr->setRight(rootPtr);
+            rootPtr = nodePtr;
+        }
+    }
+
+    void recursiveCopyFrom(const LinkedTree& other)
+    {
+        clear();
+        rootPtr = recursiveCopy(other.rootPtr);
+    }
+};
+
+const LinkedTree& getTree(bool balanced)
+{
+    static LinkedTree balancedTree(NUM_NODES, true);
+    static LinkedTree degenerateTree(NUM_NODES, false);
+    return balanced ? balancedTree : degenerateTree;
+}
+
+// Arguments: whether the tree is balanced, and the number of threads.
+void BM_Copy(benchmark::State& state)
+{
+    const LinkedTree& source = getTree(state.range(0) != 0);
+    ThreadPool pool(state.range(1));
+    LinkedTree copy;
+    for (auto _ : state)
+    {
+        copy.parallelCopyFrom(source, pool);
+
+        state.PauseTiming();
+        copy.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Copy)->ArgsProduct({ { 0, 1 }, { 1, 2, 4, 8, 16 } })
+    ->ArgNames({ "balanced", "threads" })->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_Copy_Recursive(benchmark::State& state)
+{
+    const LinkedTree& source = getTree(true);
+    LinkedTree copy;
+    for (auto _ : state)
+    {
+        copy.recursiveCopyFrom(source);
+
+        state.PauseTiming();
+        copy.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Copy_Recursive)->Unit(benchmark::kMillisecond);
+
+// Arguments: whether the tree is balanced, and the number of threads.
+void BM_Destroy(benchmark::State& state)
+{
+    const LinkedTree& source = getTree(state.range(0) != 0);
+    ThreadPool pool(state.range(1));
+    LinkedTree copy;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        copy = source;
+        state.ResumeTiming();
+
+        copy.parallelClear(pool);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Destroy)->ArgsProduct({ { 0, 1 }, { 1, 2, 4, 8, 16 } })
+    ->ArgNames({ "balanced", "threads" })->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+#include "BinaryTree.h"
+#include "ThreadPool.h"
+#include "benchmark/benchmark.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+const int NUM_NODES = 10000000;
+
+/**
+ * A tree whose nodes are linked together directly, since building a tree of
+ * NUM_NODES items through BinaryTree::add would take far too long.
+ */
+class BalancedTree : public BinaryTree<long long>
+{
+private:
+    static BinaryTreeNode<long long>* build(long long first, long long last)
+    {
+        if (first > last)
+        {
+            return nullptr;
+        }
+
+        long long middle = first + (last - first) / 2;
+        BinaryTreeNode<long long>* nodePtr =
+            new BinaryTreeNode<long long>(middle);
+        nodePtr->setLeft(build(first, middle - 1));
+        nodePtr->setRight(build(middle + 1, last));
+        return nodePtr;
+    }
+
+public:
+    /**
+     * Builds a perfectly balanced tree holding 1, ..., numNodes in order.
+     */
+    explicit BalancedTree(int numNodes)
+    {
+        rootPtr = build(1, numNodes);
+    }
+};
+
+const BalancedTree& getTree()
+{
+    static BalancedTree tree(NUM_NODES);
+    return tree;
+}
+
+const long long EXPECTED_SUM = (long long) NUM_NODES * (NUM_NODES + 1) / 2;
+
+class SumFunction : public TraversalFunction<long long>
+{
+public:
+    long long sum = 0;
+
+    virtual void visit(long long& item)
+    {
+        sum += item;
+    }
+};
+
+// The original interface: one virtual call (and one copy of the item) per
+// node, from a recursive traversal.
+void BM_Sum_TraversalFunction(benchmark::State& state)
+{
+    const BalancedTree& tree = getTree();
+    for (auto _ : state)
+    {
+        SumFunction sum;
+        tree.inorderTraverse(&sum);
+        if (sum.sum != EXPECTED_SUM)
+        {
+            state.SkipWithError("wrong sum");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Sum_TraversalFunction)->Unit(benchmark::kMillisecond);
+
+void BM_Sum_InorderForEach(benchmark::State& state)
+{
+    const BalancedTree& tree = getTree();
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        tree.inorderForEach([&sum](const long long& item) { sum += item; });
+        if (sum != EXPECTED_SUM)
+        {
+            state.SkipWithError("wrong sum");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Sum_InorderForEach)->Unit(benchmark::kMillisecond);
+
+void BM_Sum_ParallelReduce(benchmark::State& state)
+{
+    const BalancedTree& tree = getTree();
+    ThreadPool pool(state.range(0));
+    for (auto _ : state)
+    {
+        long long sum = tree.parallelReduce(0LL,
+            [](const long long& item) { return item; },
+            std::plus<long long>(), pool);
+        if (sum != EXPECTED_SUM)
+        {
+            state.SkipWithError("wrong sum");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_Sum_ParallelReduce)->RangeMultiplier(2)->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,207 @@
+#include "ArrayList.h"
+#include "LinkedList.h"
+#include "UnrolledLinkedList.h"
+#include "benchmark/benchmark.h"
+#include <cstddef>
+#include <random>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace
+{
+
+/**
+ * @return The number of bytes the program has allocated from the heap, or
+ *         0 if the C library cannot report it.
+ */
+std::size_t getHeapBytesInUse()
+{
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+const int NUM_ITEMS = 1000000;
+
+template <class ListType>
+void fill(ListType& list, int numItems)
+{
+    for (int i = 0; i < numItems; i++)
+    {
+        list.add(i);
+    }
+}
+
+template <class ListType>
+const ListType& getList()
+{
+    static ListType list;
+    if (list.empty())
+    {
+        fill(list, NUM_ITEMS);
+    }
+
+    return list;
+}
+
+template <class ListType>
+void BM_Append(benchmark::State& state)
+{
+    std::size_t numBytes = 0;
+    for (auto _ : state)
+    {
+        std::size_t numBytesBefore = getHeapBytesInUse();
+        ListType* list = new ListType();
+        fill(*list, NUM_ITEMS);
+        numBytes = getHeapBytesInUse() - numBytesBefore;
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+    state.counters["bytes_per_item"] = (double) numBytes / NUM_ITEMS;
+}
+BENCHMARK_TEMPLATE(BM_Append, LinkedList<int>)->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Append, UnrolledLinkedList<int>)->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Append, ArrayList<int>)->Iterations(5)
+    ->Unit(benchmark::kMillisecond);
+
+template <class ListType>
+void BM_Scan(benchmark::State& state)
+{
+    const ListType& list = getList<ListType>();
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int item : list)
+        {
+            sum += item;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_Scan, LinkedList<int>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Scan, UnrolledLinkedList<int>)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Scan, ArrayList<int>)->Unit(benchmark::kMillisecond);
+
+// a search for a missing item scans the whole list
+template <class ListType>
+void BM_ContainsMissing(benchmark::State& state)
+{
+    const ListType& list = getList<ListType>();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.contains(-1));
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_ITEMS);
+}
+BENCHMARK_TEMPLATE(BM_ContainsMissing, LinkedList<int>)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ContainsMissing, UnrolledLinkedList<int>)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ContainsMissing, ArrayList<int>)
+    ->Unit(benchmark::kMillisecond);
+
+// 10,000 inserts at random positions into a list of state.range(0) items;
+// neither LinkedList nor ArrayList can insert, so std::vector stands in for
+// an array
+template <class ListType>
+void BM_MiddleInsert(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    const int NUM_INSERTS = 10000;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType* list = new ListType();
+        fill(*list, numItems);
+        std::mt19937 random(42);
+        state.ResumeTiming();
+
+        for (int i = 0; i < NUM_INSERTS; i++)
+        {
+            int index = random() % (numItems + i + 1);
+            list->insert(index, i);
+        }
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_INSERTS);
+}
+
+class VectorList : public std::vector<int>
+{
+public:
+    void add(int item)
+    {
+        push_back(item);
+    }
+
+    void insert(int index, int item)
+    {
+        std::vector<int>::insert(begin() + index, item);
+    }
+
+    iterator insert(iterator position, int item)
+    {
+        return std::vector<int>::insert(position, item);
+    }
+};
+
+BENCHMARK_TEMPLATE(BM_MiddleInsert, UnrolledLinkedList<int>)
+    ->Arg(100000)->Arg(NUM_ITEMS)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MiddleInsert, VectorList)
+    ->Arg(100000)->Arg(NUM_ITEMS)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+// One pass over a list of state.range(0) items, inserting an item before
+// every 100th, as when merging in new items during a scan
+template <class ListType>
+void BM_InsertWhileScanning(benchmark::State& state)
+{
+    int numItems = state.range(0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        ListType* list = new ListType();
+        fill(*list, numItems);
+        state.ResumeTiming();
+
+        int i = 0;
+        for (auto it = list->begin(); it != list->end(); ++it)
+        {
+            if (i++ % 100 == 0)
+            {
+                it = list->insert(it, -1);
+                ++it;
+            }
+        }
+
+        state.PauseTiming();
+        delete list;
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+BENCHMARK_TEMPLATE(BM_InsertWhileScanning, UnrolledLinkedList<int>)
+    ->Arg(100000)->Arg(NUM_ITEMS)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_InsertWhileScanning, VectorList)
+    ->Arg(100000)->Arg(NUM_ITEMS)->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN();
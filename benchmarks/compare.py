@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""Compares two Google Benchmark JSON result files and flags regressions.
+
+    compare.py BASELINE RESULTS [--threshold 0.10] [--metric cpu_time]
+    compare.py --summarize RESULTS > BASELINE
+
+Benchmarks are matched by name, and each is represented by the median of
+its repetitions (run with --benchmark_repetitions), or by its _median
+aggregate when the results hold only aggregates. A benchmark whose median
+time grew by more than the threshold is a regression, as is a baseline
+benchmark missing from the results (deleted or renamed), and the script
+exits with status 1 if there is any, so that it can gate a build. Times only
+compare on the machine that recorded the baseline, so a warning is printed
+if the two files come from different machines or from a debug build of the
+benchmark library.
+
+--summarize reduces a results file to the median of each benchmark, which
+is all a stored baseline needs.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+
+TIME_UNITS_IN_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+TIME_METRICS = ("real_time", "cpu_time")
+
+
+def load_median_runs(path):
+    """Returns the context of the results and a dict from benchmark name to
+    a run holding the median times of its repetitions, ignoring failed
+    runs."""
+    with open(path) as results_file:
+        results = json.load(results_file)
+
+    repetitions = {}
+    aggregates = {}
+    for run in results["benchmarks"]:
+        if run.get("error_occurred"):
+            continue
+
+        name = run.get("run_name", run["name"])
+        if run.get("run_type") == "aggregate":
+            if run.get("aggregate_name") == "median":
+                aggregates[name] = run
+        else:
+            repetitions.setdefault(name, []).append(run)
+
+    medians = dict(aggregates)
+    for name, runs in repetitions.items():
+        median = dict(runs[0])
+        median["name"] = name
+        for metric in TIME_METRICS:
+            median[metric] = statistics.median(run[metric] for run in runs)
+        medians[name] = median
+
+    return results.get("context", {}), medians
+
+
+def load_times(path, metric):
+    """Returns the context of the results and a dict from benchmark name to
+    median time in nanoseconds."""
+    context, medians = load_median_runs(path)
+    return context, {name: run[metric] * TIME_UNITS_IN_NS[run["time_unit"]]
+                     for name, run in medians.items()}
+
+
+def check_contexts(baseline_context, results_context):
+    """Warns about differences between the two runs which make their times
+    incomparable."""
+    for key in ("host_name", "num_cpus", "mhz_per_cpu"):
+        if baseline_context.get(key) != results_context.get(key):
+            print("warning: the baseline's %s is %s, but the results' is %s"
+                  % (key, baseline_context.get(key), results_context.get(key)),
+                  file=sys.stderr)
+    for name, context in (("baseline was", baseline_context),
+                          ("results were", results_context)):
+        if context.get("library_build_type") == "debug":
+            print("warning: the %s recorded with a debug build of the "
+                  "benchmark library" % name, file=sys.stderr)
+
+
+def summarize(path):
+    context, medians = load_median_runs(path)
+    benchmarks = []
+    for name in sorted(medians):
+        run = medians[name]
+        summary = {key: run[key] for key in (
+            "iterations", "real_time", "cpu_time", "time_unit") if key in run}
+        summary["name"] = summary["run_name"] = name
+        benchmarks.append(summary)
+    json.dump({"context": context, "benchmarks": benchmarks}, sys.stdout,
+              indent=1)
+    print()
+
+
+def format_time(time):
+    for unit in ("s", "ms", "us"):
+        if time >= TIME_UNITS_IN_NS[unit]:
+            return "%.3g %s" % (time / TIME_UNITS_IN_NS[unit], unit)
+    return "%.3g ns" % time
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", nargs="?",
+                        help="the stored baseline JSON file")
+    parser.add_argument("results", help="the new JSON results")
+    parser.add_argument("--summarize", action="store_true",
+                        help="print the median of each benchmark in RESULTS "
+                             "as JSON, to store as a baseline")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="the relative slowdown which counts as a "
+                             "regression (default 0.10)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"),
+                        default="cpu_time",
+                        help="the time to compare (default cpu_time)")
+    args = parser.parse_args()
+
+    if args.summarize:
+        summarize(args.results)
+        return 0
+    if args.baseline is None:
+        parser.error("a baseline is needed unless --summarize is given")
+
+    baseline_context, baseline = load_times(args.baseline, args.metric)
+    results_context, results = load_times(args.results, args.metric)
+    check_contexts(baseline_context, results_context)
+
+    regressions = []
+    name_width = max([len(name) for name in results] + [9])
+    print("%-*s %12s %12s %8s" % (name_width, "benchmark", "baseline", "new",
+                                  "change"))
+    for name in sorted(results):
+        if name not in baseline:
+            print("%-*s %12s %12s %8s" % (name_width, name, "-",
+                                          format_time(results[name]), "new"))
+            continue
+
+        change = results[name] / baseline[name] - 1.0
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  faster"
+        else:
+            flag = ""
+        print("%-*s %12s %12s %+7.1f%%%s" % (name_width, name,
+                                             format_time(baseline[name]),
+                                             format_time(results[name]),
+                                             100.0 * change, flag))
+
+    missing = sorted(set(baseline) - set(results))
+    for name in missing:
+        print("%-*s %12s %12s %8s" % (name_width, name,
+                                      format_time(baseline[name]), "-",
+                                      "missing"))
+
+    print()
+    if missing:
+        print("%d benchmarks of the baseline are missing from the results; "
+              "record a new baseline if they were removed on purpose."
+              % len(missing))
+    if regressions:
+        print("%d of %d benchmarks are more than %.0f%% slower than the "
+              "baseline." % (len(regressions), len(results),
+                             100.0 * args.threshold))
+    if missing or regressions:
+        return 1
+
+    print("No regressions of more than %.0f%% in %d benchmarks."
+          % (100.0 * args.threshold, len(results)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
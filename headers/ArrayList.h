@@ -1,33 +1,77 @@
 #ifndef ARRAY_LIST_H
 #define ARRAY_LIST_H
 
+#include "ArraySort.h"
+#include "ContainerStats.h"
 #include "List.h"
+#include "MemoryUsage.h"
+#include "SimdSearch.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+/**
+ * Whether items of type @c T can be ordered with @c operator<.
+ */
+template <class T, class = void>
+struct LessThanComparable : std::false_type
+{
+
+};
 
 template <class T>
-class ArrayList : public List<T> 
+struct LessThanComparable<T, std::void_t<
+    decltype(std::declval<const T&>() < std::declval<const T&>())>>
+    : std::true_type
+{
+
+};
+
+template <class T, class Stats = NoStats>
+class ArrayList : public List<T>, private Stats
 {
 private:
     T* array;
     int defaultCapacity;
-    int count;
+    int numItems;
     int capacity;
 
-    virtual int indexOf(const T& item) const;
-
     virtual void resize();
 
     virtual bool removeAt(const int index);
 
+    /**
+     * @c indexOf, without timing the search as a lookup.
+     */
+    int search(const T& item) const;
+
 public:
+    /**
+     * The default number of items @c parallelSort sorts or merges on one
+     * thread before splitting the work.
+     */
+    static const int PARALLEL_GRAIN_SIZE = 1 << 16;
+
+    /**
+     * Above this many items to remove, @c removeAll looks each item of the
+     * list up in a hash set or sorted copy of them instead of comparing it
+     * with all of them.
+     */
+    static const int REMOVE_ALL_SCAN_LIMIT = 64;
+
     ArrayList();
 
     ArrayList(const int capacity);
 
-    ArrayList(const ArrayList<T>& other);
+    ArrayList(const ArrayList<T, Stats>& other);
 
     ~ArrayList();
 
-    ArrayList<T>& operator=(const ArrayList<T>& other);
+    ArrayList<T, Stats>& operator=(const ArrayList<T, Stats>& other);
 
     virtual void add(const T& item);
 
@@ -42,43 +86,174 @@ public:
     virtual void clear();
 
     virtual std::vector<T> toVector() const;
+
+    virtual std::vector<T> intoVector();
+
+    /**
+     * The items are stored contiguously, so @c data() and @c size() can be
+     * passed to any function taking a pointer and a length. The pointer and
+     * the iterators are invalidated by any change to the list's size.
+     * @return A pointer to the first item.
+     */
+    T* data();
+    const T* data() const;
+
+    /**
+     * @return The bytes the list uses (see MemoryUsage.h). The unused
+     *         capacity is slack, including any memory still owned by items
+     *         which were removed but not yet overwritten.
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * Reallocates the array to hold exactly @c size() items, releasing the
+     * unused capacity. The list grows again as usual.
+     */
+    void shrinkToFit();
+
+    /**
+     * @return The list's instrumentation (see ContainerStats.h). Searches
+     *         count a comparison per item they compare with.
+     */
+    const Stats& getStats() const;
+    Stats& getStats();
+
+    // Iterators, from the first item to the last
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Searches the list for an item. For integral and floating-point types
+     * the search is vectorized (see SimdSearch.h).
+     * @param item The item to search for.
+     * @return The index of the first item equal to @c item, or -1 if there
+     *         is none.
+     */
+    virtual int indexOf(const T& item) const;
+
+    /**
+     * @param item The item to count.
+     * @return The number of items equal to @c item.
+     */
+    int count(const T& item) const;
+
+    /**
+     * Searches the list for any of several items at once, e.g. for the
+     * first separator in a list of characters. Every item of the list is
+     * compared with every item of @c items, so this is meant for small sets.
+     * @param items The items to search for.
+     * @return The index of the first item equal to one of @c items, or -1
+     *         if there is none.
+     */
+    int indexOfAny(const std::vector<T>& items) const;
+
+    /**
+     * Removes every item for which @c pred returns true, in a single pass
+     * which moves each remaining item at most once. The remaining items
+     * keep their order.
+     * @param pred A callable invoked as <tt>pred(const T&)</tt>.
+     * @return The number of items removed.
+     */
+    template <class Predicate>
+    int removeIf(Predicate pred);
+
+    /**
+     * Removes every item for which @c pred returns false, as for
+     * @c removeIf.
+     * @return The number of items removed.
+     */
+    template <class Predicate>
+    int retainIf(Predicate pred);
+
+    /**
+     * Removes every item equal to one of @c items, in a single pass. Up to
+     * @c REMOVE_ALL_SCAN_LIMIT items are found as for @c indexOfAny. More
+     * than that are put in a @c std::unordered_set if @c std::hash<T> is
+     * defined, taking O(n + k) time for k items, or else sorted if @c T has
+     * an @c operator<, taking O((n + k) log k) time.
+     * @param items The items to remove.
+     * @return The number of items removed.
+     */
+    int removeAll(const std::vector<T>& items);
+
+    /**
+     * Removes the item at @c index in constant time, by moving the last
+     * item into its place. This does not preserve the order of the list.
+     * @param index The index of the item to remove.
+     * @return true if the item was removed, false if @c index is out of
+     *         range.
+     */
+    bool swapRemove(const int index);
+
+    /**
+     * Sorts the list in place. Integral items sorted by the default
+     * comparison are radix sorted in O(n) time, using a buffer of @c size()
+     * items; anything else is sorted with @c std::sort. Equal items may be
+     * reordered.
+     * @param cmp A callable invoked as <tt>cmp(const T&, const T&)</tt>,
+     *            which returns true if the first item goes before the
+     *            second.
+     */
+    template <class Compare = std::less<T>>
+    void sort(Compare cmp = Compare());
+
+    /**
+     * Sorts the list as for @c sort, using the threads of @c pool. Integral
+     * items are radix sorted with each pass split between the threads, and
+     * other items are merge sorted, with pieces of up to @c grainSize items
+     * sorted and merged concurrently. Needs a buffer of @c size() items.
+     * @param grainSize The number of items a thread sorts or merges before
+     *                  splitting its work.
+     */
+    template <class Compare = std::less<T>>
+    void parallelSort(Compare cmp = Compare(),
+        ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = PARALLEL_GRAIN_SIZE);
 };
 
-template <class T>
-ArrayList<T>::ArrayList() : defaultCapacity(100), count(0), capacity(100) 
+template <class T, class Stats>
+ArrayList<T, Stats>::ArrayList() : defaultCapacity(100), numItems(0),
+    capacity(100)
 {
     array = new T[capacity];
 }
 
-template <class T>
-ArrayList<T>::ArrayList(const int capacity) : defaultCapacity(capacity), 
-    count(0), capacity(capacity) 
+template <class T, class Stats>
+ArrayList<T, Stats>::ArrayList(const int capacity) : defaultCapacity(capacity), 
+    numItems(0), capacity(capacity) 
 {
     array = new T[capacity];
 }
 
-template <class T>
-ArrayList<T>::ArrayList(const ArrayList<T>& other)
+template <class T, class Stats>
+ArrayList<T, Stats>::ArrayList(const ArrayList<T, Stats>& other)
+    : List<T>(), Stats(other)
 {
     defaultCapacity = other.defaultCapacity;
-    count = other.count;
+    numItems = other.numItems;
     capacity = other.capacity;
     array = new T[capacity];
-    for (int i = 0; i < count; i++)
+    for (int i = 0; i < numItems; i++)
     {
         array[i] = other.array[i];
     }
 }
 
-template <class T>
-ArrayList<T>::~ArrayList() 
+template <class T, class Stats>
+ArrayList<T, Stats>::~ArrayList() 
 {
     delete[] array;
     array = nullptr;
 }
 
-template <class T>
-ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& other)
+template <class T, class Stats>
+ArrayList<T, Stats>& ArrayList<T, Stats>::operator=(
+    const ArrayList<T, Stats>& other)
 {
     if (array != nullptr)
     {
@@ -86,10 +261,10 @@ ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& other)
     }
 
     defaultCapacity = other.defaultCapacity;
-    count = other.count;
+    numItems = other.numItems;
     capacity = other.capacity;
     array = new T[capacity];
-    for (int i = 0; i < count; i++)
+    for (int i = 0; i < numItems; i++)
     {
         array[i] = other.array[i];
     }
@@ -97,66 +272,85 @@ ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& other)
     return *this;
 }
 
-template <class T>
-int ArrayList<T>::indexOf(const T& item) const
+template <class T, class Stats>
+int ArrayList<T, Stats>::search(const T& item) const
 {
-    for (int i = 0; i < count; ++i)
-    {
-        if (array[i] == item)
-        {
-            return i;
-        }
-    }
+    int index = simdIndexOf(array, numItems, item);
+    this->recordEvent(StatEvent::COMPARISON, index < 0 ? numItems : index + 1);
+    return index;
+}
 
-    return -1;
+template <class T, class Stats>
+int ArrayList<T, Stats>::indexOf(const T& item) const
+{
+    typename Stats::Timer timer(*this, StatOperation::LOOKUP);
+    return search(item);
 }
 
-template<class T>
-void ArrayList<T>::resize()
+template <class T, class Stats>
+int ArrayList<T, Stats>::count(const T& item) const
 {
-    capacity *= 2;
+    typename Stats::Timer timer(*this, StatOperation::LOOKUP);
+    this->recordEvent(StatEvent::COMPARISON, numItems);
+    return simdCount(array, numItems, item);
+}
+
+template <class T, class Stats>
+int ArrayList<T, Stats>::indexOfAny(const std::vector<T>& items) const
+{
+    return simdIndexOfAny(array, numItems, items.data(),
+                          static_cast<int>(items.size()));
+}
+
+template <class T, class Stats>
+void ArrayList<T, Stats>::resize()
+{
+    this->recordEvent(StatEvent::RESIZE);
+    capacity = capacity > 0 ? capacity * 2 : 1;
     T* newArray = new T[capacity];
-    for (int i = 0; i < count; ++i)
+    for (int i = 0; i < numItems; ++i)
     {
-        newArray[i] = array[i];
+        newArray[i] = std::move(array[i]);
     }
     delete[] array;
     array = nullptr;
     array = newArray;
 }
 
-template <class T>
-bool ArrayList<T>::removeAt(const int index)
+template <class T, class Stats>
+bool ArrayList<T, Stats>::removeAt(const int index)
 {
-    if (index < 0 || index >= count)
+    if (index < 0 || index >= numItems)
     {
         return false;
     }
     
-    for (int i = index + 1; i < count; i++) {
-        array[i - 1] = array[i];
+    for (int i = index + 1; i < numItems; i++) {
+        array[i - 1] = std::move(array[i]);
     }
 
-    count--;
+    numItems--;
     return true;
 }
 
-template <class T>
-void ArrayList<T>::add(const T& item) 
+template <class T, class Stats>
+void ArrayList<T, Stats>::add(const T& item) 
 {
-    if (count == capacity)
+    typename Stats::Timer timer(*this, StatOperation::ADD);
+    if (numItems == capacity)
     {
         resize();
     }
 
-    array[count] = item;
-    count++;
+    array[numItems] = item;
+    numItems++;
 }
 
-template <class T>
-bool ArrayList<T>::remove(const T& item) 
+template <class T, class Stats>
+bool ArrayList<T, Stats>::remove(const T& item) 
 {
-    int index = indexOf(item);
+    typename Stats::Timer timer(*this, StatOperation::REMOVE);
+    int index = search(item);
     if (index < 0)
     {
         return false;
@@ -165,20 +359,191 @@ bool ArrayList<T>::remove(const T& item)
     return removeAt(index);
 }
 
-template <class T>
-int ArrayList<T>::size() const 
+template <class T, class Stats>
+template <class Predicate>
+int ArrayList<T, Stats>::removeIf(Predicate pred)
+{
+    // skip to the first item to remove, so that nothing before it is moved
+    int readIndex = 0;
+    while (readIndex < numItems && !pred(array[readIndex]))
+    {
+        readIndex++;
+    }
+
+    int writeIndex = readIndex;
+    for (; readIndex < numItems; readIndex++)
+    {
+        if (!pred(array[readIndex]))
+        {
+            array[writeIndex] = std::move(array[readIndex]);
+            writeIndex++;
+        }
+    }
+
+    int numRemoved = numItems - writeIndex;
+    numItems = writeIndex;
+    return numRemoved;
+}
+
+template <class T, class Stats>
+template <class Predicate>
+int ArrayList<T, Stats>::retainIf(Predicate pred)
 {
-    return count;
+    return removeIf([&pred](const T& item)
+    {
+        return !pred(item);
+    });
 }
 
-template <class T>
-bool ArrayList<T>::empty() const 
+template <class T, class Stats>
+int ArrayList<T, Stats>::removeAll(const std::vector<T>& items)
 {
-    return count == 0;
+    if (static_cast<int>(items.size()) > REMOVE_ALL_SCAN_LIMIT)
+    {
+        if constexpr (std::is_default_constructible<std::hash<T>>::value)
+        {
+            std::unordered_set<T> itemSet(items.begin(), items.end());
+            return removeIf([&itemSet](const T& item)
+            {
+                return itemSet.count(item) > 0;
+            });
+        }
+        else if constexpr (LessThanComparable<T>::value)
+        {
+            // an item unequal to itself, such as NaN, matches nothing and
+            // would break the sort's ordering, so it is left out; for the
+            // same reason a match is confirmed with ==
+            std::vector<T> sortedItems;
+            sortedItems.reserve(items.size());
+            for (const T& item : items)
+            {
+                if (item == item)
+                {
+                    sortedItems.push_back(item);
+                }
+            }
+
+            {
+                std::vector<T> buffer(sortedItems.size());
+                std::less<T> cmp;
+                sortArray(sortedItems.data(), buffer.data(),
+                          static_cast<int>(sortedItems.size()), cmp);
+            }
+
+            return removeIf([&sortedItems](const T& item)
+            {
+                auto match = std::lower_bound(sortedItems.begin(),
+                                              sortedItems.end(), item);
+                return match != sortedItems.end() && *match == item;
+            });
+        }
+    }
+
+    const T* targets = items.data();
+    int numTargets = static_cast<int>(items.size());
+
+    // find each item to remove with indexOfAny, which is vectorized for
+    // arithmetic types, and move the run of items before it down
+    int writeIndex = simdIndexOfAny(array, numItems, targets, numTargets);
+    if (writeIndex < 0)
+    {
+        return 0;
+    }
+
+    int readIndex = writeIndex + 1;
+    while (readIndex < numItems)
+    {
+        int runLength = simdIndexOfAny(array + readIndex,
+                                       numItems - readIndex,
+                                       targets, numTargets);
+        int runEnd = runLength < 0 ? numItems : readIndex + runLength;
+        for (; readIndex < runEnd; readIndex++)
+        {
+            array[writeIndex] = std::move(array[readIndex]);
+            writeIndex++;
+        }
+        readIndex = runEnd + 1;
+    }
+
+    int numRemoved = numItems - writeIndex;
+    numItems = writeIndex;
+    return numRemoved;
 }
 
-template <class T>
-bool ArrayList<T>::contains(const T& item) const 
+template <class T, class Stats>
+bool ArrayList<T, Stats>::swapRemove(const int index)
+{
+    if (index < 0 || index >= numItems)
+    {
+        return false;
+    }
+
+    if (index != numItems - 1)
+    {
+        array[index] = std::move(array[numItems - 1]);
+    }
+
+    numItems--;
+    return true;
+}
+
+template <class T, class Stats>
+template <class Compare>
+void ArrayList<T, Stats>::sort(Compare cmp)
+{
+    if constexpr (RadixSortable<T, Compare>::value)
+    {
+        if (numItems >= RADIX_SORT_THRESHOLD)
+        {
+            std::unique_ptr<T[]> buffer(new T[numItems]);
+            radixSort(array, buffer.get(), numItems);
+            return;
+        }
+    }
+
+    std::sort(array, array + numItems, cmp);
+}
+
+template <class T, class Stats>
+template <class Compare>
+void ArrayList<T, Stats>::parallelSort(Compare cmp, ThreadPool& pool,
+                                       int grainSize)
+{
+    if (pool.getNumThreads() == 1 || numItems <= grainSize)
+    {
+        sort(cmp);
+        return;
+    }
+
+    std::unique_ptr<T[]> buffer(new T[numItems]);
+    if constexpr (RadixSortable<T, Compare>::value)
+    {
+        // a few chunks per thread, so that stealing evens out their work
+        int numChunks = std::min(4 * pool.getNumThreads(),
+                                 numItems / grainSize);
+        parallelRadixSort(array, buffer.get(), numItems, numChunks, pool);
+    }
+    else
+    {
+        parallelMergeSort(array, buffer.get(), numItems, false, cmp, pool,
+                          grainSize);
+    }
+}
+
+template <class T, class Stats>
+int ArrayList<T, Stats>::size() const 
+{
+    return numItems;
+}
+
+template <class T, class Stats>
+bool ArrayList<T, Stats>::empty() const 
+{
+    return numItems == 0;
+}
+
+template <class T, class Stats>
+bool ArrayList<T, Stats>::contains(const T& item) const 
 {
     int index = indexOf(item);
     if (index < 0)
@@ -191,22 +556,119 @@ bool ArrayList<T>::contains(const T& item) const
     }
 }
 
-template <class T>
-void ArrayList<T>::clear() 
+template <class T, class Stats>
+void ArrayList<T, Stats>::clear() 
 {
-    count = 0;
+    numItems = 0;
 }
 
-template <class T>
-std::vector<T> ArrayList<T>::toVector() const 
+template <class T, class Stats>
+std::vector<T> ArrayList<T, Stats>::toVector() const 
+{
+    return std::vector<T>(array, array + numItems);
+}
+
+template <class T, class Stats>
+std::vector<T> ArrayList<T, Stats>::intoVector()
 {
     std::vector<T> vec;
-    for (int i = 0; i < count; ++i)
+    vec.reserve(numItems);
+    for (int i = 0; i < numItems; ++i)
     {
-        vec.push_back(array[i]);
+        vec.push_back(std::move(array[i]));
     }
-    
+
+    numItems = 0;
     return vec;
 }
 
+template <class T, class Stats>
+MemoryUsage ArrayList<T, Stats>::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.payloadBytes = numItems * sizeof(T);
+    usage.slackBytes = (capacity - numItems) * sizeof(T);
+    usage.overheadBytes = sizeof(*this) + getArrayCookieBytes<T>();
+    addAllocation(usage, capacity * sizeof(T) + getArrayCookieBytes<T>());
+    for (int i = 0; i < numItems; i++)
+    {
+        addOwnedMemory(usage, array[i]);
+    }
+
+    MemoryUsage removedUsage;
+    for (int i = numItems; i < capacity; i++)
+    {
+        addOwnedMemory(removedUsage, array[i]);
+    }
+    usage.slackBytes += removedUsage.getTotalBytes();
+
+    return usage;
+}
+
+template <class T, class Stats>
+void ArrayList<T, Stats>::shrinkToFit()
+{
+    if (capacity == numItems)
+    {
+        return;
+    }
+
+    T* newArray = new T[numItems];
+    for (int i = 0; i < numItems; i++)
+    {
+        newArray[i] = std::move(array[i]);
+    }
+    delete[] array;
+    array = newArray;
+    capacity = numItems;
+}
+
+template <class T, class Stats>
+const Stats& ArrayList<T, Stats>::getStats() const
+{
+    return *this;
+}
+
+template <class T, class Stats>
+Stats& ArrayList<T, Stats>::getStats()
+{
+    return *this;
+}
+
+template <class T, class Stats>
+T* ArrayList<T, Stats>::data()
+{
+    return array;
+}
+
+template <class T, class Stats>
+const T* ArrayList<T, Stats>::data() const
+{
+    return array;
+}
+
+template <class T, class Stats>
+typename ArrayList<T, Stats>::iterator ArrayList<T, Stats>::begin()
+{
+    return array;
+}
+
+template <class T, class Stats>
+typename ArrayList<T, Stats>::iterator ArrayList<T, Stats>::end()
+{
+    return array + numItems;
+}
+
+template <class T, class Stats>
+typename ArrayList<T, Stats>::const_iterator ArrayList<T, Stats>::begin() const
+{
+    return array;
+}
+
+template <class T, class Stats>
+typename ArrayList<T, Stats>::const_iterator ArrayList<T, Stats>::end() const
+{
+    return array + numItems;
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+/**
+ * Sorts of a contiguous array, used by @c ArrayList<T>::sort and
+ * @c ArrayList<T>::parallelSort.
+ *
+ * Integral items in ascending order are sorted with an LSD radix sort, one
+ * byte per pass, which takes O(n) time and skips the passes for bytes that
+ * every item shares, so small keys in a wide type cost fewer passes. Other
+ * items and orders use a comparison sort. The parallel versions run on a
+ * @c ThreadPool: the radix sort gives each thread a chunk of the array to
+ * count and scatter, and the merge sort sorts pieces concurrently and then
+ * merges them, splitting each merge between threads as well.
+ */
+
+#ifndef ARRAY_SORT_H
+#define ARRAY_SORT_H
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Whether an array of @c T ordered by @c Compare is radix sorted: integral
+ * types other than @c bool, in ascending order.
+ */
+template <class T, class Compare>
+struct RadixSortable : std::integral_constant<bool,
+    std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+    (std::is_same<Compare, std::less<T>>::value ||
+     std::is_same<Compare, std::less<>>::value)>
+{
+
+};
+
+/**
+ * Below this many items, a comparison sort beats the radix sort's passes
+ * over its tables of counts.
+ */
+const int RADIX_SORT_THRESHOLD = 256;
+
+/**
+ * @return The radix sort key of an item: its bits, with the sign bit of a
+ *         signed type flipped so that negative items come first.
+ */
+template <class T>
+typename std::make_unsigned<T>::type getRadixKey(T item)
+{
+    typedef typename std::make_unsigned<T>::type Key;
+    const Key SIGN_BIT = std::is_signed<T>::value ?
+        static_cast<Key>(Key(1) << (8 * sizeof(T) - 1)) : Key(0);
+    return static_cast<Key>(static_cast<Key>(item) ^ SIGN_BIT);
+}
+
+template <class T>
+int getRadixDigit(T item, int digit)
+{
+    return static_cast<int>((getRadixKey(item) >> (8 * digit)) & 0xFF);
+}
+
+/**
+ * Sorts @c items into ascending order with an LSD radix sort.
+ * @param buffer Room for @c numItems items, whose contents are overwritten.
+ */
+template <class T>
+void radixSort(T* items, T* buffer, int numItems)
+{
+    const int NUM_DIGITS = sizeof(T);
+
+    // the counts of every digit, from a single pass
+    int counts[NUM_DIGITS][256] = {};
+    for (int i = 0; i < numItems; i++)
+    {
+        for (int digit = 0; digit < NUM_DIGITS; digit++)
+        {
+            counts[digit][getRadixDigit(items[i], digit)]++;
+        }
+    }
+
+    T* srcPtr = items;
+    T* dstPtr = buffer;
+    for (int digit = 0; digit < NUM_DIGITS; digit++)
+    {
+        int* digitCounts = counts[digit];
+        if (numItems == 0 ||
+            digitCounts[getRadixDigit(srcPtr[0], digit)] == numItems)
+        {
+            // every item has the same digit, so the pass would not move any
+            continue;
+        }
+
+        int offset = 0;
+        for (int value = 0; value < 256; value++)
+        {
+            int numWithValue = digitCounts[value];
+            digitCounts[value] = offset;
+            offset += numWithValue;
+        }
+
+        for (int i = 0; i < numItems; i++)
+        {
+            dstPtr[digitCounts[getRadixDigit(srcPtr[i], digit)]++] =
+                std::move(srcPtr[i]);
+        }
+        std::swap(srcPtr, dstPtr);
+    }
+
+    if (srcPtr != items)
+    {
+        std::move(srcPtr, srcPtr + numItems, items);
+    }
+}
+
+/**
+ * Sorts @c items by @c cmp, radix sorting them if they are
+ * @c RadixSortable.
+ * @param buffer Room for @c numItems items, used by the radix sort.
+ */
+template <class T, class Compare>
+void sortArray(T* items, T* buffer, int numItems, Compare& cmp)
+{
+    if constexpr (RadixSortable<T, Compare>::value)
+    {
+        if (numItems >= RADIX_SORT_THRESHOLD)
+        {
+            radixSort(items, buffer, numItems);
+            return;
+        }
+    }
+
+    std::sort(items, items + numItems, cmp);
+}
+
+/**
+ * Calls <tt>body(chunk)</tt> for every chunk from 0 to <tt>numChunks - 1</tt>,
+ * concurrently on the threads of @c pool, and waits for them all.
+ */
+template <class Function>
+void forEachChunk(int numChunks, Function body, ThreadPool& pool)
+{
+    TaskGroup group(pool);
+    for (int chunk = 1; chunk < numChunks; chunk++)
+    {
+        group.run([&body, chunk]()
+        {
+            body(chunk);
+        });
+    }
+
+    body(0);
+    group.wait();
+}
+
+/**
+ * Sorts @c items with an LSD radix sort in which each pass is split into
+ * @c numChunks chunks: every chunk counts its digits, the counts give each
+ * chunk its own range of every bucket, and then the chunks scatter their
+ * items concurrently.
+ * @param buffer Room for @c numItems items, whose contents are overwritten.
+ */
+template <class T>
+void parallelRadixSort(T* items, T* buffer, int numItems, int numChunks,
+                       ThreadPool& pool)
+{
+    const int NUM_DIGITS = sizeof(T);
+    int chunkSize = (numItems + numChunks - 1) / numChunks;
+    std::vector<std::vector<int>> counts(numChunks, std::vector<int>(256));
+
+    T* srcPtr = items;
+    T* dstPtr = buffer;
+    for (int digit = 0; digit < NUM_DIGITS; digit++)
+    {
+        forEachChunk(numChunks, [&](int chunk)
+        {
+            std::vector<int>& chunkCounts = counts[chunk];
+            std::fill(chunkCounts.begin(), chunkCounts.end(), 0);
+            int end = std::min(numItems, (chunk + 1) * chunkSize);
+            for (int i = chunk * chunkSize; i < end; i++)
+            {
+                chunkCounts[getRadixDigit(srcPtr[i], digit)]++;
+            }
+        }, pool);
+
+        // each chunk's items of a value go after the items of that value in
+        // the chunks before it
+        int offset = 0;
+        bool isSkipped = false;
+        for (int value = 0; value < 256 && !isSkipped; value++)
+        {
+            int valueOffset = offset;
+            for (int chunk = 0; chunk < numChunks; chunk++)
+            {
+                int numWithValue = counts[chunk][value];
+                counts[chunk][value] = offset;
+                offset += numWithValue;
+            }
+            isSkipped = offset - valueOffset == numItems;
+        }
+        if (isSkipped)
+        {
+            // every item has the same digit, so the pass would not move any
+            continue;
+        }
+
+        forEachChunk(numChunks, [&](int chunk)
+        {
+            std::vector<int>& offsets = counts[chunk];
+            int end = std::min(numItems, (chunk + 1) * chunkSize);
+            for (int i = chunk * chunkSize; i < end; i++)
+            {
+                dstPtr[offsets[getRadixDigit(srcPtr[i], digit)]++] =
+                    std::move(srcPtr[i]);
+            }
+        }, pool);
+        std::swap(srcPtr, dstPtr);
+    }
+
+    if (srcPtr != items)
+    {
+        forEachChunk(numChunks, [&](int chunk)
+        {
+            int begin = std::min(numItems, chunk * chunkSize);
+            int end = std::min(numItems, (chunk + 1) * chunkSize);
+            std::move(srcPtr + begin, srcPtr + end, items + begin);
+        }, pool);
+    }
+}
+
+/**
+ * Merges the sorted runs @c first and @c second into @c dstPtr, stably,
+ * splitting merges of more than @c grainSize items into two that run
+ * concurrently.
+ */
+template <class T, class Compare>
+void parallelMerge(T* first, int numFirst, T* second, int numSecond,
+                   T* dstPtr, Compare& cmp, ThreadPool& pool, int grainSize)
+{
+    if (numFirst + numSecond <= grainSize)
+    {
+        std::merge(std::make_move_iterator(first),
+                   std::make_move_iterator(first + numFirst),
+                   std::make_move_iterator(second),
+                   std::make_move_iterator(second + numSecond),
+                   dstPtr, cmp);
+        return;
+    }
+
+    // split the longer run in the middle and the other where that item
+    // would go, keeping equal items of the first run on the left
+    int firstSplit;
+    int secondSplit;
+    if (numFirst >= numSecond)
+    {
+        firstSplit = numFirst / 2;
+        secondSplit = static_cast<int>(std::lower_bound(second,
+            second + numSecond, first[firstSplit], cmp) - second);
+    }
+    else
+    {
+        secondSplit = numSecond / 2;
+        firstSplit = static_cast<int>(std::upper_bound(first,
+            first + numFirst, second[secondSplit], cmp) - first);
+    }
+
+    TaskGroup group(pool);
+    group.run([&]()
+    {
+        parallelMerge(first, firstSplit, second, secondSplit, dstPtr, cmp,
+                      pool, grainSize);
+    });
+    parallelMerge(first + firstSplit, numFirst - firstSplit,
+                  second + secondSplit, numSecond - secondSplit,
+                  dstPtr + firstSplit + secondSplit, cmp, pool, grainSize);
+    group.wait();
+}
+
+/**
+ * Sorts @c items with a merge sort whose halves are sorted concurrently,
+ * down to pieces of @c grainSize items, which are sorted by @c sortArray.
+ * Each level sorts into whichever of @c items and @c buffer the level above
+ * merges from, so no items are copied between merges.
+ * @param isIntoBuffer Whether the sorted items end up in @c buffer rather
+ *                     than in @c items.
+ */
+template <class T, class Compare>
+void parallelMergeSort(T* items, T* buffer, int numItems, bool isIntoBuffer,
+                       Compare& cmp, ThreadPool& pool, int grainSize)
+{
+    if (numItems <= grainSize)
+    {
+        sortArray(items, buffer, numItems, cmp);
+        if (isIntoBuffer)
+        {
+            std::move(items, items + numItems, buffer);
+        }
+        return;
+    }
+
+    int half = numItems / 2;
+    TaskGroup group(pool);
+    group.run([&]()
+    {
+        parallelMergeSort(items, buffer, half, !isIntoBuffer, cmp, pool,
+                          grainSize);
+    });
+    parallelMergeSort(items + half, buffer + half, numItems - half,
+                      !isIntoBuffer, cmp, pool, grainSize);
+    group.wait();
+
+    T* srcPtr = isIntoBuffer ? items : buffer;
+    T* dstPtr = isIntoBuffer ? buffer : items;
+    parallelMerge(srcPtr, half, srcPtr + half, numItems - half, dstPtr, cmp,
+                  pool, grainSize);
+}
+
+#endif
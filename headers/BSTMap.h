@@ -8,6 +8,8 @@
 #include "Entry.h"
 #include "BinarySearchTree.h"
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 template <class K, class V>
 class BSTMap : public Dictionary<K,V>
@@ -15,6 +17,11 @@ class BSTMap : public Dictionary<K,V>
 private:
     BinarySearchTree<Entry<K,V>>* searchTree;
 
+    /**
+     * Returns the underlying tree, creating it first if necessary.
+     */
+    BinarySearchTree<Entry<K,V>>* getTree();
+
 public:
     BSTMap();
 
@@ -22,6 +29,8 @@ public:
 
     ~BSTMap();
 
+    BSTMap<K,V>& operator=(const BSTMap<K,V>& other);
+
     virtual bool isEmpty() const;
 
     virtual int getSize() const;
@@ -30,25 +39,105 @@ public:
 
     virtual bool remove(const K& key);
 
-    virtual const V& getValue(const K& key) const;
+    /**
+     * Copies the value out; use @c findPtr to read or update it in place.
+     */
+    virtual V getValue(const K& key) const;
+
+    virtual bool tryGetValue(const K& key, V& outValue) const;
 
     virtual bool contains(const K& key) const;
 
     virtual void clear();
+
+    /**
+     * Looks up a batch of keys, descending the tree for several keys at once
+     * so that their cache misses overlap.
+     */
+    virtual void multiGet(const std::vector<K>& keys, std::vector<V>& outValues,
+                          std::vector<bool>& outFound) const;
+
+    virtual void multiContains(const std::vector<K>& keys,
+                               std::vector<bool>& outFound) const;
+
+    /**
+     * Looks up the value associated with a key.
+     * @param key The key to search for.
+     * @return A pointer to the value, or @c nullptr if the key is not in the
+     *         map. The pointer stays valid until the key is removed.
+     */
+    V* findPtr(const K& key);
+
+    const V* findPtr(const K& key) const;
+
+    /**
+     * Associates @c value with @c key, replacing any existing value.
+     * @param key The key.
+     * @param value The value to store.
+     * @return true if the key was newly inserted, false if an existing value
+     *         was overwritten.
+     */
+    bool insertOrAssign(const K& key, const V& value);
+
+    /**
+     * Inserts a value constructed from @c args if @c key is not already in
+     * the map. The value is not constructed if the key is present.
+     * @param key The key.
+     * @param args The arguments to forward to the constructor of @c V.
+     * @return true if the key was inserted, false if it already existed.
+     */
+    template <class... Args>
+    bool tryEmplace(const K& key, Args&&... args);
+
+    /**
+     * Returns the value associated with @c key, inserting the value returned
+     * by @c factory first if the key is not present.
+     * @param key The key.
+     * @param factory A callable taking no arguments and returning a @c V. It
+     *                is only invoked if the key is not already in the map.
+     * @return A reference to the value now associated with @c key.
+     */
+    template <class Factory>
+    V& getOrInsert(const K& key, Factory factory);
+
+    /**
+     * Calls @c func(key, value) for every entry, in increasing key order.
+     * @param func The function to call.
+     */
+    template <class Function>
+    void forEach(Function func) const;
+
+    /**
+     * Converts the map into a read-only index of its entries, which answers
+     * lookups much faster once the map will no longer change. Entries are
+     * looked up by key, as in @c index.findItem(key)->getValue(). The
+     * entries are moved into the index, and the map is left empty.
+     * @return The index of every entry that was in the map.
+     */
+    EytzingerIndex<Entry<K,V>> freeze();
+
+    /**
+     * @return The bytes the map uses (see MemoryUsage.h). The keys and
+     *         values, which each entry allocates separately, are payload;
+     *         the entries which point to them, the tree's nodes and every
+     *         allocation's overhead are overhead. Takes O(1) time unless
+     *         @c K or @c V may own memory, when every entry is visited.
+     */
+    MemoryUsage memoryUsage() const;
 };
 
 template <class K, class V>
-BSTMap()
+BSTMap<K,V>::BSTMap()
 {
     searchTree = nullptr;
 }
 
 template <class K, class V>
-BSTMap(const BSTMap<K,V>& other)
+BSTMap<K,V>::BSTMap(const BSTMap<K,V>& other)
 {
-    if (other.searchTree != nullptr) 
+    if (other.searchTree != nullptr)
     {
-        searchTree = new BinarySearchTree<Entry<K,V>>(other.searchTree);
+        searchTree = new BinarySearchTree<Entry<K,V>>(*other.searchTree);
     }
     else
     {
@@ -57,13 +146,39 @@ BSTMap(const BSTMap<K,V>& other)
 }
 
 template <class K, class V>
-~BSTMap()
+BSTMap<K,V>::~BSTMap()
 {
     clear();
 }
 
 template <class K, class V>
-bool isEmpty() const
+BSTMap<K,V>& BSTMap<K,V>::operator=(const BSTMap<K,V>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        if (other.searchTree != nullptr)
+        {
+            searchTree = new BinarySearchTree<Entry<K,V>>(*other.searchTree);
+        }
+    }
+
+    return *this;
+}
+
+template <class K, class V>
+BinarySearchTree<Entry<K,V>>* BSTMap<K,V>::getTree()
+{
+    if (searchTree == nullptr)
+    {
+        searchTree = new BinarySearchTree<Entry<K,V>>();
+    }
+
+    return searchTree;
+}
+
+template <class K, class V>
+bool BSTMap<K,V>::isEmpty() const
 {
     if (searchTree == nullptr)
     {
@@ -76,7 +191,7 @@ bool isEmpty() const
 }
 
 template <class K, class V>
-int getSize() const
+int BSTMap<K,V>::getSize() const
 {
     if (isEmpty())
     {
@@ -89,63 +204,233 @@ int getSize() const
 }
 
 template <class K, class V>
-bool add(const K& key, const V& value)
+bool BSTMap<K,V>::add(const K& key, const V& value)
 {
-    if (contains(key))
+    bool inserted = false;
+    getTree()->findOrInsert(key,
+            [&]() { return Entry<K,V>(key, value); }, inserted);
+    return inserted;
+}
+
+template <class K, class V>
+bool BSTMap<K,V>::remove(const K& key)
+{
+    if (searchTree == nullptr)
     {
         return false;
     }
 
-    Entry<K,V> newEntry(key, value);
-    if (searchTree == nullptr)
+    Entry<K,V> searchKeyEntry(key);
+    return searchTree->remove(searchKeyEntry);
+}
+
+template <class K, class V>
+V BSTMap<K,V>::getValue(const K& key) const
+{
+    const V* valuePtr = findPtr(key);
+    if (valuePtr == nullptr)
     {
-        searchTree = new BinarySearchTree<Entry<K,V>>(newEntry);
+        throw std::runtime_error("Key not found in BSTMap<K,V>::getValue.");
     }
-    else
+
+    return *valuePtr;
+}
+
+template <class K, class V>
+bool BSTMap<K,V>::tryGetValue(const K& key, V& outValue) const
+{
+    const V* valuePtr = findPtr(key);
+    if (valuePtr == nullptr)
     {
-        searchTree->add(newEntry);
+        return false;
     }
+
+    outValue = *valuePtr;
+    return true;
+}
+
+template <class K, class V>
+bool BSTMap<K,V>::contains(const K& key) const
+{
+    return findPtr(key) != nullptr;
 }
 
 template <class K, class V>
-bool remove(const K& key)
+void BSTMap<K,V>::clear()
+{
+    delete searchTree;
+    searchTree = nullptr;
+}
+
+template <class K, class V>
+void BSTMap<K,V>::multiGet(const std::vector<K>& keys,
+        std::vector<V>& outValues, std::vector<bool>& outFound) const
+{
+    outValues.assign(keys.size(), V());
+    outFound.assign(keys.size(), false);
+    if (searchTree == nullptr || keys.empty())
+    {
+        return;
+    }
+
+    std::vector<const Entry<K,V>*> entries(keys.size());
+    searchTree->findItems(keys.data(), static_cast<int>(keys.size()),
+                          entries.data());
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        if (entries[i] != nullptr)
+        {
+            outValues[i] = entries[i]->getValue();
+            outFound[i] = true;
+        }
+    }
+}
+
+template <class K, class V>
+void BSTMap<K,V>::multiContains(const std::vector<K>& keys,
+        std::vector<bool>& outFound) const
+{
+    outFound.assign(keys.size(), false);
+    if (searchTree == nullptr || keys.empty())
+    {
+        return;
+    }
+
+    std::vector<const Entry<K,V>*> entries(keys.size());
+    searchTree->findItems(keys.data(), static_cast<int>(keys.size()),
+                          entries.data());
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        outFound[i] = entries[i] != nullptr;
+    }
+}
+
+template <class K, class V>
+V* BSTMap<K,V>::findPtr(const K& key)
 {
     if (searchTree == nullptr)
     {
-        return false;
+        return nullptr;
     }
 
-    Entry<K,V> searchKeyEntry(key);
-    return searchTree->remove(searchKeyEntry);
+    Entry<K,V>* entryPtr = searchTree->findItem(key);
+    return (entryPtr != nullptr) ? &entryPtr->getValue() : nullptr;
 }
 
 template <class K, class V>
-const V& getValue(const K& key) const
+const V* BSTMap<K,V>::findPtr(const K& key) const
 {
     if (searchTree == nullptr)
     {
-        throw runtime_error("Called BSTMap<K,V>::getValue on an empty tree.");
+        return nullptr;
     }
 
-    return searchTree->getItem().getValue();
+    const Entry<K,V>* entryPtr = searchTree->findItem(key);
+    return (entryPtr != nullptr) ? &entryPtr->getValue() : nullptr;
 }
 
 template <class K, class V>
-bool contains(const K& key) const
+bool BSTMap<K,V>::insertOrAssign(const K& key, const V& value)
 {
-     if (searchTree == nullptr)
+    bool inserted = false;
+    Entry<K,V>* entryPtr = getTree()->findOrInsert(key,
+            [&]() { return Entry<K,V>(key, value); }, inserted);
+    if (!inserted)
     {
-        return false;
+        entryPtr->setValue(value);
     }
 
-    Entry<K,V> searchKeyEntry(key);
-    return searchTree->contains(searchKeyEntry);
+    return inserted;
 }
 
 template <class K, class V>
-void clear()
+template <class... Args>
+bool BSTMap<K,V>::tryEmplace(const K& key, Args&&... args)
 {
-    delete searchTree;
+    bool inserted = false;
+    getTree()->findOrInsert(key, [&]()
+            {
+                Entry<K,V> newEntry(key);
+                newEntry.setValue(V(std::forward<Args>(args)...));
+                return newEntry;
+            }, inserted);
+    return inserted;
+}
+
+template <class K, class V>
+template <class Factory>
+V& BSTMap<K,V>::getOrInsert(const K& key, Factory factory)
+{
+    bool inserted = false;
+    Entry<K,V>* entryPtr = getTree()->findOrInsert(key, [&]()
+            {
+                Entry<K,V> newEntry(key);
+                newEntry.setValue(factory());
+                return newEntry;
+            }, inserted);
+    return entryPtr->getValue();
+}
+
+template <class K, class V>
+template <class Function>
+void BSTMap<K,V>::forEach(Function func) const
+{
+    if (searchTree == nullptr)
+    {
+        return;
+    }
+
+    searchTree->inorderForEach([&func](const Entry<K,V>& entry)
+    {
+        func(entry.getKey(), entry.getValue());
+    });
+}
+
+template <class K, class V>
+EytzingerIndex<Entry<K,V>> BSTMap<K,V>::freeze()
+{
+    if (searchTree == nullptr)
+    {
+        return EytzingerIndex<Entry<K,V>>();
+    }
+
+    EytzingerIndex<Entry<K,V>> index = searchTree->freeze();
+    clear();
+    return index;
+}
+
+template <class K, class V>
+MemoryUsage BSTMap<K,V>::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.overheadBytes = sizeof(*this);
+    if (searchTree == nullptr)
+    {
+        return usage;
+    }
+
+    usage.overheadBytes += sizeof(*searchTree);
+    addAllocation(usage, sizeof(*searchTree));
+
+    // every node is allocated on its own and holds an entry, which
+    // allocates its key and value separately
+    typedef BinaryTreeNode<Entry<K,V>> EntryNode;
+    std::size_t numEntries = searchTree->getNumNodes();
+    usage.payloadBytes += numEntries * (sizeof(K) + sizeof(V));
+    usage.overheadBytes += numEntries * (getAllocatedBytes(sizeof(EntryNode)) +
+        getAllocatedBytes(sizeof(K)) - sizeof(K) +
+        getAllocatedBytes(sizeof(V)) - sizeof(V));
+
+    if constexpr (MayOwnMemory<K>::value || MayOwnMemory<V>::value)
+    {
+        searchTree->preorderForEach([&usage](const Entry<K,V>& entry)
+        {
+            addOwnedMemory(usage, entry.getKey());
+            addOwnedMemory(usage, entry.getValue());
+        });
+    }
+
+    return usage;
 }
 
 #endif
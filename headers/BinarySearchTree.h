@@ -1,6 +1,10 @@
 /**
  * @class BinarySearchTree
  * @brief A simple (non-balancing) binary search tree.
+ *
+ * @c Stats is an instrumentation policy (see ContainerStats.h). Every item a
+ * search visits counts as one comparison, so the comparisons per lookup give
+ * the depth of the searches, which grows linearly in a degenerate tree.
  * @author Kevin K. Yang
  */
 
@@ -9,23 +13,18 @@
 
 #include "BinaryTreeNode.h"
 #include "BinaryTree.h"
+#include "ContainerStats.h"
+#include "EytzingerIndex.h"
+#include "Prefetch.h"
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
-template <class T>
-class BinarySearchTree : private BinaryTree<T>
+template <class T, class Stats = NoStats>
+class BinarySearchTree : private BinaryTree<T>, private Stats
 {
 private:
-    /**
-     * Recursively inserts a new node into the tree, at the correct position as
-     * defined by the properties of a binary search tree.
-     * @param subtreePtr Pointer to the root of the subtree to insert into.
-     * @param newNodePtr Pointer to the node to be inserted.
-     * @param success A reference to a bool which is set to true if an item
-     *                was inserted, or false otherwise.
-     * @return A pointer to the root of the subtree.
-     */
-    virtual BinaryTreeNode<T>* orderedInsert(BinaryTreeNode<T>* subtreePtr,
-            BinaryTreeNode<T>* newNodePtr, bool& success);
+    int numNodes; ///< kept up to date, so that counting nodes is O(1)
 
     /**
      * @brief Removes the leftmost ancestor of a node, in order to facilitate 
@@ -56,7 +55,8 @@ private:
     virtual BinaryTreeNode<T>* removeNode(BinaryTreeNode<T>* nodePtr);
 
     /**
-     * Recursively removes a node with the target value, if it exists.
+     * Removes a node with the target value, if it exists, descending the
+     * tree in a loop which keeps track of the parent of the current node.
      * @param subtreePtr Pointer to the root of the subtree to search.
      * @param target The target value to remove.
      * @param success A boolean reference, which is set to true if the target
@@ -67,7 +67,7 @@ private:
             const T& target, bool& success);
 
     /**
-     * Recursively searches for a value in the tree.
+     * Searches for a value in the tree, in a loop.
      * @param subtreePtr The root of the tree to search.
      * @param target The value to search for.
      * @return The node with the target value if it exists, or @c nullptr
@@ -79,11 +79,12 @@ private:
 public:
     BinarySearchTree();
     BinarySearchTree(const T& rootItem);
-    BinarySearchTree(const BinarySearchTree<T>& other);
+    BinarySearchTree(const BinarySearchTree<T, Stats>& other);
 
     virtual ~BinarySearchTree();
 
-    virtual BinarySearchTree<T>& operator=(const BinarySearchTree<T>& other);
+    virtual BinarySearchTree<T, Stats>& operator=(
+            const BinarySearchTree<T, Stats>& other);
     
     /**
      * Adds a new node to the tree, maintaining the sorted nature of a BST.
@@ -121,106 +122,222 @@ public:
      */
     virtual const T& getItem(const T& item) const;
 
+    /**
+     * Searches the tree for the item which compares equal to @c key. @c Key
+     * may be @c T itself, or any type that can be compared with @c T using
+     * @c < and @c > (for example, the key type of an @c Entry), which avoids
+     * constructing a full item just to search for it.
+     * @param key The search key.
+     * @return A pointer to the item in the tree, or @c nullptr if there is no
+     *         such item. Callers must not modify the item in a way that
+     *         changes its ordering.
+     */
+    template <class Key>
+    T* findItem(const Key& key);
+
+    template <class Key>
+    const T* findItem(const Key& key) const;
+
+    /**
+     * Searches the tree for the item which compares equal to @c key and, if
+     * there is none, inserts the item returned by @c makeItem at the position
+     * where the search ended. Either way the tree is descended only once.
+     * @param key The search key.
+     * @param makeItem A callable taking no arguments and returning the item to
+     *                 insert, which must compare equal to @c key. It is only
+     *                 invoked if no such item already exists.
+     * @param inserted Set to true if a new item was inserted, false otherwise.
+     * @return A pointer to the item in the tree which compares equal to
+     *         @c key. Callers must not modify the item in a way that changes
+     *         its ordering.
+     */
+    template <class Key, class ItemFactory>
+    T* findOrInsert(const Key& key, ItemFactory makeItem, bool& inserted);
+
+    /**
+     * Searches the tree for a batch of keys at once. Groups of searches are
+     * advanced one level at a time in lockstep, prefetching each search's
+     * next node, so that the cache misses of independent searches overlap
+     * instead of being serviced one after another. If the items keep their
+     * keys behind a pointer (see @c KeyPrefetch), each level takes two
+     * steps: the first prefetches the key of the node which has arrived,
+     * and the second compares with it.
+     * @param keys The search keys (see @c findItem).
+     * @param count The number of keys.
+     * @param results An array of @c count pointers; element i is set to the
+     *                item which compares equal to @c keys[i], or @c nullptr.
+     */
+    template <class Key>
+    void findItems(const Key* keys, int count, const T** results) const;
+
+    /**
+     * Replaces the contents of this tree with a copy of @c other, copying
+     * subtrees concurrently; see @c BinaryTree::parallelCopyFrom. Only
+     * another search tree can be copied, since an arbitrary binary tree
+     * need not be ordered.
+     */
+    void parallelCopyFrom(const BinarySearchTree<T, Stats>& other,
+        ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = BinaryTree<T>::PARALLEL_GRAIN_SIZE);
+
+    /**
+     * Converts the tree into a read-only @c EytzingerIndex, which answers
+     * lookups much faster once no more items will be added or removed. The
+     * items are moved into the index, and the tree is left empty.
+     * @return The index of every item that was in the tree.
+     */
+    EytzingerIndex<T> freeze();
+
     // interfaces to derived methods
     virtual bool empty() const;
     virtual int getTreeHeight() const;
     virtual int getNumNodes() const;
     virtual void clear();
+
+    /**
+     * Deletes every node, deleting subtrees concurrently; see
+     * @c BinaryTree::parallelClear.
+     */
+    void parallelClear(ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = BinaryTree<T>::PARALLEL_GRAIN_SIZE);
+
+    using BinaryTree<T>::useArena;
+    using BinaryTree<T>::usesArena;
+    using BinaryTree<T>::memoryUsage;
+
+    /**
+     * @return The tree's instrumentation (see ContainerStats.h).
+     */
+    const Stats& getStats() const;
+    Stats& getStats();
+
     virtual void preorderTraverse(TraversalFunction<T>* func) const; 
     virtual void inorderTraverse(TraversalFunction<T>* func) const;
     virtual void postorderTraverse(TraversalFunction<T>* func) const;
+
+    // iteration, see BinaryTree
+    using typename BinaryTree<T>::iterator;
+    using typename BinaryTree<T>::const_iterator;
+    using BinaryTree<T>::begin;
+    using BinaryTree<T>::end;
+    using BinaryTree<T>::preorder;
+    using BinaryTree<T>::inorder;
+    using BinaryTree<T>::postorder;
+    using BinaryTree<T>::levelorder;
+    using BinaryTree<T>::morrisInorderTraverse;
+    using BinaryTree<T>::preorderForEach;
+    using BinaryTree<T>::inorderForEach;
+    using BinaryTree<T>::postorderForEach;
+    using BinaryTree<T>::parallelForEach;
+    using BinaryTree<T>::parallelReduce;
 };
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree()
+template <class T, class Stats>
+BinarySearchTree<T, Stats>::BinarySearchTree() : numNodes(0)
 {
 
 }
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree(const T& rootItem)
+template <class T, class Stats>
+BinarySearchTree<T, Stats>::BinarySearchTree(const T& rootItem) : numNodes(1)
 {
-    rootPtr = new BinaryTreeNode<T>(rootItem);
+    this->rootPtr = this->createNode(rootItem);
+    this->recordEvent(StatEvent::NODE_ALLOCATION);
 }
 
-template <class T>
-BinarySearchTree<T>::BinarySearchTree(const BinarySearchTree<T>& other)
+template <class T, class Stats>
+BinarySearchTree<T, Stats>::BinarySearchTree(
+        const BinarySearchTree<T, Stats>& other)
+    : BinaryTree<T>(), Stats(other), numNodes(0)
 {
-    *this = other;
+    this->copyAllocation(other);
+    this->rootPtr = this->copyTree(other.rootPtr);
+    numNodes = other.numNodes;
+    this->recordEvent(StatEvent::NODE_ALLOCATION, numNodes);
 }
 
-template <class T>
-BinarySearchTree<T>::~BinarySearchTree()
+template <class T, class Stats>
+BinarySearchTree<T, Stats>::~BinarySearchTree()
 {
     
 }
 
-template <class T>
-BinarySearchTree<T>& BinarySearchTree<T>::operator=(
-        const BinarySearchTree<T>& other)
+template <class T, class Stats>
+BinarySearchTree<T, Stats>& BinarySearchTree<T, Stats>::operator=(
+        const BinarySearchTree<T, Stats>& other)
 {
-    rootPtr = copyTree(other.rootPtr);
+    if (this != &other)
+    {
+        clear();
+        this->copyAllocation(other);
+        this->rootPtr = this->copyTree(other.rootPtr);
+        numNodes = other.numNodes;
+        this->recordEvent(StatEvent::NODE_ALLOCATION, numNodes);
+    }
+
     return *this;
 }
 
-template <class T>
-BinaryTreeNode<T>* BinarySearchTree<T>::orderedInsert(
-        BinaryTreeNode<T>* subtreePtr, BinaryTreeNode<T>* newNodePtr,
-        bool& success)
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::parallelCopyFrom(
+        const BinarySearchTree<T, Stats>& other,
+        ThreadPool& pool, int grainSize)
 {
-    if (subtreePtr == nullptr)
+    if (this == &other)
     {
-        success = true;
-        return newNodePtr;
+        return;
     }
 
-    if (subtreePtr->getItem() > newNodePtr->getItem())
-    {
-        BinaryTreeNode<T>* nodePtr = orderedInsert(subtreePtr->getLeft(),
-                newNodePtr, success);
-        subtreePtr->setLeft(nodePtr);
-    }
-    else if (subtreePtr->getItem() < newNodePtr->getItem())
-    {
-        BinaryTreeNode<T>* nodePtr = orderedInsert(subtreePtr->getRight(),
-                newNodePtr, success);
-        subtreePtr->setRight(nodePtr);
-    }
-    else
-    {
-        success = false;
-    }
-    
-    return subtreePtr;
+    this->recordEvent(StatEvent::NODE_DEALLOCATION, numNodes);
+    BinaryTree<T>::parallelCopyFrom(other, pool, grainSize);
+    numNodes = other.numNodes;
+    this->recordEvent(StatEvent::NODE_ALLOCATION, numNodes);
 }
 
-template <class T>
-bool BinarySearchTree<T>::add(const T& item)
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::parallelClear(ThreadPool& pool,
+        int grainSize)
 {
-    BinaryTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(item);
-    bool success = false;
-    rootPtr = orderedInsert(rootPtr, newNodePtr, success);
-    return success;
+    this->recordEvent(StatEvent::NODE_DEALLOCATION, numNodes);
+    BinaryTree<T>::parallelClear(pool, grainSize);
+    numNodes = 0;
+}
+
+template <class T, class Stats>
+bool BinarySearchTree<T, Stats>::add(const T& item)
+{
+    typename Stats::Timer timer(*this, StatOperation::ADD);
+    bool inserted = false;
+    findOrInsert(item, [&item]() { return item; }, inserted);
+    return inserted;
 }
 
-template <class T>
-BinaryTreeNode<T>* BinarySearchTree<T>::removeLeftmostAncestor(
+template <class T, class Stats>
+BinaryTreeNode<T>* BinarySearchTree<T, Stats>::removeLeftmostAncestor(
             BinaryTreeNode<T>* nodePtr, T& inorderSuccessor)
 {
-    if (nodePtr->getLeft() == nullptr)
+    BinaryTreeNode<T>* parentPtr = nullptr;
+    BinaryTreeNode<T>* curPtr = nodePtr;
+    while (curPtr->getLeft() != nullptr)
     {
-        inorderSuccessor = nodePtr->getItem();
-        return removeNode(nodePtr);
+        parentPtr = curPtr;
+        curPtr = curPtr->getLeft();
     }
 
-    BinaryTreeNode<T>* leftPtr = removeLeftmostAncestor(
-            nodePtr->getLeft(), inorderSuccessor);
-    nodePtr->setLeft(leftPtr);
+    inorderSuccessor = curPtr->getItem();
+    BinaryTreeNode<T>* replacementPtr = removeNode(curPtr);
+    if (parentPtr == nullptr)
+    {
+        return replacementPtr;
+    }
+
+    parentPtr->setLeft(replacementPtr);
     return nodePtr;
 }
 
-template <class T>
-BinaryTreeNode<T>* BinarySearchTree<T>::removeNode(BinaryTreeNode<T>* nodePtr)
+template <class T, class Stats>
+BinaryTreeNode<T>* BinarySearchTree<T, Stats>::removeNode(
+        BinaryTreeNode<T>* nodePtr)
 {
     if (nodePtr == nullptr)
     {
@@ -232,19 +349,22 @@ BinaryTreeNode<T>* BinarySearchTree<T>::removeNode(BinaryTreeNode<T>* nodePtr)
 
     if (!leftPtr && !rightPtr)
     {
-        delete nodePtr;
+        this->recordEvent(StatEvent::NODE_DEALLOCATION);
+        this->destroyNode(nodePtr);
         return nullptr;
     }
     else if (!leftPtr)
     {
         BinaryTreeNode<T>* rightPtr = nodePtr->getRight();
-        delete nodePtr;
+        this->recordEvent(StatEvent::NODE_DEALLOCATION);
+        this->destroyNode(nodePtr);
         return rightPtr;
     }
     else if (!rightPtr)
     {
         BinaryTreeNode<T>* leftPtr = nodePtr->getLeft();
-        delete nodePtr;
+        this->recordEvent(StatEvent::NODE_DEALLOCATION);
+        this->destroyNode(nodePtr);
         return leftPtr;
     }
     else
@@ -258,134 +378,357 @@ BinaryTreeNode<T>* BinarySearchTree<T>::removeNode(BinaryTreeNode<T>* nodePtr)
     }
 }
 
-template <class T>
-BinaryTreeNode<T>* BinarySearchTree<T>::removeHelper(
+template <class T, class Stats>
+BinaryTreeNode<T>* BinarySearchTree<T, Stats>::removeHelper(
         BinaryTreeNode<T>* subtreePtr, const T& target, bool& success)
 {
-    if (subtreePtr == nullptr)
+    BinaryTreeNode<T>* parentPtr = nullptr;
+    BinaryTreeNode<T>* curPtr = subtreePtr;
+    bool isLeftChild = false;
+    while (curPtr != nullptr)
     {
-        success = false;
-        return nullptr;
+        this->recordEvent(StatEvent::COMPARISON);
+        if (curPtr->getItem() == target)
+        {
+            success = true;
+            numNodes--;
+            BinaryTreeNode<T>* replacementPtr = removeNode(curPtr);
+            if (parentPtr == nullptr)
+            {
+                return replacementPtr;
+            }
+            else if (isLeftChild)
+            {
+                parentPtr->setLeft(replacementPtr);
+            }
+            else
+            {
+                parentPtr->setRight(replacementPtr);
+            }
+            return subtreePtr;
+        }
+
+        parentPtr = curPtr;
+        if (curPtr->getItem() > target)
+        {
+            curPtr = curPtr->getLeft();
+            isLeftChild = true;
+        }
+        else
+        {
+            curPtr = curPtr->getRight();
+            isLeftChild = false;
+        }
     }
 
-    if (subtreePtr->getItem() == target)
+    success = false;
+    return subtreePtr;
+}
+
+template <class T, class Stats>
+bool BinarySearchTree<T, Stats>::remove(const T& target)
+{
+    typename Stats::Timer timer(*this, StatOperation::REMOVE);
+    bool success = false;
+    this->rootPtr = removeHelper(this->rootPtr, target, success);
+    return success;
+}
+
+template <class T, class Stats>
+BinaryTreeNode<T>* BinarySearchTree<T, Stats>::containsHelper(
+        BinaryTreeNode<T>* subtreePtr, const T& target) const
+{
+    while (subtreePtr != nullptr)
     {
-        success = true;
-        return removeNode(subtreePtr);
+        this->recordEvent(StatEvent::COMPARISON);
+        if (subtreePtr->getItem() == target)
+        {
+            return subtreePtr;
+        }
+
+        if (subtreePtr->getItem() > target)
+        {
+            subtreePtr = subtreePtr->getLeft();
+        }
+        else if (subtreePtr->getItem() < target)
+        {
+            subtreePtr = subtreePtr->getRight();
+        }
+        else
+        {
+            // if this point is reached, there were duplicate items in the
+            // tree.
+            return nullptr;
+        }
     }
 
-    if (subtreePtr->getItem() > target)
+    return nullptr;
+}
+
+template <class T, class Stats>
+bool BinarySearchTree<T, Stats>::contains(const T& item) const
+{
+    typename Stats::Timer timer(*this, StatOperation::LOOKUP);
+    return containsHelper(this->rootPtr, item) != nullptr;
+}
+
+template <class T, class Stats>
+const T& BinarySearchTree<T, Stats>::getItem(const T& item) const
+{
+    typename Stats::Timer timer(*this, StatOperation::LOOKUP);
+    BinaryTreeNode<T>* nodePtr = containsHelper(this->rootPtr, item);
+    if (nodePtr != nullptr)
     {
-        BinaryTreeNode<T>* nodePtr = 
-                removeHelper(subtreePtr->getLeft(), target, success);
-        subtreePtr->setLeft(nodePtr);
+        return nodePtr->getItem();
     }
     else
     {
-        BinaryTreeNode<T>* nodePtr = 
-                removeHelper(subtreePtr->getRight(), target, success);
-        subtreePtr->setRight(nodePtr);
+        throw std::runtime_error("Item not found in "
+                                 "BinarySearchTree<T>::getItem");
     }
+}
 
-    return subtreePtr;
+template <class T, class Stats>
+template <class Key>
+T* BinarySearchTree<T, Stats>::findItem(const Key& key)
+{
+    typename Stats::Timer timer(*this, StatOperation::LOOKUP);
+    BinaryTreeNode<T>* curPtr = this->rootPtr;
+    while (curPtr != nullptr)
+    {
+        this->recordEvent(StatEvent::COMPARISON);
+        if (curPtr->getItem() > key)
+        {
+            curPtr = curPtr->getLeft();
+        }
+        else if (curPtr->getItem() < key)
+        {
+            curPtr = curPtr->getRight();
+        }
+        else
+        {
+            return &curPtr->getItem();
+        }
+    }
+
+    return nullptr;
 }
 
-template <class T>
-bool BinarySearchTree<T>::remove(const T& target)
+template <class T, class Stats>
+template <class Key>
+const T* BinarySearchTree<T, Stats>::findItem(const Key& key) const
 {
-    bool success = false;
-    rootPtr = removeHelper(rootPtr, target, success);
-    return success;
+    return const_cast<BinarySearchTree<T, Stats>*>(this)->findItem(key);
 }
 
-template <class T>
-BinaryTreeNode<T>* BinarySearchTree<T>::containsHelper(
-        BinaryTreeNode<T>* subtreePtr, const T& target) const
+template <class T, class Stats>
+template <class Key, class ItemFactory>
+T* BinarySearchTree<T, Stats>::findOrInsert(const Key& key,
+        ItemFactory makeItem, bool& inserted)
 {
-    if (subtreePtr == nullptr)
+    BinaryTreeNode<T>* parentPtr = nullptr;
+    BinaryTreeNode<T>* curPtr = this->rootPtr;
+    bool isLeftChild = false;
+    while (curPtr != nullptr)
     {
-        return nullptr;
+        this->recordEvent(StatEvent::COMPARISON);
+        parentPtr = curPtr;
+        if (curPtr->getItem() > key)
+        {
+            curPtr = curPtr->getLeft();
+            isLeftChild = true;
+        }
+        else if (curPtr->getItem() < key)
+        {
+            curPtr = curPtr->getRight();
+            isLeftChild = false;
+        }
+        else
+        {
+            inserted = false;
+            return &curPtr->getItem();
+        }
     }
 
-    if (subtreePtr->getItem() == target)
+    BinaryTreeNode<T>* newNodePtr = this->createNode(makeItem());
+    this->recordEvent(StatEvent::NODE_ALLOCATION);
+    numNodes++;
+    if (parentPtr == nullptr)
     {
-        return subtreePtr;
+        this->rootPtr = newNodePtr;
     }
-
-    if (subtreePtr->getItem() > target)
+    else if (isLeftChild)
     {
-        return containsHelper(subtreePtr->getLeft(), target);
+        parentPtr->setLeft(newNodePtr);
     }
-    
-    if (subtreePtr->getItem() < target)
+    else
     {
-        return containsHelper(subtreePtr->getRight(), target);
+        parentPtr->setRight(newNodePtr);
     }
 
-    // if this point is reached, there were duplicate items in the tree.
-    return nullptr;
+    inserted = true;
+    return &newNodePtr->getItem();
 }
 
-template <class T>
-bool BinarySearchTree<T>::contains(const T& item) const
+template <class T, class Stats>
+template <class Key>
+void BinarySearchTree<T, Stats>::findItems(const Key* keys, int count,
+        const T** results) const
 {
-    return containsHelper(rootPtr, item) != nullptr;
-}
+    // with a step to prefetch keys each level takes two rounds, so groups
+    // are twice as large to keep as many lookups per level in flight
+    const int GROUP_SIZE = KeyPrefetch<T>::ENABLED ? 32 : 16;
+    BinaryTreeNode<T>* lanes[GROUP_SIZE];
+    bool keyPrefetched[GROUP_SIZE];
 
-template <class T>
-const T& BinarySearchTree<T>::getItem(const T& item) const
-{
-    BinaryTreeNode<T>* nodePtr = containsHelper(rootPtr, item);
-    if (nodePtr != nullptr)
+    for (int groupStart = 0; groupStart < count; groupStart += GROUP_SIZE)
     {
-        return nodePtr->getItem();
+        int groupSize = count - groupStart;
+        if (groupSize > GROUP_SIZE)
+        {
+            groupSize = GROUP_SIZE;
+        }
+
+        for (int i = 0; i < groupSize; i++)
+        {
+            lanes[i] = this->rootPtr;
+            keyPrefetched[i] = false;
+            results[groupStart + i] = nullptr;
+        }
+
+        int numActive = (this->rootPtr != nullptr) ? groupSize : 0;
+        while (numActive > 0)
+        {
+            numActive = 0;
+            for (int i = 0; i < groupSize; i++)
+            {
+                BinaryTreeNode<T>* nodePtr = lanes[i];
+                if (nodePtr == nullptr)
+                {
+                    continue;
+                }
+
+                if constexpr (KeyPrefetch<T>::ENABLED)
+                {
+                    if (!keyPrefetched[i])
+                    {
+                        KeyPrefetch<T>::prefetch(nodePtr->getItem());
+                        keyPrefetched[i] = true;
+                        numActive++;
+                        continue;
+                    }
+                    keyPrefetched[i] = false;
+                }
+
+                this->recordEvent(StatEvent::COMPARISON);
+                const T& item = nodePtr->getItem();
+                const Key& key = keys[groupStart + i];
+                if (item > key)
+                {
+                    nodePtr = nodePtr->getLeft();
+                }
+                else if (item < key)
+                {
+                    nodePtr = nodePtr->getRight();
+                }
+                else
+                {
+                    results[groupStart + i] = &item;
+                    nodePtr = nullptr;
+                }
+
+                lanes[i] = nodePtr;
+                if (nodePtr != nullptr)
+                {
+                    prefetchForRead(nodePtr);
+                    numActive++;
+                }
+            }
+        }
     }
-    else
+}
+
+template <class T, class Stats>
+EytzingerIndex<T> BinarySearchTree<T, Stats>::freeze()
+{
+    std::vector<T> sortedItems;
+    std::vector<BinaryTreeNode<T>*> stack;
+    BinaryTreeNode<T>* curPtr = this->rootPtr;
+    while (curPtr != nullptr || !stack.empty())
     {
-        throw runtime_error("Item not found in BinarySearchTree<T>::getItem");
+        while (curPtr != nullptr)
+        {
+            stack.push_back(curPtr);
+            curPtr = curPtr->getLeft();
+        }
+
+        curPtr = stack.back();
+        stack.pop_back();
+        sortedItems.push_back(std::move(curPtr->getItem()));
+        curPtr = curPtr->getRight();
     }
+
+    clear();
+    return EytzingerIndex<T>(std::move(sortedItems));
+}
+
+template <class T, class Stats>
+bool BinarySearchTree<T, Stats>::empty() const
+{
+    return BinaryTree<T>::empty();
+}
+
+template <class T, class Stats>
+int BinarySearchTree<T, Stats>::getTreeHeight() const
+{
+    return BinaryTree<T>::getTreeHeight();
 }
 
-template <class T>
-bool BinarySearchTree<T>::empty() const
+template <class T, class Stats>
+int BinarySearchTree<T, Stats>::getNumNodes() const
 {
-    return BinaryTree::empty();
+    return numNodes;
 }
 
-template <class T>
-int BinarySearchTree<T>::getTreeHeight() const
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::clear()
 {
-    return BinaryTree::getTreeHeight();
+    this->recordEvent(StatEvent::NODE_DEALLOCATION, numNodes);
+    BinaryTree<T>::clear();
+    numNodes = 0;
 }
 
-template <class T>
-int BinarySearchTree<T>::getNumNodes() const
+template <class T, class Stats>
+const Stats& BinarySearchTree<T, Stats>::getStats() const
 {
-    return BinaryTree::getNumNodes();
+    return *this;
 }
 
-template <class T>
-void BinarySearchTree<T>::clear()
+template <class T, class Stats>
+Stats& BinarySearchTree<T, Stats>::getStats()
 {
-    BinaryTree::clear();
+    return *this;
 }
 
-template <class T>
-void BinarySearchTree<T>::preorderTraverse(TraversalFunction<T>* func) const
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::preorderTraverse(
+        TraversalFunction<T>* func) const
 {
-    BinaryTree::preorderTraverse(func);
+    BinaryTree<T>::preorderTraverse(func);
 }
 
-template <class T>
-void BinarySearchTree<T>::inorderTraverse(TraversalFunction<T>* func) const
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::inorderTraverse(
+        TraversalFunction<T>* func) const
 {
-    BinaryTree::inorderTraverse(func);
+    BinaryTree<T>::inorderTraverse(func);
 }
 
-template <class T>
-void BinarySearchTree<T>::postorderTraverse(TraversalFunction<T>* func) const
+template <class T, class Stats>
+void BinarySearchTree<T, Stats>::postorderTraverse(
+        TraversalFunction<T>* func) const
 {
-    BinaryTree::postorderTraverse(func);
+    BinaryTree<T>::postorderTraverse(func);
 }
 
 #endif
@@ -8,7 +8,18 @@
 #define BINARY_TREE_H
 
 #include "BinaryTreeNode.h"
+#include "BinaryTreeIterator.h"
+#include "MemoryUsage.h"
+#include "NodeArena.h"
+#include "ThreadPool.h"
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
  * @class TraversalFunction
@@ -34,15 +45,39 @@ class BinaryTree
 protected:
     BinaryTreeNode<T>* rootPtr;
 
+    /** The arena the nodes are allocated from, or @c nullptr for the heap. */
+    NodeArena<BinaryTreeNode<T>>* arenaPtr;
+
+    /**
+     * Allocates a node holding @c item, from the arena if the tree has one.
+     * Every node of the tree must be created with this.
+     */
+    BinaryTreeNode<T>* createNode(const T& item) const;
+    BinaryTreeNode<T>* createNode(T&& item) const;
+
+    /**
+     * Frees a node created by @c createNode.
+     */
+    void destroyNode(BinaryTreeNode<T>* nodePtr) const;
+
+    /**
+     * Makes this tree, which must be empty, allocate its nodes as @c other
+     * does: from an arena with the same chunk size, or from the heap. Used
+     * by copies, so that a copy's allocation does not depend on whether it
+     * was constructed or assigned.
+     */
+    void copyAllocation(const BinaryTree<T>& other);
+
     /** 
-     * Recursively calculates the height of the tree.
+     * Calculates the height of the tree with a level-order walk, so that
+     * trees of any height can be measured.
      * @param subtreePtr the root of the subtree to calculate the height of.
      * @return the height of the tree rooted at @c subtreePtr.
      */
     virtual int treeHeightHelper(BinaryTreeNode<T>* subtreePtr) const;
 
     /**
-     * Recursively find the number of nodes in the tree.
+     * Finds the number of nodes in the tree, without recursing.
      * @param subtreePtr the root of the subtree to act on.
      * @return the number of nodes in the tree rooted at @c subtreePtr.
      */
@@ -51,13 +86,13 @@ protected:
     /**
      * Deletes each node in the tree, including the root.
      * @param the root of the subtree to be deleted.
-     * @note uses postorder traversal.
+     * @note Uses O(1) extra memory, so trees of any height can be deleted.
      */
     virtual void destroyTree(BinaryTreeNode<T>* subtreePtr);
 
     /**
-     * Recursively adds a new node to the tree in a balanced manner, 
-     * by adding to the shorter of the root node’s two subtrees.
+     * Adds a new node to the tree in a balanced manner, by descending into
+     * the shorter of each node’s two subtrees until there is a free place.
      * @param subtreePtr the root of the tree to add to.
      * @param newNodePtr the new node to add.
      * @return the root of the tree.
@@ -66,7 +101,8 @@ protected:
         BinaryTreeNode<T>* newNodePtr);
 
     /**
-     * Removes a value from the tree.
+     * Removes a value from the tree. The search keeps an explicit stack of
+     * nodes and their parents rather than recursing.
      * @param subtreePtr, the root of the subtree to search.
      * @param target The data item of the node to delete.
      * @param success True if the value existed in the tree and was removed, 
@@ -79,14 +115,15 @@ protected:
     /**
      * Overwrites the data item of the node pointed to by @c subtreePtr by 
      * moving items from its descendant nodes upwards, and deletes the resulting 
-     * empty leaf node.
+     * empty leaf node. Works down a single path, without recursing.
      * @param subtreePtr A pointer to the node with the value to be overwritten.
      * @return A pointer to the node with the old value replaced by a new one.
      */
     virtual BinaryTreeNode<T>* shiftItemsUp(BinaryTreeNode<T>* subtreePtr);
 
     /**
-     * Searches for a node with the specified value.
+     * Searches for a node with the specified value, in preorder, using an
+     * explicit stack.
      * @param treePtr The pointer to the root of the tree to search.
      * @param target The value to search for.
      * @param success True if it was found, false otherwise.
@@ -99,12 +136,59 @@ protected:
      * Creates a deep copy of a tree.
      * @param treePtr The root of the tree to copy.
      * @return The root of the copied tree.
+     * @note Iterative, so trees of any height can be copied. The explicit
+     *       stack holds one entry per node on the current path with two
+     *       children, so it stays small even for a degenerate tree.
      */
     virtual BinaryTreeNode<T>* copyTree(const BinaryTreeNode<T>* treePtr) 
         const;
 
     /**
-     * Preorder traversal helper method.
+     * Creates a deep copy of a tree, using the threads of @c pool to copy
+     * subtrees concurrently.
+     */
+    virtual BinaryTreeNode<T>* copyTree(const BinaryTreeNode<T>* treePtr,
+        ThreadPool& pool, int grainSize) const;
+
+    /**
+     * Deletes each node in the tree, using the threads of @c pool to delete
+     * subtrees concurrently.
+     */
+    virtual void destroyTree(BinaryTreeNode<T>* subtreePtr, ThreadPool& pool,
+        int grainSize);
+
+    /**
+     * A pending step of @c copyTreeHelper: copy the subtree rooted at
+     * @c sourcePtr and attach the copy to @c parentPtr.
+     */
+    struct CopyStep
+    {
+        const BinaryTreeNode<T>* sourcePtr;
+        BinaryTreeNode<T>* parentPtr;
+        bool isLeft;
+    };
+
+    /**
+     * Copies the subtree of a @c CopyStep. If @c grainSize is positive, each
+     * time @c grainSize more nodes have been copied the oldest pending step
+     * is handed to @c spawn instead.
+     */
+    template <class Spawn>
+    void copyTreeHelper(CopyStep first, Spawn& spawn, int grainSize) const;
+
+    /**
+     * Deletes a subtree by repeatedly rotating its root's left child up,
+     * until the root has no left child and can be deleted. If @c grainSize is
+     * positive, each time @c grainSize more nodes have been deleted the
+     * root's right subtree is detached and handed to @c spawn instead.
+     */
+    template <class Spawn>
+    void destroyTreeHelper(BinaryTreeNode<T>* subtreePtr, Spawn& spawn,
+        int grainSize) const;
+
+    /**
+     * Preorder traversal helper method. The traversal helpers walk the tree
+     * with its iterators, so they are safe on trees of any height.
      */
     virtual void preorderHelper(TraversalFunction<T>* func, 
         BinaryTreeNode<T>* treePtr) const;
@@ -121,7 +205,26 @@ protected:
     virtual void postorderHelper(TraversalFunction<T>* func, 
         BinaryTreeNode<T>* treePtr) const;
 
+    /**
+     * Visits every node of a subtree in preorder using an explicit stack.
+     * Each time @c grainSize more nodes have been visited, the oldest
+     * pending subtree on the stack (the one nearest the subtree's root, and
+     * so probably the largest) is handed to @c spawn instead, so that another
+     * thread can steal it.
+     */
+    template <class Function>
+    static void parallelVisitHelper(BinaryTreeNode<T>* subtreePtr,
+        Function& visit,
+        const std::function<void(BinaryTreeNode<T>*)>& spawn,
+        int grainSize);
+
 public:
+    /**
+     * The default number of nodes a parallel traversal visits on one thread
+     * before offering part of its remaining work to other threads.
+     */
+    static const int PARALLEL_GRAIN_SIZE = 4096;
+
     // Constructors
     BinaryTree();
     BinaryTree(const T& rootItem);
@@ -151,37 +254,175 @@ public:
 
     virtual bool contains(const T& item) const;
 
+    /**
+     * Removes every item from the tree. If the tree uses an arena, its
+     * chunks are released all at once, and if @c T is trivially
+     * destructible the nodes are not visited at all.
+     */
     virtual void clear();
 
+    /**
+     * Makes the tree allocate its nodes from its own arena rather than
+     * individually from the heap. Nodes are then laid out contiguously in
+     * the order they were added, nodes freed by @c remove are reused, and
+     * @c clear releases every node at once. Copies of the tree, and trees
+     * it is assigned to, use an arena too.
+     * @param nodesPerChunk The number of nodes in each chunk of the arena.
+     * @throws runtime_error if the tree is not empty.
+     * @note The parallel copy and clear methods run sequentially on a tree
+     *       with an arena, which cannot be shared between threads.
+     */
+    void useArena(int nodesPerChunk = 
+        NodeArena<BinaryTreeNode<T>>::DEFAULT_NODES_PER_CHUNK);
+
+    /**
+     * @return true if the tree allocates its nodes from an arena.
+     */
+    bool usesArena() const;
+
+    /**
+     * @return The bytes the tree uses (see MemoryUsage.h). The links of the
+     *         nodes are overhead; with an arena, its unused slots are slack.
+     *         Visits every node.
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * Replaces the contents of this tree with a copy of @c other, using the
+     * threads of @c pool to copy subtrees concurrently. Worthwhile for trees
+     * of millions of nodes; a degenerate tree is copied by one thread.
+     * @param grainSize The number of nodes a thread copies before offering
+     *                  part of its remaining work to other threads.
+     */
+    void parallelCopyFrom(const BinaryTree<T>& other,
+        ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = PARALLEL_GRAIN_SIZE);
+
+    /**
+     * Removes every item from the tree, using the threads of @c pool to
+     * delete subtrees concurrently.
+     */
+    void parallelClear(ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = PARALLEL_GRAIN_SIZE);
+
     // Traversal operations
     virtual void preorderTraverse(TraversalFunction<T>* func) const; 
     virtual void inorderTraverse(TraversalFunction<T>* func) const;
     virtual void postorderTraverse(TraversalFunction<T>* func) const;
-   
+
+    /**
+     * Traversals which call any callable @c visit as <tt>visit(const T&)</tt>
+     * for each item, so that unlike with a @c TraversalFunction the call can
+     * be inlined. They do not recurse, so they are safe on trees of any
+     * height.
+     */
+    template <class Function>
+    void preorderForEach(Function visit) const;
+    template <class Function>
+    void inorderForEach(Function visit) const;
+    template <class Function>
+    void postorderForEach(Function visit) const;
+
+    /**
+     * Calls @c visit(const T&) once for every item, in no particular order,
+     * spreading the work across the threads of @c pool. Subtrees are forked
+     * off as tasks lazily, once a thread has visited @c grainSize nodes, so
+     * small trees are visited on the calling thread alone.
+     * @param visit A callable which is safe to call concurrently from
+     *              several threads. It must not modify the tree.
+     * @param pool The pool whose threads do the work.
+     * @param grainSize The number of nodes visited between forks.
+     * @throws The first exception thrown by @c visit, after all of the
+     *         tasks have finished.
+     */
+    template <class Function>
+    void parallelForEach(Function visit,
+        ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = PARALLEL_GRAIN_SIZE) const;
+
+    /**
+     * Computes <tt>combine(... combine(identity, map(item1)) ...,
+     * map(itemN))</tt> over every item, spreading the work across the
+     * threads of @c pool. Each task folds the items it visits into its own
+     * partial result, and the partial results are folded together at the
+     * end.
+     * @param identity The identity of @c combine, e.g. 0 for a sum.
+     * @param map A callable <tt>R map(const T&)</tt>.
+     * @param combine A callable <tt>R combine(R, R)</tt>. Since items are
+     *                visited in no particular order, it must be associative
+     *                and commutative.
+     * @return The combined result, or @c identity if the tree is empty.
+     */
+    template <class R, class Map, class Combine>
+    R parallelReduce(R identity, Map map, Combine combine,
+        ThreadPool& pool = ThreadPool::getDefault(),
+        int grainSize = PARALLEL_GRAIN_SIZE) const;
+
+    /**
+     * Visits every item in order, using Morris traversal: the tree is
+     * temporarily threaded (each inorder predecessor's empty right pointer
+     * is pointed back at its successor) so that no stack is needed at all.
+     * The threads are removed again before this method returns, even if
+     * @c visit throws.
+     * @param visit A callable invoked as <tt>visit(const T&)</tt> for each
+     *              item. It must not modify the tree.
+     * @note Since the tree's links are rewritten during the traversal, it
+     *       must not run concurrently with any other access to the tree.
+     */
+    template <class Function>
+    void morrisInorderTraverse(Function visit) const;
+
+    // Iterators
+    typedef BinaryTreeIterator<T, TraversalOrder::INORDER> iterator;
+    typedef BinaryTreeIterator<T, TraversalOrder::INORDER> const_iterator;
+
+    /**
+     * @return An iterator to the first item of an inorder traversal.
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Ranges for iterating over the tree in a particular order, e.g.
+     * <tt>for (const T& item : tree.preorder())</tt>.
+     */
+    TraversalRange<T, TraversalOrder::PREORDER> preorder() const;
+    TraversalRange<T, TraversalOrder::INORDER> inorder() const;
+    TraversalRange<T, TraversalOrder::POSTORDER> postorder() const;
+    TraversalRange<T, TraversalOrder::LEVELORDER> levelorder() const;
 };
 
 template <class T>
-BinaryTree<T>::BinaryTree() : rootPtr(nullptr)
+BinaryTree<T>::BinaryTree() : rootPtr(nullptr), arenaPtr(nullptr)
 {
       
 }
 
 template <class T>
-BinaryTree<T>::BinaryTree(const T& rootItem)
+BinaryTree<T>::BinaryTree(const T& rootItem) : arenaPtr(nullptr)
 {
-    rootPtr = new BinaryTreeNode<T>(rootItem);
+    rootPtr = createNode(rootItem);
 }
 
 template <class T>
 BinaryTree<T>::BinaryTree(const T& rootItem, 
         const BinaryTree<T>* leftSubtreePtr,
-        const BinaryTree<T>* rightSubtreePtr)
+        const BinaryTree<T>* rightSubtreePtr) : arenaPtr(nullptr)
 {
-    rootPtr= new BinaryTreeNode<T>(rootItem, leftSubtreePtr, rightSubtreePtr);
+    rootPtr = createNode(rootItem);
+    if (leftSubtreePtr != nullptr)
+    {
+        rootPtr->setLeft(copyTree(leftSubtreePtr->rootPtr));
+    }
+    if (rightSubtreePtr != nullptr)
+    {
+        rootPtr->setRight(copyTree(rightSubtreePtr->rootPtr));
+    }
 }
 
 template <class T>
-BinaryTree<T>::BinaryTree(const BinaryTree<T>& other)
+BinaryTree<T>::BinaryTree(const BinaryTree<T>& other) 
+    : rootPtr(nullptr), arenaPtr(nullptr)
 {
     *this = other;
 }
@@ -190,12 +431,122 @@ template <class T>
 BinaryTree<T>::~BinaryTree()
 {
     clear();
+    delete arenaPtr;
+    arenaPtr = nullptr;
+}
+
+template <class T>
+BinaryTreeNode<T>* BinaryTree<T>::createNode(const T& item) const
+{
+    if (arenaPtr != nullptr)
+    {
+        return arenaPtr->create(item);
+    }
+
+    return new BinaryTreeNode<T>(item);
+}
+
+template <class T>
+BinaryTreeNode<T>* BinaryTree<T>::createNode(T&& item) const
+{
+    if (arenaPtr != nullptr)
+    {
+        return arenaPtr->create(std::move(item));
+    }
+
+    return new BinaryTreeNode<T>(std::move(item));
+}
+
+template <class T>
+void BinaryTree<T>::destroyNode(BinaryTreeNode<T>* nodePtr) const
+{
+    if (arenaPtr != nullptr)
+    {
+        arenaPtr->destroy(nodePtr);
+    }
+    else
+    {
+        delete nodePtr;
+    }
+}
+
+template <class T>
+void BinaryTree<T>::copyAllocation(const BinaryTree<T>& other)
+{
+    if (other.arenaPtr != nullptr)
+    {
+        useArena(other.arenaPtr->getNodesPerChunk());
+    }
+    else
+    {
+        delete arenaPtr;
+        arenaPtr = nullptr;
+    }
+}
+
+template <class T>
+void BinaryTree<T>::useArena(int nodesPerChunk)
+{
+    if (!empty())
+    {
+        throw std::runtime_error("BinaryTree<T>::useArena can only be called "
+                                 "on an empty tree.");
+    }
+
+    NodeArena<BinaryTreeNode<T>>* newArenaPtr =
+        new NodeArena<BinaryTreeNode<T>>(nodesPerChunk);
+    delete arenaPtr;
+    arenaPtr = newArenaPtr;
+}
+
+template <class T>
+bool BinaryTree<T>::usesArena() const
+{
+    return arenaPtr != nullptr;
+}
+
+template <class T>
+MemoryUsage BinaryTree<T>::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.overheadBytes = sizeof(*this);
+
+    int numNodes = 0;
+    preorderForEach([&usage, &numNodes](const T& item)
+    {
+        usage.payloadBytes += sizeof(T);
+        usage.overheadBytes += sizeof(BinaryTreeNode<T>) - sizeof(T);
+        addOwnedMemory(usage, item);
+        numNodes++;
+    });
+
+    if (arenaPtr != nullptr)
+    {
+        usage += arenaPtr->memoryUsage(numNodes);
+    }
+    else
+    {
+        for (int i = 0; i < numNodes; i++)
+        {
+            addAllocation(usage, sizeof(BinaryTreeNode<T>));
+        }
+    }
+
+    return usage;
 }
 
 template <class T>
 BinaryTree<T>& BinaryTree<T>::operator=(const BinaryTree<T>& other)
 {
-    rootPtr = copyTree(other.rootPtr);
+    if (this != &other)
+    {
+        // clearing first, since clearing a tree with an arena releases all
+        // of the arena's nodes
+        clear();
+        copyAllocation(other);
+        rootPtr = copyTree(other.rootPtr);
+    }
+
     return *this;
 }
 
@@ -208,17 +559,34 @@ bool BinaryTree<T>::empty() const
 template <class T>
 int BinaryTree<T>::treeHeightHelper(BinaryTreeNode<T>* subtreePtr) const
 {
-    if (subtreePtr == nullptr)   
+    // one pass over each level; the height is the number of levels
+    int height = 0;
+    std::vector<BinaryTreeNode<T>*> level;
+    std::vector<BinaryTreeNode<T>*> nextLevel;
+    if (subtreePtr != nullptr)
     {
-        return 0;
+        level.push_back(subtreePtr);
     }
-    else
-    {
-        int leftHeight = treeHeightHelper(subtreePtr->getLeft());
-        int rightHeight = treeHeightHelper(subtreePtr->getRight());
 
-        return 1 + ((leftHeight > rightHeight) ? leftHeight : rightHeight);
+    while (!level.empty())
+    {
+        height++;
+        nextLevel.clear();
+        for (BinaryTreeNode<T>* nodePtr : level)
+        {
+            if (nodePtr->getLeft() != nullptr)
+            {
+                nextLevel.push_back(nodePtr->getLeft());
+            }
+            if (nodePtr->getRight() != nullptr)
+            {
+                nextLevel.push_back(nodePtr->getRight());
+            }
+        }
+        level.swap(nextLevel);
     }
+
+    return height;
 }
 
 template <class T>
@@ -230,15 +598,8 @@ int BinaryTree<T>::getTreeHeight() const
 template <class T>
 int BinaryTree<T>::numNodesHelper(BinaryTreeNode<T>* subtreePtr) const
 {
-    if (subtreePtr == nullptr)   
-    {
-        return 0;
-    }
-    else
-    {
-        return 1 + numNodesHelper(subtreePtr->getLeft()) + 
-            numNodesHelper(subtreePtr->getRight());
-    }
+    TraversalRange<T, TraversalOrder::PREORDER> nodes(subtreePtr);
+    return static_cast<int>(std::distance(nodes.begin(), nodes.end()));
 }
 
 template <class T>
@@ -284,17 +645,31 @@ BinaryTreeNode<T>* BinaryTree<T>::addHelper(BinaryTreeNode<T>* subtreePtr,
         return newNodePtr;
     }
 
-    BinaryTreeNode<T>* leftSubTree = subtreePtr->getLeft();
-    BinaryTreeNode<T>* rightSubTree = subtreePtr->getRight();
-    if (treeHeightHelper(leftSubTree) > treeHeightHelper(rightSubTree))
+    BinaryTreeNode<T>* curPtr = subtreePtr;
+    while (true)
     {
-        rightSubTree = addHelper(rightSubTree, newNodePtr);
-        subtreePtr->setRight(rightSubTree);
-    }
-    else
-    {
-        leftSubTree = addHelper(leftSubTree, newNodePtr);
-        subtreePtr->setLeft(leftSubTree);
+        BinaryTreeNode<T>* leftSubTree = curPtr->getLeft();
+        BinaryTreeNode<T>* rightSubTree = curPtr->getRight();
+        // an empty subtree is the shorter one without measuring the other
+        if (leftSubTree != nullptr && (rightSubTree == nullptr ||
+            treeHeightHelper(leftSubTree) > treeHeightHelper(rightSubTree)))
+        {
+            if (rightSubTree == nullptr)
+            {
+                curPtr->setRight(newNodePtr);
+                break;
+            }
+            curPtr = rightSubTree;
+        }
+        else
+        {
+            if (leftSubTree == nullptr)
+            {
+                curPtr->setLeft(newNodePtr);
+                break;
+            }
+            curPtr = leftSubTree;
+        }
     }
 
     return subtreePtr;
@@ -303,7 +678,7 @@ BinaryTreeNode<T>* BinaryTree<T>::addHelper(BinaryTreeNode<T>* subtreePtr,
 template <class T>
 bool BinaryTree<T>::add(const T& item)
 {
-    BinaryTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(item);
+    BinaryTreeNode<T>* newNodePtr = createNode(item);
     rootPtr = addHelper(rootPtr, newNodePtr);
 
     return rootPtr != nullptr;
@@ -313,29 +688,49 @@ template <class T>
 BinaryTreeNode<T>* BinaryTree<T>::removeHelper(BinaryTreeNode<T>* subtreePtr,
     const T& target, bool& success)
 {
-    if (subtreePtr == nullptr)
+    // pairs of a node and its parent, so that the node can be unlinked
+    std::vector<std::pair<BinaryTreeNode<T>*, BinaryTreeNode<T>*>> pending;
+    if (subtreePtr != nullptr)
     {
-        return nullptr;
+        pending.push_back({ subtreePtr, nullptr });
     }
 
-    if (subtreePtr->getItem() == target)
+    while (!pending.empty())
     {
-        success = true;
-        subtreePtr = shiftItemsUp(subtreePtr);
-        return subtreePtr;
+        BinaryTreeNode<T>* nodePtr = pending.back().first;
+        BinaryTreeNode<T>* parentPtr = pending.back().second;
+        pending.pop_back();
+
+        if (nodePtr->getItem() == target)
+        {
+            success = true;
+            BinaryTreeNode<T>* replacementPtr = shiftItemsUp(nodePtr);
+            if (parentPtr == nullptr)
+            {
+                return replacementPtr;
+            }
+
+            if (parentPtr->getLeft() == nodePtr)
+            {
+                parentPtr->setLeft(replacementPtr);
+            }
+            else
+            {
+                parentPtr->setRight(replacementPtr);
+            }
+            return subtreePtr;
+        }
+
+        if (nodePtr->getRight() != nullptr)
+        {
+            pending.push_back({ nodePtr->getRight(), nodePtr });
+        }
+        if (nodePtr->getLeft() != nullptr)
+        {
+            pending.push_back({ nodePtr->getLeft(), nodePtr });
+        }
     }
 
-    BinaryTreeNode<T>* leftPtr = removeHelper(subtreePtr->getLeft(), 
-                                             target, success);
-    subtreePtr->setLeft(leftPtr);
-    
-    if (!success)
-    {
-        BinaryTreeNode<T>* rightPtr = removeHelper(subtreePtr->getRight(), 
-                                                  target, success);
-        subtreePtr->setRight(rightPtr);
-    }
-    
     return subtreePtr;
 }
 
@@ -348,30 +743,51 @@ BinaryTreeNode<T>* BinaryTree<T>::shiftItemsUp(
         return subtreePtr;
     }
 
-    BinaryTreeNode<T>* leftSubTree = subtreePtr->getLeft();
-    BinaryTreeNode<T>* rightSubTree = subtreePtr->getRight();
+    BinaryTreeNode<T>* parentPtr = nullptr;
+    BinaryTreeNode<T>* curPtr = subtreePtr;
+    while (true)
+    {
+        BinaryTreeNode<T>* leftSubTree = curPtr->getLeft();
+        BinaryTreeNode<T>* rightSubTree = curPtr->getRight();
+
+        if (leftSubTree == nullptr && rightSubTree == nullptr)
+        {
+            break;
+        }
+
+        // an empty subtree is the shorter one without measuring the other
+        parentPtr = curPtr;
+        if (rightSubTree == nullptr || (leftSubTree != nullptr &&
+            treeHeightHelper(leftSubTree) > treeHeightHelper(rightSubTree)))
+        {
+            // move value from left subtree
+            curPtr->setItem(leftSubTree->getItem());
+            curPtr = leftSubTree;
+        }
+        else 
+        {
+            // move value from right subtree
+            curPtr->setItem(rightSubTree->getItem());
+            curPtr = rightSubTree;
+        }
+    }
 
-    if (leftSubTree == nullptr && rightSubTree == nullptr)
+    // curPtr is now the emptied leaf
+    if (parentPtr == nullptr)
     {
-        delete subtreePtr;
-        subtreePtr = nullptr;
-        return subtreePtr;
+        destroyNode(curPtr);
+        return nullptr;
     }
 
-    if (treeHeightHelper(leftSubTree) > treeHeightHelper(rightSubTree))
+    if (parentPtr->getLeft() == curPtr)
     {
-        // move value from left subtree
-        subtreePtr->setItem(leftSubTree->getItem());
-        leftSubTree = shiftItemsUp(leftSubTree);
-        subtreePtr->setLeft(leftSubTree);
+        parentPtr->setLeft(nullptr);
     }
-    else 
+    else
     {
-        // move value from right subtree
-        subtreePtr->setItem(rightSubTree->getItem());
-        rightSubTree = shiftItemsUp(rightSubTree);
-        subtreePtr->setRight(rightSubTree);
+        parentPtr->setRight(nullptr);
     }
+    destroyNode(curPtr);
 
     return subtreePtr;
 }
@@ -389,25 +805,33 @@ template <class T>
 BinaryTreeNode<T>* BinaryTree<T>::findNode(BinaryTreeNode<T>* treePtr,
     const T& target, bool& success) const
 {
-    if (treePtr == nullptr)
+    std::vector<BinaryTreeNode<T>*> pending;
+    if (treePtr != nullptr)
     {
-        return treePtr;
+        pending.push_back(treePtr);
     }
 
-    if (treePtr->getItem() == target)
+    while (!pending.empty())
     {
-        success = true;
-        return treePtr;
+        BinaryTreeNode<T>* nodePtr = pending.back();
+        pending.pop_back();
+        if (nodePtr->getItem() == target)
+        {
+            success = true;
+            return nodePtr;
+        }
+
+        if (nodePtr->getRight() != nullptr)
+        {
+            pending.push_back(nodePtr->getRight());
+        }
+        if (nodePtr->getLeft() != nullptr)
+        {
+            pending.push_back(nodePtr->getLeft());
+        }
     }
 
-    BinaryTreeNode<T>* targetNode = findNode(treePtr->getLeft(), target, 
-                                             success);
-    if (!success)
-    {
-        targetNode = findNode(treePtr->getRight(), target, success);
-    }
-
-    return success ? targetNode : treePtr;
+    return nullptr;
 }
 
 template <class T>
@@ -419,27 +843,158 @@ bool BinaryTree<T>::contains(const T& item) const
     return success;
 }
 
+template <class T>
+template <class Spawn>
+void BinaryTree<T>::destroyTreeHelper(BinaryTreeNode<T>* subtreePtr,
+    Spawn& spawn, int grainSize) const
+{
+    int numDeleted = 0;
+    while (subtreePtr != nullptr)
+    {
+        BinaryTreeNode<T>* leftPtr = subtreePtr->getLeft();
+        if (leftPtr == nullptr)
+        {
+            BinaryTreeNode<T>* rightPtr = subtreePtr->getRight();
+            destroyNode(subtreePtr);
+            subtreePtr = rightPtr;
+            numDeleted++;
+            continue;
+        }
+
+        if (grainSize > 0 && numDeleted >= grainSize &&
+            subtreePtr->getRight() != nullptr)
+        {
+            spawn(subtreePtr->getRight());
+            subtreePtr->setRight(nullptr);
+            numDeleted = 0;
+        }
+
+        // rotate right; each rotation moves one more node onto the right
+        // spine, so there are fewer than n rotations in total
+        subtreePtr->setLeft(leftPtr->getRight());
+        leftPtr->setRight(subtreePtr);
+        subtreePtr = leftPtr;
+    }
+}
+
 template <class T>
 void BinaryTree<T>::destroyTree(BinaryTreeNode<T>* subtreePtr)
 {
-    if (subtreePtr == nullptr)
+    auto noSpawn = [](BinaryTreeNode<T>*) { };
+    destroyTreeHelper(subtreePtr, noSpawn, 0);
+}
+
+template <class T>
+void BinaryTree<T>::destroyTree(BinaryTreeNode<T>* subtreePtr,
+    ThreadPool& pool, int grainSize)
+{
+    if (pool.getNumThreads() == 1 || arenaPtr != nullptr)
     {
+        destroyTree(subtreePtr);
         return;
     }
 
-    destroyTree(subtreePtr->getLeft());
-    destroyTree(subtreePtr->getRight());
-    delete subtreePtr;
-    subtreePtr = nullptr;
+    TaskGroup group(pool);
+    std::function<void(BinaryTreeNode<T>*)> spawn;
+    spawn = [&](BinaryTreeNode<T>* detachedPtr)
+    {
+        group.run([&, detachedPtr]()
+        {
+            destroyTreeHelper(detachedPtr, spawn, grainSize);
+        });
+    };
+
+    destroyTreeHelper(subtreePtr, spawn, grainSize);
+    group.wait();
 }
 
 template <class T>
 void BinaryTree<T>::clear()
 {
-    destroyTree(rootPtr);
+    if (arenaPtr == nullptr)
+    {
+        destroyTree(rootPtr);
+    }
+    else
+    {
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            destroyTree(rootPtr);
+        }
+        arenaPtr->release();
+    }
+
+    rootPtr = nullptr;
+}
+
+template <class T>
+void BinaryTree<T>::parallelClear(ThreadPool& pool, int grainSize)
+{
+    if (arenaPtr != nullptr)
+    {
+        clear();
+        return;
+    }
+
+    destroyTree(rootPtr, pool, grainSize);
     rootPtr = nullptr;
 }
 
+template <class T>
+template <class Spawn>
+void BinaryTree<T>::copyTreeHelper(CopyStep first, Spawn& spawn,
+    int grainSize) const
+{
+    // pending[0, firstPending) have been handed to spawn already
+    std::vector<CopyStep> pending;
+    std::size_t firstPending = 0;
+    int numCopied = 0;
+
+    pending.push_back(first);
+    while (pending.size() > firstPending)
+    {
+        CopyStep step = pending.back();
+        pending.pop_back();
+
+        // copy down a path, deferring only the right children of nodes
+        // with two children
+        const BinaryTreeNode<T>* sourcePtr = step.sourcePtr;
+        BinaryTreeNode<T>* parentPtr = step.parentPtr;
+        bool isLeft = step.isLeft;
+        while (sourcePtr != nullptr)
+        {
+            BinaryTreeNode<T>* copyPtr = createNode(sourcePtr->getItem());
+            if (isLeft)
+            {
+                parentPtr->setLeft(copyPtr);
+            }
+            else
+            {
+                parentPtr->setRight(copyPtr);
+            }
+
+            const BinaryTreeNode<T>* leftPtr = sourcePtr->getLeft();
+            const BinaryTreeNode<T>* rightPtr = sourcePtr->getRight();
+            if (leftPtr != nullptr && rightPtr != nullptr)
+            {
+                pending.push_back({ rightPtr, copyPtr, false });
+            }
+
+            parentPtr = copyPtr;
+            isLeft = (leftPtr != nullptr);
+            sourcePtr = (leftPtr != nullptr) ? leftPtr : rightPtr;
+
+            if (grainSize > 0 && ++numCopied >= grainSize &&
+                pending.size() > firstPending)
+            {
+                spawn(pending[firstPending]);
+                firstPending++;
+                numCopied = 0;
+            }
+        }
+    }
+}
+
 template <class T>
 BinaryTreeNode<T>* BinaryTree<T>::copyTree(const BinaryTreeNode<T>* treePtr) 
     const
@@ -449,59 +1004,121 @@ BinaryTreeNode<T>* BinaryTree<T>::copyTree(const BinaryTreeNode<T>* treePtr)
         return nullptr;
     }
 
-    BinaryTreeNode<T>* newNodePtr = new BinaryTreeNode<T>(treePtr->getItem());
-    newNodePtr->setLeft(copyTree(treePtr->getLeft()));
-    newNodePtr->setRight(copyTree(treePtr->getRight()));
+    auto noSpawn = [](const CopyStep&) { };
+    // the partial copy is always a well-formed tree, so it can be deleted
+    // if copying an item throws
+    BinaryTreeNode<T>* rootCopyPtr = createNode(treePtr->getItem());
+    try
+    {
+        copyTreeHelper({ treePtr->getLeft(), rootCopyPtr, true }, noSpawn, 0);
+        copyTreeHelper({ treePtr->getRight(), rootCopyPtr, false }, noSpawn, 
+                       0);
+    }
+    catch (...)
+    {
+        auto noDestroySpawn = [](BinaryTreeNode<T>*) { };
+        destroyTreeHelper(rootCopyPtr, noDestroySpawn, 0);
+        throw;
+    }
 
-    return newNodePtr;
+    return rootCopyPtr;
 }
 
 template <class T>
-void BinaryTree<T>::preorderHelper(TraversalFunction<T>* func, 
-    BinaryTreeNode<T>* treePtr) const
+BinaryTreeNode<T>* BinaryTree<T>::copyTree(const BinaryTreeNode<T>* treePtr,
+    ThreadPool& pool, int grainSize) const
 {
-    if (treePtr == nullptr)
+    if (treePtr == nullptr || pool.getNumThreads() == 1 || 
+        arenaPtr != nullptr)
     {
-        return;
+        return copyTree(treePtr);
     }
 
-    T item(treePtr->getItem());
+    BinaryTreeNode<T>* rootCopyPtr = createNode(treePtr->getItem());
+    TaskGroup group(pool);
+    std::function<void(const CopyStep&)> spawn;
+    spawn = [&](const CopyStep& step)
+    {
+        group.run([&, step]()
+        {
+            copyTreeHelper(step, spawn, grainSize);
+        });
+    };
+
+    try
+    {
+        if (treePtr->getRight() != nullptr)
+        {
+            spawn({ treePtr->getRight(), rootCopyPtr, false });
+        }
+        copyTreeHelper({ treePtr->getLeft(), rootCopyPtr, true }, spawn,
+                       grainSize);
+        group.wait();
+    }
+    catch (...)
+    {
+        // wait for the other tasks before deleting what they attached to
+        try
+        {
+            group.wait();
+        }
+        catch (...)
+        {
+
+        }
+        auto noDestroySpawn = [](BinaryTreeNode<T>*) { };
+        destroyTreeHelper(rootCopyPtr, noDestroySpawn, 0);
+        throw;
+    }
 
-    func->visit(item);
-    preorderHelper(func, treePtr->getLeft());
-    preorderHelper(func, treePtr->getRight());
+    return rootCopyPtr;
 }
 
 template <class T>
-void BinaryTree<T>::inorderHelper(TraversalFunction<T>* func, 
-    BinaryTreeNode<T>* treePtr) const
+void BinaryTree<T>::parallelCopyFrom(const BinaryTree<T>& other,
+    ThreadPool& pool, int grainSize)
 {
-    if (treePtr == nullptr)
+    if (this != &other)
     {
-        return;
+        parallelClear(pool, grainSize);
+        rootPtr = copyTree(other.rootPtr, pool, grainSize);
     }
+}
 
-    T item(treePtr->getItem());
+template <class T>
+void BinaryTree<T>::preorderHelper(TraversalFunction<T>* func, 
+    BinaryTreeNode<T>* treePtr) const
+{
+    for (const T& treeItem : TraversalRange<T, TraversalOrder::PREORDER>(
+             treePtr))
+    {
+        T item(treeItem);
+        func->visit(item);
+    }
+}
 
-    inorderHelper(func, treePtr->getLeft());
-    func->visit(item);
-    inorderHelper(func, treePtr->getRight());    
+template <class T>
+void BinaryTree<T>::inorderHelper(TraversalFunction<T>* func, 
+    BinaryTreeNode<T>* treePtr) const
+{
+    for (const T& treeItem : TraversalRange<T, TraversalOrder::INORDER>(
+             treePtr))
+    {
+        T item(treeItem);
+        func->visit(item);
+    }
 }
 
 template <class T>
 void BinaryTree<T>::postorderHelper(TraversalFunction<T>* func, 
     BinaryTreeNode<T>* treePtr) const
 {
-    if (treePtr == nullptr)
+    for (const T& treeItem : TraversalRange<T, TraversalOrder::POSTORDER>(
+             treePtr))
     {
-        return;
+        T item(treeItem);
+        func->visit(item);
     }
-    
-    T item(treePtr->getItem());
-
-    postorderHelper(func, treePtr->getLeft());
-    postorderHelper(func, treePtr->getRight());
-    func->visit(item);
 }
 
 template <class T>
@@ -522,4 +1139,260 @@ void BinaryTree<T>::postorderTraverse(TraversalFunction<T>* func) const
     postorderHelper(func, rootPtr);
 }
 
+template <class T>
+template <class Function>
+void BinaryTree<T>::preorderForEach(Function visit) const
+{
+    for (const T& item : preorder())
+    {
+        visit(item);
+    }
+}
+
+template <class T>
+template <class Function>
+void BinaryTree<T>::inorderForEach(Function visit) const
+{
+    for (const T& item : inorder())
+    {
+        visit(item);
+    }
+}
+
+template <class T>
+template <class Function>
+void BinaryTree<T>::postorderForEach(Function visit) const
+{
+    for (const T& item : postorder())
+    {
+        visit(item);
+    }
+}
+
+template <class T>
+template <class Function>
+void BinaryTree<T>::parallelVisitHelper(BinaryTreeNode<T>* subtreePtr,
+    Function& visit, const std::function<void(BinaryTreeNode<T>*)>& spawn,
+    int grainSize)
+{
+    // pending[0, firstPending) have been handed to spawn already
+    std::vector<BinaryTreeNode<T>*> pending;
+    std::size_t firstPending = 0;
+    int numVisited = 0;
+
+    pending.push_back(subtreePtr);
+    while (pending.size() > firstPending)
+    {
+        BinaryTreeNode<T>* nodePtr = pending.back();
+        pending.pop_back();
+        visit(static_cast<const T&>(nodePtr->getItem()));
+
+        if (nodePtr->getRight() != nullptr)
+        {
+            pending.push_back(nodePtr->getRight());
+        }
+        if (nodePtr->getLeft() != nullptr)
+        {
+            pending.push_back(nodePtr->getLeft());
+        }
+
+        if (++numVisited >= grainSize && pending.size() - firstPending > 1)
+        {
+            spawn(pending[firstPending]);
+            firstPending++;
+            numVisited = 0;
+        }
+    }
+}
+
+template <class T>
+template <class Function>
+void BinaryTree<T>::parallelForEach(Function visit, ThreadPool& pool,
+    int grainSize) const
+{
+    if (pool.getNumThreads() == 1)
+    {
+        preorderForEach(visit);
+        return;
+    }
+
+    if (rootPtr == nullptr)
+    {
+        return;
+    }
+
+    TaskGroup group(pool);
+    std::function<void(BinaryTreeNode<T>*)> spawn;
+    spawn = [&](BinaryTreeNode<T>* subtreePtr)
+    {
+        group.run([&, subtreePtr]()
+        {
+            parallelVisitHelper(subtreePtr, visit, spawn, grainSize);
+        });
+    };
+
+    parallelVisitHelper(rootPtr, visit, spawn, grainSize);
+    group.wait();
+}
+
+template <class T>
+template <class R, class Map, class Combine>
+R BinaryTree<T>::parallelReduce(R identity, Map map, Combine combine,
+    ThreadPool& pool, int grainSize) const
+{
+    if (pool.getNumThreads() == 1)
+    {
+        R result = identity;
+        preorderForEach([&](const T& item)
+        {
+            result = combine(std::move(result), map(item));
+        });
+        return result;
+    }
+
+    if (rootPtr == nullptr)
+    {
+        return identity;
+    }
+
+    std::mutex resultsLock;
+    std::vector<R> results;
+    TaskGroup group(pool);
+    std::function<void(BinaryTreeNode<T>*)> spawn;
+
+    auto reduceSubtree = [&](BinaryTreeNode<T>* subtreePtr)
+    {
+        R partial = identity;
+        auto accumulate = [&](const T& item)
+        {
+            partial = combine(std::move(partial), map(item));
+        };
+        parallelVisitHelper(subtreePtr, accumulate, spawn, grainSize);
+
+        std::lock_guard<std::mutex> guard(resultsLock);
+        results.push_back(std::move(partial));
+    };
+
+    spawn = [&](BinaryTreeNode<T>* subtreePtr)
+    {
+        group.run([&reduceSubtree, subtreePtr]()
+        {
+            reduceSubtree(subtreePtr);
+        });
+    };
+
+    reduceSubtree(rootPtr);
+    group.wait();
+
+    R result = identity;
+    for (R& partial : results)
+    {
+        result = combine(std::move(result), std::move(partial));
+    }
+
+    return result;
+}
+
+template <class T>
+template <class Function>
+void BinaryTree<T>::morrisInorderTraverse(Function visit) const
+{
+    // once visit throws, the traversal carries on without visiting so that
+    // every thread is removed, and the exception is rethrown at the end
+    std::exception_ptr error;
+    BinaryTreeNode<T>* curPtr = rootPtr;
+    while (curPtr != nullptr)
+    {
+        if (curPtr->getLeft() == nullptr)
+        {
+            if (!error)
+            {
+                try
+                {
+                    visit(static_cast<const T&>(curPtr->getItem()));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+            }
+            curPtr = curPtr->getRight();
+            continue;
+        }
+
+        BinaryTreeNode<T>* predecessorPtr = curPtr->getLeft();
+        while (predecessorPtr->getRight() != nullptr &&
+               predecessorPtr->getRight() != curPtr)
+        {
+            predecessorPtr = predecessorPtr->getRight();
+        }
+
+        if (predecessorPtr->getRight() == nullptr)
+        {
+            // first time here: thread the predecessor back to us, go left
+            predecessorPtr->setRight(curPtr);
+            curPtr = curPtr->getLeft();
+        }
+        else
+        {
+            // back through the thread: the left subtree is done
+            predecessorPtr->setRight(nullptr);
+            if (!error)
+            {
+                try
+                {
+                    visit(static_cast<const T&>(curPtr->getItem()));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+            }
+            curPtr = curPtr->getRight();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+template <class T>
+typename BinaryTree<T>::const_iterator BinaryTree<T>::begin() const
+{
+    return const_iterator(rootPtr);
+}
+
+template <class T>
+typename BinaryTree<T>::const_iterator BinaryTree<T>::end() const
+{
+    return const_iterator();
+}
+
+template <class T>
+TraversalRange<T, TraversalOrder::PREORDER> BinaryTree<T>::preorder() const
+{
+    return TraversalRange<T, TraversalOrder::PREORDER>(rootPtr);
+}
+
+template <class T>
+TraversalRange<T, TraversalOrder::INORDER> BinaryTree<T>::inorder() const
+{
+    return TraversalRange<T, TraversalOrder::INORDER>(rootPtr);
+}
+
+template <class T>
+TraversalRange<T, TraversalOrder::POSTORDER> BinaryTree<T>::postorder() const
+{
+    return TraversalRange<T, TraversalOrder::POSTORDER>(rootPtr);
+}
+
+template <class T>
+TraversalRange<T, TraversalOrder::LEVELORDER> BinaryTree<T>::levelorder() 
+    const
+{
+    return TraversalRange<T, TraversalOrder::LEVELORDER>(rootPtr);
+}
+
 #endif
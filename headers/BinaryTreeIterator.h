@@ -0,0 +1,285 @@
+/**
+ * @class BinaryTreeIterator
+ * @brief A forward iterator over the items of a @c BinaryTree in preorder,
+ * inorder, postorder or level order.
+ *
+ * Traversal state is kept in an explicit stack (or, for level order, a
+ * queue) of nodes rather than on the call stack, so iterating over a deep or
+ * degenerate tree cannot overflow the stack, and no virtual function is
+ * called per item. For preorder, inorder and postorder the stack holds
+ * O(height) nodes; for level order the queue holds O(width) nodes.
+ *
+ * Items are yielded as const references, since modifying an item could break
+ * the ordering of a search tree. Modifying the tree invalidates all of its
+ * iterators.
+ */
+
+#ifndef BINARY_TREE_ITERATOR_H
+#define BINARY_TREE_ITERATOR_H
+
+#include "BinaryTreeNode.h"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+enum class TraversalOrder
+{
+    PREORDER,
+    INORDER,
+    POSTORDER,
+    LEVELORDER
+};
+
+template <class T, TraversalOrder ORDER>
+class BinaryTreeIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+private:
+    // level order visits nodes first-in first-out, the others last-in
+    // first-out
+    typedef typename std::conditional<ORDER == TraversalOrder::LEVELORDER,
+            std::deque<BinaryTreeNode<T>*>,
+            std::vector<BinaryTreeNode<T>*>>::type Worklist;
+
+    Worklist pending; ///< the current node is at the front/back
+
+    /**
+     * Pushes @c nodePtr and its chain of left descendants.
+     */
+    void pushLeftSpine(BinaryTreeNode<T>* nodePtr);
+
+    /**
+     * Pushes the path from @c nodePtr to the first node to visit in its
+     * subtree in postorder: always go left when possible, otherwise right.
+     */
+    void pushFirstPostorder(BinaryTreeNode<T>* nodePtr);
+
+    BinaryTreeNode<T>* current() const;
+
+public:
+    /**
+     * Constructs the end iterator.
+     */
+    BinaryTreeIterator();
+
+    /**
+     * Constructs an iterator positioned at the first item of the tree rooted
+     * at @c rootPtr.
+     */
+    explicit BinaryTreeIterator(BinaryTreeNode<T>* rootPtr);
+
+    reference operator*() const;
+
+    pointer operator->() const;
+
+    BinaryTreeIterator<T, ORDER>& operator++();
+
+    BinaryTreeIterator<T, ORDER> operator++(int);
+
+    bool operator==(const BinaryTreeIterator<T, ORDER>& other) const;
+
+    bool operator!=(const BinaryTreeIterator<T, ORDER>& other) const;
+};
+
+/**
+ * A pair of iterators, so that a particular traversal order can be used with
+ * a range-based for loop, e.g. <tt>for (int x : tree.preorder())</tt>.
+ */
+template <class T, TraversalOrder ORDER>
+class TraversalRange
+{
+private:
+    BinaryTreeNode<T>* rootPtr;
+
+public:
+    explicit TraversalRange(BinaryTreeNode<T>* rootPtr) : rootPtr(rootPtr)
+    {
+
+    }
+
+    BinaryTreeIterator<T, ORDER> begin() const
+    {
+        return BinaryTreeIterator<T, ORDER>(rootPtr);
+    }
+
+    BinaryTreeIterator<T, ORDER> end() const
+    {
+        return BinaryTreeIterator<T, ORDER>();
+    }
+};
+
+template <class T, TraversalOrder ORDER>
+BinaryTreeIterator<T, ORDER>::BinaryTreeIterator()
+{
+
+}
+
+template <class T, TraversalOrder ORDER>
+BinaryTreeIterator<T, ORDER>::BinaryTreeIterator(BinaryTreeNode<T>* rootPtr)
+{
+    if (rootPtr == nullptr)
+    {
+        return;
+    }
+
+    if (ORDER == TraversalOrder::INORDER)
+    {
+        pushLeftSpine(rootPtr);
+    }
+    else if (ORDER == TraversalOrder::POSTORDER)
+    {
+        pushFirstPostorder(rootPtr);
+    }
+    else
+    {
+        pending.push_back(rootPtr);
+    }
+}
+
+template <class T, TraversalOrder ORDER>
+void BinaryTreeIterator<T, ORDER>::pushLeftSpine(BinaryTreeNode<T>* nodePtr)
+{
+    while (nodePtr != nullptr)
+    {
+        pending.push_back(nodePtr);
+        nodePtr = nodePtr->getLeft();
+    }
+}
+
+template <class T, TraversalOrder ORDER>
+void BinaryTreeIterator<T, ORDER>::pushFirstPostorder(
+        BinaryTreeNode<T>* nodePtr)
+{
+    while (nodePtr != nullptr)
+    {
+        pending.push_back(nodePtr);
+        if (nodePtr->getLeft() != nullptr)
+        {
+            nodePtr = nodePtr->getLeft();
+        }
+        else
+        {
+            nodePtr = nodePtr->getRight();
+        }
+    }
+}
+
+template <class T, TraversalOrder ORDER>
+BinaryTreeNode<T>* BinaryTreeIterator<T, ORDER>::current() const
+{
+    if (pending.empty())
+    {
+        return nullptr;
+    }
+
+    if constexpr (ORDER == TraversalOrder::LEVELORDER)
+    {
+        return pending.front();
+    }
+    else
+    {
+        return pending.back();
+    }
+}
+
+template <class T, TraversalOrder ORDER>
+typename BinaryTreeIterator<T, ORDER>::reference
+BinaryTreeIterator<T, ORDER>::operator*() const
+{
+    const BinaryTreeNode<T>* nodePtr = current();
+    return nodePtr->getItem();
+}
+
+template <class T, TraversalOrder ORDER>
+typename BinaryTreeIterator<T, ORDER>::pointer
+BinaryTreeIterator<T, ORDER>::operator->() const
+{
+    const BinaryTreeNode<T>* nodePtr = current();
+    return &nodePtr->getItem();
+}
+
+template <class T, TraversalOrder ORDER>
+BinaryTreeIterator<T, ORDER>& BinaryTreeIterator<T, ORDER>::operator++()
+{
+    if constexpr (ORDER == TraversalOrder::PREORDER)
+    {
+        BinaryTreeNode<T>* nodePtr = pending.back();
+        pending.pop_back();
+        if (nodePtr->getRight() != nullptr)
+        {
+            pending.push_back(nodePtr->getRight());
+        }
+        if (nodePtr->getLeft() != nullptr)
+        {
+            pending.push_back(nodePtr->getLeft());
+        }
+    }
+    else if constexpr (ORDER == TraversalOrder::INORDER)
+    {
+        BinaryTreeNode<T>* nodePtr = pending.back();
+        pending.pop_back();
+        pushLeftSpine(nodePtr->getRight());
+    }
+    else if constexpr (ORDER == TraversalOrder::POSTORDER)
+    {
+        BinaryTreeNode<T>* nodePtr = pending.back();
+        pending.pop_back();
+        if (!pending.empty())
+        {
+            // after a left child, its parent's right subtree is next
+            BinaryTreeNode<T>* parentPtr = pending.back();
+            if (parentPtr->getLeft() == nodePtr)
+            {
+                pushFirstPostorder(parentPtr->getRight());
+            }
+        }
+    }
+    else
+    {
+        BinaryTreeNode<T>* nodePtr = pending.front();
+        pending.pop_front();
+        if (nodePtr->getLeft() != nullptr)
+        {
+            pending.push_back(nodePtr->getLeft());
+        }
+        if (nodePtr->getRight() != nullptr)
+        {
+            pending.push_back(nodePtr->getRight());
+        }
+    }
+
+    return *this;
+}
+
+template <class T, TraversalOrder ORDER>
+BinaryTreeIterator<T, ORDER> BinaryTreeIterator<T, ORDER>::operator++(int)
+{
+    BinaryTreeIterator<T, ORDER> old(*this);
+    ++(*this);
+    return old;
+}
+
+template <class T, TraversalOrder ORDER>
+bool BinaryTreeIterator<T, ORDER>::operator==(
+        const BinaryTreeIterator<T, ORDER>& other) const
+{
+    return current() == other.current() &&
+           pending.size() == other.pending.size();
+}
+
+template <class T, TraversalOrder ORDER>
+bool BinaryTreeIterator<T, ORDER>::operator!=(
+        const BinaryTreeIterator<T, ORDER>& other) const
+{
+    return !(*this == other);
+}
+
+#endif
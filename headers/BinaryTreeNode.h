@@ -1,6 +1,8 @@
 #ifndef BINARY_TREE_NODE_H
 #define BINARY_TREE_NODE_H
 
+#include <utility>
+
 template <class T>
 class BinaryTreeNode
 {
@@ -10,15 +12,23 @@ private:
    BinaryTreeNode<T>* rightPtr;
 
 public:
-   BinaryTreeNode(const T item);
+   BinaryTreeNode(const T& item);
+
+   BinaryTreeNode(T&& item);
 
-   BinaryTreeNode(const T item, BinaryTreeNode<T>* leftPtr, 
+   BinaryTreeNode(const T& item, BinaryTreeNode<T>* leftPtr, 
       BinaryTreeNode<T>* rightPtr);
 
    virtual ~BinaryTreeNode();
 
    virtual const T& getItem() const;
 
+   /**
+    * Mutable access to the item. Callers must not change the item in a way
+    * that changes its position in an ordered tree.
+    */
+   virtual T& getItem();
+
    virtual void setItem(const T& newItem);
 
    virtual BinaryTreeNode<T>* getLeft() const;
@@ -31,14 +41,21 @@ public:
 };
 
 template <class T>
-BinaryTreeNode<T>::BinaryTreeNode(const T item)
+BinaryTreeNode<T>::BinaryTreeNode(const T& item)
    : item(item), leftPtr(nullptr), rightPtr(nullptr)
 {
 
 }
 
 template <class T>
-	BinaryTreeNode<T>::BinaryTreeNode(const T item, 
+BinaryTreeNode<T>::BinaryTreeNode(T&& item)
+   : item(std::move(item)), leftPtr(nullptr), rightPtr(nullptr)
+{
+
+}
+
+template <class T>
+	BinaryTreeNode<T>::BinaryTreeNode(const T& item, 
       BinaryTreeNode<T>* leftPtr, 
       BinaryTreeNode<T>* rightPtr)
    : item(item), leftPtr(leftPtr), rightPtr(rightPtr)
@@ -58,6 +75,12 @@ const T& BinaryTreeNode<T>::getItem() const
    return item;
 }
 
+template <class T>
+T& BinaryTreeNode<T>::getItem()
+{
+   return item;
+}
+
 template <class T>
 void BinaryTreeNode<T>::setItem(const T& newItem)
 {
@@ -0,0 +1,940 @@
+/**
+ * @class CompactBinarySearchTree
+ * @brief A binary search tree with the same interface as
+ * @c BinarySearchTree, stored compactly in a single array.
+ *
+ * Nodes live contiguously in a @c std::vector and refer to their children by
+ * 32-bit index rather than by pointer, and there are no virtual functions, so
+ * a node is just its item plus 8 bytes: 12 bytes for an @c int, against 32
+ * for a @c BinaryTreeNode<int>. Removing an item moves the last node of the
+ * array into the freed slot, so the array never has holes.
+ *
+ * The tree is kept balanced as an AVL tree. The balance of each node (which
+ * of its subtrees, if either, is taller) is packed into the top bit of each
+ * of its two child links, which leaves room for 2^31 - 1 nodes. Insertion
+ * and removal are iterative.
+ *
+ * Because nodes move, pointers to items returned by @c findItem and
+ * @c findOrInsert are invalidated by any @c add, @c remove or
+ * @c findOrInsert, as with pointers into a @c std::vector.
+ */
+
+#ifndef COMPACT_BINARY_SEARCH_TREE_H
+#define COMPACT_BINARY_SEARCH_TREE_H
+
+#include "BinaryTree.h"
+#include "Prefetch.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <class T>
+class CompactBinarySearchTree
+{
+private:
+    typedef std::uint32_t Index;
+
+    static constexpr Index INDEX_MASK = 0x7FFFFFFF;
+    static constexpr Index TALLER_BIT = 0x80000000;
+    /** The index of a missing child. */
+    static constexpr Index NIL = INDEX_MASK;
+    /** An upper bound on the height of an AVL tree of 2^31 nodes. */
+    static const int MAX_HEIGHT = 64;
+
+    struct Node
+    {
+        T item;
+        Index leftLink; ///< top bit set if the left subtree is taller
+        Index rightLink; ///< top bit set if the right subtree is taller
+
+        Node(const T& item) : item(item), leftLink(NIL), rightLink(NIL)
+        {
+
+        }
+
+        Node(T&& item) : item(std::move(item)), leftLink(NIL), rightLink(NIL)
+        {
+
+        }
+    };
+
+    /**
+     * One step of a search path: the node passed through, and which child
+     * the search continued to.
+     */
+    struct PathStep
+    {
+        Index nodeIndex;
+        bool wentLeft;
+    };
+
+    std::vector<Node> nodes;
+    Index rootIndex;
+
+    Index getLeft(Index nodeIndex) const;
+    Index getRight(Index nodeIndex) const;
+    void setLeft(Index nodeIndex, Index childIndex);
+    void setRight(Index nodeIndex, Index childIndex);
+
+    /**
+     * @return The height of the node's right subtree minus that of its left
+     *         subtree: -1, 0 or 1.
+     */
+    int getBalance(Index nodeIndex) const;
+    void setBalance(Index nodeIndex, int balance);
+
+    /**
+     * Points the link that led to @c path[depth] (or the root, if @c depth
+     * is 0) at @c childIndex.
+     */
+    void replaceChild(const PathStep* path, int depth, Index childIndex);
+
+    /**
+     * Rotations which rebalance a node whose left (right) subtree has become
+     * two levels taller than its right (left) subtree.
+     * @param nodeIndex The unbalanced node.
+     * @param heightReduced Set to true if the rebalanced subtree is one level
+     *                      shorter than the unbalanced one was.
+     * @return The new root of the subtree.
+     */
+    Index fixLeftHeavy(Index nodeIndex, bool& heightReduced);
+    Index fixRightHeavy(Index nodeIndex, bool& heightReduced);
+
+    /**
+     * Updates balances and rotates after a node was linked in below
+     * @c path[depth - 1].
+     */
+    void rebalanceAfterInsert(PathStep* path, int depth);
+
+    /**
+     * Updates balances and rotates after a node was unlinked from below
+     * @c path[depth - 1].
+     */
+    void rebalanceAfterRemove(PathStep* path, int depth);
+
+    /**
+     * Fills the slot of an unlinked node by moving the last node of the
+     * array into it, and shrinks the array.
+     */
+    void releaseSlot(Index freeIndex);
+
+    template <class Key>
+    Index findIndex(const Key& key) const;
+
+public:
+    /**
+     * A forward iterator over the items in order.
+     */
+    class const_iterator
+    {
+    private:
+        const CompactBinarySearchTree<T>* treePtr;
+        std::vector<Index> pending; ///< the current node is at the back
+
+        void pushLeftSpine(Index nodeIndex)
+        {
+            while (nodeIndex != NIL)
+            {
+                pending.push_back(nodeIndex);
+                nodeIndex = treePtr->getLeft(nodeIndex);
+            }
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator() : treePtr(nullptr)
+        {
+
+        }
+
+        explicit const_iterator(const CompactBinarySearchTree<T>* treePtr)
+            : treePtr(treePtr)
+        {
+            pushLeftSpine(treePtr->rootIndex);
+        }
+
+        reference operator*() const
+        {
+            return treePtr->nodes[pending.back()].item;
+        }
+
+        pointer operator->() const
+        {
+            return &treePtr->nodes[pending.back()].item;
+        }
+
+        const_iterator& operator++()
+        {
+            Index nodeIndex = pending.back();
+            pending.pop_back();
+            pushLeftSpine(treePtr->getRight(nodeIndex));
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+            if (pending.empty() || other.pending.empty())
+            {
+                return pending.empty() && other.pending.empty();
+            }
+
+            return pending.back() == other.pending.back() &&
+                   pending.size() == other.pending.size();
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    typedef const_iterator iterator;
+
+    CompactBinarySearchTree();
+    CompactBinarySearchTree(const T& rootItem);
+
+    bool empty() const;
+
+    /**
+     * Computed in O(log n), by following the taller child from the root.
+     */
+    int getTreeHeight() const;
+
+    int getNumNodes() const;
+
+    /**
+     * Preallocates room for @c numNodes nodes, so that building a tree of a
+     * known size neither reallocates nor leaves unused capacity.
+     */
+    void reserve(int numNodes);
+
+    /**
+     * Adds an item to the tree. Duplicate items are not added.
+     * @return true if the item was added, false otherwise.
+     * @throws runtime_error if the tree already holds 2^31 - 1 items.
+     */
+    bool add(const T& item);
+
+    /**
+     * Removes the item which compares equal to @c target, if it exists.
+     * @return true if an item was removed, false otherwise.
+     */
+    bool remove(const T& target);
+
+    bool contains(const T& item) const;
+
+    /**
+     * @return A const reference to the item in the tree which compares equal
+     *         to @c item.
+     * @throws runtime_error if the item does not exist in the tree.
+     */
+    const T& getItem(const T& item) const;
+
+    /**
+     * See @c BinarySearchTree::findItem.
+     */
+    template <class Key>
+    T* findItem(const Key& key);
+
+    template <class Key>
+    const T* findItem(const Key& key) const;
+
+    /**
+     * See @c BinarySearchTree::findOrInsert.
+     */
+    template <class Key, class ItemFactory>
+    T* findOrInsert(const Key& key, ItemFactory makeItem, bool& inserted);
+
+    /**
+     * See @c BinarySearchTree::findItems.
+     */
+    template <class Key>
+    void findItems(const Key* keys, int count, const T** results) const;
+
+    /**
+     * Removes every item, and releases the array.
+     */
+    void clear();
+
+    // Traversal operations
+    void preorderTraverse(TraversalFunction<T>* func) const;
+    void inorderTraverse(TraversalFunction<T>* func) const;
+    void postorderTraverse(TraversalFunction<T>* func) const;
+
+    template <class Function>
+    void preorderForEach(Function visit) const;
+    template <class Function>
+    void inorderForEach(Function visit) const;
+    template <class Function>
+    void postorderForEach(Function visit) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+template <class T>
+CompactBinarySearchTree<T>::CompactBinarySearchTree() : rootIndex(NIL)
+{
+
+}
+
+template <class T>
+CompactBinarySearchTree<T>::CompactBinarySearchTree(const T& rootItem)
+    : rootIndex(NIL)
+{
+    add(rootItem);
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::Index CompactBinarySearchTree<T>::getLeft(
+        Index nodeIndex) const
+{
+    return nodes[nodeIndex].leftLink & INDEX_MASK;
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::Index
+CompactBinarySearchTree<T>::getRight(Index nodeIndex) const
+{
+    return nodes[nodeIndex].rightLink & INDEX_MASK;
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::setLeft(Index nodeIndex, Index childIndex)
+{
+    Index& link = nodes[nodeIndex].leftLink;
+    link = (link & TALLER_BIT) | childIndex;
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::setRight(Index nodeIndex, Index childIndex)
+{
+    Index& link = nodes[nodeIndex].rightLink;
+    link = (link & TALLER_BIT) | childIndex;
+}
+
+template <class T>
+int CompactBinarySearchTree<T>::getBalance(Index nodeIndex) const
+{
+    const Node& node = nodes[nodeIndex];
+    if (node.leftLink & TALLER_BIT)
+    {
+        return -1;
+    }
+
+    return (node.rightLink & TALLER_BIT) ? 1 : 0;
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::setBalance(Index nodeIndex, int balance)
+{
+    Node& node = nodes[nodeIndex];
+    node.leftLink = (node.leftLink & INDEX_MASK) |
+                    ((balance < 0) ? TALLER_BIT : 0);
+    node.rightLink = (node.rightLink & INDEX_MASK) |
+                     ((balance > 0) ? TALLER_BIT : 0);
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::replaceChild(const PathStep* path, int depth,
+        Index childIndex)
+{
+    if (depth == 0)
+    {
+        rootIndex = childIndex;
+    }
+    else if (path[depth - 1].wentLeft)
+    {
+        setLeft(path[depth - 1].nodeIndex, childIndex);
+    }
+    else
+    {
+        setRight(path[depth - 1].nodeIndex, childIndex);
+    }
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::Index
+CompactBinarySearchTree<T>::fixLeftHeavy(Index nodeIndex, bool& heightReduced)
+{
+    Index childIndex = getLeft(nodeIndex);
+    int childBalance = getBalance(childIndex);
+    if (childBalance <= 0)
+    {
+        // single rotation to the right
+        setLeft(nodeIndex, getRight(childIndex));
+        setRight(childIndex, nodeIndex);
+        if (childBalance == 0)
+        {
+            // only possible after a removal
+            setBalance(nodeIndex, -1);
+            setBalance(childIndex, 1);
+            heightReduced = false;
+        }
+        else
+        {
+            setBalance(nodeIndex, 0);
+            setBalance(childIndex, 0);
+            heightReduced = true;
+        }
+        return childIndex;
+    }
+
+    // double rotation: the child's right child becomes the root
+    Index grandchildIndex = getRight(childIndex);
+    int grandchildBalance = getBalance(grandchildIndex);
+    setRight(childIndex, getLeft(grandchildIndex));
+    setLeft(grandchildIndex, childIndex);
+    setLeft(nodeIndex, getRight(grandchildIndex));
+    setRight(grandchildIndex, nodeIndex);
+
+    setBalance(nodeIndex, (grandchildBalance < 0) ? 1 : 0);
+    setBalance(childIndex, (grandchildBalance > 0) ? -1 : 0);
+    setBalance(grandchildIndex, 0);
+    heightReduced = true;
+    return grandchildIndex;
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::Index
+CompactBinarySearchTree<T>::fixRightHeavy(Index nodeIndex, bool& heightReduced)
+{
+    Index childIndex = getRight(nodeIndex);
+    int childBalance = getBalance(childIndex);
+    if (childBalance >= 0)
+    {
+        // single rotation to the left
+        setRight(nodeIndex, getLeft(childIndex));
+        setLeft(childIndex, nodeIndex);
+        if (childBalance == 0)
+        {
+            // only possible after a removal
+            setBalance(nodeIndex, 1);
+            setBalance(childIndex, -1);
+            heightReduced = false;
+        }
+        else
+        {
+            setBalance(nodeIndex, 0);
+            setBalance(childIndex, 0);
+            heightReduced = true;
+        }
+        return childIndex;
+    }
+
+    // double rotation: the child's left child becomes the root
+    Index grandchildIndex = getLeft(childIndex);
+    int grandchildBalance = getBalance(grandchildIndex);
+    setLeft(childIndex, getRight(grandchildIndex));
+    setRight(grandchildIndex, childIndex);
+    setRight(nodeIndex, getLeft(grandchildIndex));
+    setLeft(grandchildIndex, nodeIndex);
+
+    setBalance(nodeIndex, (grandchildBalance > 0) ? -1 : 0);
+    setBalance(childIndex, (grandchildBalance < 0) ? 1 : 0);
+    setBalance(grandchildIndex, 0);
+    heightReduced = true;
+    return grandchildIndex;
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::rebalanceAfterInsert(PathStep* path,
+        int depth)
+{
+    for (int i = depth - 1; i >= 0; i--)
+    {
+        Index nodeIndex = path[i].nodeIndex;
+        int balance = getBalance(nodeIndex) + (path[i].wentLeft ? -1 : 1);
+        if (balance == 0)
+        {
+            // the shorter side grew: the subtree's height is unchanged
+            setBalance(nodeIndex, 0);
+            return;
+        }
+
+        if (balance == 1 || balance == -1)
+        {
+            // the subtree grew by one level, which its parent must absorb
+            setBalance(nodeIndex, balance);
+            continue;
+        }
+
+        // a rotation restores the subtree's height from before the insertion
+        bool heightReduced;
+        Index newRootIndex = (balance < 0) ?
+            fixLeftHeavy(nodeIndex, heightReduced) :
+            fixRightHeavy(nodeIndex, heightReduced);
+        replaceChild(path, i, newRootIndex);
+        return;
+    }
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::rebalanceAfterRemove(PathStep* path,
+        int depth)
+{
+    for (int i = depth - 1; i >= 0; i--)
+    {
+        Index nodeIndex = path[i].nodeIndex;
+        int balance = getBalance(nodeIndex) + (path[i].wentLeft ? 1 : -1);
+        if (balance == 1 || balance == -1)
+        {
+            // the taller side is untouched: the subtree's height is unchanged
+            setBalance(nodeIndex, balance);
+            return;
+        }
+
+        if (balance == 0)
+        {
+            // the taller side shrank, and so did the subtree
+            setBalance(nodeIndex, 0);
+            continue;
+        }
+
+        bool heightReduced;
+        Index newRootIndex = (balance < 0) ?
+            fixLeftHeavy(nodeIndex, heightReduced) :
+            fixRightHeavy(nodeIndex, heightReduced);
+        replaceChild(path, i, newRootIndex);
+        if (!heightReduced)
+        {
+            return;
+        }
+    }
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::releaseSlot(Index freeIndex)
+{
+    Index lastIndex = static_cast<Index>(nodes.size() - 1);
+    if (freeIndex != lastIndex)
+    {
+        // find the link to the last node by searching for its item
+        const T& movedItem = nodes[lastIndex].item;
+        Index parentIndex = NIL;
+        bool wentLeft = false;
+        Index curIndex = rootIndex;
+        while (curIndex != lastIndex)
+        {
+            parentIndex = curIndex;
+            wentLeft = nodes[curIndex].item > movedItem;
+            curIndex = wentLeft ? getLeft(curIndex) : getRight(curIndex);
+        }
+
+        if (parentIndex == NIL)
+        {
+            rootIndex = freeIndex;
+        }
+        else if (wentLeft)
+        {
+            setLeft(parentIndex, freeIndex);
+        }
+        else
+        {
+            setRight(parentIndex, freeIndex);
+        }
+
+        nodes[freeIndex] = std::move(nodes[lastIndex]);
+    }
+
+    nodes.pop_back();
+}
+
+template <class T>
+template <class Key>
+typename CompactBinarySearchTree<T>::Index
+CompactBinarySearchTree<T>::findIndex(const Key& key) const
+{
+    Index curIndex = rootIndex;
+    while (curIndex != NIL)
+    {
+        const T& item = nodes[curIndex].item;
+        if (item > key)
+        {
+            curIndex = getLeft(curIndex);
+        }
+        else if (item < key)
+        {
+            curIndex = getRight(curIndex);
+        }
+        else
+        {
+            return curIndex;
+        }
+    }
+
+    return NIL;
+}
+
+template <class T>
+bool CompactBinarySearchTree<T>::empty() const
+{
+    return rootIndex == NIL;
+}
+
+template <class T>
+int CompactBinarySearchTree<T>::getTreeHeight() const
+{
+    int height = 0;
+    Index curIndex = rootIndex;
+    while (curIndex != NIL)
+    {
+        height++;
+        curIndex = (getBalance(curIndex) > 0) ?
+            getRight(curIndex) : getLeft(curIndex);
+    }
+
+    return height;
+}
+
+template <class T>
+int CompactBinarySearchTree<T>::getNumNodes() const
+{
+    return static_cast<int>(nodes.size());
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::reserve(int numNodes)
+{
+    nodes.reserve(numNodes);
+}
+
+template <class T>
+bool CompactBinarySearchTree<T>::add(const T& item)
+{
+    bool inserted = false;
+    findOrInsert(item, [&item]() { return item; }, inserted);
+    return inserted;
+}
+
+template <class T>
+template <class Key, class ItemFactory>
+T* CompactBinarySearchTree<T>::findOrInsert(const Key& key,
+        ItemFactory makeItem, bool& inserted)
+{
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    Index curIndex = rootIndex;
+    while (curIndex != NIL)
+    {
+        const T& item = nodes[curIndex].item;
+        if (item > key)
+        {
+            path[depth++] = { curIndex, true };
+            curIndex = getLeft(curIndex);
+        }
+        else if (item < key)
+        {
+            path[depth++] = { curIndex, false };
+            curIndex = getRight(curIndex);
+        }
+        else
+        {
+            inserted = false;
+            return &nodes[curIndex].item;
+        }
+    }
+
+    if (nodes.size() >= NIL)
+    {
+        throw std::runtime_error("CompactBinarySearchTree<T> cannot hold any "
+                                 "more items.");
+    }
+
+    Index newIndex = static_cast<Index>(nodes.size());
+    nodes.emplace_back(makeItem());
+    replaceChild(path, depth, newIndex);
+    rebalanceAfterInsert(path, depth);
+
+    inserted = true;
+    return &nodes[newIndex].item;
+}
+
+template <class T>
+bool CompactBinarySearchTree<T>::remove(const T& target)
+{
+    PathStep path[MAX_HEIGHT];
+    int depth = 0;
+    Index curIndex = rootIndex;
+    while (curIndex != NIL)
+    {
+        const T& item = nodes[curIndex].item;
+        if (item > target)
+        {
+            path[depth++] = { curIndex, true };
+            curIndex = getLeft(curIndex);
+        }
+        else if (item < target)
+        {
+            path[depth++] = { curIndex, false };
+            curIndex = getRight(curIndex);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (curIndex == NIL)
+    {
+        return false;
+    }
+
+    Index removedIndex = curIndex;
+    if (getLeft(curIndex) != NIL && getRight(curIndex) != NIL)
+    {
+        // replace the item with its inorder successor's, and unlink the
+        // successor's node instead
+        path[depth++] = { curIndex, false };
+        removedIndex = getRight(curIndex);
+        while (getLeft(removedIndex) != NIL)
+        {
+            path[depth++] = { removedIndex, true };
+            removedIndex = getLeft(removedIndex);
+        }
+        nodes[curIndex].item = std::move(nodes[removedIndex].item);
+    }
+
+    Index childIndex = (getLeft(removedIndex) != NIL) ?
+        getLeft(removedIndex) : getRight(removedIndex);
+    replaceChild(path, depth, childIndex);
+    rebalanceAfterRemove(path, depth);
+    releaseSlot(removedIndex);
+
+    return true;
+}
+
+template <class T>
+bool CompactBinarySearchTree<T>::contains(const T& item) const
+{
+    return findIndex(item) != NIL;
+}
+
+template <class T>
+const T& CompactBinarySearchTree<T>::getItem(const T& item) const
+{
+    Index nodeIndex = findIndex(item);
+    if (nodeIndex == NIL)
+    {
+        throw std::runtime_error("Item not found in "
+                                 "CompactBinarySearchTree<T>::getItem.");
+    }
+
+    return nodes[nodeIndex].item;
+}
+
+template <class T>
+template <class Key>
+T* CompactBinarySearchTree<T>::findItem(const Key& key)
+{
+    Index nodeIndex = findIndex(key);
+    return (nodeIndex != NIL) ? &nodes[nodeIndex].item : nullptr;
+}
+
+template <class T>
+template <class Key>
+const T* CompactBinarySearchTree<T>::findItem(const Key& key) const
+{
+    Index nodeIndex = findIndex(key);
+    return (nodeIndex != NIL) ? &nodes[nodeIndex].item : nullptr;
+}
+
+template <class T>
+template <class Key>
+void CompactBinarySearchTree<T>::findItems(const Key* keys, int count,
+        const T** results) const
+{
+    const int GROUP_SIZE = 16;
+    Index lanes[GROUP_SIZE];
+
+    for (int groupStart = 0; groupStart < count; groupStart += GROUP_SIZE)
+    {
+        int groupSize = count - groupStart;
+        if (groupSize > GROUP_SIZE)
+        {
+            groupSize = GROUP_SIZE;
+        }
+
+        for (int i = 0; i < groupSize; i++)
+        {
+            lanes[i] = rootIndex;
+            results[groupStart + i] = nullptr;
+        }
+
+        int numActive = (rootIndex != NIL) ? groupSize : 0;
+        while (numActive > 0)
+        {
+            numActive = 0;
+            for (int i = 0; i < groupSize; i++)
+            {
+                Index nodeIndex = lanes[i];
+                if (nodeIndex == NIL)
+                {
+                    continue;
+                }
+
+                const T& item = nodes[nodeIndex].item;
+                const Key& key = keys[groupStart + i];
+                if (item > key)
+                {
+                    nodeIndex = getLeft(nodeIndex);
+                }
+                else if (item < key)
+                {
+                    nodeIndex = getRight(nodeIndex);
+                }
+                else
+                {
+                    results[groupStart + i] = &item;
+                    nodeIndex = NIL;
+                }
+
+                lanes[i] = nodeIndex;
+                if (nodeIndex != NIL)
+                {
+                    prefetchForRead(&nodes[nodeIndex]);
+                    numActive++;
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::clear()
+{
+    std::vector<Node>().swap(nodes);
+    rootIndex = NIL;
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::preorderTraverse(TraversalFunction<T>* func)
+    const
+{
+    preorderForEach([func](const T& item)
+    {
+        T itemCopy(item);
+        func->visit(itemCopy);
+    });
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::inorderTraverse(TraversalFunction<T>* func)
+    const
+{
+    inorderForEach([func](const T& item)
+    {
+        T itemCopy(item);
+        func->visit(itemCopy);
+    });
+}
+
+template <class T>
+void CompactBinarySearchTree<T>::postorderTraverse(TraversalFunction<T>* func)
+    const
+{
+    postorderForEach([func](const T& item)
+    {
+        T itemCopy(item);
+        func->visit(itemCopy);
+    });
+}
+
+template <class T>
+template <class Function>
+void CompactBinarySearchTree<T>::preorderForEach(Function visit) const
+{
+    if (rootIndex == NIL)
+    {
+        return;
+    }
+
+    std::vector<Index> pending(1, rootIndex);
+    while (!pending.empty())
+    {
+        Index nodeIndex = pending.back();
+        pending.pop_back();
+        visit(static_cast<const T&>(nodes[nodeIndex].item));
+
+        if (getRight(nodeIndex) != NIL)
+        {
+            pending.push_back(getRight(nodeIndex));
+        }
+        if (getLeft(nodeIndex) != NIL)
+        {
+            pending.push_back(getLeft(nodeIndex));
+        }
+    }
+}
+
+template <class T>
+template <class Function>
+void CompactBinarySearchTree<T>::inorderForEach(Function visit) const
+{
+    for (const T& item : *this)
+    {
+        visit(item);
+    }
+}
+
+template <class T>
+template <class Function>
+void CompactBinarySearchTree<T>::postorderForEach(Function visit) const
+{
+    std::vector<Index> pending;
+    Index curIndex = rootIndex;
+    Index lastVisited = NIL;
+    while (curIndex != NIL || !pending.empty())
+    {
+        if (curIndex != NIL)
+        {
+            pending.push_back(curIndex);
+            curIndex = getLeft(curIndex);
+            continue;
+        }
+
+        Index topIndex = pending.back();
+        Index rightIndex = getRight(topIndex);
+        if (rightIndex != NIL && rightIndex != lastVisited)
+        {
+            curIndex = rightIndex;
+        }
+        else
+        {
+            visit(static_cast<const T&>(nodes[topIndex].item));
+            lastVisited = topIndex;
+            pending.pop_back();
+        }
+    }
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::const_iterator
+CompactBinarySearchTree<T>::begin() const
+{
+    return const_iterator(this);
+}
+
+template <class T>
+typename CompactBinarySearchTree<T>::const_iterator
+CompactBinarySearchTree<T>::end() const
+{
+    return const_iterator();
+}
+
+#endif
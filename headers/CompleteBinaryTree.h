@@ -0,0 +1,464 @@
+/**
+ * @class CompleteBinaryTree
+ * @brief A binary tree with the same interface as @c BinaryTree, stored in
+ * level order in a single array.
+ *
+ * The tree is always complete: every level is full except possibly the
+ * last, which is filled from the left. The item at index i has its children
+ * at 2i + 1 and 2i + 2 and its parent at (i - 1) / 2, so there are no links
+ * at all and the height is always floor(log2 n) + 1.
+ *
+ * @c add appends to the array, in amortized constant time. @c remove still
+ * has to search for its target, but the search is a linear scan of the
+ * array, and the removal itself moves the last item into the freed slot, so
+ * there is no rebalancing. The level order traversal is a scan of the array,
+ * and the other traversals walk the array by index arithmetic, without
+ * recursion or a stack.
+ *
+ * Because items move, references to items are invalidated by @c add and
+ * @c remove, as with references into a @c std::vector.
+ */
+
+#ifndef COMPLETE_BINARY_TREE_H
+#define COMPLETE_BINARY_TREE_H
+
+#include "BinaryTree.h"
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <class T>
+class CompleteBinaryTree
+{
+private:
+    std::vector<T> items;
+
+    static std::size_t leftChild(std::size_t index)
+    {
+        return 2 * index + 1;
+    }
+
+    static std::size_t parent(std::size_t index)
+    {
+        return (index - 1) / 2;
+    }
+
+    static bool isLeftChild(std::size_t index)
+    {
+        return (index & 1) != 0;
+    }
+
+    /**
+     * @return The index of the first item of an inorder traversal of the
+     *         subtree rooted at @c index, which must be in the tree.
+     */
+    std::size_t leftmost(std::size_t index) const;
+
+    /**
+     * Walk the array in the given order, calling @c visit with the index of
+     * each item. A node with only one child has a left child, so the
+     * leftmost path of a subtree always ends at a leaf.
+     */
+    template <class Function>
+    void preorderIndices(Function visit) const;
+    template <class Function>
+    void inorderIndices(Function visit) const;
+    template <class Function>
+    void postorderIndices(Function visit) const;
+
+public:
+    // the same as for std::vector, since the items are visited in the order
+    // they are stored
+    typedef typename std::vector<T>::const_iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    CompleteBinaryTree();
+    CompleteBinaryTree(const T& rootItem);
+
+    virtual ~CompleteBinaryTree();
+
+    bool empty() const;
+
+    /**
+     * @return The height of the tree, in constant time.
+     */
+    int getTreeHeight() const;
+
+    /**
+     * @return The number of items in the tree, in constant time.
+     */
+    int getNumNodes() const;
+
+    /**
+     * @throws range_error if the tree is empty.
+     */
+    const T& getRootData() const;
+
+    /**
+     * @throws range_error if the tree is empty.
+     */
+    void setRootData(const T& rootItem);
+
+    /**
+     * Adds an item in the next free position of the last level.
+     * @param item The value to add to the tree.
+     * @return true, since adding an item always succeeds.
+     */
+    bool add(const T& item);
+    bool add(T&& item);
+
+    /**
+     * Removes one item with the specified value, if it exists, by moving
+     * the last item of the tree into its position.
+     * @param item The value to remove.
+     * @return true if an item was removed, false otherwise.
+     */
+    bool remove(const T& item);
+
+    bool contains(const T& item) const;
+
+    void clear();
+
+    /**
+     * Reserves room for @c numNodes items, so that adding up to that many
+     * does not reallocate.
+     */
+    void reserve(int numNodes);
+
+    // Traversal operations
+    void preorderTraverse(TraversalFunction<T>* func);
+    void inorderTraverse(TraversalFunction<T>* func);
+    void postorderTraverse(TraversalFunction<T>* func);
+
+    /**
+     * Traversals which call any callable @c visit as <tt>visit(const T&)</tt>
+     * for each item, as for @c BinaryTree. The level order traversal is a
+     * single scan of the array.
+     */
+    template <class Function>
+    void preorderForEach(Function visit) const;
+    template <class Function>
+    void inorderForEach(Function visit) const;
+    template <class Function>
+    void postorderForEach(Function visit) const;
+    template <class Function>
+    void levelorderForEach(Function visit) const;
+
+    /**
+     * @return An iterator to the root, which visits the items in level
+     *         order.
+     */
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+template <class T>
+CompleteBinaryTree<T>::CompleteBinaryTree()
+{
+
+}
+
+template <class T>
+CompleteBinaryTree<T>::CompleteBinaryTree(const T& rootItem)
+    : items(1, rootItem)
+{
+
+}
+
+template <class T>
+CompleteBinaryTree<T>::~CompleteBinaryTree()
+{
+
+}
+
+template <class T>
+std::size_t CompleteBinaryTree<T>::leftmost(std::size_t index) const
+{
+    while (leftChild(index) < items.size())
+    {
+        index = leftChild(index);
+    }
+
+    return index;
+}
+
+template <class T>
+bool CompleteBinaryTree<T>::empty() const
+{
+    return items.empty();
+}
+
+template <class T>
+int CompleteBinaryTree<T>::getTreeHeight() const
+{
+    int height = 0;
+    for (std::size_t numItems = items.size(); numItems > 0; numItems >>= 1)
+    {
+        height++;
+    }
+
+    return height;
+}
+
+template <class T>
+int CompleteBinaryTree<T>::getNumNodes() const
+{
+    return static_cast<int>(items.size());
+}
+
+template <class T>
+const T& CompleteBinaryTree<T>::getRootData() const
+{
+    if (empty())
+    {
+        throw std::range_error("Tried to access empty tree "
+            "with CompleteBinaryTree<T>::getRootData");
+    }
+
+    return items[0];
+}
+
+template <class T>
+void CompleteBinaryTree<T>::setRootData(const T& rootItem)
+{
+    if (empty())
+    {
+        throw std::range_error("Tried to access empty tree "
+            "with CompleteBinaryTree<T>::setRootData");
+    }
+
+    items[0] = rootItem;
+}
+
+template <class T>
+bool CompleteBinaryTree<T>::add(const T& item)
+{
+    items.push_back(item);
+    return true;
+}
+
+template <class T>
+bool CompleteBinaryTree<T>::add(T&& item)
+{
+    items.push_back(std::move(item));
+    return true;
+}
+
+template <class T>
+bool CompleteBinaryTree<T>::remove(const T& item)
+{
+    for (std::size_t i = 0; i < items.size(); i++)
+    {
+        if (items[i] == item)
+        {
+            if (i != items.size() - 1)
+            {
+                items[i] = std::move(items.back());
+            }
+            items.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <class T>
+bool CompleteBinaryTree<T>::contains(const T& item) const
+{
+    for (const T& treeItem : items)
+    {
+        if (treeItem == item)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <class T>
+void CompleteBinaryTree<T>::clear()
+{
+    items.clear();
+}
+
+template <class T>
+void CompleteBinaryTree<T>::reserve(int numNodes)
+{
+    items.reserve(numNodes);
+}
+
+template <class T>
+void CompleteBinaryTree<T>::preorderTraverse(TraversalFunction<T>* func)
+{
+    preorderIndices([&](std::size_t index)
+    {
+        func->visit(items[index]);
+    });
+}
+
+template <class T>
+void CompleteBinaryTree<T>::inorderTraverse(TraversalFunction<T>* func)
+{
+    inorderIndices([&](std::size_t index)
+    {
+        func->visit(items[index]);
+    });
+}
+
+template <class T>
+void CompleteBinaryTree<T>::postorderTraverse(TraversalFunction<T>* func)
+{
+    postorderIndices([&](std::size_t index)
+    {
+        func->visit(items[index]);
+    });
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::preorderIndices(Function visit) const
+{
+    std::size_t numItems = items.size();
+    std::size_t index = 0;
+    while (index < numItems)
+    {
+        visit(index);
+
+        if (leftChild(index) < numItems)
+        {
+            index = leftChild(index);
+            continue;
+        }
+
+        // climb until there is an unvisited right sibling
+        while (index > 0 && !(isLeftChild(index) && index + 1 < numItems))
+        {
+            index = parent(index);
+        }
+        index = index > 0 ? index + 1 : numItems;
+    }
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::inorderIndices(Function visit) const
+{
+    std::size_t numItems = items.size();
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    std::size_t index = leftmost(0);
+    while (true)
+    {
+        visit(index);
+
+        if (leftChild(index) + 1 < numItems)
+        {
+            index = leftmost(leftChild(index) + 1);
+            continue;
+        }
+
+        // climb out of every subtree this item finishes
+        while (index > 0 && !isLeftChild(index))
+        {
+            index = parent(index);
+        }
+        if (index == 0)
+        {
+            return;
+        }
+        index = parent(index);
+    }
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::postorderIndices(Function visit) const
+{
+    std::size_t numItems = items.size();
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    std::size_t index = leftmost(0);
+    while (true)
+    {
+        visit(index);
+
+        if (index == 0)
+        {
+            return;
+        }
+
+        if (isLeftChild(index) && index + 1 < numItems)
+        {
+            index = leftmost(index + 1);
+        }
+        else
+        {
+            index = parent(index);
+        }
+    }
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::preorderForEach(Function visit) const
+{
+    preorderIndices([&](std::size_t index)
+    {
+        visit(items[index]);
+    });
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::inorderForEach(Function visit) const
+{
+    inorderIndices([&](std::size_t index)
+    {
+        visit(items[index]);
+    });
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::postorderForEach(Function visit) const
+{
+    postorderIndices([&](std::size_t index)
+    {
+        visit(items[index]);
+    });
+}
+
+template <class T>
+template <class Function>
+void CompleteBinaryTree<T>::levelorderForEach(Function visit) const
+{
+    for (const T& item : items)
+    {
+        visit(item);
+    }
+}
+
+template <class T>
+typename CompleteBinaryTree<T>::const_iterator
+CompleteBinaryTree<T>::begin() const
+{
+    return items.begin();
+}
+
+template <class T>
+typename CompleteBinaryTree<T>::const_iterator
+CompleteBinaryTree<T>::end() const
+{
+    return items.end();
+}
+
+#endif
@@ -0,0 +1,601 @@
+/**
+ * @class ConcurrentBinarySearchTree
+ * @brief A (non-balancing) binary search tree which may be used by many
+ * threads at once.
+ *
+ * The tree uses optimistic lock coupling. Every node carries a version lock:
+ * a counter which writers increment when they modify the node. Readers take
+ * no locks at all; they note the version of each node as they descend, and
+ * check that the parent's version is unchanged once they have moved to the
+ * child. If it has changed, the search restarts from the root. Writers
+ * descend in the same way, then lock only the one or two nodes they modify,
+ * and only if those nodes' versions are still the ones seen on the way down.
+ *
+ * Removing an item whose node has two children only marks it absent, and
+ * the node stays in place to route searches; adding the item again reuses
+ * it. Whenever a node is unlinked, its parent is unlinked too if it is such
+ * an absent node and is left with at most one child, and so on up the tree,
+ * so every absent node has two children and they never outnumber the items.
+ * Other nodes are unlinked immediately, and freed through the
+ * @c EpochManager once no reader can still be looking at them.
+ *
+ * @c add, @c remove, @c contains and @c getItem are linearizable. Items are
+ * never modified once they are in the tree, so @c T only needs to be safe to
+ * read from several threads at once.
+ */
+
+#ifndef CONCURRENT_BINARY_SEARCH_TREE_H
+#define CONCURRENT_BINARY_SEARCH_TREE_H
+
+#include "EpochManager.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template <class T>
+class ConcurrentBinarySearchTree
+{
+private:
+    /**
+     * A version counter whose low bits mark a node as locked by a writer,
+     * or as obsolete once it has been unlinked from the tree.
+     */
+    class VersionLock
+    {
+    private:
+        static const std::uint64_t OBSOLETE_BIT = 1;
+        static const std::uint64_t LOCKED_BIT = 2;
+
+        std::atomic<std::uint64_t> version;
+
+    public:
+        VersionLock() : version(0)
+        {
+
+        }
+
+        /**
+         * Waits until no writer holds the lock, then reads the version.
+         * @return false if the node is obsolete, so the caller must restart.
+         */
+        bool readLock(std::uint64_t& outVersion) const
+        {
+            std::uint64_t current = version.load(std::memory_order_acquire);
+            while ((current & LOCKED_BIT) != 0)
+            {
+                std::this_thread::yield();
+                current = version.load(std::memory_order_acquire);
+            }
+
+            outVersion = current;
+            return (current & OBSOLETE_BIT) == 0;
+        }
+
+        /**
+         * @return true if nothing has written to the node since @c oldVersion
+         *         was read, in which case everything read from the node in
+         *         the meantime is consistent. Those reads must be acquire
+         *         loads, so that they cannot move after this one.
+         */
+        bool validate(std::uint64_t oldVersion) const
+        {
+            return version.load(std::memory_order_acquire) == oldVersion;
+        }
+
+        /**
+         * Locks the node for writing, if its version is still
+         * @c oldVersion. Writes to the node while it is locked must be
+         * release stores, so that a reader which sees one also sees that
+         * the node is locked.
+         * @return true if the lock was taken, false if the caller must
+         *         restart.
+         */
+        bool tryUpgrade(std::uint64_t oldVersion)
+        {
+            return version.compare_exchange_strong(oldVersion,
+                oldVersion + LOCKED_BIT, std::memory_order_acquire);
+        }
+
+        /**
+         * Unlocks the node, advancing its version.
+         */
+        void writeUnlock()
+        {
+            version.fetch_add(LOCKED_BIT, std::memory_order_release);
+        }
+
+        /**
+         * Unlocks a node which has been unlinked, so that readers which
+         * reach it restart.
+         */
+        void writeUnlockObsolete()
+        {
+            version.fetch_add(LOCKED_BIT + OBSOLETE_BIT,
+                              std::memory_order_release);
+        }
+    };
+
+    struct Node
+    {
+        const T item;
+        std::atomic<Node*> leftPtr;
+        std::atomic<Node*> rightPtr;
+        std::atomic<bool> present; ///< false if the item has been removed
+        VersionLock lock;
+
+        explicit Node(const T& item)
+            : item(item), leftPtr(nullptr), rightPtr(nullptr), present(true)
+        {
+
+        }
+    };
+
+    /**
+     * Where a search ended: the link that leads to @c nodePtr, the lock and
+     * version of the node that owns the link, and the node's version.
+     */
+    struct Position
+    {
+        Node* parentPtr; ///< the node that owns the link, or @c nullptr
+        VersionLock* parentLockPtr;
+        std::uint64_t parentVersion;
+        std::atomic<Node*>* linkPtr;
+        Node* nodePtr; ///< the node holding the item, or @c nullptr
+        std::uint64_t nodeVersion;
+    };
+
+    std::atomic<Node*> rootPtr;
+    VersionLock rootLock; ///< guards @c rootPtr as if it were a node's link
+    std::atomic<int> numNodes;
+    std::atomic<int> numLinkedNodes;
+
+    /**
+     * Descends from the root to the node holding @c item, or to the empty
+     * link where it would be inserted, coupling versions on the way.
+     * @param item The item to search for.
+     * @param position Set to where the search ended. If @c nodePtr is
+     *                 @c nullptr, the parent's version has been validated.
+     * @return false if a concurrent write got in the way and the search must
+     *         restart.
+     */
+    bool locate(const T& item, Position& position);
+
+    /**
+     * Unlinks @c position.nodePtr, which must have at most one child.
+     * @return false if a concurrent write got in the way and the caller must
+     *         restart.
+     */
+    bool unlink(Position& position, Node* leftPtr, Node* rightPtr);
+
+    /**
+     * Unlinks @c nodePtr if its item has been removed and it has at most one
+     * child, then does the same for its parent, and so on up the tree. The
+     * caller must hold an @c EpochGuard, which keeps the nodes readable.
+     */
+    void unlinkAbsentNodes(Node* nodePtr);
+
+public:
+    ConcurrentBinarySearchTree();
+
+    ConcurrentBinarySearchTree(
+        const ConcurrentBinarySearchTree<T>& other) = delete;
+
+    /**
+     * Frees every node. No other thread may be using the tree.
+     */
+    ~ConcurrentBinarySearchTree();
+
+    ConcurrentBinarySearchTree<T>& operator=(
+        const ConcurrentBinarySearchTree<T>& other) = delete;
+
+    /**
+     * Adds an item to the tree, unless an equal item is already present.
+     * @param item The item to add.
+     * @return true if the item was added, false otherwise.
+     */
+    bool add(const T& item);
+
+    /**
+     * Removes the item equal to @c target, if there is one.
+     * @param target The item to remove.
+     * @return true if an item was removed, false otherwise.
+     */
+    bool remove(const T& target);
+
+    /**
+     * Searches the tree for a certain item, without taking any locks.
+     * @param item The item to search for.
+     * @return true if the item is in the tree, false otherwise.
+     */
+    bool contains(const T& item);
+
+    /**
+     * Returns a copy of the item in the tree which compares equal to
+     * @c item. A copy is returned, rather than a reference, since another
+     * thread may remove the item at any time.
+     * @param item The item to search for.
+     * @return A copy of the item in the tree.
+     *
+     * @throws runtime_error if the item does not exist in the tree.
+     */
+    T getItem(const T& item);
+
+    bool empty() const;
+
+    /**
+     * @return The number of items in the tree. While other threads are
+     *         modifying the tree, this is only a snapshot.
+     */
+    int getNumNodes() const;
+
+    /**
+     * @return The number of nodes linked into the tree, including those
+     *         kept only to route searches after their items were removed.
+     *         This is less than twice @c getNumNodes() plus one.
+     */
+    int getNumLinkedNodes() const;
+};
+
+template <class T>
+ConcurrentBinarySearchTree<T>::ConcurrentBinarySearchTree()
+    : rootPtr(nullptr), numNodes(0), numLinkedNodes(0)
+{
+
+}
+
+template <class T>
+ConcurrentBinarySearchTree<T>::~ConcurrentBinarySearchTree()
+{
+    std::vector<Node*> stack;
+    Node* nodePtr = rootPtr.load(std::memory_order_acquire);
+    if (nodePtr != nullptr)
+    {
+        stack.push_back(nodePtr);
+    }
+
+    while (!stack.empty())
+    {
+        nodePtr = stack.back();
+        stack.pop_back();
+        if (Node* leftPtr = nodePtr->leftPtr.load(std::memory_order_relaxed))
+        {
+            stack.push_back(leftPtr);
+        }
+        if (Node* rightPtr = nodePtr->rightPtr.load(std::memory_order_relaxed))
+        {
+            stack.push_back(rightPtr);
+        }
+        delete nodePtr;
+    }
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::locate(const T& item, Position& position)
+{
+    position.parentPtr = nullptr;
+    position.parentLockPtr = &rootLock;
+    position.linkPtr = &rootPtr;
+    if (!rootLock.readLock(position.parentVersion))
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        Node* nodePtr = position.linkPtr->load(std::memory_order_acquire);
+        position.nodePtr = nodePtr;
+        if (nodePtr == nullptr)
+        {
+            return position.parentLockPtr->validate(position.parentVersion);
+        }
+
+        // the link to the node was still valid once its version was read
+        if (!nodePtr->lock.readLock(position.nodeVersion) ||
+            !position.parentLockPtr->validate(position.parentVersion))
+        {
+            return false;
+        }
+
+        std::atomic<Node*>* nextLinkPtr;
+        if (nodePtr->item > item)
+        {
+            nextLinkPtr = &nodePtr->leftPtr;
+        }
+        else if (nodePtr->item < item)
+        {
+            nextLinkPtr = &nodePtr->rightPtr;
+        }
+        else
+        {
+            return true;
+        }
+
+        position.parentPtr = nodePtr;
+        position.parentLockPtr = &nodePtr->lock;
+        position.parentVersion = position.nodeVersion;
+        position.linkPtr = nextLinkPtr;
+    }
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::unlink(Position& position, Node* leftPtr,
+                                           Node* rightPtr)
+{
+    // lock top-down; neither upgrade waits, so this cannot deadlock
+    if (!position.parentLockPtr->tryUpgrade(position.parentVersion))
+    {
+        return false;
+    }
+
+    Node* nodePtr = position.nodePtr;
+    if (!nodePtr->lock.tryUpgrade(position.nodeVersion))
+    {
+        position.parentLockPtr->writeUnlock();
+        return false;
+    }
+
+    // the children read before locking are still current, since the
+    // version has not changed
+    // sequentially consistent, so that a thread which enters an epoch after
+    // the node is retired cannot still see it
+    position.linkPtr->store((leftPtr != nullptr) ? leftPtr : rightPtr,
+                            std::memory_order_seq_cst);
+    nodePtr->present.store(false, std::memory_order_release);
+    nodePtr->lock.writeUnlockObsolete();
+    position.parentLockPtr->writeUnlock();
+    numLinkedNodes.fetch_sub(1, std::memory_order_relaxed);
+
+    EpochManager::getDefault().retire(nodePtr);
+    return true;
+}
+
+template <class T>
+void ConcurrentBinarySearchTree<T>::unlinkAbsentNodes(Node* nodePtr)
+{
+    // a present node never needs unlinking, so most removals stop here
+    // without another descent
+    while (nodePtr != nullptr &&
+           !nodePtr->present.load(std::memory_order_acquire))
+    {
+        Position position;
+        if (!locate(nodePtr->item, position))
+        {
+            continue;
+        }
+
+        if (position.nodePtr != nodePtr)
+        {
+            // another thread has unlinked it already
+            return;
+        }
+
+        bool present = nodePtr->present.load(std::memory_order_acquire);
+        Node* leftPtr = nodePtr->leftPtr.load(std::memory_order_acquire);
+        Node* rightPtr = nodePtr->rightPtr.load(std::memory_order_acquire);
+        if (!nodePtr->lock.validate(position.nodeVersion))
+        {
+            continue;
+        }
+
+        if (present || (leftPtr != nullptr && rightPtr != nullptr))
+        {
+            return;
+        }
+
+        if (!unlink(position, leftPtr, rightPtr))
+        {
+            continue;
+        }
+
+        nodePtr = position.parentPtr;
+    }
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::add(const T& item)
+{
+    EpochGuard guard;
+    Node* newNodePtr = nullptr;
+    while (true)
+    {
+        Position position;
+        if (!locate(item, position))
+        {
+            continue;
+        }
+
+        Node* nodePtr = position.nodePtr;
+        if (nodePtr != nullptr)
+        {
+            bool present = nodePtr->present.load(std::memory_order_acquire);
+            if (present)
+            {
+                if (!nodePtr->lock.validate(position.nodeVersion))
+                {
+                    continue;
+                }
+
+                delete newNodePtr;
+                return false;
+            }
+
+            // the item was removed, but its node is still routing searches
+            if (!nodePtr->lock.tryUpgrade(position.nodeVersion))
+            {
+                continue;
+            }
+
+            nodePtr->present.store(true, std::memory_order_release);
+            nodePtr->lock.writeUnlock();
+            delete newNodePtr;
+            numNodes.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // allocate outside the lock, and only once across restarts
+        if (newNodePtr == nullptr)
+        {
+            newNodePtr = new Node(item);
+        }
+
+        if (!position.parentLockPtr->tryUpgrade(position.parentVersion))
+        {
+            continue;
+        }
+
+        position.linkPtr->store(newNodePtr, std::memory_order_release);
+        position.parentLockPtr->writeUnlock();
+        numNodes.fetch_add(1, std::memory_order_relaxed);
+        numLinkedNodes.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::remove(const T& target)
+{
+    EpochGuard guard;
+    while (true)
+    {
+        Position position;
+        if (!locate(target, position))
+        {
+            continue;
+        }
+
+        Node* nodePtr = position.nodePtr;
+        if (nodePtr == nullptr)
+        {
+            return false;
+        }
+
+        bool present = nodePtr->present.load(std::memory_order_acquire);
+        Node* leftPtr = nodePtr->leftPtr.load(std::memory_order_acquire);
+        Node* rightPtr = nodePtr->rightPtr.load(std::memory_order_acquire);
+        if (!nodePtr->lock.validate(position.nodeVersion))
+        {
+            continue;
+        }
+
+        if (leftPtr != nullptr && rightPtr != nullptr)
+        {
+            if (!present)
+            {
+                return false;
+            }
+
+            // keep the node to route searches, and only mark it absent
+            if (!nodePtr->lock.tryUpgrade(position.nodeVersion))
+            {
+                continue;
+            }
+
+            nodePtr->present.store(false, std::memory_order_release);
+            nodePtr->lock.writeUnlock();
+            numNodes.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // an absent routing node which no longer needs to route is unlinked
+        // too, although the item was already removed
+        if (!unlink(position, leftPtr, rightPtr))
+        {
+            continue;
+        }
+
+        if (present)
+        {
+            numNodes.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // the parent may be an absent node which was routing searches to
+        // this one
+        unlinkAbsentNodes(position.parentPtr);
+        return present;
+    }
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::contains(const T& item)
+{
+    EpochGuard guard;
+    while (true)
+    {
+        Position position;
+        if (!locate(item, position))
+        {
+            continue;
+        }
+
+        if (position.nodePtr == nullptr)
+        {
+            return false;
+        }
+
+        bool present = position.nodePtr->present.load(
+            std::memory_order_acquire);
+        if (position.nodePtr->lock.validate(position.nodeVersion))
+        {
+            return present;
+        }
+    }
+}
+
+template <class T>
+T ConcurrentBinarySearchTree<T>::getItem(const T& item)
+{
+    EpochGuard guard;
+    while (true)
+    {
+        Position position;
+        if (!locate(item, position))
+        {
+            continue;
+        }
+
+        Node* nodePtr = position.nodePtr;
+        if (nodePtr == nullptr)
+        {
+            break;
+        }
+
+        bool present = nodePtr->present.load(std::memory_order_acquire);
+        if (!nodePtr->lock.validate(position.nodeVersion))
+        {
+            continue;
+        }
+
+        if (present)
+        {
+            // the item itself never changes, and the guard keeps the node
+            // from being freed while it is copied
+            return nodePtr->item;
+        }
+        break;
+    }
+
+    throw std::runtime_error("Item not found in "
+                             "ConcurrentBinarySearchTree<T>::getItem.");
+}
+
+template <class T>
+bool ConcurrentBinarySearchTree<T>::empty() const
+{
+    return getNumNodes() == 0;
+}
+
+template <class T>
+int ConcurrentBinarySearchTree<T>::getNumNodes() const
+{
+    return numNodes.load(std::memory_order_relaxed);
+}
+
+template <class T>
+int ConcurrentBinarySearchTree<T>::getNumLinkedNodes() const
+{
+    return numLinkedNodes.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,507 @@
+/**
+ * Instrumentation policies for the containers which take a @c Stats
+ * template parameter (@c ArrayList, @c LinkedList, @c Heap and
+ * @c BinarySearchTree).
+ *
+ * The default policy, @c NoStats, is an empty class whose hooks are empty
+ * inline functions, so an uninstrumented container is the same size and
+ * compiles to the same code as before. @c ContainerStats counts events such
+ * as comparisons, node allocations and resizes, and times every add, remove
+ * and lookup, keeping a histogram of the latencies and of the events each
+ * operation caused (e.g. the comparisons per lookup of a tree, which reveal
+ * a degenerate tree, or the levels each removal from a heap sifts down).
+ * The statistics belong to one container and are written out as JSON by
+ * @c writeJson.
+ *
+ * A container derives privately from its policy, and copies of a container
+ * start with fresh statistics. Like the containers, the statistics are not
+ * thread-safe.
+ */
+
+#ifndef CONTAINER_STATS_H
+#define CONTAINER_STATS_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * The events a container counts.
+ */
+enum class StatEvent
+{
+    COMPARISON, ///< an item compared with a search key
+    NODE_ALLOCATION,
+    NODE_DEALLOCATION,
+    RESIZE, ///< an array grown by reallocating
+    HEAP_REBUILD_STEP, ///< a level an item moved through a heap
+    NUM_EVENTS
+};
+
+/**
+ * The operations a container times.
+ */
+enum class StatOperation
+{
+    ADD,
+    REMOVE,
+    LOOKUP,
+    NUM_OPERATIONS
+};
+
+/**
+ * The policy of a container without instrumentation; every hook does
+ * nothing.
+ */
+class NoStats
+{
+public:
+    static const bool ENABLED = false;
+
+    /**
+     * Times an operation from its construction to its destruction.
+     */
+    class Timer
+    {
+    public:
+        Timer(const NoStats&, StatOperation)
+        {
+
+        }
+    };
+
+    void recordEvent(StatEvent, std::uint64_t = 1) const
+    {
+
+    }
+};
+
+/**
+ * A histogram of non-negative values with a bucket per power of two: bucket
+ * 0 holds 0, and bucket i holds the values from 2^(i - 1) to 2^i - 1, so
+ * any value fits in 64 buckets with at most a factor of two of error.
+ */
+class Histogram
+{
+public:
+    static const int NUM_BUCKETS = 64;
+
+private:
+    std::uint64_t buckets[NUM_BUCKETS];
+    std::uint64_t count;
+    std::uint64_t sum;
+    std::uint64_t max;
+
+    static int getBucketIndex(std::uint64_t value);
+
+public:
+    Histogram();
+
+    void add(std::uint64_t value);
+
+    std::uint64_t getCount() const;
+
+    std::uint64_t getMax() const;
+
+    double getMean() const;
+
+    /**
+     * @return The number of values in bucket @c index.
+     */
+    std::uint64_t getBucketCount(int index) const;
+
+    /**
+     * @return The largest value bucket @c index holds.
+     */
+    static std::uint64_t getBucketUpperBound(int index);
+
+    /**
+     * @param fraction The fraction of values, from 0 to 1.
+     * @return An upper bound on the smallest value which is at least as
+     *         large as @c fraction of the values: the upper bound of its
+     *         bucket, or the largest value if that is smaller. 0 if the
+     *         histogram is empty.
+     */
+    std::uint64_t getPercentile(double fraction) const;
+
+    void clear();
+
+    /**
+     * Writes the count, mean, maximum, the 50th, 90th and 99th percentiles
+     * and the non-empty buckets, as <tt>[upper bound, count]</tt> pairs.
+     */
+    void writeJson(std::ostream& out) const;
+};
+
+/**
+ * The policy of an instrumented container. Lookups are const, so the
+ * statistics are mutable.
+ */
+class ContainerStats
+{
+public:
+    static const bool ENABLED = true;
+
+    static const int NUM_EVENTS = static_cast<int>(StatEvent::NUM_EVENTS);
+    static const int NUM_OPERATIONS =
+        static_cast<int>(StatOperation::NUM_OPERATIONS);
+
+    /**
+     * Times an operation from its construction to its destruction, and
+     * records how many of each event it caused. Operations may nest (e.g. a
+     * removal which starts with a lookup); each records its own events.
+     */
+    class Timer
+    {
+    private:
+        const ContainerStats& stats;
+        StatOperation operation;
+        std::uint64_t startCounts[NUM_EVENTS];
+        std::chrono::steady_clock::time_point startTime;
+
+    public:
+        Timer(const ContainerStats& stats, StatOperation operation);
+
+        Timer(const Timer& other) = delete;
+
+        Timer& operator=(const Timer& other) = delete;
+
+        ~Timer();
+    };
+
+private:
+    mutable std::uint64_t eventCounts[NUM_EVENTS];
+    mutable Histogram latencies[NUM_OPERATIONS]; ///< in nanoseconds
+    mutable Histogram eventsPerOperation[NUM_OPERATIONS][NUM_EVENTS];
+
+public:
+    ContainerStats();
+
+    // a copy of a container counts only its own events
+    ContainerStats(const ContainerStats& other);
+
+    ContainerStats& operator=(const ContainerStats& other);
+
+    void recordEvent(StatEvent event, std::uint64_t count = 1) const;
+
+    /**
+     * @return The number of times @c event has happened.
+     */
+    std::uint64_t getEventCount(StatEvent event) const;
+
+    /**
+     * @return The latencies of @c operation, in nanoseconds.
+     */
+    const Histogram& getLatencies(StatOperation operation) const;
+
+    /**
+     * @return The number of times @c event happened during each
+     *         @c operation.
+     */
+    const Histogram& getEventsPerOperation(StatOperation operation,
+                                           StatEvent event) const;
+
+    /**
+     * Clears every count and histogram.
+     */
+    void reset();
+
+    /**
+     * Writes the event counts and, for every operation which has happened,
+     * the histogram of its latencies and of each event it caused, e.g.
+     * <tt>{"events": {"comparison": 12, ...}, "operations": {"lookup":
+     * {"latency_ns": {...}, "comparison": {...}}, ...}}</tt>.
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @return The statistics as JSON, as written by @c writeJson.
+     */
+    std::string toJson() const;
+
+    static const char* getName(StatEvent event);
+
+    static const char* getName(StatOperation operation);
+};
+
+inline Histogram::Histogram()
+{
+    clear();
+}
+
+inline int Histogram::getBucketIndex(std::uint64_t value)
+{
+    // the number of bits needed to hold the value
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+inline void Histogram::add(std::uint64_t value)
+{
+    int index = getBucketIndex(value);
+    buckets[index < NUM_BUCKETS ? index : NUM_BUCKETS - 1]++;
+    count++;
+    sum += value;
+    if (value > max)
+    {
+        max = value;
+    }
+}
+
+inline std::uint64_t Histogram::getCount() const
+{
+    return count;
+}
+
+inline std::uint64_t Histogram::getMax() const
+{
+    return max;
+}
+
+inline double Histogram::getMean() const
+{
+    return count == 0 ? 0.0 : static_cast<double>(sum) / count;
+}
+
+inline std::uint64_t Histogram::getBucketCount(int index) const
+{
+    return buckets[index];
+}
+
+inline std::uint64_t Histogram::getBucketUpperBound(int index)
+{
+    return index == NUM_BUCKETS - 1 ? UINT64_MAX
+                                    : (std::uint64_t(1) << index) - 1;
+}
+
+inline std::uint64_t Histogram::getPercentile(double fraction) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // the rank of the value, counting from 1
+    std::uint64_t rank =
+        static_cast<std::uint64_t>(std::ceil(fraction * count));
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+
+    std::uint64_t numBelow = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        numBelow += buckets[i];
+        if (numBelow >= rank)
+        {
+            std::uint64_t upperBound = getBucketUpperBound(i);
+            return upperBound < max ? upperBound : max;
+        }
+    }
+
+    return max;
+}
+
+inline void Histogram::clear()
+{
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        buckets[i] = 0;
+    }
+    count = 0;
+    sum = 0;
+    max = 0;
+}
+
+inline void Histogram::writeJson(std::ostream& out) const
+{
+    out << "{\"count\": " << count << ", \"mean\": " << getMean()
+        << ", \"max\": " << max << ", \"p50\": " << getPercentile(0.5)
+        << ", \"p90\": " << getPercentile(0.9) << ", \"p99\": "
+        << getPercentile(0.99) << ", \"buckets\": [";
+
+    bool isFirst = true;
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        if (buckets[i] != 0)
+        {
+            out << (isFirst ? "" : ", ") << "[" << getBucketUpperBound(i)
+                << ", " << buckets[i] << "]";
+            isFirst = false;
+        }
+    }
+
+    out << "]}";
+}
+
+inline ContainerStats::Timer::Timer(const ContainerStats& stats,
+                                    StatOperation operation)
+    : stats(stats), operation(operation)
+{
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        startCounts[i] = stats.eventCounts[i];
+    }
+
+    startTime = std::chrono::steady_clock::now();
+}
+
+inline ContainerStats::Timer::~Timer()
+{
+    std::chrono::steady_clock::duration elapsed =
+        std::chrono::steady_clock::now() - startTime;
+    int op = static_cast<int>(operation);
+    stats.latencies[op].add(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+            .count()));
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        stats.eventsPerOperation[op][i].add(
+            stats.eventCounts[i] - startCounts[i]);
+    }
+}
+
+inline ContainerStats::ContainerStats()
+{
+    reset();
+}
+
+inline ContainerStats::ContainerStats(const ContainerStats&)
+{
+    reset();
+}
+
+inline ContainerStats& ContainerStats::operator=(const ContainerStats&)
+{
+    return *this;
+}
+
+inline void ContainerStats::recordEvent(StatEvent event,
+                                        std::uint64_t count) const
+{
+    eventCounts[static_cast<int>(event)] += count;
+}
+
+inline std::uint64_t ContainerStats::getEventCount(StatEvent event) const
+{
+    return eventCounts[static_cast<int>(event)];
+}
+
+inline const Histogram& ContainerStats::getLatencies(
+    StatOperation operation) const
+{
+    return latencies[static_cast<int>(operation)];
+}
+
+inline const Histogram& ContainerStats::getEventsPerOperation(
+    StatOperation operation, StatEvent event) const
+{
+    return eventsPerOperation[static_cast<int>(operation)]
+                             [static_cast<int>(event)];
+}
+
+inline void ContainerStats::reset()
+{
+    for (int op = 0; op < NUM_OPERATIONS; op++)
+    {
+        latencies[op].clear();
+        for (int i = 0; i < NUM_EVENTS; i++)
+        {
+            eventsPerOperation[op][i].clear();
+        }
+    }
+
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        eventCounts[i] = 0;
+    }
+}
+
+inline void ContainerStats::writeJson(std::ostream& out) const
+{
+    out << "{\"events\": {";
+    for (int i = 0; i < NUM_EVENTS; i++)
+    {
+        out << (i == 0 ? "" : ", ") << "\""
+            << getName(static_cast<StatEvent>(i)) << "\": "
+            << eventCounts[i];
+    }
+
+    out << "}, \"operations\": {";
+    bool isFirstOperation = true;
+    for (int op = 0; op < NUM_OPERATIONS; op++)
+    {
+        if (latencies[op].getCount() == 0)
+        {
+            continue;
+        }
+
+        out << (isFirstOperation ? "" : ", ") << "\""
+            << getName(static_cast<StatOperation>(op))
+            << "\": {\"latency_ns\": ";
+        latencies[op].writeJson(out);
+
+        // only the events which some operation caused
+        for (int i = 0; i < NUM_EVENTS; i++)
+        {
+            if (eventsPerOperation[op][i].getMax() != 0)
+            {
+                out << ", \"" << getName(static_cast<StatEvent>(i))
+                    << "\": ";
+                eventsPerOperation[op][i].writeJson(out);
+            }
+        }
+
+        out << "}";
+        isFirstOperation = false;
+    }
+
+    out << "}}";
+}
+
+inline std::string ContainerStats::toJson() const
+{
+    std::ostringstream out;
+    writeJson(out);
+    return out.str();
+}
+
+inline const char* ContainerStats::getName(StatEvent event)
+{
+    switch (event)
+    {
+        case StatEvent::COMPARISON:
+            return "comparison";
+        case StatEvent::NODE_ALLOCATION:
+            return "node_allocation";
+        case StatEvent::NODE_DEALLOCATION:
+            return "node_deallocation";
+        case StatEvent::RESIZE:
+            return "resize";
+        case StatEvent::HEAP_REBUILD_STEP:
+            return "heap_rebuild_step";
+        default:
+            return "unknown";
+    }
+}
+
+inline const char* ContainerStats::getName(StatOperation operation)
+{
+    switch (operation)
+    {
+        case StatOperation::ADD:
+            return "add";
+        case StatOperation::REMOVE:
+            return "remove";
+        case StatOperation::LOOKUP:
+            return "lookup";
+        default:
+            return "unknown";
+    }
+}
+
+#endif
@@ -0,0 +1,823 @@
+/**
+ * @class Deque
+ * @brief A double-ended queue of fixed-size blocks, found through a map of
+ * block pointers.
+ *
+ * Items are pushed and popped at both ends in amortized O(1) time: an end
+ * block that fills up gets a new neighbour, and one that empties is freed
+ * (the last one is kept to be reused, so that pushing and popping across a
+ * block boundary does not allocate every time). Only the map is ever
+ * reallocated, when it has no room for another block at an end, so an item
+ * keeps its address until it is popped. Item @c i is in block
+ * <tt>(frontOffset + i) / BLOCK_SIZE</tt> of the map, so indexing is O(1)
+ * too.
+ *
+ * The default block size is the largest power of two whose items fit in 512
+ * bytes, but at least 16 items, so that the divisions are shifts.
+ *
+ * Items do not need a default constructor. Pushing or popping invalidates
+ * iterators, but not pointers or references to the other items.
+ */
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "MemoryUsage.h"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T>
+struct DequeBlockSize
+{
+   static constexpr int getFloorPowerOfTwo(std::size_t n)
+   {
+      return n < 2 ? 1 : 2 * getFloorPowerOfTwo(n / 2);
+   }
+
+   static const int VALUE = 512 / sizeof(T) < 16 ? 16 :
+      getFloorPowerOfTwo(512 / sizeof(T));
+};
+
+template <class T, int BLOCK_SIZE = DequeBlockSize<T>::VALUE>
+class Deque
+{
+private:
+   static_assert(BLOCK_SIZE >= 1, "A block must hold at least one item.");
+
+   typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+   static const int MIN_MAP_CAPACITY = 8;
+
+   T** map;
+   int mapCapacity;
+   int firstBlock; ///< the blocks in use are map[firstBlock] onwards
+   int numBlocks;
+   int frontOffset; ///< where the first item is in map[firstBlock]
+   int count;
+   T* spareBlockPtr; ///< a freed block, kept to be reused
+
+   /**
+    * @return The address of item @c index, which may be one past the last.
+    */
+   T* getSlot(int index) const;
+
+   T* allocateBlock();
+
+   void releaseBlock(T* blockPtr);
+
+   /**
+    * Makes room in the map for one more block at the front or the back,
+    * recentring the blocks if the map is less than half full and
+    * reallocating it otherwise.
+    */
+   void reserveMapSlot(bool atFront);
+
+   /**
+    * Makes room for an item before the first, and moves the front to it.
+    * @return The address to construct the item at.
+    */
+   T* growFront();
+
+   /**
+    * @return The address to construct an item after the last at.
+    */
+   T* growBack();
+
+   /**
+    * Frees the first block if it holds no items.
+    */
+   void releaseFrontBlockIfEmpty();
+
+   /**
+    * Frees the last block if it holds no items.
+    */
+   void releaseBackBlockIfEmpty();
+
+   template <class Arg>
+   void emplaceFront(Arg&& item);
+
+   template <class Arg>
+   void emplaceBack(Arg&& item);
+
+   void copyFrom(const Deque<T, BLOCK_SIZE>& other);
+
+public:
+   /**
+    * A random access iterator; @c Item is @c T, or <tt>const T</tt> for a
+    * const_iterator.
+    */
+   template <class Item>
+   class Iterator
+   {
+   private:
+      T* const* blockPtr; ///< the entry of the item's block in the map
+      int offset;
+
+      friend class Deque<T, BLOCK_SIZE>;
+
+   public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Item* pointer;
+      typedef Item& reference;
+
+      Iterator(T* const* blockPtr, int offset)
+         : blockPtr(blockPtr), offset(offset)
+      {
+
+      }
+
+      /**
+       * Converts an iterator to a const_iterator.
+       */
+      template <class OtherItem, class = typename std::enable_if<
+         std::is_const<Item>::value &&
+         std::is_same<OtherItem, T>::value>::type>
+      Iterator(const Iterator<OtherItem>& other)
+         : blockPtr(other.blockPtr), offset(other.offset)
+      {
+
+      }
+
+      reference operator*() const
+      {
+         return (*blockPtr)[offset];
+      }
+
+      pointer operator->() const
+      {
+         return &(*blockPtr)[offset];
+      }
+
+      reference operator[](difference_type n) const
+      {
+         return *(*this + n);
+      }
+
+      Iterator<Item>& operator++()
+      {
+         if (++offset == BLOCK_SIZE)
+         {
+            blockPtr++;
+            offset = 0;
+         }
+         return *this;
+      }
+
+      Iterator<Item> operator++(int)
+      {
+         Iterator<Item> old = *this;
+         ++(*this);
+         return old;
+      }
+
+      Iterator<Item>& operator--()
+      {
+         if (offset-- == 0)
+         {
+            blockPtr--;
+            offset = BLOCK_SIZE - 1;
+         }
+         return *this;
+      }
+
+      Iterator<Item> operator--(int)
+      {
+         Iterator<Item> old = *this;
+         --(*this);
+         return old;
+      }
+
+      Iterator<Item>& operator+=(difference_type n)
+      {
+         difference_type position = offset + n;
+         difference_type blocks = position >= 0 ? position / BLOCK_SIZE :
+            -((-position - 1) / BLOCK_SIZE) - 1;
+         blockPtr += blocks;
+         offset = static_cast<int>(position - blocks * BLOCK_SIZE);
+         return *this;
+      }
+
+      Iterator<Item>& operator-=(difference_type n)
+      {
+         return *this += -n;
+      }
+
+      Iterator<Item> operator+(difference_type n) const
+      {
+         Iterator<Item> result = *this;
+         return result += n;
+      }
+
+      friend Iterator<Item> operator+(difference_type n,
+                                      const Iterator<Item>& it)
+      {
+         return it + n;
+      }
+
+      Iterator<Item> operator-(difference_type n) const
+      {
+         Iterator<Item> result = *this;
+         return result -= n;
+      }
+
+      difference_type operator-(const Iterator<Item>& other) const
+      {
+         return (blockPtr - other.blockPtr) * BLOCK_SIZE +
+            (offset - other.offset);
+      }
+
+      bool operator==(const Iterator<Item>& other) const
+      {
+         return blockPtr == other.blockPtr && offset == other.offset;
+      }
+
+      bool operator!=(const Iterator<Item>& other) const
+      {
+         return !(*this == other);
+      }
+
+      bool operator<(const Iterator<Item>& other) const
+      {
+         return *this - other < 0;
+      }
+
+      bool operator>(const Iterator<Item>& other) const
+      {
+         return other < *this;
+      }
+
+      bool operator<=(const Iterator<Item>& other) const
+      {
+         return !(other < *this);
+      }
+
+      bool operator>=(const Iterator<Item>& other) const
+      {
+         return !(*this < other);
+      }
+
+      template <class OtherItem>
+      friend class Iterator;
+   };
+
+   typedef Iterator<T> iterator;
+   typedef Iterator<const T> const_iterator;
+
+   Deque();
+
+   Deque(const Deque<T, BLOCK_SIZE>& other);
+
+   Deque(Deque<T, BLOCK_SIZE>&& other);
+
+   ~Deque();
+
+   Deque<T, BLOCK_SIZE>& operator=(const Deque<T, BLOCK_SIZE>& other);
+
+   Deque<T, BLOCK_SIZE>& operator=(Deque<T, BLOCK_SIZE>&& other);
+
+   void pushFront(const T& item);
+   void pushFront(T&& item);
+
+   void pushBack(const T& item);
+   void pushBack(T&& item);
+
+   /**
+    * Removes the first item.
+    * @return true if an item was removed, false if the deque was empty.
+    */
+   bool popFront();
+
+   /**
+    * Removes the last item.
+    * @return true if an item was removed, false if the deque was empty.
+    */
+   bool popBack();
+
+   /**
+    * @throws range_error if the deque is empty.
+    */
+   T& front();
+   const T& front() const;
+
+   /**
+    * @throws range_error if the deque is empty.
+    */
+   T& back();
+   const T& back() const;
+
+   /**
+    * @return The item at position @c index, counting from the front.
+    * @throws out_of_range if @c index is out of range.
+    */
+   T& get(int index);
+   const T& get(int index) const;
+
+   /**
+    * @c get, without the range check.
+    */
+   T& operator[](int index);
+   const T& operator[](int index) const;
+
+   int size() const;
+
+   bool empty() const;
+
+   /**
+    * Removes every item and frees every block but one.
+    */
+   void clear();
+
+   std::vector<T> toVector() const;
+
+   /**
+    * @return The number of blocks holding items.
+    */
+   int getNumBlocks() const;
+
+   /**
+    * @return The bytes the deque uses (see MemoryUsage.h). The unused slots
+    *         of the end blocks, and the spare block, are slack.
+    */
+   MemoryUsage memoryUsage() const;
+
+   /**
+    * Frees the spare block and reallocates the map to hold exactly the
+    * blocks in use. No item is moved.
+    */
+   void shrinkToFit();
+
+   iterator begin();
+   iterator end();
+   const_iterator begin() const;
+   const_iterator end() const;
+};
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>::Deque()
+   : map(nullptr), mapCapacity(0), firstBlock(0), numBlocks(0),
+     frontOffset(0), count(0), spareBlockPtr(nullptr)
+{
+
+}
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>::Deque(const Deque<T, BLOCK_SIZE>& other)
+   : Deque()
+{
+   copyFrom(other);
+}
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>::Deque(Deque<T, BLOCK_SIZE>&& other)
+   : Deque()
+{
+   *this = std::move(other);
+}
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>::~Deque()
+{
+   clear();
+   shrinkToFit();
+}
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>& Deque<T, BLOCK_SIZE>::operator=(
+   const Deque<T, BLOCK_SIZE>& other)
+{
+   if (this != &other)
+   {
+      clear();
+      copyFrom(other);
+   }
+
+   return *this;
+}
+
+template <class T, int BLOCK_SIZE>
+Deque<T, BLOCK_SIZE>& Deque<T, BLOCK_SIZE>::operator=(
+   Deque<T, BLOCK_SIZE>&& other)
+{
+   if (this != &other)
+   {
+      clear();
+      shrinkToFit();
+      std::swap(map, other.map);
+      std::swap(mapCapacity, other.mapCapacity);
+      std::swap(firstBlock, other.firstBlock);
+      std::swap(numBlocks, other.numBlocks);
+      std::swap(frontOffset, other.frontOffset);
+      std::swap(count, other.count);
+      std::swap(spareBlockPtr, other.spareBlockPtr);
+   }
+
+   return *this;
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::copyFrom(const Deque<T, BLOCK_SIZE>& other)
+{
+   for (const T& item : other)
+   {
+      pushBack(item);
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+T* Deque<T, BLOCK_SIZE>::getSlot(int index) const
+{
+   // unsigned, so that a power of two block size divides with a shift
+   unsigned position = frontOffset + index;
+   return map[firstBlock + position / BLOCK_SIZE] + position % BLOCK_SIZE;
+}
+
+template <class T, int BLOCK_SIZE>
+T* Deque<T, BLOCK_SIZE>::allocateBlock()
+{
+   if (spareBlockPtr != nullptr)
+   {
+      T* blockPtr = spareBlockPtr;
+      spareBlockPtr = nullptr;
+      return blockPtr;
+   }
+
+   return reinterpret_cast<T*>(new Slot[BLOCK_SIZE]);
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::releaseBlock(T* blockPtr)
+{
+   if (spareBlockPtr == nullptr)
+   {
+      spareBlockPtr = blockPtr;
+   }
+   else
+   {
+      delete[] reinterpret_cast<Slot*>(blockPtr);
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::reserveMapSlot(bool atFront)
+{
+   if (atFront ? firstBlock > 0 : firstBlock + numBlocks < mapCapacity)
+   {
+      return;
+   }
+
+   if (2 * numBlocks < mapCapacity)
+   {
+      // there is room at the other end, so move the blocks to the middle
+      int newFirstBlock = (mapCapacity - numBlocks) / 2;
+      std::memmove(map + newFirstBlock, map + firstBlock,
+                   numBlocks * sizeof(T*));
+      firstBlock = newFirstBlock;
+      return;
+   }
+
+   int newCapacity = 2 * mapCapacity > MIN_MAP_CAPACITY ? 2 * mapCapacity :
+      MIN_MAP_CAPACITY;
+   T** newMap = new T*[newCapacity];
+   int newFirstBlock = (newCapacity - numBlocks) / 2;
+   if (numBlocks > 0)
+   {
+      std::memcpy(newMap + newFirstBlock, map + firstBlock,
+                  numBlocks * sizeof(T*));
+   }
+   delete[] map;
+   map = newMap;
+   mapCapacity = newCapacity;
+   firstBlock = newFirstBlock;
+}
+
+template <class T, int BLOCK_SIZE>
+T* Deque<T, BLOCK_SIZE>::growFront()
+{
+   if (numBlocks == 0 || frontOffset == 0)
+   {
+      reserveMapSlot(true);
+      T* blockPtr = allocateBlock();
+      firstBlock -= numBlocks > 0 ? 1 : 0;
+      map[firstBlock] = blockPtr;
+      numBlocks++;
+      frontOffset = BLOCK_SIZE;
+   }
+
+   frontOffset--;
+   return map[firstBlock] + frontOffset;
+}
+
+template <class T, int BLOCK_SIZE>
+T* Deque<T, BLOCK_SIZE>::growBack()
+{
+   if (frontOffset + count == numBlocks * BLOCK_SIZE)
+   {
+      reserveMapSlot(false);
+      map[firstBlock + numBlocks] = allocateBlock();
+      numBlocks++;
+   }
+
+   return getSlot(count);
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::releaseFrontBlockIfEmpty()
+{
+   if (count == 0 || frontOffset == BLOCK_SIZE)
+   {
+      releaseBlock(map[firstBlock]);
+      numBlocks--;
+      firstBlock += numBlocks > 0 ? 1 : 0;
+      frontOffset = 0;
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::releaseBackBlockIfEmpty()
+{
+   if (count == 0 || frontOffset + count == (numBlocks - 1) * BLOCK_SIZE)
+   {
+      releaseBlock(map[firstBlock + numBlocks - 1]);
+      numBlocks--;
+      frontOffset = numBlocks > 0 ? frontOffset : 0;
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+template <class Arg>
+void Deque<T, BLOCK_SIZE>::emplaceFront(Arg&& item)
+{
+   T* slotPtr = growFront();
+   try
+   {
+      new (slotPtr) T(std::forward<Arg>(item));
+   }
+   catch (...)
+   {
+      // give back the slot, and the block if it was new
+      frontOffset++;
+      releaseFrontBlockIfEmpty();
+      throw;
+   }
+   count++;
+}
+
+template <class T, int BLOCK_SIZE>
+template <class Arg>
+void Deque<T, BLOCK_SIZE>::emplaceBack(Arg&& item)
+{
+   T* slotPtr = growBack();
+   try
+   {
+      new (slotPtr) T(std::forward<Arg>(item));
+   }
+   catch (...)
+   {
+      releaseBackBlockIfEmpty();
+      throw;
+   }
+   count++;
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::pushFront(const T& item)
+{
+   emplaceFront(item);
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::pushFront(T&& item)
+{
+   emplaceFront(std::move(item));
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::pushBack(const T& item)
+{
+   emplaceBack(item);
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::pushBack(T&& item)
+{
+   emplaceBack(std::move(item));
+}
+
+template <class T, int BLOCK_SIZE>
+bool Deque<T, BLOCK_SIZE>::popFront()
+{
+   if (count == 0)
+   {
+      return false;
+   }
+
+   map[firstBlock][frontOffset].~T();
+   frontOffset++;
+   count--;
+   releaseFrontBlockIfEmpty();
+   return true;
+}
+
+template <class T, int BLOCK_SIZE>
+bool Deque<T, BLOCK_SIZE>::popBack()
+{
+   if (count == 0)
+   {
+      return false;
+   }
+
+   getSlot(count - 1)->~T();
+   count--;
+   releaseBackBlockIfEmpty();
+   return true;
+}
+
+template <class T, int BLOCK_SIZE>
+T& Deque<T, BLOCK_SIZE>::front()
+{
+   if (count == 0)
+   {
+      throw std::range_error("Attempt to call Deque<T>::front() on an empty deque.");
+   }
+
+   return map[firstBlock][frontOffset];
+}
+
+template <class T, int BLOCK_SIZE>
+const T& Deque<T, BLOCK_SIZE>::front() const
+{
+   return const_cast<Deque<T, BLOCK_SIZE>*>(this)->front();
+}
+
+template <class T, int BLOCK_SIZE>
+T& Deque<T, BLOCK_SIZE>::back()
+{
+   if (count == 0)
+   {
+      throw std::range_error("Attempt to call Deque<T>::back() on an empty deque.");
+   }
+
+   return *getSlot(count - 1);
+}
+
+template <class T, int BLOCK_SIZE>
+const T& Deque<T, BLOCK_SIZE>::back() const
+{
+   return const_cast<Deque<T, BLOCK_SIZE>*>(this)->back();
+}
+
+template <class T, int BLOCK_SIZE>
+T& Deque<T, BLOCK_SIZE>::get(int index)
+{
+   if (index < 0 || index >= count)
+   {
+      throw std::out_of_range("Index out of range in Deque<T>::get.");
+   }
+
+   return *getSlot(index);
+}
+
+template <class T, int BLOCK_SIZE>
+const T& Deque<T, BLOCK_SIZE>::get(int index) const
+{
+   return const_cast<Deque<T, BLOCK_SIZE>*>(this)->get(index);
+}
+
+template <class T, int BLOCK_SIZE>
+T& Deque<T, BLOCK_SIZE>::operator[](int index)
+{
+   return *getSlot(index);
+}
+
+template <class T, int BLOCK_SIZE>
+const T& Deque<T, BLOCK_SIZE>::operator[](int index) const
+{
+   return *getSlot(index);
+}
+
+template <class T, int BLOCK_SIZE>
+int Deque<T, BLOCK_SIZE>::size() const
+{
+   return count;
+}
+
+template <class T, int BLOCK_SIZE>
+bool Deque<T, BLOCK_SIZE>::empty() const
+{
+   return count == 0;
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::clear()
+{
+   for (T& item : *this)
+   {
+      item.~T();
+   }
+
+   for (int i = 0; i < numBlocks; i++)
+   {
+      releaseBlock(map[firstBlock + i]);
+   }
+
+   firstBlock = mapCapacity / 2;
+   numBlocks = 0;
+   frontOffset = 0;
+   count = 0;
+}
+
+template <class T, int BLOCK_SIZE>
+std::vector<T> Deque<T, BLOCK_SIZE>::toVector() const
+{
+   return std::vector<T>(begin(), end());
+}
+
+template <class T, int BLOCK_SIZE>
+int Deque<T, BLOCK_SIZE>::getNumBlocks() const
+{
+   return numBlocks;
+}
+
+template <class T, int BLOCK_SIZE>
+MemoryUsage Deque<T, BLOCK_SIZE>::memoryUsage() const
+{
+   int numAllocatedBlocks = numBlocks + (spareBlockPtr != nullptr ? 1 : 0);
+
+   MemoryUsage usage;
+   usage.payloadBytes = count * sizeof(T);
+   usage.slackBytes = (numAllocatedBlocks * BLOCK_SIZE - count) * sizeof(T);
+   usage.overheadBytes = sizeof(*this) + mapCapacity * sizeof(T*);
+   if (mapCapacity > 0)
+   {
+      addAllocation(usage, mapCapacity * sizeof(T*));
+   }
+   for (int i = 0; i < numAllocatedBlocks; i++)
+   {
+      addAllocation(usage, BLOCK_SIZE * sizeof(T));
+   }
+   for (const T& item : *this)
+   {
+      addOwnedMemory(usage, item);
+   }
+
+   return usage;
+}
+
+template <class T, int BLOCK_SIZE>
+void Deque<T, BLOCK_SIZE>::shrinkToFit()
+{
+   delete[] reinterpret_cast<Slot*>(spareBlockPtr);
+   spareBlockPtr = nullptr;
+
+   if (numBlocks == mapCapacity)
+   {
+      return;
+   }
+
+   T** newMap = nullptr;
+   if (numBlocks > 0)
+   {
+      newMap = new T*[numBlocks];
+      std::memcpy(newMap, map + firstBlock, numBlocks * sizeof(T*));
+   }
+   delete[] map;
+   map = newMap;
+   mapCapacity = numBlocks;
+   firstBlock = 0;
+}
+
+template <class T, int BLOCK_SIZE>
+typename Deque<T, BLOCK_SIZE>::iterator Deque<T, BLOCK_SIZE>::begin()
+{
+   return iterator(map + firstBlock, frontOffset);
+}
+
+template <class T, int BLOCK_SIZE>
+typename Deque<T, BLOCK_SIZE>::iterator Deque<T, BLOCK_SIZE>::end()
+{
+   return begin() + count;
+}
+
+template <class T, int BLOCK_SIZE>
+typename Deque<T, BLOCK_SIZE>::const_iterator
+Deque<T, BLOCK_SIZE>::begin() const
+{
+   return const_iterator(map + firstBlock, frontOffset);
+}
+
+template <class T, int BLOCK_SIZE>
+typename Deque<T, BLOCK_SIZE>::const_iterator
+Deque<T, BLOCK_SIZE>::end() const
+{
+   return begin() + count;
+}
+
+#endif
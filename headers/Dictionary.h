@@ -4,10 +4,14 @@
 #ifndef DICTIONARY_H
 #define DICTIONARY_H
 
+#include <vector>
+
 template <class K, class V>
 class Dictionary
 {
 public:
+    virtual ~Dictionary() {}
+
     virtual bool isEmpty() const = 0;
 
     virtual int getSize() const = 0;
@@ -16,11 +20,76 @@ public:
 
     virtual bool remove(const K& key) = 0;
 
-    virtual const V& getValue(const K& key) const = 0;
+    /**
+     * @return A copy of the value associated with @c key. Values are copied
+     *         out so that a concurrent dictionary can finish reading one
+     *         before another thread removes or replaces it.
+     * @throws runtime_error if the key is not in the dictionary.
+     */
+    virtual V getValue(const K& key) const = 0;
+
+    /**
+     * Copies the value associated with @c key into @c outValue. This default
+     * looks the key up twice; implementations override it with one lookup.
+     * @return true if the key was found, false otherwise.
+     */
+    virtual bool tryGetValue(const K& key, V& outValue) const
+    {
+        if (!contains(key))
+        {
+            return false;
+        }
+
+        outValue = getValue(key);
+        return true;
+    }
 
     virtual bool contains(const K& key) const = 0;
 
     virtual void clear() = 0;
+
+    /**
+     * Looks up a batch of keys. Implementations may overlap the lookups so
+     * that their cache misses are serviced in parallel; this default simply
+     * performs them one at a time.
+     * @param keys The keys to look up.
+     * @param outValues Resized to @c keys.size(); element i is set to the
+     *                  value of @c keys[i] if it was found, and left
+     *                  default-constructed otherwise.
+     * @param outFound Resized to @c keys.size(); element i is set to whether
+     *                 @c keys[i] was found.
+     */
+    virtual void multiGet(const std::vector<K>& keys, std::vector<V>& outValues,
+                          std::vector<bool>& outFound) const
+    {
+        outValues.assign(keys.size(), V());
+        outFound.assign(keys.size(), false);
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            V value;
+            if (tryGetValue(keys[i], value))
+            {
+                outValues[i] = value;
+                outFound[i] = true;
+            }
+        }
+    }
+
+    /**
+     * Checks a batch of keys for membership.
+     * @param keys The keys to look up.
+     * @param outFound Resized to @c keys.size(); element i is set to whether
+     *                 @c keys[i] is in the dictionary.
+     */
+    virtual void multiContains(const std::vector<K>& keys,
+                               std::vector<bool>& outFound) const
+    {
+        outFound.assign(keys.size(), false);
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            outFound[i] = contains(keys[i]);
+        }
+    }
 };
 
 #endif
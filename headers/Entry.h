@@ -4,7 +4,10 @@
 #ifndef ENTRY_H
 #define ENTRY_H
 
+#include "MemoryUsage.h"
+#include "Prefetch.h"
 #include <stdexcept>
+#include <utility>
 
 template <class K, class V>
 class Entry
@@ -17,6 +20,7 @@ protected:
     virtual void setKey(const K& newKey);
 
 public:
+    Entry();
 
     Entry(const K& key);
 
@@ -24,27 +28,124 @@ public:
 
     Entry(const Entry<K,V>& other);
 
+    Entry(Entry<K,V>&& other);
+
     virtual ~Entry();
 
-    virtual const K& getKey();
+    Entry<K,V>& operator=(const Entry<K,V>& other);
+
+    Entry<K,V>& operator=(Entry<K,V>&& other);
+
+    virtual const K& getKey() const;
 
-    virtual const V& getValue();
+    virtual const V& getValue() const;
+
+    virtual V& getValue();
 
     virtual void setValue(const V& newValue);
 
-    friend bool operator<(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
+    virtual void setValue(V&& newValue);
+
+    /**
+     * Hints that the key, which the entry allocates separately, will soon
+     * be compared (see Prefetch.h).
+     */
+    void prefetchKey() const;
+
+    friend bool operator<(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return *lhs.keyPtr < *rhs.keyPtr;
+    }
+
+    friend bool operator>(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    friend bool operator==(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return *lhs.keyPtr == *rhs.keyPtr;
+    }
+
+    friend bool operator!=(const Entry<K,V>& lhs, const Entry<K,V>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    // Comparisons against a bare key, so that a search tree of entries can be
+    // searched without first allocating an Entry to hold the search key.
+    friend bool operator<(const Entry<K,V>& lhs, const K& rhs)
+    {
+        return *lhs.keyPtr < rhs;
+    }
+
+    friend bool operator<(const K& lhs, const Entry<K,V>& rhs)
+    {
+        return lhs < *rhs.keyPtr;
+    }
+
+    friend bool operator>(const Entry<K,V>& lhs, const K& rhs)
+    {
+        return rhs < *lhs.keyPtr;
+    }
+
+    friend bool operator>(const K& lhs, const Entry<K,V>& rhs)
+    {
+        return *rhs.keyPtr < lhs;
+    }
 
-    friend bool operator>(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
+    /**
+     * Adds the key and the value, which the entry allocates separately, to
+     * a breakdown of memory usage (see MemoryUsage.h).
+     */
+    friend void addOwnedMemory(MemoryUsage& usage, const Entry<K,V>& entry)
+    {
+        if (entry.keyPtr != nullptr)
+        {
+            usage.payloadBytes += sizeof(K);
+            addAllocation(usage, sizeof(K));
+            addOwnedMemory(usage, *entry.keyPtr);
+        }
+
+        if (entry.valuePtr != nullptr)
+        {
+            usage.payloadBytes += sizeof(V);
+            addAllocation(usage, sizeof(V));
+            addOwnedMemory(usage, *entry.valuePtr);
+        }
+    }
+};
 
-    friend bool operator<=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
-    
-    friend bool operator>=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
+/**
+ * Lets batched searches of a tree of entries prefetch each entry's key.
+ */
+template <class K, class V>
+struct KeyPrefetch<Entry<K,V>>
+{
+    static const bool ENABLED = true;
 
-    friend bool operator==(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
-    
-    friend bool operator!=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const;
+    static void prefetch(const Entry<K,V>& entry)
+    {
+        entry.prefetchKey();
+    }
 };
 
+template <class K, class V>
+Entry<K,V>::Entry() : keyPtr(nullptr), valuePtr(nullptr)
+{
+
+}
+
 template <class K, class V>
 Entry<K,V>::Entry(const K& key) : valuePtr(nullptr)
 {
@@ -61,8 +162,16 @@ Entry<K,V>::Entry(const K& key, const V& value)
 template <class K, class V>
 Entry<K,V>::Entry(const Entry<K,V>& other)
 {
-    keyPtr = new K(*(other.keyPtr));
-    valuePtr = new V(*(other.valuePtr));
+    keyPtr = (other.keyPtr != nullptr) ? new K(*(other.keyPtr)) : nullptr;
+    valuePtr = (other.valuePtr != nullptr) ? new V(*(other.valuePtr)) : nullptr;
+}
+
+template <class K, class V>
+Entry<K,V>::Entry(Entry<K,V>&& other)
+    : keyPtr(other.keyPtr), valuePtr(other.valuePtr)
+{
+    other.keyPtr = nullptr;
+    other.valuePtr = nullptr;
 }
 
 template <class K, class V>
@@ -80,11 +189,32 @@ Entry<K,V>::~Entry()
 }
 
 template <class K, class V>
-const K& Entry<K,V>::getKey()
+Entry<K,V>& Entry<K,V>::operator=(const Entry<K,V>& other)
+{
+    if (this != &other)
+    {
+        Entry<K,V> copy(other);
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+template <class K, class V>
+Entry<K,V>& Entry<K,V>::operator=(Entry<K,V>&& other)
+{
+    std::swap(keyPtr, other.keyPtr);
+    std::swap(valuePtr, other.valuePtr);
+    return *this;
+}
+
+template <class K, class V>
+const K& Entry<K,V>::getKey() const
 {
     if (keyPtr == nullptr)
     {
-        throw runtime_error("Entry<K,V>::getKey called on Entry with no key.");
+        throw std::runtime_error("Entry<K,V>::getKey called on Entry with no "
+                                 "key.");
     }
 
     return *keyPtr;
@@ -102,62 +232,62 @@ void Entry<K,V>::setKey(const K& newKey)
 }
 
 template <class K, class V>
-const V& Entry<K,V>::getValue()
+const V& Entry<K,V>::getValue() const
 {
     if (valuePtr == nullptr)
     {
-        throw runtime_error("Entry<K,V>::getValue called on Entry " + 
-                            "with no value.");
+        throw std::runtime_error("Entry<K,V>::getValue called on Entry "
+                                 "with no value.");
     }
 
     return *valuePtr;
 }
 
 template <class K, class V>
-void Entry<K,V>::setValue(const V& newValue)
+V& Entry<K,V>::getValue()
 {
-    if (valuePtr != nullptr)
+    if (valuePtr == nullptr)
     {
-        delete valuePtr;
+        throw std::runtime_error("Entry<K,V>::getValue called on Entry "
+                                 "with no value.");
     }
 
-    valuePtr = new V(newValue);
-}
-
-template <class K, class V>
-bool operator<(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
-{
-    return *lhs.key < *rhs.key;
-}
-
-template <class K, class V>
-bool operator>(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
-{
-    return rhs < lhs;
-}
-
-template <class K, class V>
-bool operator<=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
-{
-    return !(rhs < lhs);
+    return *valuePtr;
 }
 
 template <class K, class V>
-bool operator>=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
+void Entry<K,V>::setValue(const V& newValue)
 {
-    return !(lhs < rhs);
+    if (valuePtr != nullptr)
+    {
+        *valuePtr = newValue;
+    }
+    else
+    {
+        valuePtr = new V(newValue);
+    }
 }
 
 template <class K, class V>
-bool operator==(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
+void Entry<K,V>::setValue(V&& newValue)
 {
-    return *lhs.key == *rhs.key;
+    if (valuePtr != nullptr)
+    {
+        *valuePtr = std::move(newValue);
+    }
+    else
+    {
+        valuePtr = new V(std::move(newValue));
+    }
 }
 
 template <class K, class V>
-bool operator!=(const Entry<K,V>& lhs, const Entry<K,V>& rhs) const
+void Entry<K,V>::prefetchKey() const
 {
-    return !(lhs == rhs);
+    if (keyPtr != nullptr)
+    {
+        prefetchForRead(keyPtr);
+    }
 }
 
 #endif
@@ -0,0 +1,313 @@
+/**
+ * @class EpochManager
+ * @brief Epoch-based reclamation of memory shared between threads.
+ *
+ * Concurrent structures whose readers take no locks cannot free a node as
+ * soon as it is unlinked, since a reader may still be looking at it.
+ * Instead, every operation runs inside an @c EpochGuard, and unlinked nodes
+ * are passed to @c retire. A retired node is freed once every thread that
+ * was inside a guard when it was retired has left that guard.
+ *
+ * This is done with a global epoch counter. Entering a guard announces the
+ * current epoch in the thread's slot; the epoch can only advance once every
+ * thread inside a guard has announced it. A node retired in epoch e is
+ * unreachable for threads that enter in epoch e + 1 or later, so it can be
+ * freed once the epoch reaches e + 2.
+ *
+ * There is a single, process-wide manager, shared by every structure.
+ */
+
+#ifndef EPOCH_MANAGER_H
+#define EPOCH_MANAGER_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+class EpochManager
+{
+private:
+    struct RetiredNode
+    {
+        void* nodePtr;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    /**
+     * The announcement of one thread. @c localEpoch is the epoch the thread
+     * entered in, shifted left by one, with the low bit set while the thread
+     * is inside a guard.
+     */
+    struct alignas(64) ThreadSlot
+    {
+        std::atomic<std::uint64_t> localEpoch;
+        std::atomic<bool> inUse;
+        int guardDepth; ///< the number of nested guards
+        std::vector<RetiredNode> retired; ///< only used by the owner
+
+        ThreadSlot() : localEpoch(0), inUse(false), guardDepth(0)
+        {
+
+        }
+    };
+
+    /**
+     * Claims a slot for the calling thread on first use, and gives it back
+     * when the thread exits.
+     */
+    struct ThreadRegistration
+    {
+        ThreadSlot* slotPtr;
+
+        ThreadRegistration();
+        ~ThreadRegistration();
+    };
+
+    static const std::uint64_t ACTIVE_BIT = 1;
+
+    std::atomic<std::uint64_t> globalEpoch;
+    std::vector<ThreadSlot> slots;
+
+    EpochManager();
+
+    ThreadSlot& getSlot();
+
+    /**
+     * Advances the global epoch if every thread inside a guard has
+     * announced the current one.
+     */
+    void tryAdvance();
+
+    /**
+     * Frees the nodes of @c slot which were retired at least two epochs
+     * ago.
+     */
+    void freeRetired(ThreadSlot& slot, std::uint64_t safeEpoch);
+
+public:
+    /**
+     * The maximum number of threads that can use the manager at once.
+     */
+    static const int MAX_THREADS = 256;
+
+    /**
+     * The number of nodes a thread retires between attempts to free them.
+     */
+    static const int COLLECT_THRESHOLD = 128;
+
+    EpochManager(const EpochManager& other) = delete;
+
+    EpochManager& operator=(const EpochManager& other) = delete;
+
+    /**
+     * Frees every node still waiting to be freed. Runs at exit, when no
+     * other thread is using the manager.
+     */
+    ~EpochManager();
+
+    static EpochManager& getDefault();
+
+    /**
+     * Announces that the calling thread is about to read shared nodes.
+     * Guards may be nested.
+     */
+    void enter();
+
+    /**
+     * Ends the innermost guard of the calling thread.
+     */
+    void exit();
+
+    /**
+     * Schedules a node which is no longer reachable from its structure to
+     * be freed once no thread can still be reading it.
+     * @param nodePtr The unlinked node.
+     * @param deleter The function which frees it.
+     */
+    void retire(void* nodePtr, void (*deleter)(void*));
+
+    /**
+     * Schedules a node allocated with @c new to be deleted.
+     */
+    template <class Node>
+    void retire(Node* nodePtr);
+
+    /**
+     * Tries to advance the epoch and free the calling thread's retired
+     * nodes, without waiting for the retire threshold.
+     */
+    void collect();
+};
+
+/**
+ * Keeps the calling thread inside an epoch for its lifetime.
+ */
+class EpochGuard
+{
+public:
+    EpochGuard()
+    {
+        EpochManager::getDefault().enter();
+    }
+
+    ~EpochGuard()
+    {
+        EpochManager::getDefault().exit();
+    }
+
+    EpochGuard(const EpochGuard& other) = delete;
+
+    EpochGuard& operator=(const EpochGuard& other) = delete;
+};
+
+inline EpochManager::EpochManager() : globalEpoch(1), slots(MAX_THREADS)
+{
+
+}
+
+inline EpochManager::~EpochManager()
+{
+    for (ThreadSlot& slot : slots)
+    {
+        for (const RetiredNode& node : slot.retired)
+        {
+            node.deleter(node.nodePtr);
+        }
+        slot.retired.clear();
+    }
+}
+
+inline EpochManager& EpochManager::getDefault()
+{
+    static EpochManager manager;
+    return manager;
+}
+
+inline EpochManager::ThreadRegistration::ThreadRegistration()
+    : slotPtr(nullptr)
+{
+    EpochManager& manager = EpochManager::getDefault();
+    for (ThreadSlot& slot : manager.slots)
+    {
+        bool expected = false;
+        if (!slot.inUse.load(std::memory_order_relaxed) &&
+            slot.inUse.compare_exchange_strong(expected, true,
+                                               std::memory_order_acquire))
+        {
+            slotPtr = &slot;
+            return;
+        }
+    }
+
+    throw std::runtime_error("Too many threads in EpochManager.");
+}
+
+inline EpochManager::ThreadRegistration::~ThreadRegistration()
+{
+    // nodes the thread retired stay in the slot for its next owner, or for
+    // the manager's destructor
+    slotPtr->localEpoch.store(0, std::memory_order_release);
+    slotPtr->guardDepth = 0;
+    slotPtr->inUse.store(false, std::memory_order_release);
+}
+
+inline EpochManager::ThreadSlot& EpochManager::getSlot()
+{
+    static thread_local ThreadRegistration registration;
+    return *registration.slotPtr;
+}
+
+inline void EpochManager::enter()
+{
+    ThreadSlot& slot = getSlot();
+    if (slot.guardDepth++ > 0)
+    {
+        return;
+    }
+
+    // The announcement must be visible before any shared node is read, so
+    // this is a full barrier. It is also a read-modify-write, which keeps it
+    // in the release sequence of the previous exit.
+    std::uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+    slot.localEpoch.exchange((epoch << 1) | ACTIVE_BIT,
+                             std::memory_order_seq_cst);
+}
+
+inline void EpochManager::exit()
+{
+    ThreadSlot& slot = getSlot();
+    if (--slot.guardDepth > 0)
+    {
+        return;
+    }
+
+    slot.localEpoch.store(0, std::memory_order_release);
+}
+
+inline void EpochManager::tryAdvance()
+{
+    std::uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+    for (const ThreadSlot& slot : slots)
+    {
+        std::uint64_t localEpoch =
+            slot.localEpoch.load(std::memory_order_seq_cst);
+        if ((localEpoch & ACTIVE_BIT) != 0 && (localEpoch >> 1) != epoch)
+        {
+            return;
+        }
+    }
+
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1,
+                                        std::memory_order_seq_cst);
+}
+
+inline void EpochManager::freeRetired(ThreadSlot& slot,
+                                      std::uint64_t safeEpoch)
+{
+    std::size_t numKept = 0;
+    for (std::size_t i = 0; i < slot.retired.size(); i++)
+    {
+        RetiredNode node = slot.retired[i];
+        if (node.epoch + 2 <= safeEpoch)
+        {
+            node.deleter(node.nodePtr);
+        }
+        else
+        {
+            slot.retired[numKept++] = node;
+        }
+    }
+
+    slot.retired.resize(numKept);
+}
+
+inline void EpochManager::retire(void* nodePtr, void (*deleter)(void*))
+{
+    ThreadSlot& slot = getSlot();
+    slot.retired.push_back(RetiredNode {
+        nodePtr, deleter, globalEpoch.load(std::memory_order_seq_cst) });
+
+    if (slot.retired.size() % COLLECT_THRESHOLD == 0)
+    {
+        collect();
+    }
+}
+
+template <class Node>
+void EpochManager::retire(Node* nodePtr)
+{
+    retire(nodePtr, [](void* retiredPtr)
+    {
+        delete static_cast<Node*>(retiredPtr);
+    });
+}
+
+inline void EpochManager::collect()
+{
+    tryAdvance();
+    freeRetired(getSlot(), globalEpoch.load(std::memory_order_acquire));
+}
+
+#endif
@@ -0,0 +1,481 @@
+/**
+ * @class EytzingerIndex
+ * @brief A read-only sorted index for fast lookups, typically made by
+ * freezing a @c BinarySearchTree or @c BSTMap once it has been built.
+ *
+ * The items are stored in a single cache-line-aligned array in Eytzinger
+ * (breadth-first) order: the root at position 1 and the children of
+ * position k at 2k and 2k + 1. This is the layout of a perfectly balanced
+ * binary search tree with implicit links, so a search touches the same
+ * sequence of nodes as in a tree, but:
+ * - there are no pointers, so the index takes exactly one array slot per
+ *   item;
+ * - the descent is branchless (the next position is computed from the
+ *   comparison instead of branching on it), so it never mispredicts;
+ * - the nodes four levels below the current one share a cache line, which
+ *   is prefetched at every step, so the memory latency of later levels
+ *   overlaps with the comparisons of earlier ones.
+ *
+ * @c findItems searches for a batch of keys in lockstep, and for 32-bit
+ * integer and @c float keys compares four searches at a time with SSE2.
+ */
+
+#ifndef EYTZINGER_INDEX_H
+#define EYTZINGER_INDEX_H
+
+#include "Prefetch.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * An allocator which aligns arrays to cache line boundaries.
+ */
+template <class T>
+struct CacheAlignedAllocator
+{
+    typedef T value_type;
+
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    CacheAlignedAllocator()
+    {
+
+    }
+
+    template <class U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&)
+    {
+
+    }
+
+    T* allocate(std::size_t count)
+    {
+        return static_cast<T*>(::operator new(count * sizeof(T),
+            std::align_val_t(CACHE_LINE_SIZE)));
+    }
+
+    void deallocate(T* arrayPtr, std::size_t)
+    {
+        ::operator delete(arrayPtr, std::align_val_t(CACHE_LINE_SIZE));
+    }
+
+    template <class U>
+    bool operator==(const CacheAlignedAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const CacheAlignedAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
+template <class T>
+class EytzingerIndex
+{
+private:
+    /**
+     * Position k's descendants four levels down occupy positions 16k to
+     * 16k + 15, which is one cache line for 4-byte items. In general, the
+     * descendants that share a cache line are prefetched.
+     */
+    static constexpr std::size_t PREFETCH_STRIDE =
+        (sizeof(T) >= 64) ? 1 : (sizeof(T) > 32) ? 2 : (sizeof(T) > 16) ? 4 :
+        (sizeof(T) > 8) ? 8 : 16;
+
+    /** Whether findItems compares with SSE2 rather than one at a time. */
+    static constexpr bool USE_SSE2 =
+#if defined(__SSE2__)
+        std::is_same<T, std::int32_t>::value || std::is_same<T, float>::value;
+#else
+        false;
+#endif
+
+    /** items[0] is unused; items[1..numItems] are in Eytzinger order. */
+    std::vector<T, CacheAlignedAllocator<T>> items;
+    std::size_t numItems;
+
+    /**
+     * Places @c sortedItems[next...] at the positions of the subtree rooted
+     * at @c position, in order.
+     */
+    void buildHelper(std::vector<T>& sortedItems, std::size_t& next,
+                     std::size_t position);
+
+    /**
+     * @return The position of the first item not less than @c key, or 0 if
+     *         every item is less than @c key.
+     */
+    template <class Key>
+    std::size_t lowerBoundPosition(const Key& key) const;
+
+    template <class Key>
+    void findItemsScalar(const Key* keys, int count, const T** results) const;
+
+    void findItemsSse2(const T* keys, int count, const T** results) const;
+
+public:
+    /**
+     * Constructs an empty index.
+     */
+    EytzingerIndex();
+
+    /**
+     * Builds an index of @c sortedItems, which must be sorted in increasing
+     * order without duplicates. The items are moved out of the vector.
+     */
+    explicit EytzingerIndex(std::vector<T>&& sortedItems);
+
+    bool empty() const;
+
+    int getNumItems() const;
+
+    /**
+     * Searches for the item which compares equal to @c key. @c Key may be
+     * @c T itself, or any type that can be compared with @c T using @c < and
+     * @c >, as for @c BinarySearchTree::findItem.
+     * @return A pointer to the item, or @c nullptr if there is no such item.
+     */
+    template <class Key>
+    const T* findItem(const Key& key) const;
+
+    template <class Key>
+    bool contains(const Key& key) const;
+
+    /**
+     * @return A pointer to the smallest item which is not less than @c key,
+     *         or @c nullptr if there is none.
+     */
+    template <class Key>
+    const T* lowerBound(const Key& key) const;
+
+    /**
+     * Searches for a batch of keys at once. Groups of searches are advanced
+     * one level at a time in lockstep, so that their cache misses overlap.
+     * @param keys The search keys.
+     * @param count The number of keys.
+     * @param results An array of @c count pointers; element i is set to the
+     *                item which compares equal to @c keys[i], or @c nullptr.
+     */
+    template <class Key>
+    void findItems(const Key* keys, int count, const T** results) const;
+
+    /**
+     * Calls @c visit(const T&) for every item in increasing order.
+     */
+    template <class Function>
+    void inorderForEach(Function visit) const;
+};
+
+template <class T>
+EytzingerIndex<T>::EytzingerIndex() : numItems(0)
+{
+
+}
+
+template <class T>
+EytzingerIndex<T>::EytzingerIndex(std::vector<T>&& sortedItems)
+    : numItems(sortedItems.size())
+{
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    // position 0 is never searched, but must hold some item
+    items.reserve(numItems + 1);
+    items.resize(numItems + 1, sortedItems[0]);
+
+    std::size_t next = 0;
+    buildHelper(sortedItems, next, 1);
+
+    std::vector<T>().swap(sortedItems);
+}
+
+template <class T>
+void EytzingerIndex<T>::buildHelper(std::vector<T>& sortedItems,
+        std::size_t& next, std::size_t position)
+{
+    // the recursion is only as deep as the tree, about log2(numItems)
+    if (position > numItems)
+    {
+        return;
+    }
+
+    buildHelper(sortedItems, next, 2 * position);
+    items[position] = std::move(sortedItems[next++]);
+    buildHelper(sortedItems, next, 2 * position + 1);
+}
+
+template <class T>
+bool EytzingerIndex<T>::empty() const
+{
+    return numItems == 0;
+}
+
+template <class T>
+int EytzingerIndex<T>::getNumItems() const
+{
+    return static_cast<int>(numItems);
+}
+
+template <class T>
+template <class Key>
+std::size_t EytzingerIndex<T>::lowerBoundPosition(const Key& key) const
+{
+    const T* data = items.data();
+    std::size_t position = 1;
+    while (position <= numItems)
+    {
+        std::size_t prefetchPosition = position * PREFETCH_STRIDE;
+        prefetchForRead(data + ((prefetchPosition <= numItems) ?
+                                prefetchPosition : 0));
+        position = 2 * position + (data[position] < key);
+    }
+
+    // The search went right (to a smaller item) at each trailing 1 bit, and
+    // left for the last time at the lowest 0 bit: that is the answer.
+    position >>= __builtin_ctzll(~static_cast<unsigned long long>(position))
+                 + 1;
+    return position;
+}
+
+template <class T>
+template <class Key>
+const T* EytzingerIndex<T>::findItem(const Key& key) const
+{
+    std::size_t position = lowerBoundPosition(key);
+    if (position == 0 || items[position] > key)
+    {
+        return nullptr;
+    }
+
+    return &items[position];
+}
+
+template <class T>
+template <class Key>
+bool EytzingerIndex<T>::contains(const Key& key) const
+{
+    return findItem(key) != nullptr;
+}
+
+template <class T>
+template <class Key>
+const T* EytzingerIndex<T>::lowerBound(const Key& key) const
+{
+    std::size_t position = lowerBoundPosition(key);
+    return (position != 0) ? &items[position] : nullptr;
+}
+
+template <class T>
+template <class Key>
+void EytzingerIndex<T>::findItems(const Key* keys, int count,
+        const T** results) const
+{
+    if constexpr (USE_SSE2 && std::is_same<Key, T>::value)
+    {
+        findItemsSse2(keys, count, results);
+    }
+    else
+    {
+        findItemsScalar(keys, count, results);
+    }
+}
+
+template <class T>
+template <class Key>
+void EytzingerIndex<T>::findItemsScalar(const Key* keys, int count,
+        const T** results) const
+{
+    const int GROUP_SIZE = 16;
+    std::size_t positions[GROUP_SIZE];
+    const T* data = items.data();
+
+    for (int groupStart = 0; groupStart < count; groupStart += GROUP_SIZE)
+    {
+        int groupSize = count - groupStart;
+        if (groupSize > GROUP_SIZE)
+        {
+            groupSize = GROUP_SIZE;
+        }
+
+        for (int i = 0; i < groupSize; i++)
+        {
+            positions[i] = 1;
+        }
+
+        // every search descends the same number of full levels; only the
+        // last, partial level differs
+        for (std::size_t levelStart = 1; levelStart <= numItems;
+             levelStart *= 2)
+        {
+            for (int i = 0; i < groupSize; i++)
+            {
+                std::size_t position = positions[i];
+                if (position <= numItems)
+                {
+                    std::size_t prefetchPosition = position * PREFETCH_STRIDE;
+                    prefetchForRead(data + ((prefetchPosition <= numItems) ?
+                                            prefetchPosition : 0));
+                    positions[i] = 2 * position +
+                                   (data[position] < keys[groupStart + i]);
+                }
+            }
+        }
+
+        for (int i = 0; i < groupSize; i++)
+        {
+            std::size_t position = positions[i];
+            position >>= __builtin_ctzll(
+                ~static_cast<unsigned long long>(position)) + 1;
+            const Key& key = keys[groupStart + i];
+            results[groupStart + i] =
+                (position == 0 || data[position] > key) ?
+                nullptr : &data[position];
+        }
+    }
+}
+
+template <class T>
+void EytzingerIndex<T>::findItemsSse2(const T* keys, int count,
+        const T** results) const
+{
+#if defined(__SSE2__)
+    const int LANES = 4;
+    const T* data = items.data();
+
+    for (int groupStart = 0; groupStart + LANES <= count;
+         groupStart += LANES)
+    {
+        // positions stay below 2^31, since there are fewer than 2^30 items
+        // whenever this is used (see below)
+        alignas(16) std::int32_t positions[LANES];
+        __m128i positionVector = _mm_set1_epi32(1);
+        __m128i keyVector;
+        if constexpr (std::is_same<T, float>::value)
+        {
+            keyVector = _mm_castps_si128(_mm_loadu_ps(keys + groupStart));
+        }
+        else
+        {
+            keyVector = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(keys + groupStart));
+        }
+
+        // the full levels, which every search passes through
+        std::size_t fullLevels = 0;
+        while ((std::size_t(2) << fullLevels) - 1 <= numItems)
+        {
+            fullLevels++;
+        }
+
+        for (std::size_t level = 0; level < fullLevels; level++)
+        {
+            _mm_store_si128(reinterpret_cast<__m128i*>(positions),
+                            positionVector);
+            for (int i = 0; i < LANES; i++)
+            {
+                std::size_t prefetchPosition =
+                    std::size_t(positions[i]) * PREFETCH_STRIDE;
+                prefetchForRead(data + ((prefetchPosition <= numItems) ?
+                                        prefetchPosition : 0));
+            }
+
+            __m128i less;
+            if constexpr (std::is_same<T, float>::value)
+            {
+                __m128 nodeVector = _mm_setr_ps(
+                    data[positions[0]], data[positions[1]],
+                    data[positions[2]], data[positions[3]]);
+                less = _mm_castps_si128(
+                    _mm_cmplt_ps(nodeVector, _mm_castsi128_ps(keyVector)));
+            }
+            else
+            {
+                __m128i nodeVector = _mm_setr_epi32(
+                    data[positions[0]], data[positions[1]],
+                    data[positions[2]], data[positions[3]]);
+                less = _mm_cmplt_epi32(nodeVector, keyVector);
+            }
+
+            // position = 2 * position + (less ? 1 : 0), and less is -1 or 0
+            positionVector = _mm_sub_epi32(
+                _mm_add_epi32(positionVector, positionVector), less);
+        }
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(positions), positionVector);
+        for (int i = 0; i < LANES; i++)
+        {
+            std::size_t position = positions[i];
+            const T& key = keys[groupStart + i];
+            // the last, partial level
+            if (position <= numItems)
+            {
+                position = 2 * position + (data[position] < key);
+            }
+
+            position >>= __builtin_ctzll(
+                ~static_cast<unsigned long long>(position)) + 1;
+            results[groupStart + i] =
+                (position == 0 || data[position] > key) ?
+                nullptr : &data[position];
+        }
+    }
+
+    int remainder = count % LANES;
+    findItemsScalar(keys + count - remainder, remainder,
+                    results + count - remainder);
+#else
+    findItemsScalar(keys, count, results);
+#endif
+}
+
+template <class T>
+template <class Function>
+void EytzingerIndex<T>::inorderForEach(Function visit) const
+{
+    if (numItems == 0)
+    {
+        return;
+    }
+
+    // start at the leftmost position, then step to each successor
+    std::size_t position = 1;
+    while (2 * position <= numItems)
+    {
+        position *= 2;
+    }
+
+    while (position != 0)
+    {
+        visit(static_cast<const T&>(items[position]));
+
+        if (2 * position + 1 <= numItems)
+        {
+            // the leftmost position of the right subtree
+            position = 2 * position + 1;
+            while (2 * position <= numItems)
+            {
+                position *= 2;
+            }
+        }
+        else
+        {
+            // up past every ancestor of which this is the right subtree
+            position >>= __builtin_ctzll(
+                ~static_cast<unsigned long long>(position)) + 1;
+        }
+    }
+}
+
+#endif
@@ -2,15 +2,20 @@
  * Array-based Binary Max-heap Implementation
  */
 
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "ContainerStats.h"
+#include "MemoryUsage.h"
 #include <stdexcept>
-#include <cmath>
+#include <utility>
 
-template <class T>
-class Heap
+template <class T, class Stats = NoStats>
+class Heap : private Stats
 {
 private:
-    const int ROOT_INDEX = 0; ///< index of the root
-    const int DEFAULT_CAPACITY = 15; ///< default capacity to initialize array 
+    static const int ROOT_INDEX = 0; ///< index of the root
+    static const int DEFAULT_CAPACITY = 15; ///< initial capacity of the array
 
     T* items; ///< the array of items representing a heap
     int itemCount; ///< the number of items in the heap
@@ -86,8 +91,12 @@ public:
      */
     Heap(const T* array, const int size);
 
+    Heap(const Heap<T, Stats>& other);
+
     virtual ~Heap();
 
+    Heap<T, Stats>& operator=(const Heap<T, Stats>& other);
+
     /**
      * Determines if the heap is empty.
      * @return true if the heap is empty, false otherwise.
@@ -128,20 +137,40 @@ public:
     virtual bool remove();
 
     /**
-     * Removes all items from the heap.
+     * Removes all items from the heap. The array is kept, so that the heap
+     * can be refilled without reallocating.
      */
     virtual void clear();
 
+    /**
+     * @return The bytes the heap uses (see MemoryUsage.h). The unused
+     *         capacity of the array is slack, including any memory still
+     *         owned by items which were removed but not yet overwritten.
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * Reallocates the array to hold exactly @c getNumNodes() items,
+     * releasing the unused capacity. The heap grows again as usual.
+     */
+    void shrinkToFit();
+
+    /**
+     * @return The heap's instrumentation (see ContainerStats.h). Each level
+     *         an item moves up or down is a @c HEAP_REBUILD_STEP.
+     */
+    const Stats& getStats() const;
+    Stats& getStats();
 };
 
-template <class T>
-Heap<T>::Heap() : itemCount(0), capacity(DEFAULT_CAPACITY)
+template <class T, class Stats>
+Heap<T, Stats>::Heap() : itemCount(0), capacity(DEFAULT_CAPACITY)
 {
     items = new T[capacity];
 }
 
-template <class T>
-Heap<T>::Heap(const T* array, const int size) : capacity(size)
+template <class T, class Stats>
+Heap<T, Stats>::Heap(const T* array, const int size) : capacity(size)
 {
     items = new T[size];
     itemCount = size;
@@ -153,14 +182,46 @@ Heap<T>::Heap(const T* array, const int size) : capacity(size)
     heapify();
 }
 
-template <class T>
-Heap<T>::~Heap()
+template <class T, class Stats>
+Heap<T, Stats>::Heap(const Heap<T, Stats>& other)
+    : itemCount(other.itemCount), capacity(other.capacity)
 {
-    clear();
+    items = new T[capacity];
+    for (int i = 0; i < itemCount; i++)
+    {
+        items[i] = other.items[i];
+    }
 }
 
-template <class T>
-int Heap<T>::getLeftChildIndex(const int parentIndex) const
+template <class T, class Stats>
+Heap<T, Stats>::~Heap()
+{
+    delete[] items;
+    items = nullptr;
+}
+
+template <class T, class Stats>
+Heap<T, Stats>& Heap<T, Stats>::operator=(const Heap<T, Stats>& other)
+{
+    if (this != &other)
+    {
+        T* newItems = new T[other.capacity];
+        for (int i = 0; i < other.itemCount; i++)
+        {
+            newItems[i] = other.items[i];
+        }
+
+        delete[] items;
+        items = newItems;
+        itemCount = other.itemCount;
+        capacity = other.capacity;
+    }
+
+    return *this;
+}
+
+template <class T, class Stats>
+int Heap<T, Stats>::getLeftChildIndex(const int parentIndex) const
 {
     if (parentIndex < 0)
     {
@@ -171,8 +232,8 @@ int Heap<T>::getLeftChildIndex(const int parentIndex) const
     return (leftChildIndex < itemCount) ? leftChildIndex : -1;
 }
 
-template <class T>
-int Heap<T>::getRightChildIndex(const int parentIndex) const
+template <class T, class Stats>
+int Heap<T, Stats>::getRightChildIndex(const int parentIndex) const
 {
     if (parentIndex < 0)
     {
@@ -183,8 +244,8 @@ int Heap<T>::getRightChildIndex(const int parentIndex) const
     return (rightChildIndex < itemCount) ? rightChildIndex : -1;
 }
 
-template <class T>
-int Heap<T>::getParentIndex(const int childIndex) const
+template <class T, class Stats>
+int Heap<T, Stats>::getParentIndex(const int childIndex) const
 {
     if (childIndex <= 0 || childIndex >= itemCount)
     {
@@ -195,8 +256,8 @@ int Heap<T>::getParentIndex(const int childIndex) const
     return parentIndex;
 }
 
-template <class T>
-bool Heap<T>::isLeaf(const int index) const
+template <class T, class Stats>
+bool Heap<T, Stats>::isLeaf(const int index) const
 {
     if (index < 0 || index >= itemCount)
     {
@@ -204,55 +265,61 @@ bool Heap<T>::isLeaf(const int index) const
     }
     else
     {
-        return index >= (itemCount + 1) / 2;
+        // the first leaf follows the last item's parent
+        return index >= itemCount / 2;
     }
 }
 
-template <class T>
-void Heap<T>::swap(int index1, int index2)
+template <class T, class Stats>
+void Heap<T, Stats>::swap(int index1, int index2)
 {
     if (index1 < 0 || index1 >= itemCount || index2 < 0 || index2 >= itemCount)
     {
         throw std::range_error("Out of range in Heap<T>::swap");
     }
 
-    T temp = items[index1];
-    items[index1] = items[index2];
-    items[index2] = temp;
+    std::swap(items[index1], items[index2]);
 }
 
-template <class T>
-void Heap<T>::heapRebuild(int subtreeIndex)
+template <class T, class Stats>
+void Heap<T, Stats>::heapRebuild(int subtreeIndex)
 {
     if (subtreeIndex < 0 || subtreeIndex >= itemCount)
     {
-        throw std::range_error("Passed an invalid index parameter to\
-                                Heap<T>::heapRebuild.");
+        throw std::range_error("Passed an invalid index parameter to "
+                               "Heap<T>::heapRebuild.");
     }
 
-    int left = getLeftChildIndex(subtreeIndex);
-    int right = getRightChildIndex(subtreeIndex);
-    
-    if (isLeaf(subtreeIndex) || (items[subtreeIndex] >= items[left] && 
-                                 items[subtreeIndex] >= items[right]))
+    if (isLeaf(subtreeIndex))
     {
         return;
     }
 
-    if (items[left] >= items[right])
+    // the larger child; the last parent may have only a left child
+    int larger = getLeftChildIndex(subtreeIndex);
+    int right = getRightChildIndex(subtreeIndex);
+    if (right >= 0)
     {
-        swap(subtreeIndex, left);
-        heapRebuild(left);
+        this->recordEvent(StatEvent::COMPARISON);
+        if (items[right] > items[larger])
+        {
+            larger = right;
+        }
     }
-    else
+
+    this->recordEvent(StatEvent::COMPARISON);
+    if (items[subtreeIndex] >= items[larger])
     {
-        swap(subtreeIndex, right);
-        heapRebuild(right);
+        return;
     }
+
+    this->recordEvent(StatEvent::HEAP_REBUILD_STEP);
+    swap(subtreeIndex, larger);
+    heapRebuild(larger);
 }
 
-template <class T>
-void Heap<T>::heapify()
+template <class T, class Stats>
+void Heap<T, Stats>::heapify()
 {
     for (int i = itemCount / 2 - 1; i >= 0; i--)
     {
@@ -260,52 +327,61 @@ void Heap<T>::heapify()
     }
 }
 
-template <class T>
-void Heap<T>::resize()
+template <class T, class Stats>
+void Heap<T, Stats>::resize()
 {
-    capacity *= 2;
+    this->recordEvent(StatEvent::RESIZE);
+    capacity = capacity > 0 ? capacity * 2 : DEFAULT_CAPACITY;
     T* newArray = new T[capacity];
     for (int i = 0; i < itemCount; ++i)
     {
-        newArray[i] = items[i];
+        newArray[i] = std::move(items[i]);
     }
     delete[] items;
     items = newArray;
 }
 
-template <class T>
-bool Heap<T>::isEmpty() const
+template <class T, class Stats>
+bool Heap<T, Stats>::isEmpty() const
 {
     return itemCount == 0;
 }
 
-template <class T>
-int Heap<T>::getNumNodes() const
+template <class T, class Stats>
+int Heap<T, Stats>::getNumNodes() const
 {
     return itemCount;
 }
 
-template <class T>
-int Heap<T>::getHeight() const
+template <class T, class Stats>
+int Heap<T, Stats>::getHeight() const
 {
-    return ceil(log2(itemCount));
+    // floor(log2(itemCount)) + 1, since the heap is a complete tree
+    int height = 0;
+    for (int numItems = itemCount; numItems > 0; numItems >>= 1)
+    {
+        height++;
+    }
+
+    return height;
 }
 
-template <class T>
-const T& Heap<T>::peekTop() const
+template <class T, class Stats>
+const T& Heap<T, Stats>::peekTop() const
 {
     if (isEmpty())
     {
-        throw std::range_error("Tried to call Heap<T>::peekTop() on an empty \
-                                heap.");
+        throw std::range_error("Tried to call Heap<T>::peekTop() on an empty "
+                               "heap.");
     }
 
     return items[ROOT_INDEX];
 }
 
-template <class T>
-bool Heap<T>::add(const T& newData)
+template <class T, class Stats>
+bool Heap<T, Stats>::add(const T& newData)
 {
+    typename Stats::Timer timer(*this, StatOperation::ADD);
     if (itemCount == capacity)
     {
         resize();
@@ -319,8 +395,10 @@ bool Heap<T>::add(const T& newData)
     while (i > 0 && itemCount != 1)
     {
         int parentIndex = getParentIndex(i);
+        this->recordEvent(StatEvent::COMPARISON);
         if (items[i] > items[parentIndex])
         {
+            this->recordEvent(StatEvent::HEAP_REBUILD_STEP);
             swap(i, parentIndex);
             i = parentIndex;
         }
@@ -333,9 +411,10 @@ bool Heap<T>::add(const T& newData)
     return true;
 }
 
-template <class T>
-bool Heap<T>::remove()
+template <class T, class Stats>
+bool Heap<T, Stats>::remove()
 {
+    typename Stats::Timer timer(*this, StatOperation::REMOVE);
     if (isEmpty())
     {
         return false;
@@ -355,10 +434,63 @@ bool Heap<T>::remove()
     return true;
 }
 
-template <class T>
-void Heap<T>::clear()
+template <class T, class Stats>
+void Heap<T, Stats>::clear()
 {
-    delete[] items;
-    items = nullptr;
     itemCount = 0;
 }
+
+template <class T, class Stats>
+MemoryUsage Heap<T, Stats>::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.payloadBytes = itemCount * sizeof(T);
+    usage.slackBytes = (capacity - itemCount) * sizeof(T);
+    usage.overheadBytes = sizeof(*this) + getArrayCookieBytes<T>();
+    addAllocation(usage, capacity * sizeof(T) + getArrayCookieBytes<T>());
+    for (int i = 0; i < itemCount; i++)
+    {
+        addOwnedMemory(usage, items[i]);
+    }
+
+    MemoryUsage removedUsage;
+    for (int i = itemCount; i < capacity; i++)
+    {
+        addOwnedMemory(removedUsage, items[i]);
+    }
+    usage.slackBytes += removedUsage.getTotalBytes();
+
+    return usage;
+}
+
+template <class T, class Stats>
+void Heap<T, Stats>::shrinkToFit()
+{
+    if (capacity == itemCount)
+    {
+        return;
+    }
+
+    T* newArray = new T[itemCount];
+    for (int i = 0; i < itemCount; i++)
+    {
+        newArray[i] = std::move(items[i]);
+    }
+    delete[] items;
+    items = newArray;
+    capacity = itemCount;
+}
+
+template <class T, class Stats>
+const Stats& Heap<T, Stats>::getStats() const
+{
+    return *this;
+}
+
+template <class T, class Stats>
+Stats& Heap<T, Stats>::getStats()
+{
+    return *this;
+}
+
+#endif
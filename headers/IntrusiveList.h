@@ -0,0 +1,493 @@
+/**
+ * @class IntrusiveList
+ * @brief A doubly linked list of objects which hold their own links, in an
+ * @c IntrusiveListHook member.
+ *
+ * A @c LinkedList copies each item into a node it allocates. Here the list
+ * links the objects themselves, which the caller owns and keeps alive while
+ * they are linked, so linking and unlinking never allocate or copy, and an
+ * object can be removed in O(1) time given only a reference to it.
+ *
+ * @c HOOK names the member the list uses, so an object with several hooks
+ * can be on several lists at once; by default it is a member called
+ * @c listHook. An object can be on only one list per hook. The list is
+ * circular, with the head's previous link pointing to the tail, so both ends
+ * are reachable in O(1) time and an unlinked hook is one whose links are
+ * @c nullptr.
+ *
+ * Destroying or clearing the list unlinks its objects but does not destroy
+ * them. Removing an object invalidates only the iterators to it.
+ */
+
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+template <class T>
+class IntrusiveListHook
+{
+private:
+   T* nextPtr;
+   T* prevPtr;
+#ifndef NDEBUG
+   // the list the object is on, so that debug builds catch a remove from
+   // another list
+   const void* ownerPtr = nullptr;
+#endif
+
+   template <class OtherT, IntrusiveListHook<OtherT> OtherT::*HOOK>
+   friend class IntrusiveList;
+
+public:
+   IntrusiveListHook() : nextPtr(nullptr), prevPtr(nullptr)
+   {
+
+   }
+
+   // a copy of an object is not on its lists
+   IntrusiveListHook(const IntrusiveListHook<T>&)
+      : nextPtr(nullptr), prevPtr(nullptr)
+   {
+
+   }
+
+   IntrusiveListHook<T>& operator=(const IntrusiveListHook<T>&)
+   {
+      return *this;
+   }
+
+   /**
+    * @return true if the object holding this hook is on a list.
+    */
+   bool isLinked() const
+   {
+      return nextPtr != nullptr;
+   }
+};
+
+template <class T, IntrusiveListHook<T> T::*HOOK = &T::listHook>
+class IntrusiveList
+{
+private:
+   T* headPtr;
+   int count;
+
+   static IntrusiveListHook<T>& hookOf(T& item)
+   {
+      return item.*HOOK;
+   }
+
+   /**
+    * Links an unlinked item in before @c nextPtr, which is on the list, or
+    * at the end if @c nextPtr is @c nullptr.
+    * @throws runtime_error if the item is already on a list.
+    */
+   void linkBefore(T* nextPtr, T& item);
+
+public:
+   /**
+    * A bidirectional iterator; @c Item is @c T, or <tt>const T</tt> for a
+    * const_iterator.
+    */
+   template <class Item>
+   class Iterator
+   {
+   private:
+      T* curPtr; ///< @c nullptr at the end
+      const IntrusiveList<T, HOOK>* listPtr;
+
+      friend class IntrusiveList<T, HOOK>;
+
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Item* pointer;
+      typedef Item& reference;
+
+      Iterator(T* curPtr, const IntrusiveList<T, HOOK>* listPtr)
+         : curPtr(curPtr), listPtr(listPtr)
+      {
+
+      }
+
+      /**
+       * Converts an iterator to a const_iterator.
+       */
+      template <class OtherItem, class = typename std::enable_if<
+         std::is_const<Item>::value &&
+         std::is_same<OtherItem, T>::value>::type>
+      Iterator(const Iterator<OtherItem>& other)
+         : curPtr(other.curPtr), listPtr(other.listPtr)
+      {
+
+      }
+
+      reference operator*() const
+      {
+         return *curPtr;
+      }
+
+      pointer operator->() const
+      {
+         return curPtr;
+      }
+
+      Iterator<Item>& operator++()
+      {
+         curPtr = hookOf(*curPtr).nextPtr;
+         if (curPtr == listPtr->headPtr)
+         {
+            curPtr = nullptr;
+         }
+         return *this;
+      }
+
+      Iterator<Item> operator++(int)
+      {
+         Iterator<Item> old = *this;
+         ++(*this);
+         return old;
+      }
+
+      Iterator<Item>& operator--()
+      {
+         curPtr = hookOf(curPtr == nullptr ? *listPtr->headPtr : *curPtr)
+            .prevPtr;
+         return *this;
+      }
+
+      Iterator<Item> operator--(int)
+      {
+         Iterator<Item> old = *this;
+         --(*this);
+         return old;
+      }
+
+      bool operator==(const Iterator<Item>& other) const
+      {
+         return curPtr == other.curPtr;
+      }
+
+      bool operator!=(const Iterator<Item>& other) const
+      {
+         return !(*this == other);
+      }
+
+      template <class OtherItem>
+      friend class Iterator;
+   };
+
+   typedef Iterator<T> iterator;
+   typedef Iterator<const T> const_iterator;
+
+   IntrusiveList();
+
+   // the objects can only be on one list per hook
+   IntrusiveList(const IntrusiveList<T, HOOK>& other) = delete;
+   IntrusiveList<T, HOOK>& operator=(const IntrusiveList<T, HOOK>& other)
+      = delete;
+
+   /**
+    * Unlinks every object.
+    */
+   virtual ~IntrusiveList();
+
+   /**
+    * Links an object in at the front of the list.
+    * @throws runtime_error if the object is already on a list.
+    */
+   void pushFront(T& item);
+
+   /**
+    * Links an object in at the end of the list.
+    * @throws runtime_error if the object is already on a list.
+    */
+   void pushBack(T& item);
+
+   /**
+    * Links an object in before @c position.
+    * @param position Where to link the object; @c end() appends it.
+    * @return An iterator to the object.
+    * @throws runtime_error if the object is already on a list.
+    */
+   iterator insert(const_iterator position, T& item);
+
+   /**
+    * Unlinks the first object.
+    * @return true if an object was unlinked, false if the list is empty.
+    */
+   bool popFront();
+
+   /**
+    * Unlinks the last object.
+    * @return true if an object was unlinked, false if the list is empty.
+    */
+   bool popBack();
+
+   /**
+    * Unlinks an object in O(1) time. The object must be on this list, or on
+    * no list at all; unlinking it from another list which uses the same hook
+    * corrupts both lists, and debug builds assert against it.
+    * @return true if the object was unlinked, false if it was not on a list.
+    */
+   bool remove(T& item);
+
+   /**
+    * Unlinks the object at @c position.
+    * @return An iterator to the object after it.
+    */
+   iterator erase(const_iterator position);
+
+   /**
+    * @throws range_error if the list is empty.
+    */
+   T& front() const;
+
+   /**
+    * @throws range_error if the list is empty.
+    */
+   T& back() const;
+
+   int size() const;
+
+   bool empty() const;
+
+   /**
+    * Unlinks every object, in O(n) time.
+    */
+   void clear();
+
+   iterator begin();
+   iterator end();
+   const_iterator begin() const;
+   const_iterator end() const;
+};
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+IntrusiveList<T, HOOK>::IntrusiveList() : headPtr(nullptr), count(0)
+{
+
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+IntrusiveList<T, HOOK>::~IntrusiveList()
+{
+   clear();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+void IntrusiveList<T, HOOK>::linkBefore(T* nextPtr, T& item)
+{
+   IntrusiveListHook<T>& hook = hookOf(item);
+   if (hook.isLinked())
+   {
+      throw std::runtime_error("Tried to link an object which is already "
+         "on a list in IntrusiveList<T>::linkBefore.");
+   }
+
+   if (headPtr == nullptr)
+   {
+      hook.nextPtr = &item;
+      hook.prevPtr = &item;
+      headPtr = &item;
+   }
+   else
+   {
+      // the end is just before the head of a circular list
+      T* afterPtr = nextPtr == nullptr ? headPtr : nextPtr;
+      T* beforePtr = hookOf(*afterPtr).prevPtr;
+      hook.nextPtr = afterPtr;
+      hook.prevPtr = beforePtr;
+      hookOf(*beforePtr).nextPtr = &item;
+      hookOf(*afterPtr).prevPtr = &item;
+      if (nextPtr == headPtr)
+      {
+         headPtr = &item;
+      }
+   }
+
+#ifndef NDEBUG
+   hook.ownerPtr = this;
+#endif
+   count++;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+void IntrusiveList<T, HOOK>::pushFront(T& item)
+{
+   linkBefore(headPtr, item);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+void IntrusiveList<T, HOOK>::pushBack(T& item)
+{
+   linkBefore(nullptr, item);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::iterator IntrusiveList<T, HOOK>::insert(
+   const_iterator position, T& item)
+{
+   linkBefore(position.curPtr, item);
+   return iterator(&item, this);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveList<T, HOOK>::popFront()
+{
+   if (empty())
+   {
+      return false;
+   }
+
+   return remove(*headPtr);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveList<T, HOOK>::popBack()
+{
+   if (empty())
+   {
+      return false;
+   }
+
+   return remove(*hookOf(*headPtr).prevPtr);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveList<T, HOOK>::remove(T& item)
+{
+   IntrusiveListHook<T>& hook = hookOf(item);
+   if (!hook.isLinked())
+   {
+      return false;
+   }
+   assert(hook.ownerPtr == this && "the object is on another list");
+
+   if (hook.nextPtr == &item)
+   {
+      // the only object in the list
+      headPtr = nullptr;
+   }
+   else
+   {
+      hookOf(*hook.prevPtr).nextPtr = hook.nextPtr;
+      hookOf(*hook.nextPtr).prevPtr = hook.prevPtr;
+      if (headPtr == &item)
+      {
+         headPtr = hook.nextPtr;
+      }
+   }
+
+   hook.nextPtr = nullptr;
+   hook.prevPtr = nullptr;
+#ifndef NDEBUG
+   hook.ownerPtr = nullptr;
+#endif
+   count--;
+   return true;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::iterator IntrusiveList<T, HOOK>::erase(
+   const_iterator position)
+{
+   iterator next(position.curPtr, this);
+   ++next;
+   remove(*position.curPtr);
+   return next;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+T& IntrusiveList<T, HOOK>::front() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call IntrusiveList<T>::front() "
+         "on an empty list.");
+   }
+
+   return *headPtr;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+T& IntrusiveList<T, HOOK>::back() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call IntrusiveList<T>::back() "
+         "on an empty list.");
+   }
+
+   return *hookOf(*headPtr).prevPtr;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+int IntrusiveList<T, HOOK>::size() const
+{
+   return count;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveList<T, HOOK>::empty() const
+{
+   return headPtr == nullptr;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+void IntrusiveList<T, HOOK>::clear()
+{
+   if (headPtr == nullptr)
+   {
+      return;
+   }
+
+   T* curPtr = headPtr;
+   do
+   {
+      IntrusiveListHook<T>& hook = hookOf(*curPtr);
+      curPtr = hook.nextPtr;
+      hook.nextPtr = nullptr;
+      hook.prevPtr = nullptr;
+#ifndef NDEBUG
+      hook.ownerPtr = nullptr;
+#endif
+   } while (curPtr != headPtr);
+
+   headPtr = nullptr;
+   count = 0;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::iterator IntrusiveList<T, HOOK>::begin()
+{
+   return iterator(headPtr, this);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::iterator IntrusiveList<T, HOOK>::end()
+{
+   return iterator(nullptr, this);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::const_iterator
+IntrusiveList<T, HOOK>::begin() const
+{
+   return const_iterator(headPtr, this);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+typename IntrusiveList<T, HOOK>::const_iterator
+IntrusiveList<T, HOOK>::end() const
+{
+   return const_iterator(nullptr, this);
+}
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @class IntrusiveQueue
+ * @brief A first-in, first-out queue of objects which hold their own links,
+ * with the interface of @c Queue.
+ *
+ * The objects are linked through an @c IntrusiveListHook member, as for an
+ * @c IntrusiveList, so @c push and @c pop never allocate or copy, and an
+ * object can also leave the queue early, in O(1) time, with @c remove. The
+ * caller owns the objects and keeps them alive while they are queued.
+ */
+
+#ifndef INTRUSIVE_QUEUE_H
+#define INTRUSIVE_QUEUE_H
+
+#include "IntrusiveList.h"
+#include <stdexcept>
+
+template <class T, IntrusiveListHook<T> T::*HOOK = &T::listHook>
+class IntrusiveQueue
+{
+private:
+   IntrusiveList<T, HOOK> items;
+
+public:
+   IntrusiveQueue();
+
+   /**
+    * Unlinks every object.
+    */
+   virtual ~IntrusiveQueue();
+
+   /**
+    * Links an object in at the back of the queue.
+    * @return true, since linking an object does not allocate.
+    * @throws runtime_error if the object is already on a list.
+    */
+   virtual bool push(T& item);
+
+   /**
+    * Unlinks the object at the front of the queue.
+    * @return true if an object was unlinked, false if the queue is empty.
+    */
+   virtual bool pop();
+
+   /**
+    * Unlinks an object wherever it is in the queue, in O(1) time. The object
+    * must be in this queue, or on no list at all; unlinking it from another
+    * list or queue which uses the same hook corrupts both, and debug builds
+    * assert against it.
+    * @return true if the object was unlinked, false if it was not queued.
+    */
+   virtual bool remove(T& item);
+
+   /**
+    * @throws range_error if the queue is empty.
+    */
+   virtual T& front() const;
+
+   /**
+    * @throws range_error if the queue is empty.
+    */
+   virtual T& back() const;
+
+   virtual int size() const;
+
+   virtual bool empty() const;
+
+   virtual void clear();
+};
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+IntrusiveQueue<T, HOOK>::IntrusiveQueue()
+{
+
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+IntrusiveQueue<T, HOOK>::~IntrusiveQueue()
+{
+
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveQueue<T, HOOK>::push(T& item)
+{
+   items.pushBack(item);
+   return true;
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveQueue<T, HOOK>::pop()
+{
+   return items.popFront();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveQueue<T, HOOK>::remove(T& item)
+{
+   return items.remove(item);
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+T& IntrusiveQueue<T, HOOK>::front() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call IntrusiveQueue<T>::front() "
+         "on an empty queue.");
+   }
+
+   return items.front();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+T& IntrusiveQueue<T, HOOK>::back() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call IntrusiveQueue<T>::back() "
+         "on an empty queue.");
+   }
+
+   return items.back();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+int IntrusiveQueue<T, HOOK>::size() const
+{
+   return items.size();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+bool IntrusiveQueue<T, HOOK>::empty() const
+{
+   return items.empty();
+}
+
+template <class T, IntrusiveListHook<T> T::*HOOK>
+void IntrusiveQueue<T, HOOK>::clear()
+{
+   items.clear();
+}
+
+#endif
@@ -0,0 +1,231 @@
+/**
+ * @class LinkedHashSet
+ * @brief A @c LinkedList of unique items, with a hash index from each item to
+ * its node.
+ *
+ * Items keep the order in which they were added, as in a @c LinkedList, but
+ * @c contains and @c remove look the item up in the index instead of
+ * scanning the list, so they take O(1) time on average. Adding an item which
+ * is already in the set does nothing.
+ *
+ * The index refers to the items in the nodes rather than holding copies of
+ * them, so it costs one hash table entry per item. Since an item's hash must
+ * not change while it is in the set, items must not be modified through a
+ * non-const iterator.
+ */
+
+#ifndef LINKED_HASH_SET_H
+#define LINKED_HASH_SET_H
+
+#include "LinkedList.h"
+#include "MemoryUsage.h"
+#include "Node.h"
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+template <class T, class Hash = std::hash<T>>
+class LinkedHashSet : public LinkedList<T>
+{
+private:
+   /** Hashes the item an index key points to. */
+   struct ItemHash
+   {
+      Hash hash;
+
+      std::size_t operator()(const T* itemPtr) const
+      {
+         return hash(*itemPtr);
+      }
+   };
+
+   /** Compares the items two index keys point to. */
+   struct ItemEqual
+   {
+      bool operator()(const T* firstPtr, const T* secondPtr) const
+      {
+         return *firstPtr == *secondPtr;
+      }
+   };
+
+   /**
+    * Maps a pointer to the item held by each node to the node. A lookup
+    * passes a pointer to the item being searched for.
+    */
+   std::unordered_map<const T*, Node<T>*, ItemHash, ItemEqual> index;
+
+   /**
+    * Indexes every node of the list.
+    */
+   void rebuildIndex();
+
+public:
+   LinkedHashSet();
+
+   LinkedHashSet(const LinkedHashSet<T, Hash>& other);
+
+   virtual ~LinkedHashSet();
+
+   LinkedHashSet<T, Hash>& operator=(const LinkedHashSet<T, Hash>& other);
+
+   /**
+    * Adds an item to the end of the list, unless it is already in the set.
+    * @param item The item to add.
+    */
+   virtual void add(const T& item);
+
+   /**
+    * Removes an item in O(1) average time.
+    * @param item The item to remove.
+    * @return true if the item was removed, false if it was not in the set.
+    */
+   virtual bool remove(const T& item);
+
+   /**
+    * Searches for an item in O(1) average time.
+    * @param item The item to search for.
+    * @return true if the item is in the set, false otherwise.
+    */
+   virtual bool contains(const T& item) const;
+
+   virtual void clear();
+
+   virtual std::vector<T> intoVector();
+
+   /**
+    * Reserves room in the index for @c numItems items, so that adding up to
+    * that many does not rehash.
+    */
+   void reserve(int numItems);
+
+   /**
+    * @return The bytes the set uses (see MemoryUsage.h): those of the list,
+    *         plus the index's bucket array and one node per item, which are
+    *         overhead. The index's nodes are sized as libstdc++ lays them
+    *         out: a link, the entry, and the cached hash.
+    */
+   MemoryUsage memoryUsage() const;
+};
+
+template <class T, class Hash>
+LinkedHashSet<T, Hash>::LinkedHashSet()
+{
+
+}
+
+template <class T, class Hash>
+LinkedHashSet<T, Hash>::LinkedHashSet(const LinkedHashSet<T, Hash>& other)
+   : LinkedList<T>(other)
+{
+   rebuildIndex();
+}
+
+template <class T, class Hash>
+LinkedHashSet<T, Hash>::~LinkedHashSet()
+{
+
+}
+
+template <class T, class Hash>
+LinkedHashSet<T, Hash>& LinkedHashSet<T, Hash>::operator=(
+   const LinkedHashSet<T, Hash>& other)
+{
+   if (this != &other)
+   {
+      index.clear();
+      LinkedList<T>::operator=(other);
+      rebuildIndex();
+   }
+
+   return *this;
+}
+
+template <class T, class Hash>
+void LinkedHashSet<T, Hash>::rebuildIndex()
+{
+   index.clear();
+   index.reserve(this->count);
+   for (Node<T>* curPtr = this->headPtr; curPtr != nullptr;
+        curPtr = curPtr->getNext())
+   {
+      index.emplace(&curPtr->getItem(), curPtr);
+   }
+}
+
+template <class T, class Hash>
+void LinkedHashSet<T, Hash>::add(const T& item)
+{
+   if (index.find(&item) != index.end())
+   {
+      return;
+   }
+
+   LinkedList<T>::add(item);
+   index.emplace(&this->tailPtr->getItem(), this->tailPtr);
+}
+
+template <class T, class Hash>
+bool LinkedHashSet<T, Hash>::remove(const T& item)
+{
+   auto entry = index.find(&item);
+   if (entry == index.end())
+   {
+      return false;
+   }
+
+   // the key points into the node, so it has to go first
+   Node<T>* toRemove = entry->second;
+   index.erase(entry);
+   this->removeNode(toRemove);
+   return true;
+}
+
+template <class T, class Hash>
+bool LinkedHashSet<T, Hash>::contains(const T& item) const
+{
+   return index.find(&item) != index.end();
+}
+
+template <class T, class Hash>
+void LinkedHashSet<T, Hash>::clear()
+{
+   index.clear();
+   LinkedList<T>::clear();
+}
+
+template <class T, class Hash>
+std::vector<T> LinkedHashSet<T, Hash>::intoVector()
+{
+   index.clear();
+   return LinkedList<T>::intoVector();
+}
+
+template <class T, class Hash>
+void LinkedHashSet<T, Hash>::reserve(int numItems)
+{
+   index.reserve(numItems);
+}
+
+template <class T, class Hash>
+MemoryUsage LinkedHashSet<T, Hash>::memoryUsage() const
+{
+   MemoryUsage usage = LinkedList<T>::memoryUsage();
+   usage.overheadBytes += sizeof(*this) - sizeof(LinkedList<T>);
+
+   // a table with a single bucket keeps it inside the table object
+   if (index.bucket_count() > 1)
+   {
+      std::size_t bucketBytes = index.bucket_count() * sizeof(void*);
+      usage.overheadBytes += bucketBytes;
+      addAllocation(usage, bucketBytes);
+   }
+
+   typedef typename decltype(index)::value_type IndexEntry;
+   const std::size_t INDEX_NODE_BYTES =
+      sizeof(void*) + sizeof(IndexEntry) + sizeof(std::size_t);
+   usage.overheadBytes += index.size() * getAllocatedBytes(INDEX_NODE_BYTES);
+   return usage;
+}
+
+#endif
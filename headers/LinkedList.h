@@ -1,28 +1,48 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include "ContainerStats.h"
 #include "List.h"
+#include "MemoryUsage.h"
+#include "LinkedListIterator.h"
 #include "Node.h"
+#include <functional>
+#include <utility>
 #include <vector>
 
-template <class T>
-class LinkedList : public List<T>
+template <class T, class Stats = NoStats>
+class LinkedList : public List<T>, private Stats
 {
-private:
+protected:
    Node<T>* headPtr;
    Node<T>* tailPtr;
    int count;
 
    Node<T>* getPointerTo(const T& item) const;
 
+   /**
+    * Unlinks a node of the list and deletes it.
+    * @param toRemove The node to remove, which must be in the list.
+    */
+   void removeNode(Node<T>* toRemove);
+
+   /**
+    * Merges two sorted runs of nodes linked only by their next pointers,
+    * taking equal items from @c firstPtr first.
+    * @return The first node of the merged run.
+    */
+   template <class Compare>
+   static Node<T>* mergeRuns(Node<T>* firstPtr, Node<T>* secondPtr,
+                             Compare& cmp);
+
 public:
    LinkedList();
 
-   LinkedList(const LinkedList<T>& other);
+   LinkedList(const LinkedList<T, Stats>& other);
 
-   ~LinkedList();
+   virtual ~LinkedList();
 
-   LinkedList<T>& operator=(const LinkedList<T>& other);
+   LinkedList<T, Stats>& operator=(const LinkedList<T, Stats>& other);
 
    virtual void add(const T& item);
 
@@ -37,17 +57,53 @@ public:
    virtual void clear();
 
    virtual std::vector<T> toVector() const;
+
+   virtual std::vector<T> intoVector();
+
+   /**
+    * Sorts the list with a bottom-up merge sort which relinks the existing
+    * nodes, so it neither allocates nor copies any items. Equal items keep
+    * their order. Iterators stay valid and follow their items.
+    * @param cmp A callable invoked as <tt>cmp(const T&, const T&)</tt>,
+    *            which returns true if the first item goes before the
+    *            second.
+    */
+   template <class Compare = std::less<T>>
+   void sort(Compare cmp = Compare());
+
+   /**
+    * @return The bytes the list uses (see MemoryUsage.h). A list has no
+    *         slack; the links of its nodes are overhead.
+    */
+   MemoryUsage memoryUsage() const;
+
+   /**
+    * @return The list's instrumentation (see ContainerStats.h). Searches
+    *         count a comparison per item they compare with.
+    */
+   const Stats& getStats() const;
+   Stats& getStats();
+
+   // Iterators, from the first item added to the last
+   typedef LinkedListIterator<T, T> iterator;
+   typedef LinkedListIterator<T, const T> const_iterator;
+
+   iterator begin();
+   iterator end();
+   const_iterator begin() const;
+   const_iterator end() const;
 };
 
-template <class T>
-LinkedList<T>::LinkedList() : headPtr(nullptr), tailPtr(nullptr), count(0)
+template <class T, class Stats>
+LinkedList<T, Stats>::LinkedList() :
+      headPtr(nullptr), tailPtr(nullptr), count(0)
 {
 
 }
 
-template <class T>
-LinkedList<T>::LinkedList(const LinkedList<T>& other) :
-      count(other.count)
+template <class T, class Stats>
+LinkedList<T, Stats>::LinkedList(const LinkedList<T, Stats>& other) :
+      headPtr(nullptr), tailPtr(nullptr), count(other.count)
 {
    Node<T>* otherPtr = other.headPtr;
    Node<T>* thisPtr = nullptr;
@@ -68,17 +124,19 @@ LinkedList<T>::LinkedList(const LinkedList<T>& other) :
       otherPtr = otherPtr->getNext();
    }
    tailPtr = thisPtr;
+   this->recordEvent(StatEvent::NODE_ALLOCATION, count);
 }
 
-template <class T>
-LinkedList<T>::~LinkedList()
+template <class T, class Stats>
+LinkedList<T, Stats>::~LinkedList()
 {
    clear();
 }
 
 //TODO can you just use the assignment operator in the copy constructor or vice versa?
-template <class T>
-LinkedList<T>& LinkedList<T>::operator=(const LinkedList<T>& other)
+template <class T, class Stats>
+LinkedList<T, Stats>& LinkedList<T, Stats>::operator=(
+   const LinkedList<T, Stats>& other)
 {
    clear();
 
@@ -101,16 +159,19 @@ LinkedList<T>& LinkedList<T>::operator=(const LinkedList<T>& other)
       otherPtr = otherPtr->getNext();
    }
    tailPtr = thisPtr;
+   count = other.count;
+   this->recordEvent(StatEvent::NODE_ALLOCATION, count);
 
    return *this;
 }
 
-template <class T>
-Node<T>* LinkedList<T>::getPointerTo(const T& item) const
+template <class T, class Stats>
+Node<T>* LinkedList<T, Stats>::getPointerTo(const T& item) const
 {
    Node<T>* curPtr = headPtr;
    while (curPtr != nullptr)
    {
+      this->recordEvent(StatEvent::COMPARISON);
       if (curPtr->getItem() == item)
       {
          return curPtr;
@@ -125,57 +186,63 @@ Node<T>* LinkedList<T>::getPointerTo(const T& item) const
 }
 
 //TODO add to Doxygen documentation: type T MUST have a fully working copy constructor, as Node will make a copy of the item to prevent memory errors
-template <class T>
-void LinkedList<T>::add(const T& item)
+template <class T, class Stats>
+void LinkedList<T, Stats>::add(const T& item)
 {
-   Node<T>* newNode = new Node<T>(item, nullptr, nullptr);
+   typename Stats::Timer timer(*this, StatOperation::ADD);
+   this->recordEvent(StatEvent::NODE_ALLOCATION);
+   Node<T>* newNode = new Node<T>(item, nullptr, tailPtr);
    if (headPtr == nullptr)
    {
       headPtr = newNode;
-      count = 1;   
    }
    else
    {
-      Node<T>* curPtr = headPtr;
-      while(curPtr->getNext() != nullptr)
-      {
-         curPtr = curPtr->getNext();
-      }
-      curPtr->setNext(newNode);
-      newNode->setPrev(curPtr);
-      count++;
+      tailPtr->setNext(newNode);
    }
 
    tailPtr = newNode;
+   count++;
 }
 
-template <class T>
-bool LinkedList<T>::remove(const T& item)
+template <class T, class Stats>
+void LinkedList<T, Stats>::removeNode(Node<T>* toRemove)
 {
-   Node<T>* toRemove = getPointerTo(item);
-   if (toRemove != nullptr)
+   if (toRemove == headPtr)
    {
-      if (toRemove == headPtr)
+      headPtr = toRemove->getNext();
+      if (headPtr != nullptr)
       {
-         headPtr = toRemove->getNext();
+         headPtr->setPrev(nullptr);
       }
-      else
+   }
+   else
+   {
+      toRemove->getPrev()->setNext(toRemove->getNext());
+      if (toRemove->getNext() != nullptr)
       {
-         toRemove->getPrev()->setNext(toRemove->getNext());
-         if (toRemove->getNext() != nullptr)
-         {
-            toRemove->getNext()->setPrev(toRemove->getPrev());
-         }        
+         toRemove->getNext()->setPrev(toRemove->getPrev());
       }
+   }
 
-      if (toRemove == tailPtr)
-      {
-         tailPtr = toRemove->getPrev();
-      }
+   if (toRemove == tailPtr)
+   {
+      tailPtr = toRemove->getPrev();
+   }
 
-      count--;
-      delete toRemove;
-      toRemove = nullptr;
+   count--;
+   this->recordEvent(StatEvent::NODE_DEALLOCATION);
+   delete toRemove;
+}
+
+template <class T, class Stats>
+bool LinkedList<T, Stats>::remove(const T& item)
+{
+   typename Stats::Timer timer(*this, StatOperation::REMOVE);
+   Node<T>* toRemove = getPointerTo(item);
+   if (toRemove != nullptr)
+   {
+      removeNode(toRemove);
       return true;
    }
    else
@@ -184,21 +251,22 @@ bool LinkedList<T>::remove(const T& item)
    }
 }
 
-template <class T>
-int LinkedList<T>::size() const
+template <class T, class Stats>
+int LinkedList<T, Stats>::size() const
 {
    return count;
 }
 
-template <class T>
-bool LinkedList<T>::empty() const
+template <class T, class Stats>
+bool LinkedList<T, Stats>::empty() const
 {
    return count == 0;
 }
 
-template <class T>
-bool LinkedList<T>::contains(const T& item) const
+template <class T, class Stats>
+bool LinkedList<T, Stats>::contains(const T& item) const
 {
+   typename Stats::Timer timer(*this, StatOperation::LOOKUP);
    if (getPointerTo(item) != nullptr)
    {
       return true; 
@@ -209,9 +277,10 @@ bool LinkedList<T>::contains(const T& item) const
    }
 }
 
-template <class T>
-void LinkedList<T>::clear()
+template <class T, class Stats>
+void LinkedList<T, Stats>::clear()
 {
+   this->recordEvent(StatEvent::NODE_DEALLOCATION, count);
    Node<T>* curPtr = headPtr;
    while (curPtr != nullptr)
    {
@@ -224,21 +293,180 @@ void LinkedList<T>::clear()
    tailPtr = nullptr;
 }
 
-template <class T>
-std::vector<T> LinkedList<T>::toVector() const
+template <class T, class Stats>
+std::vector<T> LinkedList<T, Stats>::toVector() const
 {
    std::vector<T> vec;
-   if (!empty())
+   vec.reserve(count);
+   for (Node<T>* curPtr = headPtr; curPtr != nullptr;
+        curPtr = curPtr->getNext())
    {
-      Node<T>* curPtr = headPtr;
-      while(curPtr != nullptr)
+      vec.push_back(curPtr->getItem());
+   }
+
+   return vec;
+}
+
+template <class T, class Stats>
+std::vector<T> LinkedList<T, Stats>::intoVector()
+{
+   std::vector<T> vec;
+   vec.reserve(count);
+   for (Node<T>* curPtr = headPtr; curPtr != nullptr;
+        curPtr = curPtr->getNext())
+   {
+      vec.push_back(std::move(curPtr->getItem()));
+   }
+
+   clear();
+   return vec;
+}
+
+template <class T, class Stats>
+template <class Compare>
+Node<T>* LinkedList<T, Stats>::mergeRuns(Node<T>* firstPtr, Node<T>* secondPtr,
+                                  Compare& cmp)
+{
+   Node<T>* mergedPtr = nullptr;
+   Node<T>* lastPtr = nullptr;
+   while (firstPtr != nullptr && secondPtr != nullptr)
+   {
+      Node<T>* nextPtr;
+      if (cmp(secondPtr->getItem(), firstPtr->getItem()))
       {
-         vec.push_back(curPtr->getItem());
-         curPtr = curPtr->getNext();
+         nextPtr = secondPtr;
+         secondPtr = secondPtr->getNext();
+      }
+      else
+      {
+         nextPtr = firstPtr;
+         firstPtr = firstPtr->getNext();
+      }
+
+      if (lastPtr == nullptr)
+      {
+         mergedPtr = nextPtr;
+      }
+      else
+      {
+         lastPtr->setNext(nextPtr);
       }
+      lastPtr = nextPtr;
    }
 
-   return vec;
+   Node<T>* restPtr = firstPtr != nullptr ? firstPtr : secondPtr;
+   if (lastPtr == nullptr)
+   {
+      return restPtr;
+   }
+
+   lastPtr->setNext(restPtr);
+   return mergedPtr;
+}
+
+template <class T, class Stats>
+template <class Compare>
+void LinkedList<T, Stats>::sort(Compare cmp)
+{
+   // runs[i] is empty or a sorted run of 2^i nodes, holding items which
+   // came before those of runs[i - 1]; a list of n nodes needs log2(n) runs
+   const int MAX_RUNS = 64;
+   Node<T>* runs[MAX_RUNS] = {};
+   int numRuns = 0;
+
+   Node<T>* curPtr = headPtr;
+   while (curPtr != nullptr)
+   {
+      Node<T>* runPtr = curPtr;
+      curPtr = curPtr->getNext();
+      runPtr->setNext(nullptr);
+
+      // carry the new node up, like adding one to a binary counter
+      int i = 0;
+      for (; i < numRuns && runs[i] != nullptr; i++)
+      {
+         runPtr = mergeRuns(runs[i], runPtr, cmp);
+         runs[i] = nullptr;
+      }
+      runs[i] = runPtr;
+      if (i == numRuns)
+      {
+         numRuns++;
+      }
+   }
+
+   Node<T>* sortedPtr = nullptr;
+   for (int i = 0; i < numRuns; i++)
+   {
+      if (runs[i] != nullptr)
+      {
+         sortedPtr = mergeRuns(runs[i], sortedPtr, cmp);
+      }
+   }
+
+   // restore the prev pointers, which the merges ignored
+   headPtr = sortedPtr;
+   tailPtr = nullptr;
+   for (curPtr = headPtr; curPtr != nullptr; curPtr = curPtr->getNext())
+   {
+      curPtr->setPrev(tailPtr);
+      tailPtr = curPtr;
+   }
+}
+
+template <class T, class Stats>
+MemoryUsage LinkedList<T, Stats>::memoryUsage() const
+{
+   MemoryUsage usage;
+   usage.overheadBytes = sizeof(*this);
+   for (Node<T>* curPtr = headPtr; curPtr != nullptr;
+        curPtr = curPtr->getNext())
+   {
+      usage.payloadBytes += sizeof(T);
+      usage.overheadBytes += sizeof(Node<T>) - sizeof(T);
+      addAllocation(usage, sizeof(Node<T>));
+      addOwnedMemory(usage, curPtr->getItem());
+   }
+
+   return usage;
+}
+
+template <class T, class Stats>
+const Stats& LinkedList<T, Stats>::getStats() const
+{
+   return *this;
+}
+
+template <class T, class Stats>
+Stats& LinkedList<T, Stats>::getStats()
+{
+   return *this;
+}
+
+template <class T, class Stats>
+typename LinkedList<T, Stats>::iterator LinkedList<T, Stats>::begin()
+{
+   return iterator(headPtr, &tailPtr);
+}
+
+template <class T, class Stats>
+typename LinkedList<T, Stats>::iterator LinkedList<T, Stats>::end()
+{
+   return iterator(nullptr, &tailPtr);
+}
+
+template <class T, class Stats>
+typename LinkedList<T, Stats>::const_iterator
+LinkedList<T, Stats>::begin() const
+{
+   return const_iterator(headPtr, &tailPtr);
+}
+
+template <class T, class Stats>
+typename LinkedList<T, Stats>::const_iterator
+LinkedList<T, Stats>::end() const
+{
+   return const_iterator(nullptr, &tailPtr);
 }
 
 #endif
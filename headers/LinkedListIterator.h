@@ -0,0 +1,141 @@
+/**
+ * @class LinkedListIterator
+ * @brief A bidirectional iterator over the items of a @c LinkedList.
+ *
+ * @c Item is @c T for an iterator which can modify the items, or
+ * <tt>const T</tt> for one which cannot. Removing an item invalidates only
+ * the iterators to it; the end iterator stays valid while items are added
+ * and removed, and decrementing it yields the current last item.
+ */
+
+#ifndef LINKED_LIST_ITERATOR_H
+#define LINKED_LIST_ITERATOR_H
+
+#include "Node.h"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+template <class T, class Item>
+class LinkedListIterator
+{
+public:
+   typedef std::bidirectional_iterator_tag iterator_category;
+   typedef T value_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef Item* pointer;
+   typedef Item& reference;
+
+private:
+   Node<T>* curPtr; ///< @c nullptr at the end
+   /// the list's own tail pointer, read when the end iterator is
+   /// decremented so that it follows later additions and removals
+   Node<T>* const* tailPtrPtr;
+
+   template <class OtherT, class OtherItem>
+   friend class LinkedListIterator;
+
+public:
+   LinkedListIterator(Node<T>* curPtr, Node<T>* const* tailPtrPtr);
+
+   /**
+    * Converts an iterator which can modify items to one which cannot.
+    */
+   template <class OtherItem, class = typename std::enable_if<
+      std::is_const<Item>::value &&
+      std::is_same<OtherItem, T>::value>::type>
+   LinkedListIterator(const LinkedListIterator<T, OtherItem>& other);
+
+   reference operator*() const;
+
+   pointer operator->() const;
+
+   LinkedListIterator<T, Item>& operator++();
+
+   LinkedListIterator<T, Item> operator++(int);
+
+   LinkedListIterator<T, Item>& operator--();
+
+   LinkedListIterator<T, Item> operator--(int);
+
+   bool operator==(const LinkedListIterator<T, Item>& other) const;
+
+   bool operator!=(const LinkedListIterator<T, Item>& other) const;
+};
+
+template <class T, class Item>
+LinkedListIterator<T, Item>::LinkedListIterator(Node<T>* curPtr,
+                                                Node<T>* const* tailPtrPtr)
+   : curPtr(curPtr), tailPtrPtr(tailPtrPtr)
+{
+
+}
+
+template <class T, class Item>
+template <class OtherItem, class>
+LinkedListIterator<T, Item>::LinkedListIterator(
+   const LinkedListIterator<T, OtherItem>& other)
+   : curPtr(other.curPtr), tailPtrPtr(other.tailPtrPtr)
+{
+
+}
+
+template <class T, class Item>
+typename LinkedListIterator<T, Item>::reference
+LinkedListIterator<T, Item>::operator*() const
+{
+   return curPtr->getItem();
+}
+
+template <class T, class Item>
+typename LinkedListIterator<T, Item>::pointer
+LinkedListIterator<T, Item>::operator->() const
+{
+   return &curPtr->getItem();
+}
+
+template <class T, class Item>
+LinkedListIterator<T, Item>& LinkedListIterator<T, Item>::operator++()
+{
+   curPtr = curPtr->getNext();
+   return *this;
+}
+
+template <class T, class Item>
+LinkedListIterator<T, Item> LinkedListIterator<T, Item>::operator++(int)
+{
+   LinkedListIterator<T, Item> old = *this;
+   ++(*this);
+   return old;
+}
+
+template <class T, class Item>
+LinkedListIterator<T, Item>& LinkedListIterator<T, Item>::operator--()
+{
+   curPtr = curPtr == nullptr ? *tailPtrPtr : curPtr->getPrev();
+   return *this;
+}
+
+template <class T, class Item>
+LinkedListIterator<T, Item> LinkedListIterator<T, Item>::operator--(int)
+{
+   LinkedListIterator<T, Item> old = *this;
+   --(*this);
+   return old;
+}
+
+template <class T, class Item>
+bool LinkedListIterator<T, Item>::operator==(
+   const LinkedListIterator<T, Item>& other) const
+{
+   return curPtr == other.curPtr;
+}
+
+template <class T, class Item>
+bool LinkedListIterator<T, Item>::operator!=(
+   const LinkedListIterator<T, Item>& other) const
+{
+   return !(*this == other);
+}
+
+#endif
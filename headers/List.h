@@ -7,6 +7,11 @@ template <class T>
 class List 
 {
 public:
+    virtual ~List()
+    {
+
+    }
+
     virtual void add(const T& item) = 0;
 
     virtual bool remove(const T& item) = 0;
@@ -20,6 +25,12 @@ public:
     virtual void clear() = 0;
 
     virtual std::vector<T> toVector() const = 0;
+
+    /**
+     * Moves every item, in order, into a new vector, leaving the list empty.
+     * Unlike @c toVector, no item is copied.
+     */
+    virtual std::vector<T> intoVector() = 0;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+/**
+ * @class MemoryUsage
+ * @brief A breakdown of the bytes a container uses, as returned by the
+ * containers' @c memoryUsage methods.
+ *
+ * The bytes are split three ways:
+ * - payload: the items themselves, @c sizeof(T) each, and whatever memory
+ *   the items own (e.g. the buffer of a long @c std::string);
+ * - slack: capacity allocated for items the container does not hold, which
+ *   @c shrinkToFit releases where the container has one;
+ * - overhead: the container object, the links of its nodes, and what the
+ *   allocator adds to every allocation.
+ *
+ * The allocator's overhead is known for glibc's malloc, which rounds each
+ * request up to a multiple of 16 bytes with an 8 byte header; elsewhere it
+ * is left out. An item type which owns memory tells the containers about it
+ * by overloading @c addOwnedMemory, as done here for strings and vectors and
+ * in Entry.h for entries.
+ */
+
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct MemoryUsage
+{
+    std::size_t payloadBytes;
+    std::size_t slackBytes;
+    std::size_t overheadBytes;
+
+    MemoryUsage() : payloadBytes(0), slackBytes(0), overheadBytes(0)
+    {
+
+    }
+
+    std::size_t getTotalBytes() const
+    {
+        return payloadBytes + slackBytes + overheadBytes;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other)
+    {
+        payloadBytes += other.payloadBytes;
+        slackBytes += other.slackBytes;
+        overheadBytes += other.overheadBytes;
+        return *this;
+    }
+};
+
+/**
+ * @return The bytes the allocator reserves for a request of
+ *         @c requestedBytes, including its header and rounding.
+ */
+inline std::size_t getAllocatedBytes(std::size_t requestedBytes)
+{
+#if defined(__GLIBC__) && defined(__LP64__)
+    const std::size_t HEADER_BYTES = 8;
+    const std::size_t MIN_CHUNK_BYTES = 32;
+    const std::size_t MMAP_THRESHOLD = 128 * 1024;
+    const std::size_t PAGE_BYTES = 4096;
+
+    std::size_t chunkBytes = (requestedBytes + HEADER_BYTES + 15) &
+                             ~std::size_t(15);
+    if (chunkBytes >= MMAP_THRESHOLD)
+    {
+        // large requests are mapped separately, a page at a time
+        return (requestedBytes + 2 * HEADER_BYTES + PAGE_BYTES - 1) &
+               ~(PAGE_BYTES - 1);
+    }
+
+    return chunkBytes < MIN_CHUNK_BYTES ? MIN_CHUNK_BYTES : chunkBytes;
+#else
+    return requestedBytes;
+#endif
+}
+
+/**
+ * Adds the allocator's overhead for one allocation of @c requestedBytes,
+ * whose bytes the caller counts itself.
+ */
+inline void addAllocation(MemoryUsage& usage, std::size_t requestedBytes)
+{
+    usage.overheadBytes += getAllocatedBytes(requestedBytes) - requestedBytes;
+}
+
+/**
+ * @return The bytes of the cookie which <tt>new T[n]</tt> stores before the
+ *         array, to know how many destructors <tt>delete[]</tt> runs.
+ */
+template <class T>
+std::size_t getArrayCookieBytes()
+{
+    return std::is_trivially_destructible<T>::value ? 0 : sizeof(std::size_t);
+}
+
+/**
+ * Whether items of type @c T may own memory for @c addOwnedMemory to count.
+ * A trivially copyable item owns none, since a copy of its bytes would share
+ * whatever it points to, so containers of such items need not visit them.
+ */
+template <class T>
+struct MayOwnMemory
+    : std::integral_constant<bool, !std::is_trivially_copyable<T>::value>
+{
+
+};
+
+/**
+ * Adds the memory an item owns, beyond its @c sizeof, to @c usage. Items own
+ * nothing unless their type overloads this.
+ */
+template <class T>
+void addOwnedMemory(MemoryUsage&, const T&)
+{
+
+}
+
+template <class Char, class Traits, class Allocator>
+void addOwnedMemory(MemoryUsage& usage,
+                    const std::basic_string<Char, Traits, Allocator>& str)
+{
+    // a short string is held inside the object itself
+    const char* objectPtr = reinterpret_cast<const char*>(&str);
+    const char* dataPtr = reinterpret_cast<const char*>(str.data());
+    if (dataPtr >= objectPtr && dataPtr < objectPtr + sizeof(str))
+    {
+        return;
+    }
+
+    std::size_t bufferBytes = (str.capacity() + 1) * sizeof(Char);
+    usage.payloadBytes += (str.size() + 1) * sizeof(Char);
+    usage.slackBytes += bufferBytes - (str.size() + 1) * sizeof(Char);
+    addAllocation(usage, bufferBytes);
+}
+
+template <class U, class Allocator>
+void addOwnedMemory(MemoryUsage& usage, const std::vector<U, Allocator>& vec)
+{
+    if (vec.capacity() == 0)
+    {
+        return;
+    }
+
+    usage.payloadBytes += vec.size() * sizeof(U);
+    usage.slackBytes += (vec.capacity() - vec.size()) * sizeof(U);
+    addAllocation(usage, vec.capacity() * sizeof(U));
+    for (const U& item : vec)
+    {
+        addOwnedMemory(usage, item);
+    }
+}
+
+#endif
@@ -1,21 +1,27 @@
 #ifndef NODE_H
 #define NODE_H
 
+#include <utility>
+
 template <class T>
 class Node
 {
 private:
-   const T item;
+   T item;
    Node<T>* nextPtr;
    Node<T>* prevPtr;
 
 public:
-   Node(const T item, Node<T>* nextPtr, Node<T>* prevPtr);
+   Node(const T& item, Node<T>* nextPtr, Node<T>* prevPtr);
+
+   Node(T&& item, Node<T>* nextPtr, Node<T>* prevPtr);
 
    virtual ~Node();
 
    virtual const T& getItem() const;
 
+   virtual T& getItem();
+
    virtual Node<T>* getNext() const;
 
    virtual void setNext(Node<T>* nextPtr);   
@@ -26,12 +32,19 @@ public:
 };
 
 template <class T>
-Node<T>::Node(const T item, Node<T>* nextPtr, Node<T>* prevPtr)
+Node<T>::Node(const T& item, Node<T>* nextPtr, Node<T>* prevPtr)
    : item(item), nextPtr(nextPtr), prevPtr(prevPtr)
 {
 
 }
 
+template <class T>
+Node<T>::Node(T&& item, Node<T>* nextPtr, Node<T>* prevPtr)
+   : item(std::move(item)), nextPtr(nextPtr), prevPtr(prevPtr)
+{
+
+}
+
 template <class T>
 Node<T>::~Node()
 {
@@ -44,6 +57,12 @@ const T& Node<T>::getItem() const
    return item;
 }
 
+template <class T>
+T& Node<T>::getItem()
+{
+   return item;
+}
+
 template <class T>
 Node<T>* Node<T>::getNext() const
 {
@@ -0,0 +1,229 @@
+/**
+ * @class NodeArena
+ * @brief A bump allocator for the nodes of a single linked structure.
+ *
+ * Nodes are carved out of large chunks in the order they are created, so
+ * nodes created together are adjacent in memory. Destroyed nodes go onto a
+ * free list and are reused by later allocations. All chunks are released at
+ * once by @c release or the destructor, without visiting individual nodes.
+ *
+ * An arena is not thread-safe; it belongs to one structure and is used only
+ * by whichever thread is modifying that structure.
+ */
+
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include "MemoryUsage.h"
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template <class Node>
+class NodeArena
+{
+private:
+    struct FreeSlot
+    {
+        FreeSlot* nextPtr;
+    };
+
+    static_assert(sizeof(Node) >= sizeof(FreeSlot),
+                  "A node must be large enough to hold a free list link.");
+
+    std::vector<char*> chunks;
+    char* nextSlotPtr; ///< the next unused slot of the newest chunk
+    char* chunkEndPtr;
+    FreeSlot* freeListPtr;
+    int nodesPerChunk;
+
+    void addChunk();
+
+public:
+    static const int DEFAULT_NODES_PER_CHUNK = 4096;
+
+    /**
+     * @param nodesPerChunk The number of nodes each chunk can hold.
+     */
+    explicit NodeArena(int nodesPerChunk = DEFAULT_NODES_PER_CHUNK);
+
+    NodeArena(const NodeArena<Node>& other) = delete;
+
+    NodeArena<Node>& operator=(const NodeArena<Node>& other) = delete;
+
+    /**
+     * Releases every chunk. Destructors of nodes still in use are not run.
+     */
+    ~NodeArena();
+
+    /**
+     * Constructs a node in the arena, reusing a destroyed node's memory if
+     * there is one.
+     * @param args The arguments to pass to the node's constructor.
+     * @return A pointer to the new node.
+     */
+    template <class... Args>
+    Node* create(Args&&... args);
+
+    /**
+     * Runs the destructor of a node created by this arena and puts its
+     * memory on the free list.
+     */
+    void destroy(Node* nodePtr);
+
+    /**
+     * Releases every chunk at once, making all nodes invalid. Destructors of
+     * nodes still in use are not run, so the caller must destroy them first
+     * unless they are trivially destructible.
+     */
+    void release();
+
+    int getNodesPerChunk() const;
+
+    /**
+     * @return The number of chunks currently allocated.
+     */
+    int getNumChunks() const;
+
+    /**
+     * @param numLiveNodes The number of nodes in use, which the caller
+     *                     counts itself.
+     * @return The bytes of the arena apart from its live nodes: the unused
+     *         and freed slots as slack, and the arena itself, its list of
+     *         chunks and the allocator's overhead as overhead.
+     */
+    MemoryUsage memoryUsage(int numLiveNodes) const;
+};
+
+template <class Node>
+NodeArena<Node>::NodeArena(int nodesPerChunk)
+    : nextSlotPtr(nullptr), chunkEndPtr(nullptr), freeListPtr(nullptr),
+      nodesPerChunk(nodesPerChunk)
+{
+    if (nodesPerChunk < 1)
+    {
+        throw std::invalid_argument("NodeArena<Node>::NodeArena requires at "
+                                    "least one node per chunk.");
+    }
+}
+
+template <class Node>
+NodeArena<Node>::~NodeArena()
+{
+    release();
+}
+
+template <class Node>
+void NodeArena<Node>::addChunk()
+{
+    // operator new aligns for any fundamental type, and every slot is a
+    // multiple of sizeof(Node) from the start, so nodes are aligned too
+    char* chunkPtr = static_cast<char*>(
+        ::operator new(static_cast<std::size_t>(nodesPerChunk) * sizeof(Node)));
+    chunks.push_back(chunkPtr);
+    nextSlotPtr = chunkPtr;
+    chunkEndPtr = chunkPtr + static_cast<std::size_t>(nodesPerChunk) *
+                  sizeof(Node);
+}
+
+template <class Node>
+template <class... Args>
+Node* NodeArena<Node>::create(Args&&... args)
+{
+    void* slotPtr;
+    if (freeListPtr != nullptr)
+    {
+        slotPtr = freeListPtr;
+        freeListPtr = freeListPtr->nextPtr;
+    }
+    else
+    {
+        if (nextSlotPtr == chunkEndPtr)
+        {
+            addChunk();
+        }
+        slotPtr = nextSlotPtr;
+        nextSlotPtr += sizeof(Node);
+    }
+
+    try
+    {
+        return new (slotPtr) Node(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        FreeSlot* freeSlotPtr = static_cast<FreeSlot*>(slotPtr);
+        freeSlotPtr->nextPtr = freeListPtr;
+        freeListPtr = freeSlotPtr;
+        throw;
+    }
+}
+
+template <class Node>
+void NodeArena<Node>::destroy(Node* nodePtr)
+{
+    if (nodePtr == nullptr)
+    {
+        return;
+    }
+
+    nodePtr->~Node();
+    FreeSlot* freeSlotPtr = reinterpret_cast<FreeSlot*>(nodePtr);
+    freeSlotPtr->nextPtr = freeListPtr;
+    freeListPtr = freeSlotPtr;
+}
+
+template <class Node>
+void NodeArena<Node>::release()
+{
+    for (char* chunkPtr : chunks)
+    {
+        ::operator delete(chunkPtr);
+    }
+
+    chunks.clear();
+    nextSlotPtr = nullptr;
+    chunkEndPtr = nullptr;
+    freeListPtr = nullptr;
+}
+
+template <class Node>
+int NodeArena<Node>::getNodesPerChunk() const
+{
+    return nodesPerChunk;
+}
+
+template <class Node>
+int NodeArena<Node>::getNumChunks() const
+{
+    return static_cast<int>(chunks.size());
+}
+
+template <class Node>
+MemoryUsage NodeArena<Node>::memoryUsage(int numLiveNodes) const
+{
+    std::size_t chunkBytes = static_cast<std::size_t>(nodesPerChunk) *
+                             sizeof(Node);
+    std::size_t numSlots = chunks.size() *
+                           static_cast<std::size_t>(nodesPerChunk);
+
+    MemoryUsage usage;
+    usage.slackBytes = (numSlots - numLiveNodes) * sizeof(Node);
+    usage.overheadBytes = sizeof(*this) +
+                          chunks.capacity() * sizeof(char*);
+    addAllocation(usage, sizeof(*this));
+    if (chunks.capacity() > 0)
+    {
+        addAllocation(usage, chunks.capacity() * sizeof(char*));
+    }
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        addAllocation(usage, chunkBytes);
+    }
+
+    return usage;
+}
+
+#endif
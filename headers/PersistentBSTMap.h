@@ -0,0 +1,238 @@
+/**
+ * A Dictionary backed by a PersistentBinarySearchTree, so that consistent
+ * point-in-time views of it can be taken in O(1) while it is being modified.
+ * Lookups on the live map copy values out; references to values are only
+ * handed out by a @c Snapshot.
+ */
+#ifndef PERSISTENT_BST_MAP_H
+#define PERSISTENT_BST_MAP_H
+
+#include "Dictionary.h"
+#include "Entry.h"
+#include "PersistentBinarySearchTree.h"
+#include <stdexcept>
+
+template <class K, class V>
+class PersistentBSTMap : public Dictionary<K,V>
+{
+private:
+    typedef PersistentBinarySearchTree<Entry<K,V>> Tree;
+
+    Tree searchTree;
+
+public:
+    /**
+     * An immutable version of the map, whose values stay valid for as long
+     * as the snapshot exists. Any number of threads may read it.
+     */
+    class Snapshot
+    {
+    private:
+        typename Tree::Snapshot entries;
+
+        explicit Snapshot(const typename Tree::Snapshot& entries)
+            : entries(entries)
+        {
+
+        }
+
+        friend class PersistentBSTMap<K,V>;
+
+    public:
+        bool isEmpty() const;
+
+        int getSize() const;
+
+        bool contains(const K& key) const;
+
+        /**
+         * @throws runtime_error if the key is not in the snapshot.
+         */
+        const V& getValue(const K& key) const;
+
+        /**
+         * @return A pointer to the value associated with @c key, or
+         *         @c nullptr.
+         */
+        const V* findPtr(const K& key) const;
+    };
+
+    PersistentBSTMap();
+
+    /**
+     * Copying is O(1); see @c snapshot.
+     */
+    PersistentBSTMap(const PersistentBSTMap<K,V>& other);
+
+    virtual ~PersistentBSTMap();
+
+    PersistentBSTMap<K,V>& operator=(const PersistentBSTMap<K,V>& other);
+
+    /**
+     * Returns an immutable point-in-time view of the map in O(1), which can
+     * be read from any number of threads while this map keeps changing.
+     */
+    virtual Snapshot snapshot() const;
+
+    virtual bool isEmpty() const;
+
+    virtual int getSize() const;
+
+    virtual bool add(const K& key, const V& value);
+
+    virtual bool remove(const K& key);
+
+    /**
+     * Copies the value out of the current version.
+     * @throws runtime_error if the key is not in the map.
+     */
+    virtual V getValue(const K& key) const;
+
+    virtual bool tryGetValue(const K& key, V& outValue) const;
+
+    virtual bool contains(const K& key) const;
+
+    virtual void clear();
+
+    /**
+     * Associates @c value with @c key, replacing any existing value.
+     * @return true if the key was newly inserted, false otherwise.
+     */
+    bool insertOrAssign(const K& key, const V& value);
+};
+
+template <class K, class V>
+PersistentBSTMap<K,V>::PersistentBSTMap()
+{
+
+}
+
+template <class K, class V>
+PersistentBSTMap<K,V>::PersistentBSTMap(const PersistentBSTMap<K,V>& other)
+    : searchTree(other.searchTree)
+{
+
+}
+
+template <class K, class V>
+PersistentBSTMap<K,V>::~PersistentBSTMap()
+{
+
+}
+
+template <class K, class V>
+PersistentBSTMap<K,V>& PersistentBSTMap<K,V>::operator=(
+        const PersistentBSTMap<K,V>& other)
+{
+    searchTree = other.searchTree;
+    return *this;
+}
+
+template <class K, class V>
+typename PersistentBSTMap<K,V>::Snapshot PersistentBSTMap<K,V>::snapshot() const
+{
+    return Snapshot(searchTree.snapshot());
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::isEmpty() const
+{
+    return searchTree.empty();
+}
+
+template <class K, class V>
+int PersistentBSTMap<K,V>::getSize() const
+{
+    return searchTree.getNumNodes();
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::add(const K& key, const V& value)
+{
+    return searchTree.add(Entry<K,V>(key, value));
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::remove(const K& key)
+{
+    return searchTree.remove(Entry<K,V>(key));
+}
+
+template <class K, class V>
+V PersistentBSTMap<K,V>::getValue(const K& key) const
+{
+    // the snapshot keeps the entry alive until the value has been copied
+    return snapshot().getValue(key);
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::tryGetValue(const K& key, V& outValue) const
+{
+    Snapshot view = snapshot();
+    const V* valuePtr = view.findPtr(key);
+    if (valuePtr == nullptr)
+    {
+        return false;
+    }
+
+    outValue = *valuePtr;
+    return true;
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::contains(const K& key) const
+{
+    return snapshot().contains(key);
+}
+
+template <class K, class V>
+void PersistentBSTMap<K,V>::clear()
+{
+    searchTree.clear();
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::insertOrAssign(const K& key, const V& value)
+{
+    return searchTree.addOrReplace(Entry<K,V>(key, value));
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::Snapshot::isEmpty() const
+{
+    return entries.empty();
+}
+
+template <class K, class V>
+int PersistentBSTMap<K,V>::Snapshot::getSize() const
+{
+    return entries.getNumNodes();
+}
+
+template <class K, class V>
+bool PersistentBSTMap<K,V>::Snapshot::contains(const K& key) const
+{
+    return entries.findItem(key) != nullptr;
+}
+
+template <class K, class V>
+const V& PersistentBSTMap<K,V>::Snapshot::getValue(const K& key) const
+{
+    const V* valuePtr = findPtr(key);
+    if (valuePtr == nullptr)
+    {
+        throw std::runtime_error("Key not found in "
+                                 "PersistentBSTMap<K,V>::getValue.");
+    }
+
+    return *valuePtr;
+}
+
+template <class K, class V>
+const V* PersistentBSTMap<K,V>::Snapshot::findPtr(const K& key) const
+{
+    const Entry<K,V>* entryPtr = entries.findItem(key);
+    return (entryPtr != nullptr) ? &entryPtr->getValue() : nullptr;
+}
+
+#endif
@@ -0,0 +1,741 @@
+/**
+ * @class PersistentBinarySearchTree
+ * @brief A (non-balancing) binary search tree whose versions are immutable.
+ *
+ * Nodes are never modified once they are built. An add or remove copies only
+ * the nodes on the path from the root to the change, and shares every other
+ * node with the previous version through reference counting. Taking a
+ * snapshot therefore costs O(1): it just holds on to the current root.
+ * Readers of a snapshot need no locks, and the tree can keep changing while
+ * they read.
+ *
+ * Writers are serialized by an internal mutex. Readers of the live tree load
+ * the current version atomically, so each read sees either the version before
+ * or the version after any concurrent write. A concurrent write may free the
+ * nodes of the version a read saw, so the live tree copies items out; only
+ * a @c Snapshot, which keeps its version alive, hands out references.
+ */
+
+#ifndef PERSISTENT_BINARY_SEARCH_TREE_H
+#define PERSISTENT_BINARY_SEARCH_TREE_H
+
+#include "BinaryTree.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+template <class T>
+class PersistentBinarySearchTree
+{
+private:
+    struct Node;
+    typedef std::shared_ptr<const Node> NodePtr;
+
+    struct Node
+    {
+        const T item;
+        NodePtr leftPtr;
+        NodePtr rightPtr;
+
+        Node(const T& item, const NodePtr& leftPtr, const NodePtr& rightPtr)
+            : item(item), leftPtr(leftPtr), rightPtr(rightPtr)
+        {
+
+        }
+
+        /**
+         * Releases the node's children without recursion, so that dropping
+         * a degenerate (list-shaped) tree cannot overflow the stack.
+         */
+        ~Node();
+    };
+
+    /**
+     * One version of the tree: a root and the number of nodes reachable
+     * from it.
+     */
+    struct Version
+    {
+        NodePtr rootPtr;
+        int numNodes;
+
+        Version(const NodePtr& rootPtr, int numNodes)
+            : rootPtr(rootPtr), numNodes(numNodes)
+        {
+
+        }
+    };
+
+    typedef std::shared_ptr<const Version> VersionPtr;
+
+    /**
+     * The path from the root to a node, recorded during a descent so that
+     * the nodes on it can be copied bottom-up.
+     */
+    struct PathStep
+    {
+        const Node* nodePtr;
+        bool wentLeft;
+    };
+
+    VersionPtr current; ///< only accessed through loadVersion/storeVersion
+    std::mutex writeLock;
+
+    VersionPtr loadVersion() const;
+
+    void storeVersion(const VersionPtr& newVersion);
+
+    /**
+     * Rebuilds the path above a changed subtree.
+     * @param path The path from the root down to the parent of the change.
+     * @param newSubtreePtr The new subtree to hang from the last step.
+     * @return The root of the new version.
+     */
+    static NodePtr copyPath(const std::vector<PathStep>& path,
+                            NodePtr newSubtreePtr);
+
+    /**
+     * Finds the node comparing equal to @c key in the tree rooted at
+     * @c rootPtr, recording the path to it (excluding the node itself).
+     * @return The node, or @c nullptr if there is none.
+     */
+    template <class Key>
+    static const Node* findPath(const NodePtr& rootPtr, const Key& key,
+                                std::vector<PathStep>& path);
+
+    /**
+     * The height and the traversals walk the tree with an explicit stack or
+     * queue of nodes, so that a degenerate tree cannot overflow the stack.
+     */
+    static int treeHeightHelper(const Node* subtreePtr);
+
+    static void preorderHelper(TraversalFunction<T>* func,
+                               const Node* treePtr);
+
+    static void inorderHelper(TraversalFunction<T>* func,
+                              const Node* treePtr);
+
+    static void postorderHelper(TraversalFunction<T>* func,
+                                const Node* treePtr);
+
+public:
+    /**
+     * An immutable version of the tree. It keeps its nodes alive, so the
+     * references it hands out stay valid for as long as the snapshot exists,
+     * whatever is written to the tree meanwhile. Any number of threads may
+     * read it without locking.
+     */
+    class Snapshot
+    {
+    private:
+        VersionPtr version;
+
+        explicit Snapshot(const VersionPtr& version) : version(version)
+        {
+
+        }
+
+        friend class PersistentBinarySearchTree<T>;
+
+    public:
+        bool empty() const;
+
+        int getTreeHeight() const;
+
+        int getNumNodes() const;
+
+        bool contains(const T& item) const;
+
+        /**
+         * @throws runtime_error if the item does not exist in the snapshot.
+         */
+        const T& getItem(const T& item) const;
+
+        /**
+         * Searches for the item which compares equal to @c key, where @c Key
+         * is @c T or any type comparable with @c T using @c < and @c >.
+         * @return A pointer to the item, or @c nullptr.
+         */
+        template <class Key>
+        const T* findItem(const Key& key) const;
+
+        void preorderTraverse(TraversalFunction<T>* func) const;
+        void inorderTraverse(TraversalFunction<T>* func) const;
+        void postorderTraverse(TraversalFunction<T>* func) const;
+    };
+
+    PersistentBinarySearchTree();
+
+    /**
+     * Copying is O(1): the copy shares the current version with @c other.
+     * Later changes to either tree are not seen by the other.
+     */
+    PersistentBinarySearchTree(const PersistentBinarySearchTree<T>& other);
+
+    virtual ~PersistentBinarySearchTree();
+
+    PersistentBinarySearchTree<T>& operator=(
+            const PersistentBinarySearchTree<T>& other);
+
+    /**
+     * Returns an immutable point-in-time view of the tree in O(1). The
+     * snapshot may be read from any number of threads without locking while
+     * this tree continues to change.
+     */
+    virtual Snapshot snapshot() const;
+
+    /**
+     * Adds an item, copying the path from the root to its position.
+     * Duplicate items are not added.
+     * @return true if the item was added, false otherwise.
+     */
+    virtual bool add(const T& item);
+
+    /**
+     * Adds an item, or replaces the item which compares equal to it.
+     * @return true if the item was newly added, false if one was replaced.
+     */
+    virtual bool addOrReplace(const T& item);
+
+    /**
+     * Removes the item which compares equal to @c target, copying the path
+     * from the root to it (and to its inorder successor, if it has two
+     * children).
+     * @return true if an item was removed, false otherwise.
+     */
+    virtual bool remove(const T& target);
+
+    virtual bool contains(const T& item) const;
+
+    /**
+     * @return A copy of the item which compares equal to @c item.
+     * @throws runtime_error if the item does not exist in the tree.
+     */
+    virtual T getItem(const T& item) const;
+
+    /**
+     * Copies the item which compares equal to @c key, where @c Key is @c T or
+     * any type comparable with @c T using @c < and @c >, into @c outItem.
+     * @return true if the item was found, false otherwise.
+     */
+    template <class Key>
+    bool tryGetItem(const Key& key, T& outItem) const;
+
+    virtual bool empty() const;
+    virtual int getTreeHeight() const;
+    virtual int getNumNodes() const;
+    virtual void clear();
+    virtual void preorderTraverse(TraversalFunction<T>* func) const;
+    virtual void inorderTraverse(TraversalFunction<T>* func) const;
+    virtual void postorderTraverse(TraversalFunction<T>* func) const;
+};
+
+template <class T>
+PersistentBinarySearchTree<T>::Node::~Node()
+{
+    // The outermost node destructor on each thread drains a list of children
+    // to release; destructors of nodes freed while draining only add their
+    // own children to the list instead of recursing.
+    thread_local std::vector<NodePtr>* pendingPtr = nullptr;
+    if (!leftPtr && !rightPtr)
+    {
+        return;
+    }
+
+    if (pendingPtr != nullptr)
+    {
+        if (leftPtr)
+        {
+            pendingPtr->push_back(std::move(leftPtr));
+        }
+        if (rightPtr)
+        {
+            pendingPtr->push_back(std::move(rightPtr));
+        }
+        return;
+    }
+
+    std::vector<NodePtr> pending;
+    pendingPtr = &pending;
+    pending.push_back(std::move(leftPtr));
+    pending.push_back(std::move(rightPtr));
+    while (!pending.empty())
+    {
+        NodePtr nodePtr = std::move(pending.back());
+        pending.pop_back();
+        nodePtr.reset();
+    }
+    pendingPtr = nullptr;
+}
+
+template <class T>
+PersistentBinarySearchTree<T>::PersistentBinarySearchTree()
+    : current(std::make_shared<const Version>(NodePtr(), 0))
+{
+
+}
+
+template <class T>
+PersistentBinarySearchTree<T>::PersistentBinarySearchTree(
+        const PersistentBinarySearchTree<T>& other)
+    : current(other.loadVersion())
+{
+
+}
+
+template <class T>
+PersistentBinarySearchTree<T>::~PersistentBinarySearchTree()
+{
+
+}
+
+template <class T>
+PersistentBinarySearchTree<T>& PersistentBinarySearchTree<T>::operator=(
+        const PersistentBinarySearchTree<T>& other)
+{
+    if (this != &other)
+    {
+        std::lock_guard<std::mutex> guard(writeLock);
+        storeVersion(other.loadVersion());
+    }
+
+    return *this;
+}
+
+template <class T>
+typename PersistentBinarySearchTree<T>::VersionPtr
+PersistentBinarySearchTree<T>::loadVersion() const
+{
+    return std::atomic_load(&current);
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::storeVersion(const VersionPtr& newVersion)
+{
+    std::atomic_store(&current, newVersion);
+}
+
+template <class T>
+typename PersistentBinarySearchTree<T>::Snapshot
+PersistentBinarySearchTree<T>::snapshot() const
+{
+    return Snapshot(loadVersion());
+}
+
+template <class T>
+typename PersistentBinarySearchTree<T>::NodePtr
+PersistentBinarySearchTree<T>::copyPath(const std::vector<PathStep>& path,
+        NodePtr newSubtreePtr)
+{
+    for (auto step = path.rbegin(); step != path.rend(); ++step)
+    {
+        const Node* oldPtr = step->nodePtr;
+        if (step->wentLeft)
+        {
+            newSubtreePtr = std::make_shared<const Node>(oldPtr->item,
+                    newSubtreePtr, oldPtr->rightPtr);
+        }
+        else
+        {
+            newSubtreePtr = std::make_shared<const Node>(oldPtr->item,
+                    oldPtr->leftPtr, newSubtreePtr);
+        }
+    }
+
+    return newSubtreePtr;
+}
+
+template <class T>
+template <class Key>
+const typename PersistentBinarySearchTree<T>::Node*
+PersistentBinarySearchTree<T>::findPath(const NodePtr& rootPtr,
+        const Key& key, std::vector<PathStep>& path)
+{
+    const Node* curPtr = rootPtr.get();
+    while (curPtr != nullptr)
+    {
+        if (curPtr->item > key)
+        {
+            path.push_back(PathStep { curPtr, true });
+            curPtr = curPtr->leftPtr.get();
+        }
+        else if (curPtr->item < key)
+        {
+            path.push_back(PathStep { curPtr, false });
+            curPtr = curPtr->rightPtr.get();
+        }
+        else
+        {
+            return curPtr;
+        }
+    }
+
+    return nullptr;
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::add(const T& item)
+{
+    std::lock_guard<std::mutex> guard(writeLock);
+    VersionPtr version = loadVersion();
+
+    std::vector<PathStep> path;
+    if (findPath(version->rootPtr, item, path) != nullptr)
+    {
+        return false;
+    }
+
+    NodePtr newLeafPtr = std::make_shared<const Node>(item, NodePtr(),
+                                                      NodePtr());
+    storeVersion(std::make_shared<const Version>(copyPath(path, newLeafPtr),
+                                                 version->numNodes + 1));
+    return true;
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::addOrReplace(const T& item)
+{
+    std::lock_guard<std::mutex> guard(writeLock);
+    VersionPtr version = loadVersion();
+
+    std::vector<PathStep> path;
+    const Node* nodePtr = findPath(version->rootPtr, item, path);
+    if (nodePtr != nullptr)
+    {
+        NodePtr newNodePtr = std::make_shared<const Node>(item,
+                nodePtr->leftPtr, nodePtr->rightPtr);
+        storeVersion(std::make_shared<const Version>(
+                copyPath(path, newNodePtr), version->numNodes));
+        return false;
+    }
+
+    NodePtr newLeafPtr = std::make_shared<const Node>(item, NodePtr(),
+                                                      NodePtr());
+    storeVersion(std::make_shared<const Version>(copyPath(path, newLeafPtr),
+                                                 version->numNodes + 1));
+    return true;
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::remove(const T& target)
+{
+    std::lock_guard<std::mutex> guard(writeLock);
+    VersionPtr version = loadVersion();
+
+    std::vector<PathStep> path;
+    const Node* nodePtr = findPath(version->rootPtr, target, path);
+    if (nodePtr == nullptr)
+    {
+        return false;
+    }
+
+    NodePtr replacementPtr;
+    if (!nodePtr->leftPtr)
+    {
+        replacementPtr = nodePtr->rightPtr;
+    }
+    else if (!nodePtr->rightPtr)
+    {
+        replacementPtr = nodePtr->leftPtr;
+    }
+    else
+    {
+        // Replace the node with its inorder successor: the leftmost node of
+        // its right subtree, which is spliced out by copying the path to it.
+        std::vector<PathStep> successorPath;
+        const Node* successorPtr = nodePtr->rightPtr.get();
+        while (successorPtr->leftPtr)
+        {
+            successorPath.push_back(PathStep { successorPtr, true });
+            successorPtr = successorPtr->leftPtr.get();
+        }
+
+        NodePtr newRightPtr = copyPath(successorPath, successorPtr->rightPtr);
+        replacementPtr = std::make_shared<const Node>(successorPtr->item,
+                nodePtr->leftPtr, newRightPtr);
+    }
+
+    storeVersion(std::make_shared<const Version>(
+            copyPath(path, replacementPtr), version->numNodes - 1));
+    return true;
+}
+
+template <class T>
+template <class Key>
+bool PersistentBinarySearchTree<T>::tryGetItem(const Key& key,
+                                               T& outItem) const
+{
+    Snapshot view = snapshot();
+    const T* itemPtr = view.findItem(key);
+    if (itemPtr == nullptr)
+    {
+        return false;
+    }
+
+    outItem = *itemPtr;
+    return true;
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::contains(const T& item) const
+{
+    return snapshot().contains(item);
+}
+
+template <class T>
+T PersistentBinarySearchTree<T>::getItem(const T& item) const
+{
+    // the snapshot keeps the node alive until the item has been copied
+    return snapshot().getItem(item);
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::empty() const
+{
+    return loadVersion()->numNodes == 0;
+}
+
+template <class T>
+int PersistentBinarySearchTree<T>::treeHeightHelper(const Node* subtreePtr)
+{
+    // one pass over each level; the height is the number of levels
+    int height = 0;
+    std::vector<const Node*> level;
+    std::vector<const Node*> nextLevel;
+    if (subtreePtr != nullptr)
+    {
+        level.push_back(subtreePtr);
+    }
+
+    while (!level.empty())
+    {
+        height++;
+        nextLevel.clear();
+        for (const Node* nodePtr : level)
+        {
+            if (nodePtr->leftPtr != nullptr)
+            {
+                nextLevel.push_back(nodePtr->leftPtr.get());
+            }
+            if (nodePtr->rightPtr != nullptr)
+            {
+                nextLevel.push_back(nodePtr->rightPtr.get());
+            }
+        }
+        level.swap(nextLevel);
+    }
+
+    return height;
+}
+
+template <class T>
+int PersistentBinarySearchTree<T>::getTreeHeight() const
+{
+    return snapshot().getTreeHeight();
+}
+
+template <class T>
+int PersistentBinarySearchTree<T>::getNumNodes() const
+{
+    return loadVersion()->numNodes;
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::clear()
+{
+    std::lock_guard<std::mutex> guard(writeLock);
+    storeVersion(std::make_shared<const Version>(NodePtr(), 0));
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::preorderHelper(TraversalFunction<T>* func,
+        const Node* treePtr)
+{
+    std::vector<const Node*> pending;
+    if (treePtr != nullptr)
+    {
+        pending.push_back(treePtr);
+    }
+
+    while (!pending.empty())
+    {
+        const Node* nodePtr = pending.back();
+        pending.pop_back();
+
+        T item(nodePtr->item);
+        func->visit(item);
+
+        if (nodePtr->rightPtr != nullptr)
+        {
+            pending.push_back(nodePtr->rightPtr.get());
+        }
+        if (nodePtr->leftPtr != nullptr)
+        {
+            pending.push_back(nodePtr->leftPtr.get());
+        }
+    }
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::inorderHelper(TraversalFunction<T>* func,
+        const Node* treePtr)
+{
+    std::vector<const Node*> pending;
+    const Node* curPtr = treePtr;
+    while (curPtr != nullptr || !pending.empty())
+    {
+        while (curPtr != nullptr)
+        {
+            pending.push_back(curPtr);
+            curPtr = curPtr->leftPtr.get();
+        }
+
+        const Node* nodePtr = pending.back();
+        pending.pop_back();
+
+        T item(nodePtr->item);
+        func->visit(item);
+
+        curPtr = nodePtr->rightPtr.get();
+    }
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::postorderHelper(TraversalFunction<T>* func,
+        const Node* treePtr)
+{
+    // a node is visited once its right subtree, if any, has been
+    std::vector<const Node*> pending;
+    const Node* lastVisitedPtr = nullptr;
+    const Node* curPtr = treePtr;
+    while (curPtr != nullptr || !pending.empty())
+    {
+        while (curPtr != nullptr)
+        {
+            pending.push_back(curPtr);
+            curPtr = curPtr->leftPtr.get();
+        }
+
+        const Node* nodePtr = pending.back();
+        const Node* rightPtr = nodePtr->rightPtr.get();
+        if (rightPtr != nullptr && rightPtr != lastVisitedPtr)
+        {
+            curPtr = rightPtr;
+            continue;
+        }
+
+        T item(nodePtr->item);
+        func->visit(item);
+
+        lastVisitedPtr = nodePtr;
+        pending.pop_back();
+    }
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::preorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    snapshot().preorderTraverse(func);
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::inorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    snapshot().inorderTraverse(func);
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::postorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    snapshot().postorderTraverse(func);
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::Snapshot::empty() const
+{
+    return version->numNodes == 0;
+}
+
+template <class T>
+int PersistentBinarySearchTree<T>::Snapshot::getTreeHeight() const
+{
+    return treeHeightHelper(version->rootPtr.get());
+}
+
+template <class T>
+int PersistentBinarySearchTree<T>::Snapshot::getNumNodes() const
+{
+    return version->numNodes;
+}
+
+template <class T>
+bool PersistentBinarySearchTree<T>::Snapshot::contains(const T& item) const
+{
+    return findItem(item) != nullptr;
+}
+
+template <class T>
+const T& PersistentBinarySearchTree<T>::Snapshot::getItem(const T& item) const
+{
+    const T* itemPtr = findItem(item);
+    if (itemPtr == nullptr)
+    {
+        throw std::runtime_error("Item not found in "
+                                 "PersistentBinarySearchTree<T>::getItem");
+    }
+
+    return *itemPtr;
+}
+
+template <class T>
+template <class Key>
+const T* PersistentBinarySearchTree<T>::Snapshot::findItem(
+        const Key& key) const
+{
+    const Node* curPtr = version->rootPtr.get();
+    while (curPtr != nullptr)
+    {
+        if (curPtr->item > key)
+        {
+            curPtr = curPtr->leftPtr.get();
+        }
+        else if (curPtr->item < key)
+        {
+            curPtr = curPtr->rightPtr.get();
+        }
+        else
+        {
+            return &curPtr->item;
+        }
+    }
+
+    return nullptr;
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::Snapshot::preorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    preorderHelper(func, version->rootPtr.get());
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::Snapshot::inorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    inorderHelper(func, version->rootPtr.get());
+}
+
+template <class T>
+void PersistentBinarySearchTree<T>::Snapshot::postorderTraverse(
+        TraversalFunction<T>* func) const
+{
+    postorderHelper(func, version->rootPtr.get());
+}
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * Portable software prefetch hints.
+ */
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+/**
+ * Hints to the processor that the cache line containing @c address will soon
+ * be read, so that the load can overlap with other work. This is only a
+ * hint: it never faults, and compiles to nothing where it isn't supported.
+ * @param address The address to prefetch.
+ */
+inline void prefetchForRead(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void) address;
+#endif
+}
+
+/**
+ * Describes how a batched search prefetches the search key of an item which
+ * keeps its key outside of itself, behind a pointer. Such types (e.g.
+ * @c Entry) specialize this with @c ENABLED true and a @c prefetch function,
+ * and searches then fetch the key a step before comparing with it rather
+ * than taking a second dependent cache miss. By default an item's key is
+ * assumed to be inside it, and there is nothing more to prefetch.
+ */
+template <class T>
+struct KeyPrefetch
+{
+    static const bool ENABLED = false;
+
+    static void prefetch(const T&)
+    {
+
+    }
+};
+
+#endif
@@ -7,8 +7,8 @@
 
 #include "Heap.h"
 
-template<class T>
-class PriorityQueue : private Heap<T>
+template <class T, class Stats = NoStats>
+class PriorityQueue : private Heap<T, Stats>
 {
 public:
     PriorityQueue();
@@ -24,48 +24,52 @@ public:
     virtual const T& peek() const;
 
     virtual void clear();
+
+    using Heap<T, Stats>::memoryUsage;
+    using Heap<T, Stats>::shrinkToFit;
+    using Heap<T, Stats>::getStats;
 };
 
-template <class T>
-PriorityQueue<T>::PriorityQueue()
+template <class T, class Stats>
+PriorityQueue<T, Stats>::PriorityQueue()
 {
 
 }
 
-template <class T>
-PriorityQueue<T>::~PriorityQueue()
+template <class T, class Stats>
+PriorityQueue<T, Stats>::~PriorityQueue()
 {
 
 }
 
-template <class T>
-bool PriorityQueue<T>::isEmpty()
+template <class T, class Stats>
+bool PriorityQueue<T, Stats>::isEmpty() const
 {
-    return Heap::isEmpty();
+    return Heap<T, Stats>::isEmpty();
 }
 
-template <class T>
-bool PriorityQueue<T>::add(const T& item)
+template <class T, class Stats>
+bool PriorityQueue<T, Stats>::add(const T& item)
 {
-    return Heap::add(item);
+    return Heap<T, Stats>::add(item);
 }
 
-template <class T>
-bool PriorityQueue<T>::remove()
+template <class T, class Stats>
+bool PriorityQueue<T, Stats>::remove()
 {
-    return Heap::remove();
+    return Heap<T, Stats>::remove();
 }
 
-template <class T>
-const T& PriorityQueue<T>::peek()
+template <class T, class Stats>
+const T& PriorityQueue<T, Stats>::peek() const
 {
-    return Heap::peekTop();
+    return Heap<T, Stats>::peekTop();
 }
 
-template <class T>
-void PriorityQueue<T>::clear()
+template <class T, class Stats>
+void PriorityQueue<T, Stats>::clear()
 {
-    Heap::clear();
+    Heap<T, Stats>::clear();
 }
 
 #endif
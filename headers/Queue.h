@@ -1,24 +1,96 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include "Deque.h"
 #include "Node.h"
 #include <stdexcept>
+#include <type_traits>
 
+/**
+ * The storage behind a Queue: items are pushed at the back and popped and
+ * read at the front. It is specialized for each container a Queue can use;
+ * the primary template rejects any other container.
+ */
+template <class T, class Container>
+class QueueStorage
+{
+   static_assert(!std::is_same<Container, Container>::value,
+                 "Queue<T, Container> supports only Node<T> and "
+                 "Deque<T, BLOCK_SIZE> containers");
+};
+
+/**
+ * A circular list of linked nodes, one allocated per item.
+ */
 template <class T>
-class Queue
+class QueueStorage<T, Node<T>>
 {
 private:
    // circular back pointer (backPtr->getNext() is the 'front')
    Node<T>* backPtr = nullptr;
 
+public:
+   QueueStorage();
+
+   QueueStorage(const QueueStorage<T, Node<T>>& other);
+
+   ~QueueStorage();
+
+   QueueStorage<T, Node<T>>& operator=(const QueueStorage<T, Node<T>>& other);
+
+   void push(const T& item);
+
+   bool pop();
+
+   /**
+    * @return The front item; the queue must not be empty.
+    */
+   const T& front() const;
+
+   bool empty() const;
+
+   void clear();
+};
+
+/**
+ * A Deque, which allocates a block of items at a time.
+ */
+template <class T, int BLOCK_SIZE>
+class QueueStorage<T, Deque<T, BLOCK_SIZE>>
+{
+private:
+   Deque<T, BLOCK_SIZE> items;
+
+public:
+   void push(const T& item);
+
+   bool pop();
+
+   const T& front() const;
+
+   bool empty() const;
+
+   void clear();
+};
+
+/**
+ * A queue of linked nodes, one allocated per item. <tt>Queue<T, Deque<T>></tt>
+ * is backed by a Deque instead, which allocates a block of items at a time.
+ */
+template <class T, class Container = Node<T>>
+class Queue
+{
+private:
+   QueueStorage<T, Container> items;
+
 public:
    Queue();
 
-   Queue(const Queue<T>& other);
+   Queue(const Queue<T, Container>& other);
 
    virtual ~Queue();
 
-   virtual Queue<T>& operator=(const Queue<T>& other);
+   virtual Queue<T, Container>& operator=(const Queue<T, Container>& other);
 
    virtual bool push(const T& item);
 
@@ -32,26 +104,32 @@ public:
 };
 
 template <class T>
-Queue<T>::Queue()
+QueueStorage<T, Node<T>>::QueueStorage()
 {
 
 }
 
 template <class T>
-Queue<T>::Queue(const Queue<T>& other)
+QueueStorage<T, Node<T>>::QueueStorage(const QueueStorage<T, Node<T>>& other)
 {
    *this = other;
 }
 
 template <class T>
-Queue<T>::~Queue()
+QueueStorage<T, Node<T>>::~QueueStorage()
 {
    clear();
 }
 
 template <class T>
-Queue<T>& Queue<T>::operator=(const Queue<T>& other)
+QueueStorage<T, Node<T>>& QueueStorage<T, Node<T>>::operator=(
+   const QueueStorage<T, Node<T>>& other)
 {
+   if (this == &other)
+   {
+      return *this;
+   }
+
    clear();
 
    Node<T>* otherPtr = other.backPtr;
@@ -85,7 +163,7 @@ Queue<T>& Queue<T>::operator=(const Queue<T>& other)
 }
 
 template <class T>
-bool Queue<T>::push(const T& item)
+void QueueStorage<T, Node<T>>::push(const T& item)
 {
    if (backPtr == nullptr)
    {
@@ -98,11 +176,10 @@ bool Queue<T>::push(const T& item)
       backPtr = new Node<T>(item, tempPtr->getNext(), nullptr);
       tempPtr->setNext(backPtr);
    }
-   return true;
 }
 
 template <class T>
-bool Queue<T>::pop()
+bool QueueStorage<T, Node<T>>::pop()
 {
    if (empty())
    {
@@ -119,31 +196,26 @@ bool Queue<T>::pop()
       Node<T>* tempPtr = backPtr->getNext();
       backPtr->setNext(tempPtr->getNext());
       delete tempPtr;
-      tempPtr = nullptr;   
+      tempPtr = nullptr;
    }
 
    return true;
 }
 
 template <class T>
-const T& Queue<T>::front() const
+const T& QueueStorage<T, Node<T>>::front() const
 {
-   if (empty())
-   {
-      throw std::range_error("Attempt to call Queue<T>::front() on an empty queue.");
-   }
-
    return backPtr->getNext()->getItem();
 }
 
 template <class T>
-bool Queue<T>::empty() const
+bool QueueStorage<T, Node<T>>::empty() const
 {
    return backPtr == nullptr;
 }
 
 template <class T>
-void Queue<T>::clear()
+void QueueStorage<T, Node<T>>::clear()
 {
    if (backPtr == nullptr)
    {
@@ -161,4 +233,96 @@ void Queue<T>::clear()
    backPtr = nullptr;
 }
 
+template <class T, int BLOCK_SIZE>
+void QueueStorage<T, Deque<T, BLOCK_SIZE>>::push(const T& item)
+{
+   items.pushBack(item);
+}
+
+template <class T, int BLOCK_SIZE>
+bool QueueStorage<T, Deque<T, BLOCK_SIZE>>::pop()
+{
+   return items.popFront();
+}
+
+template <class T, int BLOCK_SIZE>
+const T& QueueStorage<T, Deque<T, BLOCK_SIZE>>::front() const
+{
+   return items.front();
+}
+
+template <class T, int BLOCK_SIZE>
+bool QueueStorage<T, Deque<T, BLOCK_SIZE>>::empty() const
+{
+   return items.empty();
+}
+
+template <class T, int BLOCK_SIZE>
+void QueueStorage<T, Deque<T, BLOCK_SIZE>>::clear()
+{
+   items.clear();
+}
+
+template <class T, class Container>
+Queue<T, Container>::Queue()
+{
+
+}
+
+template <class T, class Container>
+Queue<T, Container>::Queue(const Queue<T, Container>& other)
+   : items(other.items)
+{
+
+}
+
+template <class T, class Container>
+Queue<T, Container>::~Queue()
+{
+
+}
+
+template <class T, class Container>
+Queue<T, Container>& Queue<T, Container>::operator=(const Queue<T, Container>& other)
+{
+   items = other.items;
+   return *this;
+}
+
+template <class T, class Container>
+bool Queue<T, Container>::push(const T& item)
+{
+   items.push(item);
+   return true;
+}
+
+template <class T, class Container>
+bool Queue<T, Container>::pop()
+{
+   return items.pop();
+}
+
+template <class T, class Container>
+const T& Queue<T, Container>::front() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call Queue<T>::front() on an empty queue.");
+   }
+
+   return items.front();
+}
+
+template <class T, class Container>
+bool Queue<T, Container>::empty() const
+{
+   return items.empty();
+}
+
+template <class T, class Container>
+void Queue<T, Container>::clear()
+{
+   items.clear();
+}
+
 #endif
@@ -0,0 +1,333 @@
+/**
+ * @class ShardedMap
+ * @brief A thread-safe Dictionary which partitions its keys by hash into
+ * independently locked shards.
+ *
+ * Each shard is a @c BSTMap guarded by its own reader-writer lock, and is
+ * padded to a whole number of cache lines so that threads working on
+ * different shards never contend on the same line. Operations on keys in
+ * different shards proceed in parallel; lookups of keys in the same shard
+ * share its lock.
+ */
+
+#ifndef SHARDED_MAP_H
+#define SHARDED_MAP_H
+
+#include "Dictionary.h"
+#include "BSTMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedMap : public Dictionary<K,V>
+{
+private:
+    static const int DEFAULT_NUM_SHARDS = 64;
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Shard
+    {
+        mutable std::shared_mutex lock;
+        BSTMap<K,V> map;
+    };
+
+    Shard* shards; ///< array of numShards shards
+    int numShards; ///< always a power of two
+    int shardShift; ///< 64 - log2(numShards)
+    Hash hasher;
+
+    /**
+     * Selects the shard responsible for a key. The hash is scrambled with a
+     * multiplicative (Fibonacci) hash before taking its top bits, since
+     * @c std::hash is the identity for integers on common implementations.
+     */
+    Shard& getShard(const K& key) const;
+
+public:
+    /**
+     * @param numShards The number of shards, rounded up to a power of two.
+     *                  More shards means less contention at the cost of
+     *                  memory; a few times the number of threads is typical.
+     */
+    ShardedMap(int numShards = DEFAULT_NUM_SHARDS);
+
+    ShardedMap(const ShardedMap<K,V,Hash>& other);
+
+    virtual ~ShardedMap();
+
+    ShardedMap<K,V,Hash>& operator=(const ShardedMap<K,V,Hash>& other);
+
+    /**
+     * The size and emptiness of the map are computed by visiting each shard
+     * in turn, so under concurrent modification they are approximate.
+     */
+    virtual bool isEmpty() const;
+
+    virtual int getSize() const;
+
+    virtual bool add(const K& key, const V& value);
+
+    virtual bool remove(const K& key);
+
+    /**
+     * Copies the value associated with @c key while holding the shard's lock.
+     * @throws runtime_error if the key is not in the map.
+     */
+    virtual V getValue(const K& key) const;
+
+    virtual bool contains(const K& key) const;
+
+    virtual void clear();
+
+    /**
+     * Copies the value associated with @c key while holding the shard's lock.
+     * @param key The key to look up.
+     * @param outValue Set to the value, if the key was found.
+     * @return true if the key was found, false otherwise.
+     */
+    virtual bool tryGetValue(const K& key, V& outValue) const;
+
+    /**
+     * Associates @c value with @c key, replacing any existing value.
+     * @return true if the key was newly inserted, false otherwise.
+     */
+    bool insertOrAssign(const K& key, const V& value);
+
+    /**
+     * @return the number of shards.
+     */
+    int getNumShards() const;
+
+    /**
+     * Calls @c func(shardIndex, shardMap) for every shard, where @c shardMap
+     * is a <tt>const BSTMap<K,V>&</tt> holding that shard's entries. Each
+     * shard is read-locked while @c func runs on it, so writers to other
+     * shards are not blocked.
+     * @param func The function to call.
+     * @param numThreads If greater than 1, the shards are divided between
+     *                   this many threads, and @c func must be safe to call
+     *                   concurrently on different shards.
+     */
+    template <class Function>
+    void forEachShard(Function func, int numThreads = 1) const;
+};
+
+template <class K, class V, class Hash>
+ShardedMap<K,V,Hash>::ShardedMap(int numShards)
+{
+    if (numShards < 1)
+    {
+        throw std::invalid_argument("ShardedMap<K,V>::ShardedMap requires at "
+                                    "least one shard.");
+    }
+
+    this->numShards = 1;
+    shardShift = 64;
+    while (this->numShards < numShards)
+    {
+        this->numShards *= 2;
+        shardShift--;
+    }
+
+    shards = new Shard[this->numShards];
+}
+
+template <class K, class V, class Hash>
+ShardedMap<K,V,Hash>::ShardedMap(const ShardedMap<K,V,Hash>& other)
+    : numShards(other.numShards), shardShift(other.shardShift),
+      hasher(other.hasher)
+{
+    shards = new Shard[numShards];
+    for (int i = 0; i < numShards; i++)
+    {
+        std::shared_lock<std::shared_mutex> guard(other.shards[i].lock);
+        shards[i].map = other.shards[i].map;
+    }
+}
+
+template <class K, class V, class Hash>
+ShardedMap<K,V,Hash>::~ShardedMap()
+{
+    delete[] shards;
+    shards = nullptr;
+}
+
+template <class K, class V, class Hash>
+ShardedMap<K,V,Hash>& ShardedMap<K,V,Hash>::operator=(
+        const ShardedMap<K,V,Hash>& other)
+{
+    if (this != &other)
+    {
+        ShardedMap<K,V,Hash> copy(other);
+        std::swap(shards, copy.shards);
+        std::swap(numShards, copy.numShards);
+        std::swap(shardShift, copy.shardShift);
+        std::swap(hasher, copy.hasher);
+    }
+
+    return *this;
+}
+
+template <class K, class V, class Hash>
+typename ShardedMap<K,V,Hash>::Shard& ShardedMap<K,V,Hash>::getShard(
+        const K& key) const
+{
+    if (numShards == 1)
+    {
+        return shards[0];
+    }
+
+    std::uint64_t hash = static_cast<std::uint64_t>(hasher(key));
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return shards[hash >> shardShift];
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::isEmpty() const
+{
+    for (int i = 0; i < numShards; i++)
+    {
+        std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+        if (!shards[i].map.isEmpty())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class K, class V, class Hash>
+int ShardedMap<K,V,Hash>::getSize() const
+{
+    int size = 0;
+    for (int i = 0; i < numShards; i++)
+    {
+        std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+        size += shards[i].map.getSize();
+    }
+
+    return size;
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::add(const K& key, const V& value)
+{
+    Shard& shard = getShard(key);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    return shard.map.add(key, value);
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::remove(const K& key)
+{
+    Shard& shard = getShard(key);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    return shard.map.remove(key);
+}
+
+template <class K, class V, class Hash>
+V ShardedMap<K,V,Hash>::getValue(const K& key) const
+{
+    Shard& shard = getShard(key);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    const V* valuePtr = shard.map.findPtr(key);
+    if (valuePtr == nullptr)
+    {
+        throw std::runtime_error("Key not found in "
+                                 "ShardedMap<K,V,Hash>::getValue.");
+    }
+
+    return *valuePtr;
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::contains(const K& key) const
+{
+    Shard& shard = getShard(key);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    return shard.map.contains(key);
+}
+
+template <class K, class V, class Hash>
+void ShardedMap<K,V,Hash>::clear()
+{
+    for (int i = 0; i < numShards; i++)
+    {
+        std::unique_lock<std::shared_mutex> guard(shards[i].lock);
+        shards[i].map.clear();
+    }
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::tryGetValue(const K& key, V& outValue) const
+{
+    Shard& shard = getShard(key);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    const V* valuePtr = shard.map.findPtr(key);
+    if (valuePtr == nullptr)
+    {
+        return false;
+    }
+
+    outValue = *valuePtr;
+    return true;
+}
+
+template <class K, class V, class Hash>
+bool ShardedMap<K,V,Hash>::insertOrAssign(const K& key, const V& value)
+{
+    Shard& shard = getShard(key);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    return shard.map.insertOrAssign(key, value);
+}
+
+template <class K, class V, class Hash>
+int ShardedMap<K,V,Hash>::getNumShards() const
+{
+    return numShards;
+}
+
+template <class K, class V, class Hash>
+template <class Function>
+void ShardedMap<K,V,Hash>::forEachShard(Function func, int numThreads) const
+{
+    if (numThreads > numShards)
+    {
+        numThreads = numShards;
+    }
+
+    if (numThreads < 1)
+    {
+        numThreads = 1;
+    }
+
+    auto visitShards = [this, &func, numThreads](int firstShard)
+    {
+        for (int i = firstShard; i < numShards; i += numThreads)
+        {
+            std::shared_lock<std::shared_mutex> guard(shards[i].lock);
+            func(i, static_cast<const BSTMap<K,V>&>(shards[i].map));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++)
+    {
+        threads.emplace_back(visitShards, t);
+    }
+    visitShards(0);
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif
@@ -0,0 +1,498 @@
+/**
+ * Linear searches of an array, vectorized with SSE4.2 or AVX2 when @c T is
+ * an integral or floating-point type.
+ *
+ * The instruction set is chosen at run time, from what the processor
+ * supports, so the code needs no special compiler flags. Other types, and
+ * other compilers and processors, fall back to a scalar loop. Items are
+ * compared as with @c ==, so a NaN is never found, and 0.0 and -0.0 are
+ * equal.
+ */
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#define SIMD_SEARCH_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define SIMD_SEARCH_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+
+/**
+ * Whether searches for a @c T are vectorized: integral and floating-point
+ * types whose size is a power of two up to 8 bytes.
+ */
+template <class T>
+struct SimdSearchable : std::integral_constant<bool,
+    (std::is_integral<T>::value || std::is_same<T, float>::value ||
+     std::is_same<T, double>::value) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)>
+{
+
+};
+
+template <class T>
+int scalarIndexOf(const T* items, int numItems, const T& item)
+{
+    for (int i = 0; i < numItems; i++)
+    {
+        if (items[i] == item)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+template <class T>
+int scalarCount(const T* items, int numItems, const T& item)
+{
+    int numFound = 0;
+    for (int i = 0; i < numItems; i++)
+    {
+        if (items[i] == item)
+        {
+            numFound++;
+        }
+    }
+
+    return numFound;
+}
+
+template <class T>
+int scalarIndexOfAny(const T* items, int numItems, const T* targets,
+                     int numTargets)
+{
+    for (int i = 0; i < numItems; i++)
+    {
+        for (int j = 0; j < numTargets; j++)
+        {
+            if (items[i] == targets[j])
+            {
+                return i;
+            }
+        }
+    }
+
+    return -1;
+}
+
+#ifdef SIMD_SEARCH_X86
+
+// Each vector compare produces a mask with all bits of a lane set where the
+// lane matched; movemask turns that into sizeof(T) bits per lane, so a
+// lane's index is its first bit over sizeof(T), and the number of matches
+// is the number of bits over sizeof(T).
+
+template <class T>
+SIMD_SEARCH_SSE42 inline __m128i sse42Broadcast(T item)
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return _mm_castps_si128(_mm_set1_ps(item));
+    }
+    else if constexpr (std::is_same<T, double>::value)
+    {
+        return _mm_castpd_si128(_mm_set1_pd(item));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        return _mm_set1_epi8(static_cast<char>(item));
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm_set1_epi16(static_cast<short>(item));
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm_set1_epi32(static_cast<int>(item));
+    }
+    else
+    {
+        return _mm_set1_epi64x(static_cast<long long>(item));
+    }
+}
+
+template <class T>
+SIMD_SEARCH_SSE42 inline __m128i sse42Equal(__m128i block, __m128i target)
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(block),
+                                             _mm_castsi128_ps(target)));
+    }
+    else if constexpr (std::is_same<T, double>::value)
+    {
+        return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(block),
+                                             _mm_castsi128_pd(target)));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        return _mm_cmpeq_epi8(block, target);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm_cmpeq_epi16(block, target);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm_cmpeq_epi32(block, target);
+    }
+    else
+    {
+        return _mm_cmpeq_epi64(block, target);
+    }
+}
+
+template <class T>
+SIMD_SEARCH_SSE42 inline unsigned sse42EqualMask(const T* items,
+                                                 __m128i target)
+{
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items));
+    return static_cast<unsigned>(_mm_movemask_epi8(sse42Equal<T>(block,
+                                                                 target)));
+}
+
+template <class T>
+SIMD_SEARCH_SSE42 int sse42IndexOf(const T* items, int numItems,
+                                   const T& item)
+{
+    const int LANES = 16 / sizeof(T);
+    __m128i target = sse42Broadcast(item);
+    int i = 0;
+    for (; i + 4 * LANES <= numItems; i += 4 * LANES)
+    {
+        unsigned mask = sse42EqualMask(items + i, target) |
+            sse42EqualMask(items + i + LANES, target) |
+            sse42EqualMask(items + i + 2 * LANES, target) |
+            sse42EqualMask(items + i + 3 * LANES, target);
+        if (mask != 0)
+        {
+            break;
+        }
+    }
+
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        unsigned mask = sse42EqualMask(items + i, target);
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+
+    int index = scalarIndexOf(items + i, numItems - i, item);
+    return index < 0 ? -1 : i + index;
+}
+
+template <class T>
+SIMD_SEARCH_SSE42 int sse42Count(const T* items, int numItems, const T& item)
+{
+    const int LANES = 16 / sizeof(T);
+    __m128i target = sse42Broadcast(item);
+    int numBits = 0;
+    int i = 0;
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        numBits += __builtin_popcount(sse42EqualMask(items + i, target));
+    }
+
+    return numBits / sizeof(T) +
+        scalarCount(items + i, numItems - i, item);
+}
+
+template <class T>
+SIMD_SEARCH_SSE42 int sse42IndexOfAny(const T* items, int numItems,
+                                      const T* targets, int numTargets)
+{
+    const int LANES = 16 / sizeof(T);
+    int i = 0;
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        __m128i block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+        __m128i matches = _mm_setzero_si128();
+        for (int j = 0; j < numTargets; j++)
+        {
+            matches = _mm_or_si128(matches,
+                sse42Equal<T>(block, sse42Broadcast(targets[j])));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+
+    int index = scalarIndexOfAny(items + i, numItems - i, targets,
+                                 numTargets);
+    return index < 0 ? -1 : i + index;
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 inline __m256i avx2Broadcast(T item)
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return _mm256_castps_si256(_mm256_set1_ps(item));
+    }
+    else if constexpr (std::is_same<T, double>::value)
+    {
+        return _mm256_castpd_si256(_mm256_set1_pd(item));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        return _mm256_set1_epi8(static_cast<char>(item));
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm256_set1_epi16(static_cast<short>(item));
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm256_set1_epi32(static_cast<int>(item));
+    }
+    else
+    {
+        return _mm256_set1_epi64x(static_cast<long long>(item));
+    }
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 inline __m256i avx2Equal(__m256i block, __m256i target)
+{
+    if constexpr (std::is_same<T, float>::value)
+    {
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(block),
+            _mm256_castsi256_ps(target), _CMP_EQ_OQ));
+    }
+    else if constexpr (std::is_same<T, double>::value)
+    {
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(block),
+            _mm256_castsi256_pd(target), _CMP_EQ_OQ));
+    }
+    else if constexpr (sizeof(T) == 1)
+    {
+        return _mm256_cmpeq_epi8(block, target);
+    }
+    else if constexpr (sizeof(T) == 2)
+    {
+        return _mm256_cmpeq_epi16(block, target);
+    }
+    else if constexpr (sizeof(T) == 4)
+    {
+        return _mm256_cmpeq_epi32(block, target);
+    }
+    else
+    {
+        return _mm256_cmpeq_epi64(block, target);
+    }
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 inline __m256i avx2EqualBlock(const T* items,
+                                               __m256i target)
+{
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items));
+    return avx2Equal<T>(block, target);
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 int avx2IndexOf(const T* items, int numItems, const T& item)
+{
+    const int LANES = 32 / sizeof(T);
+    __m256i target = avx2Broadcast(item);
+    int i = 0;
+
+    // four vectors per iteration, with one test for all of them, to keep
+    // several loads in flight
+    for (; i + 4 * LANES <= numItems; i += 4 * LANES)
+    {
+        __m256i matches = _mm256_or_si256(
+            _mm256_or_si256(avx2EqualBlock(items + i, target),
+                            avx2EqualBlock(items + i + LANES, target)),
+            _mm256_or_si256(avx2EqualBlock(items + i + 2 * LANES, target),
+                            avx2EqualBlock(items + i + 3 * LANES, target)));
+        if (!_mm256_testz_si256(matches, matches))
+        {
+            break;
+        }
+    }
+
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(avx2EqualBlock(items + i, target)));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+
+    int index = scalarIndexOf(items + i, numItems - i, item);
+    return index < 0 ? -1 : i + index;
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 int avx2Count(const T* items, int numItems, const T& item)
+{
+    const int LANES = 32 / sizeof(T);
+    __m256i target = avx2Broadcast(item);
+    int numBits = 0;
+    int i = 0;
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        numBits += __builtin_popcount(static_cast<unsigned>(
+            _mm256_movemask_epi8(avx2EqualBlock(items + i, target))));
+    }
+
+    return numBits / sizeof(T) +
+        scalarCount(items + i, numItems - i, item);
+}
+
+template <class T>
+SIMD_SEARCH_AVX2 int avx2IndexOfAny(const T* items, int numItems,
+                                    const T* targets, int numTargets)
+{
+    const int LANES = 32 / sizeof(T);
+    int i = 0;
+    for (; i + LANES <= numItems; i += LANES)
+    {
+        __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(items + i));
+        __m256i matches = _mm256_setzero_si256();
+        for (int j = 0; j < numTargets; j++)
+        {
+            matches = _mm256_or_si256(matches,
+                avx2Equal<T>(block, avx2Broadcast(targets[j])));
+        }
+
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask) / sizeof(T);
+        }
+    }
+
+    int index = scalarIndexOfAny(items + i, numItems - i, targets,
+                                 numTargets);
+    return index < 0 ? -1 : i + index;
+}
+
+/**
+ * The best instruction set the processor supports, detected once.
+ */
+enum class SimdLevel
+{
+    SCALAR,
+    SSE42,
+    AVX2
+};
+
+inline SimdLevel getSimdLevel()
+{
+    static const SimdLevel level = []()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") &&
+            __builtin_cpu_supports("popcnt"))
+        {
+            return SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.2") &&
+            __builtin_cpu_supports("popcnt"))
+        {
+            return SimdLevel::SSE42;
+        }
+        return SimdLevel::SCALAR;
+    }();
+
+    return level;
+}
+
+#endif
+
+/**
+ * @return The index of the first item of @c items equal to @c item, or -1
+ *         if there is none.
+ */
+template <class T>
+int simdIndexOf(const T* items, int numItems, const T& item)
+{
+#ifdef SIMD_SEARCH_X86
+    if constexpr (SimdSearchable<T>::value)
+    {
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX2:
+            return avx2IndexOf(items, numItems, item);
+        case SimdLevel::SSE42:
+            return sse42IndexOf(items, numItems, item);
+        default:
+            break;
+        }
+    }
+#endif
+
+    return scalarIndexOf(items, numItems, item);
+}
+
+/**
+ * @return The number of items of @c items equal to @c item.
+ */
+template <class T>
+int simdCount(const T* items, int numItems, const T& item)
+{
+#ifdef SIMD_SEARCH_X86
+    if constexpr (SimdSearchable<T>::value)
+    {
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX2:
+            return avx2Count(items, numItems, item);
+        case SimdLevel::SSE42:
+            return sse42Count(items, numItems, item);
+        default:
+            break;
+        }
+    }
+#endif
+
+    return scalarCount(items, numItems, item);
+}
+
+/**
+ * @return The index of the first item of @c items equal to any of the
+ *         @c numTargets items of @c targets, or -1 if there is none. Every
+ *         item is compared with every target, so this is meant for small
+ *         sets of targets.
+ */
+template <class T>
+int simdIndexOfAny(const T* items, int numItems, const T* targets,
+                   int numTargets)
+{
+#ifdef SIMD_SEARCH_X86
+    if constexpr (SimdSearchable<T>::value)
+    {
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX2:
+            return avx2IndexOfAny(items, numItems, targets, numTargets);
+        case SimdLevel::SSE42:
+            return sse42IndexOfAny(items, numItems, targets, numTargets);
+        default:
+            break;
+        }
+    }
+#endif
+
+    return scalarIndexOfAny(items, numItems, targets, numTargets);
+}
+
+#endif
@@ -0,0 +1,584 @@
+/**
+ * @class SkipListMap
+ * @brief A lock-free, ordered Dictionary based on a skip list.
+ *
+ * Entries are kept in a sorted linked list, with sparser "express" lists
+ * above it: each node is linked into a random number of levels, with the
+ * number of nodes falling by a factor of four per level. A search moves
+ * right along each level until the next key is too large, then drops a
+ * level, for O(log n) expected time. Unlike a search tree, the structure
+ * never needs rebalancing, so every update is a handful of compare-and-swap
+ * operations on neighbouring links and no locks are needed.
+ *
+ * A node is removed by first marking its links (setting the low bit of each
+ * pointer), which logically deletes it and stops anything from being linked
+ * after it, and then unlinking it from each level. Any operation that comes
+ * across a marked node helps unlink it. Unlinked nodes are freed through the
+ * @c EpochManager once no thread can still be looking at them.
+ *
+ * Every operation except the destructor may be called concurrently with any
+ * other. @c add, @c remove, @c contains, @c getValue and @c tryGetValue
+ * are linearizable. Lookups copy values out rather than returning
+ * references, which would dangle once another thread removed the key. Iteration and range scans are weakly
+ * consistent: they visit entries in increasing key order, see every entry
+ * that is present throughout the scan, and may or may not see entries that
+ * are added or removed while it is in progress.
+ */
+
+#ifndef SKIP_LIST_MAP_H
+#define SKIP_LIST_MAP_H
+
+#include "Dictionary.h"
+#include "EpochManager.h"
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+
+template <class K, class V>
+class SkipListMap : public Dictionary<K,V>
+{
+private:
+    static const int MAX_LEVEL = 16;
+
+    /** A link to the next node, whose low bit marks its owner as removed. */
+    typedef std::atomic<std::uintptr_t> Link;
+
+    static const std::uintptr_t MARK_BIT = 1;
+
+    struct Node
+    {
+        const K key;
+        const V value;
+        const int height;
+        /**
+         * Both the inserting thread, until it has finished linking the
+         * upper levels, and the removing thread own the node; whichever
+         * finishes last unlinks it for good and retires it.
+         */
+        std::atomic<int> numOwners;
+        Link* links; ///< @c height links, allocated right after the node
+
+        Node(const K& key, const V& value, int height)
+            : key(key), value(value), height(height), numOwners(2),
+              links(reinterpret_cast<Link*>(this + 1))
+        {
+            for (int level = 0; level < height; level++)
+            {
+                new (&links[level]) Link(0);
+            }
+        }
+    };
+
+    Link headLinks[MAX_LEVEL];
+    std::atomic<int> size;
+
+    static Node* getNode(std::uintptr_t link);
+
+    static bool isMarked(std::uintptr_t link);
+
+    static Node* createNode(const K& key, const V& value, int height);
+
+    static void destroyNode(void* nodePtr);
+
+    /**
+     * @return A random height between 1 and MAX_LEVEL, where each further
+     *         level is a quarter as likely as the one before.
+     */
+    static int randomHeight();
+
+    /**
+     * Finds, at every level, the last link before @c key and the first node
+     * not less than it, unlinking any removed nodes on the way.
+     * @param key The key to search for.
+     * @param preds Set to the link arrays holding the last link before
+     *              @c key at each level.
+     * @param succs Set to the first node not less than @c key at each level.
+     * @return true if @c succs[0] holds @c key.
+     */
+    bool find(const K& key, Link** preds, Node** succs);
+
+    /**
+     * Searches without modifying anything, skipping removed nodes.
+     * @return The first node not less than @c key, or @c nullptr.
+     */
+    Node* findLowerBound(const K& key) const;
+
+    /**
+     * Gives up one thread's ownership of @c nodePtr; see @c Node::numOwners.
+     */
+    void releaseOwnership(Node* nodePtr);
+
+public:
+    SkipListMap();
+
+    SkipListMap(const SkipListMap<K,V>& other) = delete;
+
+    /**
+     * Frees every node. No other thread may be using the map.
+     */
+    virtual ~SkipListMap();
+
+    SkipListMap<K,V>& operator=(const SkipListMap<K,V>& other) = delete;
+
+    /**
+     * Under concurrent modification, the size is only a snapshot.
+     */
+    virtual bool isEmpty() const;
+
+    virtual int getSize() const;
+
+    virtual bool add(const K& key, const V& value);
+
+    virtual bool remove(const K& key);
+
+    /**
+     * Copies the value associated with @c key while the epoch guard keeps
+     * its node alive.
+     * @throws runtime_error if the key is not in the map.
+     */
+    virtual V getValue(const K& key) const;
+
+    virtual bool contains(const K& key) const;
+
+    /**
+     * Removes every entry, one at a time, so it is safe while other threads
+     * use the map, although entries they add meanwhile may remain.
+     */
+    virtual void clear();
+
+    /**
+     * Copies the value associated with @c key into @c value.
+     * @return true if the key was found, false otherwise.
+     */
+    virtual bool tryGetValue(const K& key, V& value) const;
+
+    /**
+     * Calls @c func(key, value) for every entry, in increasing key order.
+     * @param func The function to call.
+     */
+    template <class Function>
+    void forEach(Function func) const;
+
+    /**
+     * Calls @c func(key, value) for every entry whose key is at least
+     * @c low and less than @c high, in increasing key order.
+     * @param low The smallest key to visit.
+     * @param high The key at which to stop.
+     * @param func The function to call.
+     */
+    template <class Function>
+    void forEachInRange(const K& low, const K& high, Function func) const;
+};
+
+template <class K, class V>
+SkipListMap<K,V>::SkipListMap() : size(0)
+{
+    for (Link& link : headLinks)
+    {
+        link.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <class K, class V>
+SkipListMap<K,V>::~SkipListMap()
+{
+    Node* nodePtr = getNode(headLinks[0].load(std::memory_order_acquire));
+    while (nodePtr != nullptr)
+    {
+        Node* nextPtr = getNode(nodePtr->links[0].load(
+            std::memory_order_relaxed));
+        destroyNode(nodePtr);
+        nodePtr = nextPtr;
+    }
+}
+
+template <class K, class V>
+typename SkipListMap<K,V>::Node* SkipListMap<K,V>::getNode(
+        std::uintptr_t link)
+{
+    return reinterpret_cast<Node*>(link & ~MARK_BIT);
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::isMarked(std::uintptr_t link)
+{
+    return (link & MARK_BIT) != 0;
+}
+
+template <class K, class V>
+typename SkipListMap<K,V>::Node* SkipListMap<K,V>::createNode(const K& key,
+        const V& value, int height)
+{
+    void* memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+    try
+    {
+        return new (memory) Node(key, value, height);
+    }
+    catch (...)
+    {
+        ::operator delete(memory);
+        throw;
+    }
+}
+
+template <class K, class V>
+void SkipListMap<K,V>::destroyNode(void* nodePtr)
+{
+    static_cast<Node*>(nodePtr)->~Node();
+    ::operator delete(nodePtr);
+}
+
+template <class K, class V>
+int SkipListMap<K,V>::randomHeight()
+{
+    // xorshift64*, seeded differently in every thread
+    static thread_local std::uint64_t state =
+        reinterpret_cast<std::uintptr_t>(&state) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    std::uint64_t bits = state * 0x2545F4914F6CDD1DULL;
+
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 3) == 0)
+    {
+        height++;
+        bits >>= 2;
+    }
+
+    return height;
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::find(const K& key, Link** preds, Node** succs)
+{
+retry:
+    Link* predLinks = headLinks;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--)
+    {
+        Node* curPtr = getNode(predLinks[level].load(
+            std::memory_order_acquire));
+        while (curPtr != nullptr)
+        {
+            std::uintptr_t nextLink =
+                curPtr->links[level].load(std::memory_order_acquire);
+            if (isMarked(nextLink))
+            {
+                // help unlink the removed node
+                std::uintptr_t expected =
+                    reinterpret_cast<std::uintptr_t>(curPtr);
+                if (!predLinks[level].compare_exchange_strong(expected,
+                        nextLink & ~MARK_BIT))
+                {
+                    goto retry;
+                }
+
+                curPtr = getNode(nextLink);
+            }
+            else if (curPtr->key < key)
+            {
+                predLinks = curPtr->links;
+                curPtr = getNode(nextLink);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        preds[level] = predLinks;
+        succs[level] = curPtr;
+    }
+
+    return succs[0] != nullptr && !(key < succs[0]->key);
+}
+
+template <class K, class V>
+typename SkipListMap<K,V>::Node* SkipListMap<K,V>::findLowerBound(
+        const K& key) const
+{
+    const Link* predLinks = headLinks;
+    Node* curPtr = nullptr;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--)
+    {
+        curPtr = getNode(predLinks[level].load(std::memory_order_acquire));
+        while (curPtr != nullptr)
+        {
+            std::uintptr_t nextLink =
+                curPtr->links[level].load(std::memory_order_acquire);
+            if (isMarked(nextLink))
+            {
+                curPtr = getNode(nextLink);
+            }
+            else if (curPtr->key < key)
+            {
+                predLinks = curPtr->links;
+                curPtr = getNode(nextLink);
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    return curPtr;
+}
+
+template <class K, class V>
+void SkipListMap<K,V>::releaseOwnership(Node* nodePtr)
+{
+    if (nodePtr->numOwners.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    // Both owners are done, so the node is marked at every level and will
+    // not be linked anywhere again. Unlink it from every level it is still
+    // in before retiring it.
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    find(nodePtr->key, preds, succs);
+    EpochManager::getDefault().retire(nodePtr, &destroyNode);
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::isEmpty() const
+{
+    return getSize() == 0;
+}
+
+template <class K, class V>
+int SkipListMap<K,V>::getSize() const
+{
+    return size.load(std::memory_order_relaxed);
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::add(const K& key, const V& value)
+{
+    EpochGuard guard;
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    Node* newNodePtr = nullptr;
+    int height = randomHeight();
+
+    // link the bottom level, which is what makes the entry present
+    while (true)
+    {
+        if (find(key, preds, succs))
+        {
+            if (newNodePtr != nullptr)
+            {
+                destroyNode(newNodePtr);
+            }
+            return false;
+        }
+
+        if (newNodePtr == nullptr)
+        {
+            newNodePtr = createNode(key, value, height);
+        }
+
+        for (int level = 0; level < height; level++)
+        {
+            newNodePtr->links[level].store(
+                reinterpret_cast<std::uintptr_t>(succs[level]),
+                std::memory_order_relaxed);
+        }
+
+        std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(succs[0]);
+        if (preds[0][0].compare_exchange_strong(expected,
+                reinterpret_cast<std::uintptr_t>(newNodePtr)))
+        {
+            break;
+        }
+    }
+    size.fetch_add(1, std::memory_order_relaxed);
+
+    // then the levels above, which only speed up searches
+    for (int level = 1; level < height; level++)
+    {
+        while (true)
+        {
+            // point the node at its successor, unless a removal has begun
+            std::uintptr_t succLink =
+                reinterpret_cast<std::uintptr_t>(succs[level]);
+            std::uintptr_t currentLink =
+                newNodePtr->links[level].load(std::memory_order_acquire);
+            if (isMarked(currentLink) ||
+                (currentLink != succLink &&
+                 !newNodePtr->links[level].compare_exchange_strong(
+                     currentLink, succLink)))
+            {
+                goto linked;
+            }
+
+            std::uintptr_t expected = succLink;
+            if (preds[level][level].compare_exchange_strong(expected,
+                    reinterpret_cast<std::uintptr_t>(newNodePtr)))
+            {
+                break;
+            }
+
+            // the neighbourhood changed; look again, and stop if the node
+            // has been removed in the meantime
+            find(key, preds, succs);
+            if (succs[0] != newNodePtr)
+            {
+                goto linked;
+            }
+        }
+    }
+
+linked:
+    releaseOwnership(newNodePtr);
+    return true;
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::remove(const K& key)
+{
+    EpochGuard guard;
+    Link* preds[MAX_LEVEL];
+    Node* succs[MAX_LEVEL];
+    if (!find(key, preds, succs))
+    {
+        return false;
+    }
+
+    // mark the upper levels first, so nothing more is linked after the node
+    Node* nodePtr = succs[0];
+    for (int level = nodePtr->height - 1; level >= 1; level--)
+    {
+        std::uintptr_t nextLink =
+            nodePtr->links[level].load(std::memory_order_acquire);
+        while (!isMarked(nextLink) &&
+               !nodePtr->links[level].compare_exchange_weak(nextLink,
+                    nextLink | MARK_BIT))
+        {
+
+        }
+    }
+
+    // whichever thread marks the bottom level removes the entry
+    std::uintptr_t nextLink =
+        nodePtr->links[0].load(std::memory_order_acquire);
+    while (true)
+    {
+        if (isMarked(nextLink))
+        {
+            return false;
+        }
+
+        if (nodePtr->links[0].compare_exchange_strong(nextLink,
+                nextLink | MARK_BIT))
+        {
+            break;
+        }
+    }
+    size.fetch_sub(1, std::memory_order_relaxed);
+
+    find(key, preds, succs);
+    releaseOwnership(nodePtr);
+    return true;
+}
+
+template <class K, class V>
+V SkipListMap<K,V>::getValue(const K& key) const
+{
+    EpochGuard guard;
+    Node* nodePtr = findLowerBound(key);
+    if (nodePtr == nullptr || key < nodePtr->key)
+    {
+        throw std::runtime_error("Key not found in SkipListMap<K,V>::getValue.");
+    }
+
+    return nodePtr->value;
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::contains(const K& key) const
+{
+    EpochGuard guard;
+    Node* nodePtr = findLowerBound(key);
+    return nodePtr != nullptr && !(key < nodePtr->key);
+}
+
+template <class K, class V>
+void SkipListMap<K,V>::clear()
+{
+    EpochGuard guard;
+    while (true)
+    {
+        Node* nodePtr = getNode(headLinks[0].load(std::memory_order_acquire));
+        while (nodePtr != nullptr && isMarked(
+                   nodePtr->links[0].load(std::memory_order_acquire)))
+        {
+            nodePtr = getNode(nodePtr->links[0].load(
+                std::memory_order_acquire));
+        }
+
+        if (nodePtr == nullptr)
+        {
+            return;
+        }
+
+        // the guard keeps the node, and so its key, alive
+        remove(nodePtr->key);
+    }
+}
+
+template <class K, class V>
+bool SkipListMap<K,V>::tryGetValue(const K& key, V& value) const
+{
+    EpochGuard guard;
+    Node* nodePtr = findLowerBound(key);
+    if (nodePtr == nullptr || key < nodePtr->key)
+    {
+        return false;
+    }
+
+    value = nodePtr->value;
+    return true;
+}
+
+template <class K, class V>
+template <class Function>
+void SkipListMap<K,V>::forEach(Function func) const
+{
+    EpochGuard guard;
+    Node* nodePtr = getNode(headLinks[0].load(std::memory_order_acquire));
+    while (nodePtr != nullptr)
+    {
+        std::uintptr_t nextLink =
+            nodePtr->links[0].load(std::memory_order_acquire);
+        if (!isMarked(nextLink))
+        {
+            func(nodePtr->key, nodePtr->value);
+        }
+        nodePtr = getNode(nextLink);
+    }
+}
+
+template <class K, class V>
+template <class Function>
+void SkipListMap<K,V>::forEachInRange(const K& low, const K& high,
+                                      Function func) const
+{
+    EpochGuard guard;
+    Node* nodePtr = findLowerBound(low);
+    while (nodePtr != nullptr && nodePtr->key < high)
+    {
+        std::uintptr_t nextLink =
+            nodePtr->links[0].load(std::memory_order_acquire);
+        if (!isMarked(nextLink))
+        {
+            func(nodePtr->key, nodePtr->value);
+        }
+        nodePtr = getNode(nextLink);
+    }
+}
+
+#endif
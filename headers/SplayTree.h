@@ -0,0 +1,410 @@
+/**
+ * @class SplayTree
+ * @brief A self-adjusting binary search tree.
+ *
+ * Every access (a lookup, an insertion or a removal) splays the accessed
+ * item to the root, rotating the nodes on the way so that the path to it
+ * roughly halves in length. Items that are accessed often therefore stay
+ * near the root, which makes a splay tree well suited to skewed access
+ * patterns where a small set of items receives most lookups. Any sequence
+ * of m accesses takes O(m log n) time in total, although a single access
+ * may take O(n).
+ *
+ * Splaying is done top-down in a single pass, without recursion or a stack,
+ * so even a very deep tree is safe to search.
+ *
+ * Since lookups restructure the tree, @c contains, @c getItem and
+ * @c findItem are not const, and concurrent lookups need the same external
+ * synchronization as insertions and removals.
+ */
+
+#ifndef SPLAY_TREE_H
+#define SPLAY_TREE_H
+
+#include "BinaryTreeNode.h"
+#include "BinaryTree.h"
+#include <stdexcept>
+
+template <class T>
+class SplayTree : private BinaryTree<T>
+{
+private:
+    int numNodes;
+
+    /**
+     * Splays the subtree rooted at @c subtreePtr around @c key: afterwards
+     * its root is the item which compares equal to @c key if there is one,
+     * or else the item at which an unsuccessful search for @c key ended.
+     * @param subtreePtr The root of the subtree, which may be @c nullptr.
+     * @param key The search key (see @c findItem).
+     * @return The new root of the subtree.
+     */
+    template <class Key>
+    static BinaryTreeNode<T>* splay(BinaryTreeNode<T>* subtreePtr,
+                                    const Key& key);
+
+public:
+    SplayTree();
+    SplayTree(const SplayTree<T>& other);
+
+    virtual ~SplayTree();
+
+    SplayTree<T>& operator=(const SplayTree<T>& other);
+
+    /**
+     * Adds a new item to the tree, which becomes the new root. Items added
+     * to the tree must be unique (duplicate items will not be added, but the
+     * existing item is still splayed to the root).
+     * @param item The value to add to the tree.
+     * @return true if the item was added, false otherwise.
+     */
+    bool add(const T& item);
+
+    /**
+     * Removes the item with the specified value, if it exists.
+     * @param target The target value to search for.
+     * @return true if an item was removed, false otherwise.
+     */
+    bool remove(const T& target);
+
+    /**
+     * Searches the tree for a certain item, splaying it to the root.
+     * @param item The item to search for.
+     * @return true if the item is in the tree, false otherwise.
+     */
+    bool contains(const T& item);
+
+    /**
+     * Returns the item in the tree which compares equal to @c item, splaying
+     * it to the root.
+     * @param item The item to search for.
+     * @return A const reference to the item in the tree.
+     *
+     * @throws runtime_error if the item does not exist in the tree.
+     */
+    const T& getItem(const T& item);
+
+    /**
+     * Searches the tree for the item which compares equal to @c key, and
+     * splays it to the root. @c Key may be @c T itself, or any type that can
+     * be compared with @c T using @c < and @c >, as for
+     * @c BinarySearchTree::findItem.
+     * @param key The search key.
+     * @return A pointer to the item in the tree, or @c nullptr if there is no
+     *         such item. The pointer stays valid until the item is removed.
+     */
+    template <class Key>
+    T* findItem(const Key& key);
+
+    // interfaces to derived methods
+    bool empty() const;
+    int getTreeHeight() const;
+
+    /**
+     * @return The number of items in the tree, in constant time.
+     */
+    int getNumNodes() const;
+
+    void clear();
+    using BinaryTree<T>::useArena;
+    using BinaryTree<T>::usesArena;
+    void preorderTraverse(TraversalFunction<T>* func) const;
+    void inorderTraverse(TraversalFunction<T>* func) const;
+    void postorderTraverse(TraversalFunction<T>* func) const;
+
+    // iteration, see BinaryTree; none of these splay
+    using typename BinaryTree<T>::iterator;
+    using typename BinaryTree<T>::const_iterator;
+    using BinaryTree<T>::begin;
+    using BinaryTree<T>::end;
+    using BinaryTree<T>::preorder;
+    using BinaryTree<T>::inorder;
+    using BinaryTree<T>::postorder;
+    using BinaryTree<T>::levelorder;
+    using BinaryTree<T>::preorderForEach;
+    using BinaryTree<T>::inorderForEach;
+    using BinaryTree<T>::postorderForEach;
+};
+
+template <class T>
+SplayTree<T>::SplayTree() : numNodes(0)
+{
+
+}
+
+template <class T>
+SplayTree<T>::SplayTree(const SplayTree<T>& other)
+    : BinaryTree<T>(), numNodes(other.numNodes)
+{
+    this->copyAllocation(other);
+    this->rootPtr = this->copyTree(other.rootPtr);
+}
+
+template <class T>
+SplayTree<T>::~SplayTree()
+{
+
+}
+
+template <class T>
+SplayTree<T>& SplayTree<T>::operator=(const SplayTree<T>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        this->copyAllocation(other);
+        this->rootPtr = this->copyTree(other.rootPtr);
+        numNodes = other.numNodes;
+    }
+
+    return *this;
+}
+
+template <class T>
+template <class Key>
+BinaryTreeNode<T>* SplayTree<T>::splay(BinaryTreeNode<T>* subtreePtr,
+                                       const Key& key)
+{
+    if (subtreePtr == nullptr)
+    {
+        return nullptr;
+    }
+
+    // Nodes less than the key are gathered into a left tree, whose largest
+    // node is leftMaxPtr, and nodes greater than it into a right tree,
+    // whose smallest node is rightMinPtr. They become the final root's
+    // subtrees at the end.
+    BinaryTreeNode<T>* leftRootPtr = nullptr;
+    BinaryTreeNode<T>* leftMaxPtr = nullptr;
+    BinaryTreeNode<T>* rightRootPtr = nullptr;
+    BinaryTreeNode<T>* rightMinPtr = nullptr;
+    BinaryTreeNode<T>* curPtr = subtreePtr;
+
+    while (true)
+    {
+        if (curPtr->getItem() > key)
+        {
+            BinaryTreeNode<T>* leftPtr = curPtr->getLeft();
+            if (leftPtr == nullptr)
+            {
+                break;
+            }
+
+            if (leftPtr->getItem() > key)
+            {
+                // zig-zig: rotate right before linking
+                curPtr->setLeft(leftPtr->getRight());
+                leftPtr->setRight(curPtr);
+                curPtr = leftPtr;
+                if (curPtr->getLeft() == nullptr)
+                {
+                    break;
+                }
+            }
+
+            // link curPtr into the right tree as its new smallest node
+            if (rightMinPtr != nullptr)
+            {
+                rightMinPtr->setLeft(curPtr);
+            }
+            else
+            {
+                rightRootPtr = curPtr;
+            }
+            rightMinPtr = curPtr;
+            curPtr = curPtr->getLeft();
+        }
+        else if (curPtr->getItem() < key)
+        {
+            BinaryTreeNode<T>* rightPtr = curPtr->getRight();
+            if (rightPtr == nullptr)
+            {
+                break;
+            }
+
+            if (rightPtr->getItem() < key)
+            {
+                // zig-zig: rotate left before linking
+                curPtr->setRight(rightPtr->getLeft());
+                rightPtr->setLeft(curPtr);
+                curPtr = rightPtr;
+                if (curPtr->getRight() == nullptr)
+                {
+                    break;
+                }
+            }
+
+            // link curPtr into the left tree as its new largest node
+            if (leftMaxPtr != nullptr)
+            {
+                leftMaxPtr->setRight(curPtr);
+            }
+            else
+            {
+                leftRootPtr = curPtr;
+            }
+            leftMaxPtr = curPtr;
+            curPtr = curPtr->getRight();
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    // reassemble around curPtr
+    if (leftMaxPtr != nullptr)
+    {
+        leftMaxPtr->setRight(curPtr->getLeft());
+        curPtr->setLeft(leftRootPtr);
+    }
+
+    if (rightMinPtr != nullptr)
+    {
+        rightMinPtr->setLeft(curPtr->getRight());
+        curPtr->setRight(rightRootPtr);
+    }
+
+    return curPtr;
+}
+
+template <class T>
+bool SplayTree<T>::add(const T& item)
+{
+    BinaryTreeNode<T>* rootPtr = splay(this->rootPtr, item);
+    this->rootPtr = rootPtr;
+    if (rootPtr != nullptr && !(rootPtr->getItem() < item) &&
+        !(rootPtr->getItem() > item))
+    {
+        return false;
+    }
+
+    // the old root is the new item's neighbour, so it and one of its
+    // subtrees go on one side of the new root
+    BinaryTreeNode<T>* newNodePtr = this->createNode(item);
+    if (rootPtr != nullptr)
+    {
+        if (rootPtr->getItem() > item)
+        {
+            newNodePtr->setLeft(rootPtr->getLeft());
+            newNodePtr->setRight(rootPtr);
+            rootPtr->setLeft(nullptr);
+        }
+        else
+        {
+            newNodePtr->setRight(rootPtr->getRight());
+            newNodePtr->setLeft(rootPtr);
+            rootPtr->setRight(nullptr);
+        }
+    }
+
+    this->rootPtr = newNodePtr;
+    numNodes++;
+    return true;
+}
+
+template <class T>
+bool SplayTree<T>::remove(const T& target)
+{
+    if (findItem(target) == nullptr)
+    {
+        return false;
+    }
+
+    // every item in the left subtree is less than the target, so splaying
+    // it around the target brings its largest item to the top, which has no
+    // right child
+    BinaryTreeNode<T>* oldRootPtr = this->rootPtr;
+    BinaryTreeNode<T>* newRootPtr = splay(oldRootPtr->getLeft(), target);
+    if (newRootPtr != nullptr)
+    {
+        newRootPtr->setRight(oldRootPtr->getRight());
+    }
+    else
+    {
+        newRootPtr = oldRootPtr->getRight();
+    }
+
+    this->destroyNode(oldRootPtr);
+    this->rootPtr = newRootPtr;
+    numNodes--;
+    return true;
+}
+
+template <class T>
+bool SplayTree<T>::contains(const T& item)
+{
+    return findItem(item) != nullptr;
+}
+
+template <class T>
+const T& SplayTree<T>::getItem(const T& item)
+{
+    T* itemPtr = findItem(item);
+    if (itemPtr == nullptr)
+    {
+        throw std::runtime_error("Item not found in SplayTree<T>::getItem.");
+    }
+
+    return *itemPtr;
+}
+
+template <class T>
+template <class Key>
+T* SplayTree<T>::findItem(const Key& key)
+{
+    this->rootPtr = splay(this->rootPtr, key);
+    BinaryTreeNode<T>* rootPtr = this->rootPtr;
+    if (rootPtr == nullptr || rootPtr->getItem() < key ||
+        rootPtr->getItem() > key)
+    {
+        return nullptr;
+    }
+
+    return &rootPtr->getItem();
+}
+
+template <class T>
+bool SplayTree<T>::empty() const
+{
+    return BinaryTree<T>::empty();
+}
+
+template <class T>
+int SplayTree<T>::getTreeHeight() const
+{
+    return BinaryTree<T>::getTreeHeight();
+}
+
+template <class T>
+int SplayTree<T>::getNumNodes() const
+{
+    return numNodes;
+}
+
+template <class T>
+void SplayTree<T>::clear()
+{
+    BinaryTree<T>::clear();
+    numNodes = 0;
+}
+
+template <class T>
+void SplayTree<T>::preorderTraverse(TraversalFunction<T>* func) const
+{
+    BinaryTree<T>::preorderTraverse(func);
+}
+
+template <class T>
+void SplayTree<T>::inorderTraverse(TraversalFunction<T>* func) const
+{
+    BinaryTree<T>::inorderTraverse(func);
+}
+
+template <class T>
+void SplayTree<T>::postorderTraverse(TraversalFunction<T>* func) const
+{
+    BinaryTree<T>::postorderTraverse(func);
+}
+
+#endif
@@ -1,23 +1,96 @@
 #ifndef STACK_H
 #define STACK_H
 
+#include "Deque.h"
 #include "Node.h"
 #include <stdexcept>
+#include <type_traits>
 
+/**
+ * The storage behind a Stack: items are pushed, popped and read at the top.
+ * It is specialized for each container a Stack can use; the primary
+ * template rejects any other container.
+ */
+template <class T, class Container>
+class StackStorage
+{
+   static_assert(!std::is_same<Container, Container>::value,
+                 "Stack<T, Container> supports only Node<T> and "
+                 "Deque<T, BLOCK_SIZE> containers");
+};
+
+/**
+ * Linked nodes, one allocated per item.
+ */
 template <class T>
-class Stack
+class StackStorage<T, Node<T>>
 {
 private:
    Node<T>* topPtr = nullptr;
 
+public:
+   StackStorage();
+
+   StackStorage(const StackStorage<T, Node<T>>& other);
+
+   ~StackStorage();
+
+   StackStorage<T, Node<T>>& operator=(const StackStorage<T, Node<T>>& other);
+
+   void push(const T& item);
+
+   bool pop();
+
+   /**
+    * @return The top item; the stack must not be empty.
+    */
+   const T& top() const;
+
+   bool empty() const;
+
+   void clear();
+};
+
+/**
+ * A Deque, which allocates a block of items at a time; the top is the back
+ * of the deque.
+ */
+template <class T, int BLOCK_SIZE>
+class StackStorage<T, Deque<T, BLOCK_SIZE>>
+{
+private:
+   Deque<T, BLOCK_SIZE> items;
+
+public:
+   void push(const T& item);
+
+   bool pop();
+
+   const T& top() const;
+
+   bool empty() const;
+
+   void clear();
+};
+
+/**
+ * A stack of linked nodes, one allocated per item. <tt>Stack<T, Deque<T>></tt>
+ * is backed by a Deque instead, which allocates a block of items at a time.
+ */
+template <class T, class Container = Node<T>>
+class Stack
+{
+private:
+   StackStorage<T, Container> items;
+
 public:
    Stack();
 
-   Stack(const Stack<T>& other);
+   Stack(const Stack<T, Container>& other);
 
    virtual ~Stack();
 
-   virtual Stack<T>& operator=(const Stack<T>& other);
+   virtual Stack<T, Container>& operator=(const Stack<T, Container>& other);
 
    virtual bool push(const T& item);
 
@@ -32,26 +105,32 @@ public:
 };
 
 template <class T>
-Stack<T>::Stack()
+StackStorage<T, Node<T>>::StackStorage()
 {
 
 }
 
 template <class T>
-Stack<T>::Stack(const Stack<T>& other)
+StackStorage<T, Node<T>>::StackStorage(const StackStorage<T, Node<T>>& other)
 {
    *this = other;
 }
 
 template <class T>
-Stack<T>::~Stack()
+StackStorage<T, Node<T>>::~StackStorage()
 {
    clear();
 }
 
 template <class T>
-Stack<T>& Stack<T>::operator=(const Stack<T>& other)
+StackStorage<T, Node<T>>& StackStorage<T, Node<T>>::operator=(
+   const StackStorage<T, Node<T>>& other)
 {
+   if (this == &other)
+   {
+      return *this;
+   }
+
    clear();
 
    Node<T>* otherPtr = other.topPtr;
@@ -77,16 +156,15 @@ Stack<T>& Stack<T>::operator=(const Stack<T>& other)
 }
 
 template <class T>
-bool Stack<T>::push(const T& item)
+void StackStorage<T, Node<T>>::push(const T& item)
 {
    Node<T>* newTopPtr = new Node<T>(item, topPtr, nullptr);
    topPtr = newTopPtr;
    newTopPtr = nullptr;
-   return true;
 }
 
 template <class T>
-bool Stack<T>::pop()
+bool StackStorage<T, Node<T>>::pop()
 {
    if (empty())
    {
@@ -101,24 +179,19 @@ bool Stack<T>::pop()
 }
 
 template <class T>
-const T& Stack<T>::top() const
+const T& StackStorage<T, Node<T>>::top() const
 {
-   if (empty())
-   {
-      throw std::range_error("Attempt to call Stack<T>::top() on an empty stack.");
-   }
-
    return topPtr->getItem();
 }
 
 template <class T>
-bool Stack<T>::empty() const
+bool StackStorage<T, Node<T>>::empty() const
 {
    return topPtr == nullptr;
 }
 
 template <class T>
-void Stack<T>::clear()
+void StackStorage<T, Node<T>>::clear()
 {
    Node<T>* curPtr = topPtr;
    while (curPtr != nullptr)
@@ -130,4 +203,96 @@ void Stack<T>::clear()
    topPtr = nullptr;
 }
 
+template <class T, int BLOCK_SIZE>
+void StackStorage<T, Deque<T, BLOCK_SIZE>>::push(const T& item)
+{
+   items.pushBack(item);
+}
+
+template <class T, int BLOCK_SIZE>
+bool StackStorage<T, Deque<T, BLOCK_SIZE>>::pop()
+{
+   return items.popBack();
+}
+
+template <class T, int BLOCK_SIZE>
+const T& StackStorage<T, Deque<T, BLOCK_SIZE>>::top() const
+{
+   return items.back();
+}
+
+template <class T, int BLOCK_SIZE>
+bool StackStorage<T, Deque<T, BLOCK_SIZE>>::empty() const
+{
+   return items.empty();
+}
+
+template <class T, int BLOCK_SIZE>
+void StackStorage<T, Deque<T, BLOCK_SIZE>>::clear()
+{
+   items.clear();
+}
+
+template <class T, class Container>
+Stack<T, Container>::Stack()
+{
+
+}
+
+template <class T, class Container>
+Stack<T, Container>::Stack(const Stack<T, Container>& other)
+   : items(other.items)
+{
+
+}
+
+template <class T, class Container>
+Stack<T, Container>::~Stack()
+{
+
+}
+
+template <class T, class Container>
+Stack<T, Container>& Stack<T, Container>::operator=(const Stack<T, Container>& other)
+{
+   items = other.items;
+   return *this;
+}
+
+template <class T, class Container>
+bool Stack<T, Container>::push(const T& item)
+{
+   items.push(item);
+   return true;
+}
+
+template <class T, class Container>
+bool Stack<T, Container>::pop()
+{
+   return items.pop();
+}
+
+template <class T, class Container>
+const T& Stack<T, Container>::top() const
+{
+   if (empty())
+   {
+      throw std::range_error("Attempt to call Stack<T>::top() on an empty stack.");
+   }
+
+   return items.top();
+}
+
+template <class T, class Container>
+bool Stack<T, Container>::empty() const
+{
+   return items.empty();
+}
+
+template <class T, class Container>
+void Stack<T, Container>::clear()
+{
+   items.clear();
+}
+
 #endif
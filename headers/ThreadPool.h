@@ -0,0 +1,371 @@
+/**
+ * @class ThreadPool
+ * @brief A fixed-size pool of threads that execute tasks, with a work queue
+ * per thread and work stealing between them.
+ *
+ * Each thread pushes the tasks it spawns onto the back of its own queue and
+ * takes its next task from the back as well, so recently spawned (and still
+ * cached) work is run first. An idle thread steals from the front of another
+ * thread's queue, which for divide-and-conquer work holds the oldest and
+ * therefore largest pieces.
+ *
+ * Tasks are normally spawned through a @c TaskGroup, which lets a thread wait
+ * for the tasks it spawned. A waiting thread runs pending tasks rather than
+ * blocking, so fork-join tasks may spawn and wait for tasks of their own
+ * without deadlocking the pool.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+private:
+    static const std::size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) WorkQueue
+    {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * Queue 0 belongs to threads outside the pool, and queue i to the
+     * pool's i-th worker thread.
+     */
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<int> numPending; ///< tasks queued but not yet started
+    bool stopping;
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+
+    /** The pool and queue of the current thread, if it is a worker. */
+    static thread_local ThreadPool* currentPool;
+    static thread_local int currentQueue;
+
+    int getQueueIndex() const;
+
+    /**
+     * Takes a task from the back of this thread's own queue, or else from
+     * the front of another one.
+     * @return true if a task was taken, false if every queue was empty.
+     */
+    bool takeTask(std::function<void()>& task);
+
+    void workerLoop(int queueIndex);
+
+public:
+    /**
+     * @param numThreads The number of threads that run tasks, counting the
+     *                   thread that waits on a @c TaskGroup, so the pool
+     *                   starts <tt>numThreads - 1</tt> threads of its own. If
+     *                   0, the number of hardware threads is used.
+     */
+    explicit ThreadPool(int numThreads = 0);
+
+    ThreadPool(const ThreadPool& other) = delete;
+
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    /**
+     * Waits for the worker threads to finish their current tasks and stops
+     * them. Tasks still queued are discarded.
+     */
+    ~ThreadPool();
+
+    /**
+     * @return The number of threads that run tasks, as passed to the
+     *         constructor.
+     */
+    int getNumThreads() const;
+
+    /**
+     * Queues @c task to be run by some thread of the pool. The task must not
+     * throw; use a @c TaskGroup to propagate exceptions.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Runs one queued task on the calling thread, if there is one.
+     * @return true if a task was run, false otherwise.
+     */
+    bool runPendingTask();
+
+    /**
+     * @return A pool shared by the whole program, with one thread per
+     *         hardware thread.
+     */
+    static ThreadPool& getDefault();
+};
+
+/**
+ * @class TaskGroup
+ * @brief A set of tasks spawned on a @c ThreadPool which can be waited for
+ * together.
+ */
+class TaskGroup
+{
+private:
+    ThreadPool& pool;
+    std::atomic<int> numRunning;
+    std::mutex errorLock;
+    std::exception_ptr error; ///< the first exception thrown by a task
+
+public:
+    explicit TaskGroup(ThreadPool& pool);
+
+    TaskGroup(const TaskGroup& other) = delete;
+
+    TaskGroup& operator=(const TaskGroup& other) = delete;
+
+    /**
+     * Waits for any tasks still running. Exceptions they throw are dropped;
+     * call @c wait first to observe them.
+     */
+    ~TaskGroup();
+
+    /**
+     * Spawns @c task, which may itself spawn more tasks into this group.
+     */
+    template <class Function>
+    void run(Function task);
+
+    /**
+     * Runs queued tasks on the calling thread until every task of this group
+     * has finished.
+     * @throws The first exception thrown by any of the group's tasks.
+     */
+    void wait();
+};
+
+inline thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+inline thread_local int ThreadPool::currentQueue = 0;
+
+inline ThreadPool::ThreadPool(int numThreads)
+    : numPending(0), stopping(false)
+{
+    if (numThreads < 0)
+    {
+        throw std::invalid_argument("ThreadPool::ThreadPool requires a "
+                                    "non-negative number of threads.");
+    }
+
+    if (numThreads == 0)
+    {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (numThreads < 1)
+        {
+            numThreads = 1;
+        }
+    }
+
+    for (int i = 0; i < numThreads; i++)
+    {
+        queues.emplace_back(new WorkQueue());
+    }
+
+    for (int i = 1; i < numThreads; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+inline int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(queues.size());
+}
+
+inline int ThreadPool::getQueueIndex() const
+{
+    return (currentPool == this) ? currentQueue : 0;
+}
+
+inline void ThreadPool::submit(std::function<void()> task)
+{
+    WorkQueue& queue = *queues[getQueueIndex()];
+    {
+        std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    numPending.fetch_add(1, std::memory_order_release);
+    if (!workers.empty())
+    {
+        // taking the lock orders this with a worker about to go to sleep
+        std::lock_guard<std::mutex> guard(sleepLock);
+        wakeUp.notify_one();
+    }
+}
+
+inline bool ThreadPool::takeTask(std::function<void()>& task)
+{
+    if (numPending.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    int ownIndex = getQueueIndex();
+    {
+        WorkQueue& queue = *queues[ownIndex];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            numPending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    int numQueues = static_cast<int>(queues.size());
+    for (int i = 1; i < numQueues; i++)
+    {
+        WorkQueue& victim = *queues[(ownIndex + i) % numQueues];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            numPending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    if (!takeTask(task))
+    {
+        return false;
+    }
+
+    task();
+    return true;
+}
+
+inline void ThreadPool::workerLoop(int queueIndex)
+{
+    currentPool = this;
+    currentQueue = queueIndex;
+
+    while (true)
+    {
+        if (runPendingTask())
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wakeUp.wait(guard, [this]()
+        {
+            return stopping || numPending.load(std::memory_order_acquire) > 0;
+        });
+
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
+
+inline ThreadPool& ThreadPool::getDefault()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+inline TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool), numRunning(0)
+{
+
+}
+
+inline TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+
+    }
+}
+
+template <class Function>
+void TaskGroup::run(Function task)
+{
+    numRunning.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([this, task]() mutable
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+
+        // the group may be destroyed as soon as this reaches zero
+        numRunning.fetch_sub(1, std::memory_order_acq_rel);
+    });
+}
+
+inline void TaskGroup::wait()
+{
+    while (numRunning.load(std::memory_order_acquire) > 0)
+    {
+        if (!pool.runPendingTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr firstError;
+    {
+        std::lock_guard<std::mutex> guard(errorLock);
+        std::swap(firstError, error);
+    }
+
+    if (firstError)
+    {
+        std::rethrow_exception(firstError);
+    }
+}
+
+#endif
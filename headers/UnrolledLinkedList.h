@@ -0,0 +1,672 @@
+/**
+ * @class UnrolledLinkedList
+ * @brief A doubly linked list of blocks, each holding up to @c BLOCK_SIZE
+ * items in a contiguous array.
+ *
+ * A @c LinkedList spends a node (with a vptr and two pointers) on every item
+ * and takes a cache miss per item when it is scanned. Here the items of a
+ * block are adjacent, so a scan takes one miss per block and the per-item
+ * overhead is spread over up to @c BLOCK_SIZE items. The default block size
+ * keeps a block's items within about four cache lines, with at least 16 and
+ * at most 64 items.
+ *
+ * @c add appends to the last block, in amortized O(1) time. Inserting before
+ * an iterator shifts at most one block's items, splitting the block in two
+ * if it is full; inserting at an index first walks the blocks to it.
+ * @c remove merges a block with its successor when they fit in one, so
+ * blocks stay at least half full on average. Searches of integral and
+ * floating-point items are vectorized within each block (see SimdSearch.h).
+ *
+ * Items do not need a default constructor. Adding, inserting or removing an
+ * item invalidates iterators and pointers to the items of its block and the
+ * following block.
+ */
+
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+
+#include "List.h"
+#include "SimdSearch.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T>
+struct UnrolledBlockSize
+{
+   static const int VALUE = 256 / sizeof(T) < 16 ? 16 :
+      (256 / sizeof(T) > 64 ? 64 : static_cast<int>(256 / sizeof(T)));
+};
+
+template <class T, int BLOCK_SIZE = UnrolledBlockSize<T>::VALUE>
+class UnrolledLinkedList : public List<T>
+{
+private:
+   static_assert(BLOCK_SIZE >= 2, "A block must hold at least two items.");
+
+   struct Block
+   {
+      Block* nextPtr;
+      Block* prevPtr;
+      int numItems;
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type
+         storage[BLOCK_SIZE];
+
+      Block() : nextPtr(nullptr), prevPtr(nullptr), numItems(0)
+      {
+
+      }
+
+      T* items()
+      {
+         return reinterpret_cast<T*>(storage);
+      }
+
+      const T* items() const
+      {
+         return reinterpret_cast<const T*>(storage);
+      }
+   };
+
+   Block* headPtr;
+   Block* tailPtr;
+   int count;
+
+   /**
+    * Creates an empty block and links it in after @c prevPtr, or at the
+    * front if @c prevPtr is @c nullptr.
+    */
+   Block* insertBlockAfter(Block* prevPtr);
+
+   /**
+    * Unlinks an empty block and deletes it.
+    */
+   void removeBlock(Block* blockPtr);
+
+   /**
+    * Destroys the item at @c offset of @c blockPtr and closes the gap,
+    * merging the block with its successor if they now fit in one.
+    */
+   void removeAt(Block* blockPtr, int offset);
+
+   /**
+    * Moves the upper half of a full block into a new block after it.
+    */
+   void splitBlock(Block* blockPtr);
+
+   void copyFrom(const UnrolledLinkedList<T, BLOCK_SIZE>& other);
+
+public:
+   /**
+    * A bidirectional iterator; @c Item is @c T, or <tt>const T</tt> for a
+    * const_iterator.
+    */
+   template <class Item>
+   class Iterator
+   {
+   private:
+      Block* blockPtr; ///< @c nullptr at the end
+      Block* tailPtr; ///< so that the end iterator can be decremented
+      int offset;
+
+      friend class UnrolledLinkedList<T, BLOCK_SIZE>;
+
+   public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef T value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Item* pointer;
+      typedef Item& reference;
+
+      Iterator(Block* blockPtr, Block* tailPtr, int offset)
+         : blockPtr(blockPtr), tailPtr(tailPtr), offset(offset)
+      {
+
+      }
+
+      /**
+       * Converts an iterator to a const_iterator.
+       */
+      template <class OtherItem, class = typename std::enable_if<
+         std::is_const<Item>::value &&
+         std::is_same<OtherItem, T>::value>::type>
+      Iterator(const Iterator<OtherItem>& other)
+         : blockPtr(other.blockPtr), tailPtr(other.tailPtr),
+           offset(other.offset)
+      {
+
+      }
+
+      reference operator*() const
+      {
+         return blockPtr->items()[offset];
+      }
+
+      pointer operator->() const
+      {
+         return &blockPtr->items()[offset];
+      }
+
+      Iterator<Item>& operator++()
+      {
+         if (++offset == blockPtr->numItems)
+         {
+            blockPtr = blockPtr->nextPtr;
+            offset = 0;
+         }
+         return *this;
+      }
+
+      Iterator<Item> operator++(int)
+      {
+         Iterator<Item> old = *this;
+         ++(*this);
+         return old;
+      }
+
+      Iterator<Item>& operator--()
+      {
+         if (blockPtr == nullptr || offset == 0)
+         {
+            blockPtr = blockPtr == nullptr ? tailPtr : blockPtr->prevPtr;
+            offset = blockPtr->numItems;
+         }
+         offset--;
+         return *this;
+      }
+
+      Iterator<Item> operator--(int)
+      {
+         Iterator<Item> old = *this;
+         --(*this);
+         return old;
+      }
+
+      bool operator==(const Iterator<Item>& other) const
+      {
+         return blockPtr == other.blockPtr && offset == other.offset;
+      }
+
+      bool operator!=(const Iterator<Item>& other) const
+      {
+         return !(*this == other);
+      }
+
+      template <class OtherItem>
+      friend class Iterator;
+   };
+
+   typedef Iterator<T> iterator;
+   typedef Iterator<const T> const_iterator;
+
+private:
+   /**
+    * Inserts an item before the item at @c offset of @c blockPtr.
+    * @return An iterator to the new item.
+    */
+   iterator insertAt(Block* blockPtr, int offset, const T& item);
+
+public:
+   UnrolledLinkedList();
+
+   UnrolledLinkedList(const UnrolledLinkedList<T, BLOCK_SIZE>& other);
+
+   virtual ~UnrolledLinkedList();
+
+   UnrolledLinkedList<T, BLOCK_SIZE>& operator=(
+      const UnrolledLinkedList<T, BLOCK_SIZE>& other);
+
+   virtual void add(const T& item);
+
+   /**
+    * Inserts an item before position @c index.
+    * @param index The position of the new item, from 0 to @c size().
+    * @param item The item to insert.
+    * @throws out_of_range if @c index is out of range.
+    */
+   void insert(int index, const T& item);
+
+   /**
+    * Inserts an item before @c position, shifting the items of at most one
+    * block.
+    * @param position Where to insert the item; @c end() appends it.
+    * @param item The item to insert.
+    * @return An iterator to the new item.
+    */
+   iterator insert(const_iterator position, const T& item);
+
+   /**
+    * Removes the first item equal to @c item, if there is one.
+    * @return true if an item was removed, false otherwise.
+    */
+   virtual bool remove(const T& item);
+
+   /**
+    * @return The item at position @c index, found by walking the blocks.
+    * @throws out_of_range if @c index is out of range.
+    */
+   const T& get(int index) const;
+
+   virtual int size() const;
+
+   virtual bool empty() const;
+
+   virtual bool contains(const T& item) const;
+
+   virtual void clear();
+
+   virtual std::vector<T> toVector() const;
+
+   virtual std::vector<T> intoVector();
+
+   /**
+    * @return The number of blocks in the list.
+    */
+   int getNumBlocks() const;
+
+   iterator begin();
+   iterator end();
+   const_iterator begin() const;
+   const_iterator end() const;
+};
+
+template <class T, int BLOCK_SIZE>
+UnrolledLinkedList<T, BLOCK_SIZE>::UnrolledLinkedList()
+   : headPtr(nullptr), tailPtr(nullptr), count(0)
+{
+
+}
+
+template <class T, int BLOCK_SIZE>
+UnrolledLinkedList<T, BLOCK_SIZE>::UnrolledLinkedList(
+   const UnrolledLinkedList<T, BLOCK_SIZE>& other)
+   : headPtr(nullptr), tailPtr(nullptr), count(0)
+{
+   copyFrom(other);
+}
+
+template <class T, int BLOCK_SIZE>
+UnrolledLinkedList<T, BLOCK_SIZE>::~UnrolledLinkedList()
+{
+   clear();
+}
+
+template <class T, int BLOCK_SIZE>
+UnrolledLinkedList<T, BLOCK_SIZE>& UnrolledLinkedList<T, BLOCK_SIZE>::
+   operator=(const UnrolledLinkedList<T, BLOCK_SIZE>& other)
+{
+   if (this != &other)
+   {
+      clear();
+      copyFrom(other);
+   }
+
+   return *this;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::copyFrom(
+   const UnrolledLinkedList<T, BLOCK_SIZE>& other)
+{
+   // copied blocks are packed full
+   for (Block* otherPtr = other.headPtr; otherPtr != nullptr;
+        otherPtr = otherPtr->nextPtr)
+   {
+      for (int i = 0; i < otherPtr->numItems; i++)
+      {
+         add(otherPtr->items()[i]);
+      }
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::Block*
+UnrolledLinkedList<T, BLOCK_SIZE>::insertBlockAfter(Block* prevPtr)
+{
+   Block* blockPtr = new Block();
+   blockPtr->prevPtr = prevPtr;
+   blockPtr->nextPtr = prevPtr == nullptr ? headPtr : prevPtr->nextPtr;
+
+   if (blockPtr->nextPtr != nullptr)
+   {
+      blockPtr->nextPtr->prevPtr = blockPtr;
+   }
+   else
+   {
+      tailPtr = blockPtr;
+   }
+
+   if (prevPtr != nullptr)
+   {
+      prevPtr->nextPtr = blockPtr;
+   }
+   else
+   {
+      headPtr = blockPtr;
+   }
+
+   return blockPtr;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::removeBlock(Block* blockPtr)
+{
+   if (blockPtr->prevPtr != nullptr)
+   {
+      blockPtr->prevPtr->nextPtr = blockPtr->nextPtr;
+   }
+   else
+   {
+      headPtr = blockPtr->nextPtr;
+   }
+
+   if (blockPtr->nextPtr != nullptr)
+   {
+      blockPtr->nextPtr->prevPtr = blockPtr->prevPtr;
+   }
+   else
+   {
+      tailPtr = blockPtr->prevPtr;
+   }
+
+   delete blockPtr;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::removeAt(Block* blockPtr, int offset)
+{
+   T* items = blockPtr->items();
+   for (int i = offset + 1; i < blockPtr->numItems; i++)
+   {
+      items[i - 1] = std::move(items[i]);
+   }
+   blockPtr->numItems--;
+   items[blockPtr->numItems].~T();
+   count--;
+
+   if (blockPtr->numItems == 0)
+   {
+      removeBlock(blockPtr);
+      return;
+   }
+
+   Block* nextPtr = blockPtr->nextPtr;
+   if (nextPtr != nullptr &&
+       blockPtr->numItems + nextPtr->numItems <= BLOCK_SIZE)
+   {
+      T* nextItems = nextPtr->items();
+      for (int i = 0; i < nextPtr->numItems; i++)
+      {
+         new (&items[blockPtr->numItems + i]) T(std::move(nextItems[i]));
+         nextItems[i].~T();
+      }
+      blockPtr->numItems += nextPtr->numItems;
+      nextPtr->numItems = 0;
+      removeBlock(nextPtr);
+   }
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::splitBlock(Block* blockPtr)
+{
+   Block* newBlockPtr = insertBlockAfter(blockPtr);
+   int numKept = blockPtr->numItems / 2;
+   T* items = blockPtr->items();
+   T* newItems = newBlockPtr->items();
+   for (int i = numKept; i < blockPtr->numItems; i++)
+   {
+      new (&newItems[i - numKept]) T(std::move(items[i]));
+      items[i].~T();
+   }
+
+   newBlockPtr->numItems = blockPtr->numItems - numKept;
+   blockPtr->numItems = numKept;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::add(const T& item)
+{
+   if (tailPtr == nullptr || tailPtr->numItems == BLOCK_SIZE)
+   {
+      insertBlockAfter(tailPtr);
+   }
+
+   new (&tailPtr->items()[tailPtr->numItems]) T(item);
+   tailPtr->numItems++;
+   count++;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::insert(int index, const T& item)
+{
+   if (index < 0 || index > count)
+   {
+      throw std::out_of_range("Index out of range in "
+         "UnrolledLinkedList<T>::insert.");
+   }
+
+   if (index == count)
+   {
+      add(item);
+      return;
+   }
+
+   // find the block holding the item now at index
+   Block* blockPtr = headPtr;
+   while (index >= blockPtr->numItems)
+   {
+      index -= blockPtr->numItems;
+      blockPtr = blockPtr->nextPtr;
+   }
+
+   insertAt(blockPtr, index, item);
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::insert(const_iterator position,
+                                          const T& item)
+{
+   if (position.blockPtr == nullptr)
+   {
+      add(item);
+      return iterator(tailPtr, tailPtr, tailPtr->numItems - 1);
+   }
+
+   return insertAt(position.blockPtr, position.offset, item);
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::insertAt(Block* blockPtr, int offset,
+                                            const T& item)
+{
+   if (blockPtr->numItems == BLOCK_SIZE)
+   {
+      splitBlock(blockPtr);
+      if (offset >= blockPtr->numItems)
+      {
+         offset -= blockPtr->numItems;
+         blockPtr = blockPtr->nextPtr;
+      }
+   }
+
+   // open a gap at offset by moving the items after it up one slot
+   T* items = blockPtr->items();
+   int last = blockPtr->numItems;
+   new (&items[last]) T(std::move(items[last - 1]));
+   for (int i = last - 1; i > offset; i--)
+   {
+      items[i] = std::move(items[i - 1]);
+   }
+
+   items[offset] = item;
+   blockPtr->numItems++;
+   count++;
+   return iterator(blockPtr, tailPtr, offset);
+}
+
+template <class T, int BLOCK_SIZE>
+bool UnrolledLinkedList<T, BLOCK_SIZE>::remove(const T& item)
+{
+   for (Block* blockPtr = headPtr; blockPtr != nullptr;
+        blockPtr = blockPtr->nextPtr)
+   {
+      int offset = simdIndexOf(blockPtr->items(), blockPtr->numItems, item);
+      if (offset >= 0)
+      {
+         removeAt(blockPtr, offset);
+         return true;
+      }
+   }
+
+   return false;
+}
+
+template <class T, int BLOCK_SIZE>
+const T& UnrolledLinkedList<T, BLOCK_SIZE>::get(int index) const
+{
+   if (index < 0 || index >= count)
+   {
+      throw std::out_of_range("Index out of range in "
+         "UnrolledLinkedList<T>::get.");
+   }
+
+   const Block* blockPtr = headPtr;
+   while (index >= blockPtr->numItems)
+   {
+      index -= blockPtr->numItems;
+      blockPtr = blockPtr->nextPtr;
+   }
+
+   return blockPtr->items()[index];
+}
+
+template <class T, int BLOCK_SIZE>
+int UnrolledLinkedList<T, BLOCK_SIZE>::size() const
+{
+   return count;
+}
+
+template <class T, int BLOCK_SIZE>
+bool UnrolledLinkedList<T, BLOCK_SIZE>::empty() const
+{
+   return count == 0;
+}
+
+template <class T, int BLOCK_SIZE>
+bool UnrolledLinkedList<T, BLOCK_SIZE>::contains(const T& item) const
+{
+   for (const Block* blockPtr = headPtr; blockPtr != nullptr;
+        blockPtr = blockPtr->nextPtr)
+   {
+      if (simdIndexOf(blockPtr->items(), blockPtr->numItems, item) >= 0)
+      {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+template <class T, int BLOCK_SIZE>
+void UnrolledLinkedList<T, BLOCK_SIZE>::clear()
+{
+   Block* blockPtr = headPtr;
+   while (blockPtr != nullptr)
+   {
+      Block* nextPtr = blockPtr->nextPtr;
+      T* items = blockPtr->items();
+      for (int i = 0; i < blockPtr->numItems; i++)
+      {
+         items[i].~T();
+      }
+      delete blockPtr;
+      blockPtr = nextPtr;
+   }
+
+   headPtr = nullptr;
+   tailPtr = nullptr;
+   count = 0;
+}
+
+template <class T, int BLOCK_SIZE>
+std::vector<T> UnrolledLinkedList<T, BLOCK_SIZE>::toVector() const
+{
+   std::vector<T> vec;
+   vec.reserve(count);
+   for (const Block* blockPtr = headPtr; blockPtr != nullptr;
+        blockPtr = blockPtr->nextPtr)
+   {
+      vec.insert(vec.end(), blockPtr->items(),
+                 blockPtr->items() + blockPtr->numItems);
+   }
+
+   return vec;
+}
+
+template <class T, int BLOCK_SIZE>
+std::vector<T> UnrolledLinkedList<T, BLOCK_SIZE>::intoVector()
+{
+   std::vector<T> vec;
+   vec.reserve(count);
+   for (Block* blockPtr = headPtr; blockPtr != nullptr;
+        blockPtr = blockPtr->nextPtr)
+   {
+      T* items = blockPtr->items();
+      for (int i = 0; i < blockPtr->numItems; i++)
+      {
+         vec.push_back(std::move(items[i]));
+      }
+   }
+
+   clear();
+   return vec;
+}
+
+template <class T, int BLOCK_SIZE>
+int UnrolledLinkedList<T, BLOCK_SIZE>::getNumBlocks() const
+{
+   int numBlocks = 0;
+   for (const Block* blockPtr = headPtr; blockPtr != nullptr;
+        blockPtr = blockPtr->nextPtr)
+   {
+      numBlocks++;
+   }
+
+   return numBlocks;
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::begin()
+{
+   return iterator(headPtr, tailPtr, 0);
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::end()
+{
+   return iterator(nullptr, tailPtr, 0);
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::const_iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::begin() const
+{
+   return const_iterator(headPtr, tailPtr, 0);
+}
+
+template <class T, int BLOCK_SIZE>
+typename UnrolledLinkedList<T, BLOCK_SIZE>::const_iterator
+UnrolledLinkedList<T, BLOCK_SIZE>::end() const
+{
+   return const_iterator(nullptr, tailPtr, 0);
+}
+
+#endif
@@ -0,0 +1,187 @@
+#include "BSTMap.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+class BSTMapTest : public ::testing::Test
+{
+protected:
+    BSTMap<std::string, int> map;
+
+    BSTMapTest()
+    {
+
+    }
+
+    ~BSTMapTest()
+    {
+
+    }
+};
+
+TEST_F(BSTMapTest, SimpleTest)
+{
+    ASSERT_TRUE(map.isEmpty());
+
+    ASSERT_TRUE(map.add("b", 2));
+    ASSERT_TRUE(map.add("a", 1));
+    ASSERT_TRUE(map.add("c", 3));
+    ASSERT_FALSE(map.add("a", 10));
+
+    ASSERT_EQ(map.getSize(), 3);
+    EXPECT_EQ(map.getValue("a"), 1);
+    EXPECT_EQ(map.getValue("b"), 2);
+    EXPECT_EQ(map.getValue("c"), 3);
+    EXPECT_THROW(map.getValue("d"), std::runtime_error);
+
+    ASSERT_TRUE(map.remove("b"));
+    ASSERT_FALSE(map.contains("b"));
+    ASSERT_FALSE(map.remove("b"));
+    ASSERT_EQ(map.getSize(), 2);
+
+    BSTMap<std::string, int> copy(map);
+    map.clear();
+    ASSERT_TRUE(map.isEmpty());
+    EXPECT_EQ(copy.getValue("c"), 3);
+}
+
+TEST_F(BSTMapTest, FindPtrTest)
+{
+    EXPECT_EQ(map.findPtr("a"), nullptr);
+
+    map.add("a", 1);
+    int* valuePtr = map.findPtr("a");
+    ASSERT_NE(valuePtr, nullptr);
+    EXPECT_EQ(*valuePtr, 1);
+
+    *valuePtr = 5;
+    EXPECT_EQ(map.getValue("a"), 5);
+    EXPECT_EQ(map.findPtr("b"), nullptr);
+}
+
+TEST_F(BSTMapTest, InsertOrAssignTest)
+{
+    EXPECT_TRUE(map.insertOrAssign("a", 1));
+    EXPECT_FALSE(map.insertOrAssign("a", 2));
+    EXPECT_EQ(map.getValue("a"), 2);
+    EXPECT_EQ(map.getSize(), 1);
+}
+
+TEST_F(BSTMapTest, TryEmplaceTest)
+{
+    BSTMap<int, std::string> strings;
+    EXPECT_TRUE(strings.tryEmplace(1, 3, 'x'));
+    EXPECT_FALSE(strings.tryEmplace(1, 5, 'y'));
+    EXPECT_EQ(strings.getValue(1), "xxx");
+}
+
+TEST_F(BSTMapTest, GetOrInsertTest)
+{
+    int calls = 0;
+    auto zero = [&calls]() { calls++; return 0; };
+
+    const char* words[] = { "the", "cat", "the", "hat", "the", "cat" };
+    for (const char* word : words)
+    {
+        map.getOrInsert(word, zero)++;
+    }
+
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(map.getValue("the"), 3);
+    EXPECT_EQ(map.getValue("cat"), 2);
+    EXPECT_EQ(map.getValue("hat"), 1);
+}
+
+TEST_F(BSTMapTest, MultiGetTest)
+{
+    std::vector<std::string> keys;
+    std::vector<int> values;
+    std::vector<bool> found;
+
+    map.multiGet(keys, values, found);
+    EXPECT_TRUE(values.empty());
+
+    for (int i = 0; i < 40; i += 2)
+    {
+        map.add(std::to_string(i), i);
+    }
+
+    for (int i = 0; i < 40; i++)
+    {
+        keys.push_back(std::to_string(i));
+    }
+
+    map.multiGet(keys, values, found);
+    ASSERT_EQ(values.size(), keys.size());
+    ASSERT_EQ(found.size(), keys.size());
+    for (int i = 0; i < 40; i++)
+    {
+        EXPECT_EQ(found[i], i % 2 == 0);
+        EXPECT_EQ(values[i], (i % 2 == 0) ? i : 0);
+    }
+
+    std::vector<bool> contained;
+    map.multiContains(keys, contained);
+    EXPECT_EQ(contained, found);
+}
+
+TEST(BSTMapDegenerateTest, RemoveTest)
+{
+    // keys added in order form a single spine, deep enough to overflow the
+    // call stack if removing recursed
+    const int NUM_KEYS = 40000;
+    BSTMap<int, int> intMap;
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        intMap.add(i, -i);
+    }
+
+    EXPECT_TRUE(intMap.remove(NUM_KEYS - 1));
+    EXPECT_TRUE(intMap.remove(NUM_KEYS / 2));
+    EXPECT_TRUE(intMap.remove(0));
+    EXPECT_FALSE(intMap.remove(NUM_KEYS / 2));
+    EXPECT_FALSE(intMap.contains(NUM_KEYS - 1));
+    EXPECT_EQ(intMap.getValue(NUM_KEYS - 2), 2 - NUM_KEYS);
+    EXPECT_EQ(intMap.getSize(), NUM_KEYS - 3);
+}
+
+TEST_F(BSTMapTest, MemoryUsageTest)
+{
+    EXPECT_EQ(map.memoryUsage().getTotalBytes(), sizeof(map));
+
+    // short keys are held inside the strings
+    map.add("a", 1);
+    map.add("b", 2);
+    MemoryUsage usage = map.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 2 * (sizeof(std::string) + sizeof(int)));
+    EXPECT_EQ(usage.slackBytes, 0u);
+    EXPECT_GE(usage.overheadBytes,
+              sizeof(map) + 2 * sizeof(Entry<std::string, int>));
+
+    // a long key's buffer is payload too
+    const std::string LONG_KEY(100, 'k');
+    map.add(LONG_KEY, 3);
+    EXPECT_GE(map.memoryUsage().payloadBytes,
+              usage.payloadBytes + sizeof(std::string) + sizeof(int) + 101);
+
+    map.clear();
+    EXPECT_EQ(map.memoryUsage().payloadBytes, 0u);
+
+    // entries of plain keys and values are counted without visiting them
+    BSTMap<int, double> numbers;
+    for (int i = 0; i < 100; i++)
+    {
+        numbers.add(i * 37 % 100, i);
+    }
+    usage = numbers.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 100 * (sizeof(int) + sizeof(double)));
+    EXPECT_EQ(usage.slackBytes, 0u);
+    EXPECT_GE(usage.overheadBytes, sizeof(numbers) +
+              100 * sizeof(BinaryTreeNode<Entry<int, double>>));
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
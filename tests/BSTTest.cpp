@@ -1,5 +1,7 @@
 #include "BinarySearchTree.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <string>
 #include <vector>
 
 class BSTTest : public ::testing::Test
@@ -63,6 +65,192 @@ TEST_F(BSTTest, SimpleTest)
     ASSERT_FALSE(tree->contains(2));
 }
 
+TEST_F(BSTTest, FindOrInsertTest)
+{
+    tree->add(5);
+    tree->add(3);
+
+    bool inserted = false;
+    int* itemPtr = tree->findOrInsert(3, []() { return 3; }, inserted);
+    ASSERT_NE(itemPtr, nullptr);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*itemPtr, 3);
+
+    itemPtr = tree->findOrInsert(4, []() { return 4; }, inserted);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*itemPtr, 4);
+    EXPECT_EQ(tree->getNumNodes(), 3);
+
+    EXPECT_NE(tree->findItem(4), nullptr);
+    EXPECT_EQ(tree->findItem(6), nullptr);
+    EXPECT_FALSE(tree->add(4));
+}
+
+TEST_F(BSTTest, IteratorTest)
+{
+    int items[] = { 5, 2, 8, 1, 3, 7, 9 };
+    for (int item : items)
+    {
+        tree->add(item);
+    }
+
+    std::vector<int> sorted;
+    for (int item : *tree)
+    {
+        sorted.push_back(item);
+    }
+    std::vector<int> expected = { 1, 2, 3, 5, 7, 8, 9 };
+    EXPECT_EQ(sorted, expected);
+
+    EXPECT_EQ(*std::find_if(tree->begin(), tree->end(),
+                            [](int item) { return item > 5; }), 7);
+    EXPECT_EQ(std::count_if(tree->begin(), tree->end(),
+                            [](int item) { return item % 2 == 1; }), 5);
+
+    std::vector<int> levels(tree->levelorder().begin(),
+                            tree->levelorder().end());
+    std::vector<int> expectedLevels = { 5, 2, 8, 1, 3, 7, 9 };
+    EXPECT_EQ(levels, expectedLevels);
+}
+
+TEST_F(BSTTest, DegenerateTreeIteratorTest)
+{
+    // inserting sorted items builds a tree that is one long right spine
+    const int NUM_ITEMS = 20000;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree->add(i);
+    }
+
+    int expected = 0;
+    for (int item : *tree)
+    {
+        ASSERT_EQ(item, expected++);
+    }
+    EXPECT_EQ(expected, NUM_ITEMS);
+
+    expected = NUM_ITEMS - 1;
+    for (int item : tree->postorder())
+    {
+        ASSERT_EQ(item, expected--);
+    }
+
+    long long sum = 0;
+    tree->morrisInorderTraverse([&sum](const int& item) { sum += item; });
+    EXPECT_EQ(sum, (long long) NUM_ITEMS * (NUM_ITEMS - 1) / 2);
+}
+
+TEST_F(BSTTest, DegenerateTreeRemoveTest)
+{
+    // deep enough to overflow the call stack if searching or removing
+    // recursed
+    const int NUM_ITEMS = 40000;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree->add(i);
+    }
+
+    EXPECT_TRUE(tree->contains(NUM_ITEMS - 1));
+    EXPECT_EQ(tree->getItem(NUM_ITEMS - 2), NUM_ITEMS - 2);
+    EXPECT_FALSE(tree->remove(NUM_ITEMS));
+
+    // from the bottom of the spine, the middle and the root
+    EXPECT_TRUE(tree->remove(NUM_ITEMS - 1));
+    EXPECT_TRUE(tree->remove(NUM_ITEMS / 2));
+    EXPECT_TRUE(tree->remove(0));
+    EXPECT_FALSE(tree->contains(NUM_ITEMS / 2));
+    EXPECT_EQ(tree->getNumNodes(), NUM_ITEMS - 3);
+    EXPECT_EQ(tree->getTreeHeight(), NUM_ITEMS - 3);
+
+    int expected = 1;
+    for (int item : *tree)
+    {
+        if (expected == NUM_ITEMS / 2)
+        {
+            expected++;
+        }
+        ASSERT_EQ(item, expected++);
+    }
+    EXPECT_EQ(expected, NUM_ITEMS - 1);
+}
+
+TEST_F(BSTTest, ArenaTest)
+{
+    // std::string is not trivially destructible, so clearing must still run
+    // the destructors of the remaining items
+    BinarySearchTree<std::string> words;
+    words.useArena(16);
+    for (int i = 0; i < 100; i++)
+    {
+        words.add("word number " + std::to_string(i));
+    }
+    EXPECT_EQ(words.getNumNodes(), 100);
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        EXPECT_TRUE(words.remove("word number " + std::to_string(i)));
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(words.contains("word number " + std::to_string(i)),
+                  i % 2 == 1);
+    }
+
+    BinarySearchTree<std::string> copy(words);
+    EXPECT_TRUE(copy.usesArena());
+    EXPECT_TRUE(std::equal(copy.begin(), copy.end(), words.begin()));
+
+    // assignment sets up the allocation as the copy constructor does
+    BinarySearchTree<std::string> assigned;
+    assigned.add("replaced");
+    assigned = words;
+    EXPECT_TRUE(assigned.usesArena());
+    EXPECT_EQ(assigned.getNumNodes(), 50);
+    EXPECT_TRUE(std::equal(assigned.begin(), assigned.end(), words.begin()));
+    assigned = BinarySearchTree<std::string>();
+    EXPECT_FALSE(assigned.usesArena());
+    EXPECT_TRUE(assigned.empty());
+
+    words.clear();
+    EXPECT_TRUE(words.empty());
+    EXPECT_EQ(copy.getNumNodes(), 50);
+
+    tree->useArena();
+    for (int i = 0; i < 1000; i++)
+    {
+        tree->add((i * 7919) % 1000);
+    }
+    EXPECT_EQ(tree->getNumNodes(), 1000);
+    EXPECT_TRUE(std::is_sorted(tree->begin(), tree->end()));
+}
+
+TEST_F(BSTTest, MemoryUsageTest)
+{
+    const std::size_t LINK_BYTES = sizeof(BinaryTreeNode<int>) - sizeof(int);
+    MemoryUsage usage = tree->memoryUsage();
+    EXPECT_EQ(usage.getTotalBytes(), usage.overheadBytes);
+
+    for (int i = 0; i < 20; i++)
+    {
+        tree->add(i);
+    }
+    usage = tree->memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 20 * sizeof(int));
+    EXPECT_EQ(usage.slackBytes, 0u);
+    EXPECT_GE(usage.overheadBytes, 20 * LINK_BYTES);
+
+    // two chunks of 16 nodes, 12 of them unused
+    BinarySearchTree<int> arenaTree;
+    arenaTree.useArena(16);
+    for (int i = 0; i < 20; i++)
+    {
+        arenaTree.add(i);
+    }
+    usage = arenaTree.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 20 * sizeof(int));
+    EXPECT_EQ(usage.slackBytes, 12 * sizeof(BinaryTreeNode<int>));
+    EXPECT_GE(usage.overheadBytes, 20 * LINK_BYTES);
+}
 
 int main(int argc, char** argv)
 {
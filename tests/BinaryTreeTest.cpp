@@ -1,5 +1,10 @@
 #include "BinaryTree.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
 class BinaryTreeTest : public ::testing::Test
@@ -108,6 +113,368 @@ TEST_F(BinaryTreeTest, TraversalTest)
     delete func;
 }
 
+TEST_F(BinaryTreeTest, IteratorTest)
+{
+    EXPECT_TRUE(tree->begin() == tree->end());
+
+    for (int i = 1; i <= 10; i++)
+    {
+        tree->add(i);
+    }
+
+    std::vector<int> preorder = { 1, 2, 4, 7, 6, 10, 3, 5, 9, 8 };
+    std::vector<int> inorder = { 7, 4, 2, 10, 6, 1, 9, 5, 3, 8 };
+    std::vector<int> postorder = { 7, 4, 10, 6, 2, 9, 5, 8, 3, 1 };
+    std::vector<int> levelorder = { 1, 2, 3, 4, 6, 5, 8, 7, 10, 9 };
+
+    EXPECT_EQ(std::vector<int>(tree->begin(), tree->end()), inorder);
+
+    std::vector<int> visited;
+    for (int item : tree->preorder())
+    {
+        visited.push_back(item);
+    }
+    EXPECT_EQ(visited, preorder);
+
+    visited.clear();
+    for (int item : tree->inorder())
+    {
+        visited.push_back(item);
+    }
+    EXPECT_EQ(visited, inorder);
+
+    visited.clear();
+    for (int item : tree->postorder())
+    {
+        visited.push_back(item);
+    }
+    EXPECT_EQ(visited, postorder);
+
+    visited.clear();
+    for (int item : tree->levelorder())
+    {
+        visited.push_back(item);
+    }
+    EXPECT_EQ(visited, levelorder);
+
+    EXPECT_EQ(std::accumulate(tree->begin(), tree->end(), 0), 55);
+
+    visited.clear();
+    tree->morrisInorderTraverse([&](const int& item) 
+    {
+        visited.push_back(item);
+    });
+    EXPECT_EQ(visited, inorder);
+
+    // the threads must be gone afterwards, even if the visitor throws
+    EXPECT_THROW(tree->morrisInorderTraverse([](const int& item)
+    {
+        if (item == 10)
+        {
+            throw std::runtime_error("stop");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(std::vector<int>(tree->begin(), tree->end()), inorder);
+    EXPECT_EQ(tree->getNumNodes(), 10);
+}
+
+TEST_F(BinaryTreeTest, ForEachTest)
+{
+    for (int i = 1; i <= 10; i++)
+    {
+        tree->add(i);
+    }
+
+    std::vector<int> preorder = { 1, 2, 4, 7, 6, 10, 3, 5, 9, 8 };
+    std::vector<int> inorder = { 7, 4, 2, 10, 6, 1, 9, 5, 3, 8 };
+    std::vector<int> postorder = { 7, 4, 10, 6, 2, 9, 5, 8, 3, 1 };
+
+    std::vector<int> visited;
+    auto record = [&visited](const int& item) { visited.push_back(item); };
+
+    tree->preorderForEach(record);
+    EXPECT_EQ(visited, preorder);
+
+    visited.clear();
+    tree->inorderForEach(record);
+    EXPECT_EQ(visited, inorder);
+
+    visited.clear();
+    tree->postorderForEach(record);
+    EXPECT_EQ(visited, postorder);
+}
+
+TEST_F(BinaryTreeTest, ParallelTest)
+{
+    ThreadPool pool(4);
+    std::atomic<long long> sum(0);
+    tree->parallelForEach([&sum](const int& item) { sum += item; }, pool);
+    EXPECT_EQ(sum, 0);
+    EXPECT_EQ(tree->parallelReduce(0, [](const int& item) { return item; },
+                                   std::plus<int>(), pool), 0);
+
+    const int NUM_ITEMS = 3000;
+    for (int i = 1; i <= NUM_ITEMS; i++)
+    {
+        tree->add(i);
+    }
+
+    // a tiny grain size forces many forks even on a small tree
+    std::vector<std::atomic<int>> visits(NUM_ITEMS + 1);
+    tree->parallelForEach([&visits](const int& item) { visits[item]++; },
+                          pool, 8);
+    for (int i = 1; i <= NUM_ITEMS; i++)
+    {
+        ASSERT_EQ(visits[i], 1);
+    }
+
+    long long expected = (long long) NUM_ITEMS * (NUM_ITEMS + 1) / 2;
+    auto square = [](const int& item) { return (long long) item * item; };
+    long long expectedSquares = 0;
+    for (int i = 1; i <= NUM_ITEMS; i++)
+    {
+        expectedSquares += (long long) i * i;
+    }
+
+    for (int numThreads = 1; numThreads <= 8; numThreads *= 2)
+    {
+        ThreadPool threads(numThreads);
+        EXPECT_EQ(tree->parallelReduce(0LL,
+                  [](const int& item) { return (long long) item; },
+                  std::plus<long long>(), threads, 8), expected);
+        EXPECT_EQ(tree->parallelReduce(0LL, square, std::plus<long long>(),
+                                       threads, 8), expectedSquares);
+    }
+
+    EXPECT_EQ(tree->parallelReduce(0, [](const int& item) { return item; },
+              [](int a, int b) { return a > b ? a : b; }, pool, 8), NUM_ITEMS);
+
+    EXPECT_THROW(tree->parallelForEach([](const int& item)
+    {
+        if (item == NUM_ITEMS / 2)
+        {
+            throw std::runtime_error("stop");
+        }
+    }, pool, 8), std::runtime_error);
+}
+
+/**
+ * Links a chain of nodes directly, since adding them one at a time would
+ * take quadratic time.
+ */
+class SpineTree : public BinaryTree<int>
+{
+public:
+    SpineTree(int numNodes, bool leftSpine)
+    {
+        for (int i = numNodes; i >= 1; i--)
+        {
+            BinaryTreeNode<int>* nodePtr = new BinaryTreeNode<int>(i);
+            if (leftSpine)
+            {
+                nodePtr->setLeft(rootPtr);
+            }
+            else
+            {
+                nodePtr->setRight(rootPtr);
+            }
+            rootPtr = nodePtr;
+        }
+    }
+};
+
+TEST_F(BinaryTreeTest, DeepTreeCopyTest)
+{
+    // deep enough to overflow the call stack if copying or deleting recursed
+    const int NUM_NODES = 1000000;
+    ThreadPool pool(4);
+
+    for (bool leftSpine : { true, false })
+    {
+        SpineTree spine(NUM_NODES, leftSpine);
+
+        BinaryTree<int> copy(spine);
+        EXPECT_TRUE(std::equal(copy.preorder().begin(), copy.preorder().end(),
+                               spine.preorder().begin()));
+
+        BinaryTree<int> parallelCopy;
+        parallelCopy.parallelCopyFrom(spine, pool, 64);
+        EXPECT_TRUE(std::equal(parallelCopy.preorder().begin(),
+                               parallelCopy.preorder().end(),
+                               spine.preorder().begin()));
+
+        copy.clear();
+        EXPECT_TRUE(copy.empty());
+        parallelCopy.parallelClear(pool, 64);
+        EXPECT_TRUE(parallelCopy.empty());
+    }
+}
+
+TEST_F(BinaryTreeTest, DeepTreeTraversalTest)
+{
+    // deep enough to overflow the call stack if measuring or traversing
+    // recursed
+    const int NUM_NODES = 1000000;
+
+    for (bool leftSpine : { true, false })
+    {
+        SpineTree spine(NUM_NODES, leftSpine);
+        EXPECT_EQ(spine.getNumNodes(), NUM_NODES);
+        EXPECT_EQ(spine.getTreeHeight(), NUM_NODES);
+
+        TestTraversal traversal(this);
+        spine.preorderTraverse(&traversal);
+        spine.inorderTraverse(&traversal);
+        spine.postorderTraverse(&traversal);
+        ASSERT_EQ(vec.size(), 3u * NUM_NODES);
+        EXPECT_EQ(vec[0], 1);
+        EXPECT_EQ(vec[NUM_NODES - 1], NUM_NODES);
+        EXPECT_EQ(vec[NUM_NODES], leftSpine ? NUM_NODES : 1);
+        EXPECT_EQ(vec[2 * NUM_NODES], NUM_NODES);
+        EXPECT_EQ(vec.back(), 1);
+        vec.clear();
+    }
+}
+
+TEST_F(BinaryTreeTest, DeepTreeRemoveTest)
+{
+    // deep enough to overflow the call stack if searching or removing
+    // recursed
+    const int NUM_NODES = 1000000;
+
+    for (bool leftSpine : { true, false })
+    {
+        SpineTree spine(NUM_NODES, leftSpine);
+        EXPECT_TRUE(spine.contains(NUM_NODES));
+        EXPECT_FALSE(spine.contains(0));
+
+        // the root's item is replaced by the rest of the spine shifting up
+        EXPECT_TRUE(spine.remove(1));
+        EXPECT_TRUE(spine.remove(NUM_NODES));
+        EXPECT_TRUE(spine.remove(NUM_NODES / 2));
+        EXPECT_FALSE(spine.remove(NUM_NODES / 2));
+        EXPECT_EQ(spine.getNumNodes(), NUM_NODES - 3);
+        EXPECT_EQ(spine.getRootData(), 2);
+
+        EXPECT_TRUE(spine.add(0));
+        EXPECT_EQ(spine.getTreeHeight(), NUM_NODES - 3);
+    }
+}
+
+TEST_F(BinaryTreeTest, ParallelCopyTest)
+{
+    ThreadPool pool(4);
+    for (int i = 1; i <= 3000; i++)
+    {
+        tree->add(i);
+    }
+
+    std::vector<int> preorder(tree->preorder().begin(), tree->preorder().end());
+    std::vector<int> inorder(tree->begin(), tree->end());
+
+    BinaryTree<int> copy;
+    copy.add(42);
+    copy.parallelCopyFrom(*tree, pool, 8);
+    EXPECT_EQ(std::vector<int>(copy.preorder().begin(), copy.preorder().end()),
+              preorder);
+    EXPECT_EQ(std::vector<int>(copy.begin(), copy.end()), inorder);
+
+    copy.parallelCopyFrom(copy, pool, 8);
+    EXPECT_EQ(copy.getNumNodes(), 3000);
+
+    copy.parallelClear(pool, 8);
+    EXPECT_TRUE(copy.empty());
+
+    BinaryTree<int> empty;
+    copy.parallelCopyFrom(empty, pool);
+    EXPECT_TRUE(copy.empty());
+
+    copy = *tree;
+    EXPECT_EQ(std::vector<int>(copy.preorder().begin(), copy.preorder().end()),
+              preorder);
+}
+
+TEST_F(BinaryTreeTest, NodeArenaTest)
+{
+    NodeArena<BinaryTreeNode<int>> arena(4);
+    EXPECT_EQ(arena.getNumChunks(), 0);
+
+    std::vector<BinaryTreeNode<int>*> nodes;
+    for (int i = 0; i < 8; i++)
+    {
+        nodes.push_back(arena.create(i));
+        EXPECT_EQ(nodes.back()->getItem(), i);
+    }
+    EXPECT_EQ(arena.getNumChunks(), 2);
+
+    // nodes of a chunk are contiguous, in creation order
+    EXPECT_EQ(nodes[1], nodes[0] + 1);
+    EXPECT_EQ(nodes[3], nodes[0] + 3);
+
+    // freed nodes are reused before any new chunk is allocated
+    arena.destroy(nodes[2]);
+    arena.destroy(nodes[5]);
+    BinaryTreeNode<int>* reusedPtr = arena.create(10);
+    EXPECT_EQ(reusedPtr, nodes[5]);
+    reusedPtr = arena.create(11);
+    EXPECT_EQ(reusedPtr, nodes[2]);
+    EXPECT_EQ(arena.getNumChunks(), 2);
+
+    arena.create(12);
+    EXPECT_EQ(arena.getNumChunks(), 3);
+
+    arena.release();
+    EXPECT_EQ(arena.getNumChunks(), 0);
+}
+
+TEST_F(BinaryTreeTest, ArenaTest)
+{
+    EXPECT_FALSE(tree->usesArena());
+    tree->useArena(4);
+    EXPECT_TRUE(tree->usesArena());
+
+    for (int i = 1; i <= 10; i++)
+    {
+        tree->add(i);
+    }
+    EXPECT_THROW(tree->useArena(), std::runtime_error);
+
+    std::vector<int> preorder = { 1, 2, 4, 7, 6, 10, 3, 5, 9, 8 };
+    EXPECT_EQ(std::vector<int>(tree->preorder().begin(),
+                               tree->preorder().end()), preorder);
+
+    EXPECT_TRUE(tree->remove(4));
+    EXPECT_TRUE(tree->add(11));
+    EXPECT_EQ(tree->getNumNodes(), 10);
+
+    BinaryTree<int> copy(*tree);
+    EXPECT_TRUE(copy.usesArena());
+    EXPECT_TRUE(std::equal(copy.preorder().begin(), copy.preorder().end(),
+                           tree->preorder().begin()));
+
+    BinaryTree<int> assigned;
+    assigned.add(0);
+    assigned = *tree;
+    EXPECT_TRUE(assigned.usesArena());
+    EXPECT_TRUE(std::equal(assigned.preorder().begin(),
+                           assigned.preorder().end(),
+                           tree->preorder().begin()));
+
+    ThreadPool pool(4);
+    BinaryTree<int> parallelCopy;
+    parallelCopy.useArena();
+    parallelCopy.parallelCopyFrom(*tree, pool, 2);
+    EXPECT_EQ(parallelCopy.getNumNodes(), 10);
+    parallelCopy.parallelClear(pool, 2);
+    EXPECT_TRUE(parallelCopy.empty());
+
+    tree->clear();
+    EXPECT_TRUE(tree->empty());
+    EXPECT_TRUE(tree->usesArena());
+    tree->add(1);
+    EXPECT_EQ(tree->getRootData(), 1);
+}
+
 TEST_F(BinaryTreeTest, CopyTest)
 {
     tree->add(1);
@@ -0,0 +1,227 @@
+#include "CompactBinarySearchTree.h"
+#include "Entry.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+class CompactBSTTest : public ::testing::Test
+{
+protected:
+    CompactBinarySearchTree<int>* tree;
+
+    CompactBSTTest()
+    {
+        tree = new CompactBinarySearchTree<int>();
+    }
+
+    ~CompactBSTTest()
+    {
+        delete tree;
+    }
+
+    /**
+     * Checks that the tree holds exactly the items of @c expected, and that
+     * its height is within the AVL bound of 1.44 log2(n + 2).
+     */
+    void expectMatches(const std::set<int>& expected)
+    {
+        ASSERT_EQ(tree->getNumNodes(), static_cast<int>(expected.size()));
+        ASSERT_TRUE(std::equal(tree->begin(), tree->end(), expected.begin(),
+                               expected.end()));
+        ASSERT_LE(tree->getTreeHeight(),
+                  1.4405 * std::log2(expected.size() + 2.0));
+    }
+};
+
+class TraverseCompactBST : public TraversalFunction<int>
+{
+public:
+    std::vector<int> vec;
+
+    virtual void visit(int& item)
+    {
+        vec.push_back(item);
+    }
+};
+
+TEST_F(CompactBSTTest, SimpleTest)
+{
+    EXPECT_TRUE(tree->empty());
+    EXPECT_EQ(tree->getTreeHeight(), 0);
+
+    tree->add(2);
+    tree->add(4);
+    tree->add(3);
+    tree->add(1);
+    tree->add(0);
+    EXPECT_FALSE(tree->add(3));
+
+    ASSERT_TRUE(tree->contains(0));
+    EXPECT_EQ(tree->getNumNodes(), 5);
+    EXPECT_EQ(tree->getTreeHeight(), 3);
+    EXPECT_EQ(tree->getItem(4), 4);
+    EXPECT_THROW(tree->getItem(5), std::runtime_error);
+
+    TraverseCompactBST func;
+    tree->inorderTraverse(&func);
+    std::vector<int> expected = { 0, 1, 2, 3, 4 };
+    EXPECT_EQ(func.vec, expected);
+
+    EXPECT_TRUE(tree->remove(2));
+    EXPECT_FALSE(tree->contains(2));
+    EXPECT_FALSE(tree->remove(2));
+    EXPECT_EQ(tree->getNumNodes(), 4);
+
+    tree->clear();
+    EXPECT_TRUE(tree->empty());
+    EXPECT_FALSE(tree->contains(0));
+}
+
+TEST_F(CompactBSTTest, TraversalTest)
+{
+    // sorted insertion would make a plain BST a list; here it stays balanced
+    for (int i = 1; i <= 7; i++)
+    {
+        tree->add(i);
+    }
+    EXPECT_EQ(tree->getTreeHeight(), 3);
+
+    std::vector<int> visited;
+    auto record = [&visited](const int& item) { visited.push_back(item); };
+
+    tree->preorderForEach(record);
+    std::vector<int> preorder = { 4, 2, 1, 3, 6, 5, 7 };
+    EXPECT_EQ(visited, preorder);
+
+    visited.clear();
+    tree->postorderForEach(record);
+    std::vector<int> postorder = { 1, 3, 2, 5, 7, 6, 4 };
+    EXPECT_EQ(visited, postorder);
+
+    TraverseCompactBST func;
+    tree->preorderTraverse(&func);
+    EXPECT_EQ(func.vec, preorder);
+}
+
+TEST_F(CompactBSTTest, RandomOperationsTest)
+{
+    std::set<int> expected;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> key(0, 999);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int item = key(rng);
+        if (rng() % 3 == 0)
+        {
+            ASSERT_EQ(tree->remove(item), expected.erase(item) == 1);
+        }
+        else
+        {
+            ASSERT_EQ(tree->add(item), expected.insert(item).second);
+        }
+
+        if (i % 100 == 0)
+        {
+            expectMatches(expected);
+        }
+    }
+    expectMatches(expected);
+
+    for (int item : std::vector<int>(expected.begin(), expected.end()))
+    {
+        ASSERT_TRUE(tree->remove(item));
+        expected.erase(item);
+    }
+    expectMatches(expected);
+    EXPECT_TRUE(tree->empty());
+}
+
+TEST_F(CompactBSTTest, SortedInsertionTest)
+{
+    std::set<int> expected;
+    const int NUM_ITEMS = 100000;
+    tree->reserve(NUM_ITEMS);
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree->add(i);
+        expected.insert(i);
+    }
+    expectMatches(expected);
+
+    for (int i = NUM_ITEMS - 1; i >= 0; i -= 2)
+    {
+        ASSERT_TRUE(tree->remove(i));
+        expected.erase(i);
+    }
+    expectMatches(expected);
+}
+
+TEST_F(CompactBSTTest, FindTest)
+{
+    CompactBinarySearchTree<Entry<std::string, int>> entries;
+    bool inserted = false;
+    for (const char* word : { "pear", "apple", "fig", "apple", "pear" })
+    {
+        Entry<std::string, int>* entryPtr = entries.findOrInsert(
+            std::string(word),
+            [word]() { return Entry<std::string, int>(word, 0); }, inserted);
+        entryPtr->setValue(entryPtr->getValue() + 1);
+    }
+
+    EXPECT_EQ(entries.getNumNodes(), 3);
+    EXPECT_EQ(entries.findItem(std::string("apple"))->getValue(), 2);
+    EXPECT_EQ(entries.findItem(std::string("fig"))->getValue(), 1);
+    EXPECT_EQ(entries.findItem(std::string("kiwi")), nullptr);
+
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree->add(i);
+    }
+    std::vector<int> keys;
+    for (int i = 0; i < 100; i++)
+    {
+        keys.push_back(i);
+    }
+    std::vector<const int*> results(keys.size());
+    tree->findItems(keys.data(), keys.size(), results.data());
+    for (int i = 0; i < 100; i++)
+    {
+        if (i % 2 == 0)
+        {
+            ASSERT_NE(results[i], nullptr);
+            EXPECT_EQ(*results[i], i);
+        }
+        else
+        {
+            EXPECT_EQ(results[i], nullptr);
+        }
+    }
+}
+
+TEST_F(CompactBSTTest, CopyTest)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        tree->add(i);
+    }
+
+    CompactBinarySearchTree<int> copy(*tree);
+    copy.remove(5);
+    EXPECT_TRUE(tree->contains(5));
+    EXPECT_FALSE(copy.contains(5));
+
+    *tree = copy;
+    EXPECT_FALSE(tree->contains(5));
+    EXPECT_EQ(tree->getNumNodes(), 9);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,192 @@
+#include "CompleteBinaryTree.h"
+#include "gtest/gtest.h"
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+class CompleteBinaryTreeTest : public ::testing::Test
+{
+protected:
+    CompleteBinaryTree<int>* tree;
+
+    CompleteBinaryTreeTest()
+    {
+        tree = new CompleteBinaryTree<int>();
+    }
+
+    ~CompleteBinaryTreeTest()
+    {
+        delete tree;
+    }
+
+public:
+    std::vector<int> vec;
+
+};
+
+class TestTraversal : public TraversalFunction<int>
+{
+private:
+    CompleteBinaryTreeTest* mParent;
+
+public:
+    TestTraversal(CompleteBinaryTreeTest* parent)
+    {
+        mParent = parent;
+    }
+
+    virtual void visit(int& item)
+    {
+        mParent->vec.push_back(item);
+    }
+};
+
+TEST_F(CompleteBinaryTreeTest, SimpleTest)
+{
+    ASSERT_TRUE(tree->empty());
+    ASSERT_EQ(tree->getTreeHeight(), 0);
+    ASSERT_THROW(tree->getRootData(), std::range_error);
+
+    tree->add(1);
+    tree->add(2);
+    tree->add(3);
+
+    ASSERT_EQ(tree->getRootData(), 1);
+    ASSERT_EQ(tree->getNumNodes(), 3);
+    ASSERT_EQ(tree->getTreeHeight(), 2);
+
+    tree->add(4);
+    ASSERT_EQ(tree->getTreeHeight(), 3);
+
+    ASSERT_TRUE(tree->remove(2));
+    ASSERT_FALSE(tree->contains(2));
+    ASSERT_FALSE(tree->remove(5));
+    ASSERT_TRUE(tree->contains(4));
+    ASSERT_EQ(tree->getNumNodes(), 3);
+    ASSERT_EQ(tree->getTreeHeight(), 2);
+
+    EXPECT_FALSE(tree->empty());
+    tree->setRootData(6);
+    ASSERT_EQ(tree->getRootData(), 6);
+
+    tree->clear();
+    EXPECT_TRUE(tree->empty());
+}
+
+TEST_F(CompleteBinaryTreeTest, TraversalTest)
+{
+    for (int i = 1; i <= 10; i++)
+    {
+        tree->add(i);
+    }
+
+    std::vector<int> preorder = { 1, 2, 4, 8, 9, 5, 10, 3, 6, 7 };
+    std::vector<int> inorder = { 8, 4, 9, 2, 10, 5, 1, 6, 3, 7 };
+    std::vector<int> postorder = { 8, 9, 4, 10, 5, 2, 6, 7, 3, 1 };
+    std::vector<int> levelorder = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    TestTraversal func(this);
+
+    tree->preorderTraverse(&func);
+    EXPECT_EQ(vec, preorder);
+    vec.clear();
+
+    tree->inorderTraverse(&func);
+    EXPECT_EQ(vec, inorder);
+    vec.clear();
+
+    tree->postorderTraverse(&func);
+    EXPECT_EQ(vec, postorder);
+    vec.clear();
+
+    std::vector<int> visited;
+    auto visit = [&](const int& item)
+    {
+        visited.push_back(item);
+    };
+
+    tree->levelorderForEach(visit);
+    EXPECT_EQ(visited, levelorder);
+    EXPECT_EQ(std::vector<int>(tree->begin(), tree->end()), levelorder);
+}
+
+TEST_F(CompleteBinaryTreeTest, ForEachTest)
+{
+    // compare against a recursive traversal for every shape of the last
+    // level
+    for (int numNodes = 0; numNodes <= 40; numNodes++)
+    {
+        tree->clear();
+        for (int i = 0; i < numNodes; i++)
+        {
+            tree->add(i);
+        }
+
+        std::vector<int> preorder, inorder, postorder;
+        std::function<void(int)> walk = [&](int index)
+        {
+            if (index >= numNodes)
+            {
+                return;
+            }
+
+            preorder.push_back(index);
+            walk(2 * index + 1);
+            inorder.push_back(index);
+            walk(2 * index + 2);
+            postorder.push_back(index);
+        };
+        walk(0);
+
+        std::vector<int> visited;
+        auto visit = [&](const int& item)
+        {
+            visited.push_back(item);
+        };
+
+        tree->preorderForEach(visit);
+        EXPECT_EQ(visited, preorder) << numNodes;
+        visited.clear();
+
+        tree->inorderForEach(visit);
+        EXPECT_EQ(visited, inorder) << numNodes;
+        visited.clear();
+
+        tree->postorderForEach(visit);
+        EXPECT_EQ(visited, postorder) << numNodes;
+    }
+}
+
+TEST_F(CompleteBinaryTreeTest, RemoveTest)
+{
+    const int NUM_NODES = 1000;
+    for (int i = 0; i < NUM_NODES; i++)
+    {
+        tree->add(i);
+    }
+
+    // removing an item moves the last one into its place
+    ASSERT_TRUE(tree->remove(0));
+    ASSERT_EQ(tree->getRootData(), NUM_NODES - 1);
+
+    for (int i = 1; i < NUM_NODES; i += 2)
+    {
+        ASSERT_TRUE(tree->remove(i));
+    }
+
+    ASSERT_EQ(tree->getNumNodes(), NUM_NODES / 2 - 1);
+    for (int i = 1; i < NUM_NODES; i++)
+    {
+        ASSERT_EQ(tree->contains(i), i % 2 == 0);
+    }
+
+    CompleteBinaryTree<int> copy(*tree);
+    tree->clear();
+    EXPECT_EQ(copy.getNumNodes(), NUM_NODES / 2 - 1);
+}
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
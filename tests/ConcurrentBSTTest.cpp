@@ -0,0 +1,254 @@
+#include "ConcurrentBinarySearchTree.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ConcurrentBSTTest : public ::testing::Test
+{
+protected:
+    ConcurrentBinarySearchTree<int>* tree;
+
+    ConcurrentBSTTest()
+    {
+        tree = new ConcurrentBinarySearchTree<int>();
+    }
+
+    ~ConcurrentBSTTest()
+    {
+        delete tree;
+    }
+};
+
+TEST_F(ConcurrentBSTTest, SimpleTest)
+{
+    EXPECT_TRUE(tree->empty());
+    EXPECT_FALSE(tree->contains(0));
+    EXPECT_FALSE(tree->remove(0));
+
+    tree->add(2);
+    tree->add(4);
+    tree->add(3);
+    tree->add(1);
+    tree->add(0);
+    EXPECT_FALSE(tree->add(3));
+    EXPECT_EQ(tree->getNumNodes(), 5);
+    EXPECT_EQ(tree->getItem(4), 4);
+    EXPECT_THROW(tree->getItem(5), std::runtime_error);
+
+    // 2 is the root and has two children, so it stays to route searches
+    EXPECT_TRUE(tree->remove(2));
+    EXPECT_FALSE(tree->contains(2));
+    EXPECT_FALSE(tree->remove(2));
+    EXPECT_THROW(tree->getItem(2), std::runtime_error);
+    EXPECT_EQ(tree->getNumNodes(), 4);
+    EXPECT_EQ(tree->getNumLinkedNodes(), 5);
+
+    EXPECT_TRUE(tree->add(2));
+    EXPECT_TRUE(tree->contains(2));
+    EXPECT_EQ(tree->getNumNodes(), 5);
+
+    for (int i = 0; i <= 4; i++)
+    {
+        EXPECT_TRUE(tree->remove(i));
+    }
+    EXPECT_TRUE(tree->empty());
+    EXPECT_EQ(tree->getNumLinkedNodes(), 0);
+}
+
+TEST_F(ConcurrentBSTTest, AbsentNodeTest)
+{
+    for (int item : { 4, 2, 6, 1, 3 })
+    {
+        tree->add(item);
+    }
+
+    // 2 only routes searches once it is removed, until it loses a child;
+    // then it is unlinked along with the child
+    EXPECT_TRUE(tree->remove(2));
+    EXPECT_EQ(tree->getNumLinkedNodes(), 5);
+    EXPECT_TRUE(tree->remove(1));
+    EXPECT_EQ(tree->getNumLinkedNodes(), 3);
+    EXPECT_TRUE(tree->contains(3));
+    EXPECT_FALSE(tree->contains(2));
+
+    // removing the last child of an absent chain unlinks the whole chain
+    EXPECT_TRUE(tree->remove(4));
+    EXPECT_EQ(tree->getNumLinkedNodes(), 3);
+    EXPECT_TRUE(tree->remove(6));
+    EXPECT_EQ(tree->getNumLinkedNodes(), 1);
+    EXPECT_EQ(tree->getNumNodes(), 1);
+}
+
+TEST_F(ConcurrentBSTTest, ChurnTest)
+{
+    // random adds and removes leave absent routing nodes behind, but never
+    // more of them than there are items
+    const int NUM_KEYS = 1000;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 200000; i++)
+    {
+        int key = rng() % NUM_KEYS;
+        if (rng() % 2 == 0)
+        {
+            tree->add(key);
+        }
+        else
+        {
+            tree->remove(key);
+        }
+
+        if (i % 1000 == 0)
+        {
+            ASSERT_LE(tree->getNumLinkedNodes(), 2 * tree->getNumNodes() + 1);
+        }
+    }
+
+    for (int key = 0; key < NUM_KEYS; key++)
+    {
+        tree->remove(key);
+    }
+    EXPECT_TRUE(tree->empty());
+    EXPECT_EQ(tree->getNumLinkedNodes(), 0);
+}
+
+TEST_F(ConcurrentBSTTest, RandomOperationsTest)
+{
+    std::set<int> expected;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> key(0, 999);
+
+    for (int i = 0; i < 50000; i++)
+    {
+        int item = key(rng);
+        switch (rng() % 3)
+        {
+        case 0:
+            ASSERT_EQ(tree->remove(item), expected.erase(item) == 1);
+            break;
+        case 1:
+            ASSERT_EQ(tree->add(item), expected.insert(item).second);
+            break;
+        default:
+            ASSERT_EQ(tree->contains(item), expected.count(item) == 1);
+        }
+    }
+
+    EXPECT_EQ(tree->getNumNodes(), static_cast<int>(expected.size()));
+    for (int item = 0; item < 1000; item++)
+    {
+        ASSERT_EQ(tree->contains(item), expected.count(item) == 1);
+    }
+}
+
+TEST_F(ConcurrentBSTTest, StringTest)
+{
+    ConcurrentBinarySearchTree<std::string> words;
+    EXPECT_TRUE(words.add("pear"));
+    EXPECT_TRUE(words.add("apple"));
+    EXPECT_FALSE(words.add("pear"));
+    EXPECT_EQ(words.getItem("apple"), "apple");
+    EXPECT_TRUE(words.remove("pear"));
+    EXPECT_FALSE(words.contains("pear"));
+}
+
+/**
+ * Writers add and remove keys from a small, contended range while readers
+ * check keys that never change. Run under ThreadSanitizer with
+ * "make tsan".
+ */
+TEST_F(ConcurrentBSTTest, StressTest)
+{
+    const int NUM_WRITERS = 4;
+    const int NUM_READERS = 4;
+    const int NUM_HOT_KEYS = 64;
+    const int NUM_OPERATIONS = 20000;
+
+    // odd keys above the hot range are always present, even ones never are
+    int numStableKeys = 0;
+    for (int key = NUM_HOT_KEYS + 1; key < 4 * NUM_HOT_KEYS; key += 2)
+    {
+        tree->add(key);
+        numStableKeys++;
+    }
+
+    // the number of successful adds minus successful removes of each key
+    std::vector<std::atomic<int>> balances(NUM_HOT_KEYS);
+    std::atomic<int> numWritersDone(0);
+    std::atomic<bool> readerFailed(false);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < NUM_WRITERS; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 rng(t);
+            for (int i = 0; i < NUM_OPERATIONS; i++)
+            {
+                int key = rng() % NUM_HOT_KEYS;
+                if (rng() % 2 == 0)
+                {
+                    if (tree->add(key))
+                    {
+                        balances[key]++;
+                    }
+                }
+                else if (tree->remove(key))
+                {
+                    balances[key]--;
+                }
+            }
+            numWritersDone++;
+        });
+    }
+
+    for (int t = 0; t < NUM_READERS; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 rng(100 + t);
+            while (numWritersDone.load() < NUM_WRITERS)
+            {
+                int key = NUM_HOT_KEYS + 1 + rng() % (3 * NUM_HOT_KEYS - 1);
+                if (tree->contains(key) != (key % 2 == 1))
+                {
+                    readerFailed = true;
+                }
+                tree->contains(rng() % NUM_HOT_KEYS);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(readerFailed.load());
+    int numPresent = 0;
+    for (int key = 0; key < NUM_HOT_KEYS; key++)
+    {
+        int balance = balances[key].load();
+        ASSERT_TRUE(balance == 0 || balance == 1);
+        ASSERT_EQ(tree->contains(key), balance == 1);
+        numPresent += balance;
+    }
+    EXPECT_EQ(tree->getNumNodes(), numPresent + numStableKeys);
+    EXPECT_LE(tree->getNumLinkedNodes(), 2 * tree->getNumNodes() + 1);
+
+    for (int key = 0; key < 4 * NUM_HOT_KEYS; key++)
+    {
+        tree->remove(key);
+    }
+    EXPECT_EQ(tree->getNumLinkedNodes(), 0);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
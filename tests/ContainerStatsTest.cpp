@@ -0,0 +1,217 @@
+#include "ArrayList.h"
+#include "BinarySearchTree.h"
+#include "ContainerStats.h"
+#include "Heap.h"
+#include "LinkedList.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <type_traits>
+
+TEST(ContainerStatsTest, HistogramTest)
+{
+    Histogram histogram;
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getPercentile(0.5), 0u);
+
+    for (int value : { 0, 1, 2, 3, 4, 100 })
+    {
+        histogram.add(value);
+    }
+
+    EXPECT_EQ(histogram.getCount(), 6u);
+    EXPECT_EQ(histogram.getMax(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.getMean(), 110.0 / 6);
+    EXPECT_EQ(histogram.getBucketCount(0), 1u);
+    EXPECT_EQ(histogram.getBucketCount(1), 1u);
+    EXPECT_EQ(histogram.getBucketCount(2), 2u);
+    EXPECT_EQ(histogram.getBucketCount(3), 1u);
+    EXPECT_EQ(histogram.getBucketCount(7), 1u);
+
+    // the upper bound of the value's bucket, but never more than the max
+    EXPECT_EQ(histogram.getPercentile(0.5), 3u);
+    EXPECT_EQ(histogram.getPercentile(0.99), 100u);
+    EXPECT_EQ(histogram.getPercentile(1.0), 100u);
+
+    histogram.clear();
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_EQ(histogram.getBucketCount(2), 0u);
+}
+
+namespace
+{
+
+// the members of Heap<int>
+struct HeapLayout
+{
+    virtual ~HeapLayout()
+    {
+
+    }
+
+    int* items;
+    int itemCount;
+    int capacity;
+};
+
+}
+
+TEST(ContainerStatsTest, NoStatsTest)
+{
+    // an uninstrumented container is no larger than its members
+    EXPECT_TRUE(std::is_empty<NoStats>::value);
+    EXPECT_EQ(sizeof(Heap<int>), sizeof(HeapLayout));
+}
+
+TEST(ContainerStatsTest, ArrayListTest)
+{
+    ArrayList<int, ContainerStats> list(4);
+    for (int i = 0; i < 10; i++)
+    {
+        list.add(i);
+    }
+
+    const ContainerStats& stats = list.getStats();
+    EXPECT_EQ(stats.getEventCount(StatEvent::RESIZE), 2u);
+    EXPECT_EQ(stats.getLatencies(StatOperation::ADD).getCount(), 10u);
+
+    EXPECT_TRUE(list.contains(2));
+    EXPECT_FALSE(list.contains(20));
+    EXPECT_EQ(stats.getEventCount(StatEvent::COMPARISON), 3u + 10u);
+    const Histogram& comparisons = stats.getEventsPerOperation(
+        StatOperation::LOOKUP, StatEvent::COMPARISON);
+    EXPECT_EQ(comparisons.getCount(), 2u);
+    EXPECT_EQ(comparisons.getMax(), 10u);
+
+    EXPECT_TRUE(list.remove(0));
+    EXPECT_EQ(stats.getLatencies(StatOperation::REMOVE).getCount(), 1u);
+    EXPECT_EQ(stats.getLatencies(StatOperation::LOOKUP).getCount(), 2u);
+
+    // a copy counts only its own events
+    ArrayList<int, ContainerStats> copy(list);
+    EXPECT_EQ(copy.getStats().getEventCount(StatEvent::RESIZE), 0u);
+
+    list.getStats().reset();
+    EXPECT_EQ(stats.getEventCount(StatEvent::COMPARISON), 0u);
+    EXPECT_EQ(stats.getLatencies(StatOperation::ADD).getCount(), 0u);
+}
+
+TEST(ContainerStatsTest, LinkedListTest)
+{
+    LinkedList<std::string, ContainerStats> list;
+    list.add("a");
+    list.add("b");
+    list.add("c");
+
+    const ContainerStats& stats = list.getStats();
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_ALLOCATION), 3u);
+
+    EXPECT_TRUE(list.remove("b"));
+    EXPECT_EQ(stats.getEventCount(StatEvent::COMPARISON), 2u);
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_DEALLOCATION), 1u);
+
+    list.clear();
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_DEALLOCATION), 3u);
+}
+
+TEST(ContainerStatsTest, HeapTest)
+{
+    Heap<int, ContainerStats> heap;
+    const int NUM_ITEMS = 1023;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        heap.add(i);
+    }
+
+    // every item is larger than the others, so it moves up to the root
+    const ContainerStats& stats = heap.getStats();
+    const Histogram& addSteps = stats.getEventsPerOperation(
+        StatOperation::ADD, StatEvent::HEAP_REBUILD_STEP);
+    EXPECT_EQ(addSteps.getMax(), 9u);
+    EXPECT_EQ(stats.getEventCount(StatEvent::RESIZE), 7u);
+
+    while (!heap.isEmpty())
+    {
+        heap.remove();
+    }
+
+    // no removal moves an item further than the height of the heap
+    const Histogram& removeSteps = stats.getEventsPerOperation(
+        StatOperation::REMOVE, StatEvent::HEAP_REBUILD_STEP);
+    EXPECT_EQ(removeSteps.getCount(), static_cast<std::uint64_t>(NUM_ITEMS));
+    EXPECT_LE(removeSteps.getMax(), 9u);
+    EXPECT_GT(removeSteps.getMean(), 1.0);
+}
+
+TEST(ContainerStatsTest, DegenerateTreeTest)
+{
+    // items added in order make a tree which is a linked list
+    const int NUM_ITEMS = 100;
+    BinarySearchTree<int, ContainerStats> tree;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree.add(i);
+    }
+
+    const ContainerStats& stats = tree.getStats();
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_ALLOCATION),
+              static_cast<std::uint64_t>(NUM_ITEMS));
+    EXPECT_EQ(stats.getEventsPerOperation(StatOperation::ADD,
+                                          StatEvent::COMPARISON).getMax(),
+              static_cast<std::uint64_t>(NUM_ITEMS - 1));
+
+    EXPECT_TRUE(tree.contains(NUM_ITEMS - 1));
+    EXPECT_FALSE(tree.contains(NUM_ITEMS));
+    const Histogram& comparisons = stats.getEventsPerOperation(
+        StatOperation::LOOKUP, StatEvent::COMPARISON);
+    EXPECT_EQ(comparisons.getCount(), 2u);
+    EXPECT_EQ(comparisons.getMax(), static_cast<std::uint64_t>(NUM_ITEMS));
+
+    EXPECT_TRUE(tree.remove(0));
+    EXPECT_FALSE(tree.remove(0));
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_DEALLOCATION), 1u);
+
+    // copies count the nodes they copy, without walking the tree again
+    BinarySearchTree<int, ContainerStats> copy(tree);
+    EXPECT_EQ(copy.getStats().getEventCount(StatEvent::NODE_ALLOCATION),
+              static_cast<std::uint64_t>(NUM_ITEMS - 1));
+    copy.add(NUM_ITEMS);
+    copy = tree;
+    EXPECT_EQ(copy.getStats().getEventCount(StatEvent::NODE_DEALLOCATION),
+              static_cast<std::uint64_t>(NUM_ITEMS));
+    EXPECT_EQ(copy.getNumNodes(), NUM_ITEMS - 1);
+
+    tree.clear();
+    EXPECT_EQ(stats.getEventCount(StatEvent::NODE_DEALLOCATION),
+              static_cast<std::uint64_t>(NUM_ITEMS));
+}
+
+TEST(ContainerStatsTest, JsonTest)
+{
+    BinarySearchTree<int, ContainerStats> tree;
+    tree.add(2);
+    tree.add(1);
+    tree.contains(1);
+
+    std::string json = tree.getStats().toJson();
+    EXPECT_EQ(json.find("{\"events\": {\"comparison\": 3, "
+                        "\"node_allocation\": 2, "), 0u);
+    EXPECT_NE(json.find("\"add\": {\"latency_ns\": {\"count\": 2, "),
+              std::string::npos);
+    EXPECT_NE(json.find("\"lookup\": {\"latency_ns\": {\"count\": 1, "),
+              std::string::npos);
+    EXPECT_NE(json.find("\"comparison\": {\"count\": 1, \"mean\": 2, "
+                        "\"max\": 2, \"p50\": 2, \"p90\": 2, \"p99\": 2, "
+                        "\"buckets\": [[3, 1]]}"),
+              std::string::npos);
+
+    // operations which never happened, and events they never caused, are
+    // left out
+    EXPECT_EQ(json.find("\"remove\""), std::string::npos);
+    EXPECT_EQ(json.find("\"resize\": {"), std::string::npos);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,263 @@
+#include "Deque.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+class DequeTest : public ::testing::Test
+{
+protected:
+    // small blocks, so that a few items span several of them
+    Deque<int, 4>* deque;
+
+    DequeTest()
+    {
+        deque = new Deque<int, 4>();
+    }
+
+    ~DequeTest()
+    {
+        delete deque;
+    }
+};
+
+TEST_F(DequeTest, SimpleTest)
+{
+    ASSERT_TRUE(deque->empty());
+    EXPECT_FALSE(deque->popFront());
+    EXPECT_FALSE(deque->popBack());
+    EXPECT_THROW(deque->front(), std::range_error);
+    EXPECT_THROW(deque->back(), std::range_error);
+
+    for (int i = 1; i <= 5; i++)
+    {
+        deque->pushBack(i);
+        deque->pushFront(-i);
+    }
+
+    ASSERT_EQ(deque->size(), 10);
+    EXPECT_EQ(deque->front(), -5);
+    EXPECT_EQ(deque->back(), 5);
+    EXPECT_EQ(deque->get(0), -5);
+    EXPECT_EQ(deque->get(5), 1);
+    EXPECT_EQ((*deque)[9], 5);
+    EXPECT_THROW(deque->get(10), std::out_of_range);
+    EXPECT_THROW(deque->get(-1), std::out_of_range);
+    EXPECT_EQ(deque->toVector(),
+              std::vector<int>({ -5, -4, -3, -2, -1, 1, 2, 3, 4, 5 }));
+    // -5 and 5 are alone in the end blocks
+    EXPECT_EQ(deque->getNumBlocks(), 4);
+
+    EXPECT_TRUE(deque->popFront());
+    EXPECT_TRUE(deque->popBack());
+    EXPECT_EQ(deque->front(), -4);
+    EXPECT_EQ(deque->back(), 4);
+    EXPECT_EQ(deque->getNumBlocks(), 2);
+
+    deque->clear();
+    EXPECT_TRUE(deque->empty());
+    EXPECT_EQ(deque->getNumBlocks(), 0);
+    deque->pushFront(1);
+    EXPECT_EQ(deque->back(), 1);
+}
+
+TEST_F(DequeTest, RandomOperationsTest)
+{
+    std::mt19937 random(5);
+    std::deque<int> reference;
+    for (int i = 0; i < 50000; i++)
+    {
+        int item = random() % 1000;
+        // drift towards each end in turn, so that the map is recentred and
+        // reallocated
+        bool growing = (i / 5000) % 2 == 0;
+        switch (random() % 5)
+        {
+        case 0:
+            deque->pushFront(item);
+            reference.push_front(item);
+            break;
+        case 1:
+            deque->pushBack(item);
+            reference.push_back(item);
+            break;
+        case 2:
+            ASSERT_EQ(deque->popFront(), !reference.empty());
+            if (!reference.empty())
+            {
+                reference.pop_front();
+            }
+            break;
+        case 3:
+            ASSERT_EQ(deque->popBack(), !reference.empty());
+            if (!reference.empty())
+            {
+                reference.pop_back();
+            }
+            break;
+        default:
+            if (growing)
+            {
+                deque->pushBack(item);
+                reference.push_back(item);
+            }
+            else if (!reference.empty())
+            {
+                ASSERT_EQ(deque->get(item % reference.size()),
+                          reference[item % reference.size()]);
+            }
+            break;
+        }
+
+        ASSERT_EQ(deque->size(), (int) reference.size());
+        if (!reference.empty())
+        {
+            ASSERT_EQ(deque->front(), reference.front());
+            ASSERT_EQ(deque->back(), reference.back());
+        }
+        if (i % 1000 == 0)
+        {
+            ASSERT_EQ(deque->toVector(),
+                      std::vector<int>(reference.begin(), reference.end()));
+        }
+    }
+
+    EXPECT_EQ(deque->toVector(),
+              std::vector<int>(reference.begin(), reference.end()));
+    EXPECT_LE(deque->getNumBlocks(), deque->size() / 4 + 2);
+}
+
+TEST_F(DequeTest, StableAddressTest)
+{
+    deque->pushBack(0);
+    const int* firstPtr = &deque->front();
+    std::vector<const int*> pointers;
+    for (int i = 1; i <= 1000; i++)
+    {
+        deque->pushFront(-i);
+        deque->pushBack(i);
+        pointers.push_back(&deque->front());
+    }
+
+    // the map was reallocated many times, but no item moved
+    EXPECT_EQ(firstPtr, &deque->get(1000));
+    for (int i = 1; i <= 1000; i++)
+    {
+        EXPECT_EQ(*pointers[i - 1], -i);
+    }
+
+    while (deque->size() > 1)
+    {
+        deque->popFront();
+        deque->popBack();
+    }
+    EXPECT_EQ(firstPtr, &deque->front());
+}
+
+TEST_F(DequeTest, IteratorTest)
+{
+    EXPECT_TRUE(deque->begin() == deque->end());
+
+    for (int i = 0; i < 10; i++)
+    {
+        deque->pushFront(i);
+    }
+
+    Deque<int, 4>::iterator it = deque->begin();
+    EXPECT_EQ(deque->end() - it, 10);
+    EXPECT_EQ(it[3], 6);
+    EXPECT_EQ(*(it + 7), 2);
+    it += 9;
+    EXPECT_EQ(*it, 0);
+    it -= 6;
+    EXPECT_EQ(*it, 6);
+    EXPECT_EQ(*--it, 7);
+    EXPECT_TRUE(it < deque->end());
+    EXPECT_TRUE(deque->end() - 10 == deque->begin());
+
+    std::sort(deque->begin(), deque->end());
+    EXPECT_EQ(deque->toVector(),
+              std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    const Deque<int, 4>& constDeque = *deque;
+    Deque<int, 4>::const_iterator constIt = constDeque.end();
+    EXPECT_EQ(*--constIt, 9);
+    EXPECT_EQ(std::count_if(constDeque.begin(), constDeque.end(),
+                            [](int item) { return item % 2 == 0; }), 5);
+}
+
+TEST_F(DequeTest, StringTest)
+{
+    // no default constructor is needed, and every item is destroyed
+    Deque<std::string> strings;
+    for (int i = 0; i < 1000; i++)
+    {
+        strings.pushBack(std::to_string(i));
+        strings.pushFront(std::to_string(-i));
+    }
+    EXPECT_EQ(strings.front(), "-999");
+    EXPECT_EQ(strings.get(1000), "0");
+
+    Deque<std::string> copy(strings);
+    strings.clear();
+    EXPECT_EQ(copy.size(), 2000);
+    EXPECT_EQ(copy.back(), "999");
+
+    Deque<std::string> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 2000);
+    copy.pushBack("after the move");
+    EXPECT_EQ(copy.front(), "after the move");
+
+    copy = moved;
+    EXPECT_EQ(copy.toVector(), moved.toVector());
+    moved = std::move(strings);
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST_F(DequeTest, MemoryUsageTest)
+{
+    Deque<int, 64> ints;
+    MemoryUsage usage = ints.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 0u);
+    EXPECT_EQ(usage.slackBytes, 0u);
+    EXPECT_EQ(usage.overheadBytes, sizeof(ints));
+
+    for (int i = 0; i < 100; i++)
+    {
+        ints.pushBack(i);
+    }
+    usage = ints.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 100 * sizeof(int));
+    EXPECT_EQ(usage.slackBytes, 28 * sizeof(int));
+
+    // popping the second block keeps it as the spare
+    while (ints.size() > 10)
+    {
+        ints.popBack();
+    }
+    usage = ints.memoryUsage();
+    EXPECT_EQ(ints.getNumBlocks(), 1);
+    EXPECT_EQ(usage.slackBytes, (128 - 10) * sizeof(int));
+
+    ints.shrinkToFit();
+    usage = ints.memoryUsage();
+    EXPECT_EQ(usage.slackBytes, 54 * sizeof(int));
+    EXPECT_EQ(ints.toVector(),
+              std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    // the deque grows again after shrinking
+    ints.pushFront(-1);
+    EXPECT_EQ(ints.front(), -1);
+    EXPECT_EQ(ints.getNumBlocks(), 2);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
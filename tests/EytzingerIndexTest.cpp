@@ -0,0 +1,191 @@
+#include "EytzingerIndex.h"
+#include "BinarySearchTree.h"
+#include "BSTMap.h"
+#include "Entry.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST(EytzingerIndexTest, EmptyTest)
+{
+    EytzingerIndex<int> index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.getNumItems(), 0);
+    EXPECT_FALSE(index.contains(1));
+    EXPECT_EQ(index.lowerBound(1), nullptr);
+
+    int key = 1;
+    const int* result = &key;
+    index.findItems(&key, 1, &result);
+    EXPECT_EQ(result, nullptr);
+}
+
+TEST(EytzingerIndexTest, LookupTest)
+{
+    // every size up to a few full levels, so each shape of last level is
+    // covered
+    for (int size = 1; size <= 70; size++)
+    {
+        std::vector<int> items;
+        for (int i = 0; i < size; i++)
+        {
+            items.push_back(2 * i);
+        }
+        EytzingerIndex<int> index(std::move(items));
+        ASSERT_EQ(index.getNumItems(), size);
+
+        std::vector<int> keys;
+        for (int key = -1; key <= 2 * size; key++)
+        {
+            keys.push_back(key);
+            const int* itemPtr = index.findItem(key);
+            const int* lowerBoundPtr = index.lowerBound(key);
+            if (key >= 0 && key % 2 == 0 && key < 2 * size)
+            {
+                ASSERT_NE(itemPtr, nullptr);
+                EXPECT_EQ(*itemPtr, key);
+            }
+            else
+            {
+                EXPECT_EQ(itemPtr, nullptr);
+            }
+
+            if (key < 2 * size - 1)
+            {
+                ASSERT_NE(lowerBoundPtr, nullptr);
+                EXPECT_EQ(*lowerBoundPtr, std::max(key + key % 2, 0));
+            }
+            else
+            {
+                EXPECT_EQ(lowerBoundPtr, nullptr);
+            }
+        }
+
+        std::vector<const int*> results(keys.size());
+        index.findItems(keys.data(), keys.size(), results.data());
+        for (std::size_t i = 0; i < keys.size(); i++)
+        {
+            EXPECT_EQ(results[i], index.findItem(keys[i]));
+        }
+
+        std::vector<int> visited;
+        index.inorderForEach([&visited](const int& item)
+        {
+            visited.push_back(item);
+        });
+        ASSERT_EQ(static_cast<int>(visited.size()), size);
+        for (int i = 0; i < size; i++)
+        {
+            EXPECT_EQ(visited[i], 2 * i);
+        }
+    }
+}
+
+TEST(EytzingerIndexTest, BatchTest)
+{
+    // float keys take the SSE2 path, double keys the scalar one
+    std::vector<float> floats;
+    std::vector<double> doubles;
+    for (int i = 0; i < 1000; i++)
+    {
+        floats.push_back(i * 0.5f);
+        doubles.push_back(i * 0.5);
+    }
+    EytzingerIndex<float> floatIndex(std::move(floats));
+    EytzingerIndex<double> doubleIndex(std::move(doubles));
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> key(-10, 1010);
+    std::vector<float> floatKeys;
+    std::vector<double> doubleKeys;
+    for (int i = 0; i < 1003; i++)
+    {
+        int k = key(rng);
+        floatKeys.push_back(k * 0.25f);
+        doubleKeys.push_back(k * 0.25);
+    }
+
+    std::vector<const float*> floatResults(floatKeys.size());
+    std::vector<const double*> doubleResults(doubleKeys.size());
+    floatIndex.findItems(floatKeys.data(), floatKeys.size(),
+                         floatResults.data());
+    doubleIndex.findItems(doubleKeys.data(), doubleKeys.size(),
+                          doubleResults.data());
+    for (std::size_t i = 0; i < floatKeys.size(); i++)
+    {
+        bool expected = floatKeys[i] >= 0 && floatKeys[i] <= 499.5f &&
+                        static_cast<int>(floatKeys[i] * 4) % 2 == 0;
+        ASSERT_EQ(floatResults[i] != nullptr, expected);
+        ASSERT_EQ(doubleResults[i] != nullptr, expected);
+        if (expected)
+        {
+            EXPECT_EQ(*floatResults[i], floatKeys[i]);
+            EXPECT_EQ(*doubleResults[i], doubleKeys[i]);
+        }
+    }
+}
+
+TEST(EytzingerIndexTest, FreezeTest)
+{
+    BinarySearchTree<int> tree;
+    std::vector<int> items;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 5000; i++)
+    {
+        int item = rng() % 100000;
+        if (tree.add(item))
+        {
+            items.push_back(item);
+        }
+    }
+    std::sort(items.begin(), items.end());
+
+    EytzingerIndex<int> index = tree.freeze();
+    EXPECT_TRUE(tree.empty());
+    ASSERT_EQ(index.getNumItems(), static_cast<int>(items.size()));
+    for (int item : items)
+    {
+        ASSERT_TRUE(index.contains(item));
+    }
+    EXPECT_FALSE(index.contains(100000));
+
+    std::vector<int> visited;
+    index.inorderForEach([&visited](const int& item)
+    {
+        visited.push_back(item);
+    });
+    EXPECT_EQ(visited, items);
+}
+
+TEST(EytzingerIndexTest, FreezeMapTest)
+{
+    BSTMap<std::string, int> map;
+    EXPECT_TRUE(map.freeze().empty());
+
+    map.add("pear", 3);
+    map.add("apple", 1);
+    map.add("fig", 2);
+
+    EytzingerIndex<Entry<std::string, int>> index = map.freeze();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(index.getNumItems(), 3);
+    EXPECT_EQ(index.findItem(std::string("apple"))->getValue(), 1);
+    EXPECT_EQ(index.findItem(std::string("pear"))->getValue(), 3);
+    EXPECT_EQ(index.findItem(std::string("kiwi")), nullptr);
+    EXPECT_EQ(index.lowerBound(std::string("b"))->getKey(), "fig");
+
+    std::vector<std::string> keys = { "fig", "kiwi", "apple" };
+    std::vector<const Entry<std::string, int>*> results(keys.size());
+    index.findItems(keys.data(), keys.size(), results.data());
+    EXPECT_EQ(results[0]->getValue(), 2);
+    EXPECT_EQ(results[1], nullptr);
+    EXPECT_EQ(results[2]->getValue(), 1);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
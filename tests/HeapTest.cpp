@@ -1,5 +1,9 @@
 #include "gtest/gtest.h"
 #include "Heap.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
 
 TEST(HeapTest, SimpleHeapTest)
 {
@@ -70,6 +74,116 @@ TEST(HeapTest, CopyTest)
     delete[] array;
 }
 
+TEST(HeapTest, ClearTest)
+{
+    Heap<int> heap;
+    for (int i = 0; i < 20; i++)
+    {
+        heap.add(i);
+    }
+
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.getHeight(), 0);
+
+    // the heap can be refilled after it is cleared
+    heap.add(5);
+    heap.add(7);
+    EXPECT_EQ(heap.peekTop(), 7);
+    EXPECT_EQ(heap.getNumNodes(), 2);
+}
+
+TEST(HeapTest, CopyConstructorTest)
+{
+    Heap<std::string> heap;
+    heap.add("b");
+    heap.add("c");
+    heap.add("a");
+
+    Heap<std::string> heapCopy(heap);
+    heap.remove();
+    EXPECT_EQ(heap.peekTop(), "b");
+    EXPECT_EQ(heapCopy.peekTop(), "c");
+    EXPECT_EQ(heapCopy.getNumNodes(), 3);
+
+    heapCopy = heap;
+    EXPECT_EQ(heapCopy.getNumNodes(), 2);
+    heap.clear();
+    EXPECT_EQ(heapCopy.peekTop(), "b");
+
+    heapCopy = heapCopy;
+    EXPECT_EQ(heapCopy.peekTop(), "b");
+}
+
+TEST(HeapTest, SingleChildTest)
+{
+    // removing from heaps whose last parent has only a left child
+    for (int size = 1; size <= 16; size++)
+    {
+        std::vector<int> items;
+        for (int i = 0; i < size; i++)
+        {
+            items.push_back(i);
+        }
+        std::shuffle(items.begin(), items.end(), std::mt19937(size));
+
+        Heap<int> heap;
+        for (int item : items)
+        {
+            heap.add(item);
+        }
+
+        EXPECT_EQ(heap.getHeight(), size < 2 ? 1 : size < 4 ? 2 :
+                                    size < 8 ? 3 : size < 16 ? 4 : 5);
+        for (int i = size - 1; i >= 0; i--)
+        {
+            ASSERT_EQ(heap.peekTop(), i);
+            heap.remove();
+        }
+        EXPECT_TRUE(heap.isEmpty());
+    }
+}
+
+TEST(HeapTest, EmptyArrayTest)
+{
+    Heap<int> heap(nullptr, 0);
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_THROW(heap.peekTop(), std::range_error);
+
+    heap.add(1);
+    EXPECT_EQ(heap.peekTop(), 1);
+}
+
+TEST(HeapTest, ShrinkToFitTest)
+{
+    Heap<int> heap;
+    for (int i = 0; i < 20; i++)
+    {
+        heap.add(i);
+    }
+
+    // the array doubled from 15 to 30 items
+    MemoryUsage usage = heap.memoryUsage();
+    EXPECT_EQ(usage.payloadBytes, 20 * sizeof(int));
+    EXPECT_EQ(usage.slackBytes, 10 * sizeof(int));
+    EXPECT_GE(usage.overheadBytes, sizeof(heap));
+
+    heap.shrinkToFit();
+    EXPECT_EQ(heap.memoryUsage().slackBytes, 0u);
+    EXPECT_EQ(heap.peekTop(), 19);
+
+    while (!heap.isEmpty())
+    {
+        heap.remove();
+    }
+    heap.shrinkToFit();
+    EXPECT_EQ(heap.memoryUsage().getTotalBytes(),
+              heap.memoryUsage().overheadBytes);
+
+    heap.add(1);
+    EXPECT_EQ(heap.peekTop(), 1);
+}
+
 int main (int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,176 @@
+#include "IntrusiveList.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+struct Job
+{
+    int id;
+    IntrusiveListHook<Job> listHook;
+    IntrusiveListHook<Job> otherHook;
+
+    Job(int id) : id(id)
+    {
+
+    }
+};
+
+typedef IntrusiveList<Job> JobList;
+typedef IntrusiveList<Job, &Job::otherHook> OtherJobList;
+
+template <class ListType>
+std::vector<int> getIds(const ListType& list)
+{
+    std::vector<int> ids;
+    for (const Job& job : list)
+    {
+        ids.push_back(job.id);
+    }
+    return ids;
+}
+
+}
+
+class IntrusiveListTest : public ::testing::Test
+{
+protected:
+    std::vector<Job> jobs;
+    JobList* list;
+
+    IntrusiveListTest()
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            jobs.emplace_back(i);
+        }
+        list = new JobList();
+    }
+
+    ~IntrusiveListTest()
+    {
+        delete list;
+    }
+};
+
+TEST_F(IntrusiveListTest, SimpleTest)
+{
+    ASSERT_TRUE(list->empty());
+    EXPECT_FALSE(list->popFront());
+    EXPECT_THROW(list->front(), std::range_error);
+
+    list->pushBack(jobs[1]);
+    list->pushBack(jobs[2]);
+    list->pushFront(jobs[0]);
+    ASSERT_EQ(list->size(), 3);
+    EXPECT_EQ(getIds(*list), std::vector<int>({ 0, 1, 2 }));
+    EXPECT_EQ(list->front().id, 0);
+    EXPECT_EQ(list->back().id, 2);
+    EXPECT_TRUE(jobs[1].listHook.isLinked());
+    EXPECT_THROW(list->pushBack(jobs[1]), std::runtime_error);
+
+    // removal needs only the object
+    EXPECT_TRUE(list->remove(jobs[1]));
+    EXPECT_FALSE(list->remove(jobs[1]));
+    EXPECT_FALSE(jobs[1].listHook.isLinked());
+    EXPECT_EQ(getIds(*list), std::vector<int>({ 0, 2 }));
+
+    EXPECT_TRUE(list->remove(jobs[0]));
+    EXPECT_EQ(list->front().id, 2);
+    EXPECT_TRUE(list->popBack());
+    EXPECT_TRUE(list->empty());
+
+    list->pushBack(jobs[3]);
+    list->pushBack(jobs[4]);
+    list->clear();
+    EXPECT_TRUE(list->empty());
+    EXPECT_FALSE(jobs[3].listHook.isLinked());
+    EXPECT_FALSE(jobs[4].listHook.isLinked());
+}
+
+TEST_F(IntrusiveListTest, IteratorTest)
+{
+    for (Job& job : jobs)
+    {
+        list->pushBack(job);
+    }
+
+    // insert before the head, in the middle and at the end
+    Job first(-1), middle(10), last(20);
+    JobList::iterator it = list->insert(list->begin(), first);
+    EXPECT_EQ(it->id, -1);
+    EXPECT_EQ(list->front().id, -1);
+    it = list->begin();
+    std::advance(it, 3);
+    list->insert(it, middle);
+    list->insert(list->end(), last);
+    EXPECT_EQ(getIds(*list), std::vector<int>({ -1, 0, 1, 10, 2, 3, 4, 20 }));
+
+    // erase every other object while iterating
+    it = list->begin();
+    while (it != list->end())
+    {
+        it = list->erase(it);
+        if (it != list->end())
+        {
+            ++it;
+        }
+    }
+    EXPECT_EQ(getIds(*list), std::vector<int>({ 0, 10, 3, 20 }));
+
+    std::vector<int> reversed;
+    for (it = list->end(); it != list->begin(); )
+    {
+        --it;
+        reversed.push_back(it->id);
+    }
+    EXPECT_EQ(reversed, std::vector<int>({ 20, 3, 10, 0 }));
+
+    list->clear();
+}
+
+TEST_F(IntrusiveListTest, TwoHooksTest)
+{
+    OtherJobList other;
+    for (Job& job : jobs)
+    {
+        list->pushBack(job);
+        other.pushFront(job);
+    }
+
+    EXPECT_EQ(getIds(*list), std::vector<int>({ 0, 1, 2, 3, 4 }));
+    EXPECT_EQ(getIds(other), std::vector<int>({ 4, 3, 2, 1, 0 }));
+
+    list->remove(jobs[2]);
+    EXPECT_EQ(getIds(*list), std::vector<int>({ 0, 1, 3, 4 }));
+    EXPECT_EQ(other.size(), 5);
+    EXPECT_TRUE(jobs[2].otherHook.isLinked());
+
+    // a copy of a linked object is not linked
+    Job copy = jobs[0];
+    EXPECT_FALSE(copy.listHook.isLinked());
+    EXPECT_FALSE(copy.otherHook.isLinked());
+}
+
+TEST_F(IntrusiveListTest, DestructorTest)
+{
+    {
+        JobList scoped;
+        scoped.pushBack(jobs[0]);
+        scoped.pushBack(jobs[1]);
+    }
+    EXPECT_FALSE(jobs[0].listHook.isLinked());
+    EXPECT_FALSE(jobs[1].listHook.isLinked());
+
+    list->pushBack(jobs[0]);
+    EXPECT_EQ(list->size(), 1);
+    list->clear();
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
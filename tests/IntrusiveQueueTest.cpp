@@ -0,0 +1,76 @@
+#include "IntrusiveQueue.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+
+namespace
+{
+
+struct Message
+{
+    int id;
+    IntrusiveListHook<Message> listHook;
+
+    Message(int id) : id(id)
+    {
+
+    }
+};
+
+}
+
+TEST(IntrusiveQueueTest, SimpleTest)
+{
+    Message messages[] = { 0, 1, 2, 3 };
+    IntrusiveQueue<Message> queue;
+
+    ASSERT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop());
+    EXPECT_THROW(queue.front(), std::range_error);
+
+    for (Message& message : messages)
+    {
+        queue.push(message);
+    }
+    ASSERT_EQ(queue.size(), 4);
+    EXPECT_EQ(&queue.front(), &messages[0]);
+    EXPECT_EQ(&queue.back(), &messages[3]);
+    EXPECT_THROW(queue.push(messages[2]), std::runtime_error);
+
+    EXPECT_TRUE(queue.pop());
+    EXPECT_FALSE(messages[0].listHook.isLinked());
+    EXPECT_EQ(queue.front().id, 1);
+
+    // a message can leave from the middle of the queue
+    EXPECT_TRUE(queue.remove(messages[2]));
+    EXPECT_FALSE(queue.remove(messages[2]));
+    EXPECT_TRUE(queue.pop());
+    EXPECT_EQ(queue.front().id, 3);
+
+    // and be queued again
+    queue.push(messages[0]);
+    EXPECT_EQ(queue.back().id, 0);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(messages[3].listHook.isLinked());
+}
+
+#ifndef NDEBUG
+TEST(IntrusiveQueueDeathTest, RemoveFromOtherQueueTest)
+{
+    Message message(0);
+    IntrusiveQueue<Message> queue;
+    IntrusiveQueue<Message> otherQueue;
+    queue.push(message);
+
+    // the message shares its hook with the other queue, but is not in it
+    EXPECT_DEATH(otherQueue.remove(message), "another list");
+    queue.clear();
+}
+#endif
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
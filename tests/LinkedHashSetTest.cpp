@@ -0,0 +1,152 @@
+#include "LinkedHashSet.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+class LinkedHashSetTest : public ::testing::Test
+{
+protected:
+    LinkedHashSet<int>* set;
+
+    LinkedHashSetTest()
+    {
+        set = new LinkedHashSet<int>();
+    }
+
+    ~LinkedHashSetTest()
+    {
+        delete set;
+    }
+};
+
+TEST_F(LinkedHashSetTest, SimpleTest)
+{
+    ASSERT_TRUE(set->empty());
+
+    set->add(3);
+    set->add(1);
+    set->add(2);
+    set->add(1);
+
+    ASSERT_EQ(set->size(), 3);
+    EXPECT_EQ(set->toVector(), std::vector<int>({ 3, 1, 2 }));
+    EXPECT_TRUE(set->contains(1));
+    EXPECT_FALSE(set->contains(4));
+
+    EXPECT_TRUE(set->remove(3));
+    EXPECT_FALSE(set->remove(3));
+    EXPECT_FALSE(set->contains(3));
+    EXPECT_EQ(set->toVector(), std::vector<int>({ 1, 2 }));
+
+    set->add(3);
+    EXPECT_EQ(set->toVector(), std::vector<int>({ 1, 2, 3 }));
+
+    set->clear();
+    EXPECT_TRUE(set->empty());
+    EXPECT_FALSE(set->contains(1));
+}
+
+TEST_F(LinkedHashSetTest, RandomOperationsTest)
+{
+    // compare against a plain LinkedList, whose contains and remove scan
+    std::mt19937 random(7);
+    LinkedList<int> reference;
+    for (int i = 0; i < 5000; i++)
+    {
+        int item = random() % 500;
+        switch (random() % 3)
+        {
+        case 0:
+            if (!reference.contains(item))
+            {
+                reference.add(item);
+            }
+            set->add(item);
+            break;
+        case 1:
+            ASSERT_EQ(set->remove(item), reference.remove(item));
+            break;
+        default:
+            ASSERT_EQ(set->contains(item), reference.contains(item));
+            break;
+        }
+        ASSERT_EQ(set->size(), reference.size());
+    }
+
+    EXPECT_EQ(set->toVector(), reference.toVector());
+    EXPECT_EQ(std::vector<int>(set->begin(), set->end()),
+              reference.toVector());
+}
+
+TEST_F(LinkedHashSetTest, CopyTest)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        set->add(i);
+    }
+
+    LinkedHashSet<int> copy(*set);
+    set->clear();
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_TRUE(copy.remove(50));
+    EXPECT_FALSE(copy.contains(50));
+    EXPECT_TRUE(copy.contains(99));
+
+    LinkedHashSet<int> assigned;
+    assigned.add(1000);
+    assigned = copy;
+    EXPECT_EQ(assigned.size(), 99);
+    EXPECT_FALSE(assigned.contains(1000));
+    EXPECT_TRUE(assigned.remove(0));
+    EXPECT_EQ(assigned.toVector().front(), 1);
+}
+
+TEST_F(LinkedHashSetTest, StringTest)
+{
+    LinkedHashSet<std::string> strings;
+    strings.reserve(3);
+    strings.add("b");
+    strings.add("a");
+    strings.add("b");
+
+    EXPECT_TRUE(strings.contains("a"));
+    std::vector<std::string> vec = strings.intoVector();
+    EXPECT_EQ(vec, std::vector<std::string>({ "b", "a" }));
+    EXPECT_TRUE(strings.empty());
+    EXPECT_FALSE(strings.contains("a"));
+
+    strings.add("a");
+    EXPECT_TRUE(strings.contains("a"));
+}
+
+TEST_F(LinkedHashSetTest, MemoryUsageTest)
+{
+    LinkedList<int> list;
+    for (int i = 0; i < 1000; i++)
+    {
+        set->add(i);
+        list.add(i);
+    }
+
+    // the index is overhead on top of what the list uses
+    MemoryUsage setUsage = set->memoryUsage();
+    MemoryUsage listUsage = list.memoryUsage();
+    EXPECT_EQ(setUsage.payloadBytes, listUsage.payloadBytes);
+    EXPECT_EQ(setUsage.slackBytes, listUsage.slackBytes);
+    EXPECT_GE(setUsage.overheadBytes, listUsage.overheadBytes +
+              1000 * (sizeof(int*) + sizeof(Node<int>*)) +
+              1000 * sizeof(void*));
+
+    set->clear();
+    list.clear();
+    EXPECT_LT(set->memoryUsage().getTotalBytes(),
+              setUsage.getTotalBytes() / 5);
+}
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
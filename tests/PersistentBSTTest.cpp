@@ -0,0 +1,248 @@
+#include "PersistentBinarySearchTree.h"
+#include "PersistentBSTMap.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CollectInts : public TraversalFunction<int>
+{
+public:
+    std::vector<int> vec;
+
+    virtual void visit(int& item)
+    {
+        vec.push_back(item);
+    }
+};
+
+TEST(PersistentBSTTest, SimpleTest)
+{
+    PersistentBinarySearchTree<int> tree;
+    ASSERT_TRUE(tree.empty());
+
+    int items[] = { 4, 2, 6, 1, 3, 5, 7 };
+    for (int item : items)
+    {
+        ASSERT_TRUE(tree.add(item));
+    }
+    ASSERT_FALSE(tree.add(4));
+    ASSERT_EQ(tree.getNumNodes(), 7);
+    ASSERT_EQ(tree.getTreeHeight(), 3);
+    ASSERT_TRUE(tree.contains(5));
+    ASSERT_EQ(tree.getItem(5), 5);
+    EXPECT_THROW(tree.getItem(8), std::runtime_error);
+
+    int item = 0;
+    EXPECT_TRUE(tree.tryGetItem(6, item));
+    EXPECT_EQ(item, 6);
+    EXPECT_FALSE(tree.tryGetItem(8, item));
+
+    // a leaf, a node with one child, and a node with two children
+    ASSERT_TRUE(tree.remove(1));
+    ASSERT_TRUE(tree.remove(2));
+    ASSERT_TRUE(tree.remove(4));
+    ASSERT_FALSE(tree.remove(4));
+    ASSERT_EQ(tree.getNumNodes(), 4);
+
+    CollectInts func;
+    tree.inorderTraverse(&func);
+    std::vector<int> expected = { 3, 5, 6, 7 };
+    EXPECT_EQ(func.vec, expected);
+
+    tree.clear();
+    EXPECT_TRUE(tree.empty());
+}
+
+TEST(PersistentBSTTest, TraversalTest)
+{
+    PersistentBinarySearchTree<int> tree;
+    for (int item : { 4, 2, 6, 1, 3, 5, 7 })
+    {
+        tree.add(item);
+    }
+
+    CollectInts preorder;
+    tree.preorderTraverse(&preorder);
+    EXPECT_EQ(preorder.vec, std::vector<int>({ 4, 2, 1, 3, 6, 5, 7 }));
+
+    CollectInts postorder;
+    tree.postorderTraverse(&postorder);
+    EXPECT_EQ(postorder.vec, std::vector<int>({ 1, 3, 2, 5, 7, 6, 4 }));
+}
+
+TEST(PersistentBSTTest, DegenerateTreeTest)
+{
+    // every add copies the whole spine, so the tree is kept small enough to
+    // build quickly; the height and traversals do not recurse at any depth
+    const int NUM_ITEMS = 4000;
+    PersistentBinarySearchTree<int> tree;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree.add(i);
+    }
+    EXPECT_EQ(tree.getTreeHeight(), NUM_ITEMS);
+
+    CollectInts preorder;
+    CollectInts inorder;
+    CollectInts postorder;
+    tree.preorderTraverse(&preorder);
+    tree.inorderTraverse(&inorder);
+    tree.postorderTraverse(&postorder);
+    ASSERT_EQ(preorder.vec.size(), static_cast<std::size_t>(NUM_ITEMS));
+    EXPECT_EQ(preorder.vec, inorder.vec);
+    EXPECT_EQ(inorder.vec.front(), 0);
+    EXPECT_EQ(inorder.vec.back(), NUM_ITEMS - 1);
+    EXPECT_EQ(postorder.vec.front(), NUM_ITEMS - 1);
+    EXPECT_EQ(postorder.vec.back(), 0);
+}
+
+TEST(PersistentBSTTest, SnapshotTest)
+{
+    PersistentBinarySearchTree<int> tree;
+    for (int i = 0; i < 10; i++)
+    {
+        tree.add((i * 7) % 10);
+    }
+
+    PersistentBinarySearchTree<int>::Snapshot snapshot = tree.snapshot();
+    tree.remove(3);
+    tree.add(42);
+    tree.remove(0);
+
+    EXPECT_EQ(snapshot.getNumNodes(), 10);
+    EXPECT_TRUE(snapshot.contains(3));
+    EXPECT_TRUE(snapshot.contains(0));
+    EXPECT_FALSE(snapshot.contains(42));
+
+    EXPECT_EQ(tree.getNumNodes(), 9);
+    EXPECT_FALSE(tree.contains(3));
+    EXPECT_TRUE(tree.contains(42));
+
+    CollectInts func;
+    snapshot.inorderTraverse(&func);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(func.vec[i], i);
+    }
+}
+
+TEST(PersistentBSTTest, ConcurrentSnapshotTest)
+{
+    PersistentBinarySearchTree<int> tree;
+    const int NUM_ITEMS = 2000;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]()
+    {
+        for (int i = 0; i < NUM_ITEMS; i++)
+        {
+            tree.add((i * 7919) % NUM_ITEMS);
+        }
+        for (int i = 0; i < NUM_ITEMS; i += 2)
+        {
+            tree.remove(i);
+        }
+        done = true;
+    });
+
+    // every snapshot must be internally consistent: sorted, and the size
+    // recorded with its root must match the number of nodes in it
+    while (!done)
+    {
+        PersistentBinarySearchTree<int>::Snapshot snapshot = tree.snapshot();
+        CollectInts func;
+        snapshot.inorderTraverse(&func);
+        ASSERT_EQ(static_cast<int>(func.vec.size()), snapshot.getNumNodes());
+        for (std::size_t i = 1; i < func.vec.size(); i++)
+        {
+            ASSERT_LT(func.vec[i - 1], func.vec[i]);
+        }
+    }
+
+    writer.join();
+    EXPECT_EQ(tree.getNumNodes(), NUM_ITEMS / 2);
+}
+
+TEST(PersistentBSTTest, MapTest)
+{
+    PersistentBSTMap<std::string, int> map;
+    ASSERT_TRUE(map.add("a", 1));
+    ASSERT_TRUE(map.add("b", 2));
+    ASSERT_FALSE(map.add("a", 3));
+
+    PersistentBSTMap<std::string, int>::Snapshot snapshot = map.snapshot();
+    EXPECT_FALSE(map.insertOrAssign("a", 10));
+    EXPECT_TRUE(map.remove("b"));
+
+    EXPECT_EQ(map.getValue("a"), 10);
+    EXPECT_FALSE(map.contains("b"));
+    EXPECT_EQ(map.getSize(), 1);
+
+    EXPECT_EQ(snapshot.getValue("a"), 1);
+    EXPECT_EQ(snapshot.getValue("b"), 2);
+    EXPECT_EQ(snapshot.getSize(), 2);
+    EXPECT_THROW(map.getValue("b"), std::runtime_error);
+
+    // a snapshot's values outlive every later write to the map
+    const int* valuePtr = snapshot.findPtr("a");
+    ASSERT_NE(valuePtr, nullptr);
+    map.clear();
+    EXPECT_EQ(*valuePtr, 1);
+    EXPECT_EQ(snapshot.findPtr("c"), nullptr);
+
+    int value = 0;
+    EXPECT_FALSE(map.tryGetValue("a", value));
+    map.add("c", 3);
+    EXPECT_TRUE(map.tryGetValue("c", value));
+    EXPECT_EQ(value, 3);
+}
+
+TEST(PersistentBSTTest, ConcurrentGetItemTest)
+{
+    // a writer replaces and removes the items a reader is looking up; the
+    // reader's copies are taken while its version of the tree is alive
+    PersistentBSTMap<int, std::string> map;
+    const int NUM_KEYS = 64;
+    for (int key = 0; key < NUM_KEYS; key++)
+    {
+        map.add(key, std::string(100, 'a' + key % 26));
+    }
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]()
+    {
+        for (int i = 0; i < 20000; i++)
+        {
+            int key = (i * 7) % NUM_KEYS;
+            map.remove(key);
+            map.insertOrAssign(key, std::string(100, 'a' + key % 26));
+        }
+        done = true;
+    });
+
+    bool readerFailed = false;
+    while (!done)
+    {
+        for (int key = 0; key < NUM_KEYS; key++)
+        {
+            std::string value;
+            if (map.tryGetValue(key, value) &&
+                value != std::string(100, 'a' + key % 26))
+            {
+                readerFailed = true;
+            }
+        }
+    }
+
+    writer.join();
+    EXPECT_FALSE(readerFailed);
+    EXPECT_EQ(map.getSize(), NUM_KEYS);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,37 @@
+#include "PriorityQueue.h"
+#include "gtest/gtest.h"
+
+TEST(PriorityQueueTest, SimpleTest)
+{
+    PriorityQueue<int> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.remove());
+
+    queue.add(3);
+    queue.add(9);
+    queue.add(1);
+    queue.add(9);
+    queue.add(4);
+    EXPECT_FALSE(queue.isEmpty());
+
+    // the largest item comes out first
+    int expected[] = { 9, 9, 4, 3, 1 };
+    for (int item : expected)
+    {
+        ASSERT_EQ(queue.peek(), item);
+        EXPECT_TRUE(queue.remove());
+    }
+    EXPECT_TRUE(queue.isEmpty());
+
+    queue.add(2);
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    queue.add(5);
+    EXPECT_EQ(queue.peek(), 5);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,5 +1,6 @@
 #include "Queue.h"
 #include "gtest/gtest.h"
+#include <stdexcept>
 
 TEST(QueueTest, Test1)
 {
@@ -30,6 +31,53 @@ TEST(QueueTest, Test1)
    ASSERT_TRUE(queue.empty());
 }
 
+TEST(QueueTest, AssignTest)
+{
+   Queue<int> queue;
+   queue.push(0);
+   queue.push(1);
+
+   Queue<int> other;
+   other.push(5);
+   other = queue;
+   ASSERT_EQ(other.front(), 0);
+   ASSERT_TRUE(other.pop());
+   ASSERT_EQ(other.front(), 1);
+
+   // assigning a queue to itself keeps its items
+   Queue<int>& self = queue;
+   queue = self;
+   ASSERT_EQ(queue.front(), 0);
+}
+
+TEST(DequeQueueTest, Test1)
+{
+   Queue<int, Deque<int>> queue;
+   ASSERT_TRUE(queue.empty());
+   ASSERT_THROW(queue.front(), std::range_error);
+   ASSERT_FALSE(queue.pop());
+
+   for (int i = 0; i < 1000; i++)
+   {
+      queue.push(i);
+   }
+   ASSERT_EQ(queue.front(), 0);
+
+   Queue<int, Deque<int>> queueCopy(queue);
+   for (int i = 0; i < 1000; i++)
+   {
+      ASSERT_EQ(queue.front(), i);
+      ASSERT_TRUE(queue.pop());
+   }
+   ASSERT_TRUE(queue.empty());
+   ASSERT_EQ(queueCopy.front(), 0);
+
+   queue = queueCopy;
+   queueCopy.clear();
+   ASSERT_TRUE(queueCopy.empty());
+   ASSERT_EQ(queue.front(), 0);
+}
+
 int main(int argc, char** argv)
 {
    ::testing::InitGoogleTest(&argc, argv);
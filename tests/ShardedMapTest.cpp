@@ -0,0 +1,126 @@
+#include "ShardedMap.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class ShardedMapTest : public ::testing::Test
+{
+protected:
+    ShardedMap<int, int> map;
+
+    ShardedMapTest() : map(8)
+    {
+
+    }
+
+    ~ShardedMapTest()
+    {
+
+    }
+};
+
+TEST_F(ShardedMapTest, SimpleTest)
+{
+    ASSERT_TRUE(map.isEmpty());
+    ASSERT_EQ(map.getNumShards(), 8);
+
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(map.add(i, i * i));
+    }
+    ASSERT_FALSE(map.add(5, 0));
+    ASSERT_EQ(map.getSize(), 100);
+
+    int value = 0;
+    EXPECT_TRUE(map.tryGetValue(9, value));
+    EXPECT_EQ(value, 81);
+    EXPECT_FALSE(map.tryGetValue(-1, value));
+    EXPECT_FALSE(map.tryGetValue(100, value));
+
+    // lookups through the Dictionary interface copy the value out too
+    const Dictionary<int, int>& dictionary = map;
+    EXPECT_EQ(dictionary.getValue(7), 49);
+    EXPECT_THROW(dictionary.getValue(-1), std::runtime_error);
+    EXPECT_TRUE(dictionary.tryGetValue(8, value));
+    EXPECT_EQ(value, 64);
+
+    EXPECT_FALSE(map.insertOrAssign(9, 1));
+    EXPECT_TRUE(map.tryGetValue(9, value));
+    EXPECT_EQ(value, 1);
+
+    ASSERT_TRUE(map.remove(9));
+    ASSERT_FALSE(map.contains(9));
+    ASSERT_EQ(map.getSize(), 99);
+
+    ShardedMap<int, int> copy(map);
+    map.clear();
+    ASSERT_TRUE(map.isEmpty());
+    EXPECT_EQ(copy.getSize(), 99);
+    EXPECT_TRUE(copy.tryGetValue(7, value));
+    EXPECT_EQ(value, 49);
+}
+
+TEST_F(ShardedMapTest, ForEachShardTest)
+{
+    for (int i = 0; i < 1000; i++)
+    {
+        map.add(i, 1);
+    }
+
+    std::atomic<int> total(0);
+    std::atomic<int> shardsVisited(0);
+    map.forEachShard([&](int, const BSTMap<int, int>& shardMap)
+    {
+        shardsVisited++;
+        shardMap.forEach([&](const int&, const int& value)
+        {
+            total += value;
+        });
+    }, 4);
+
+    EXPECT_EQ(shardsVisited.load(), 8);
+    EXPECT_EQ(total.load(), 1000);
+}
+
+TEST_F(ShardedMapTest, ConcurrentTest)
+{
+    const int NUM_THREADS = 8;
+    const int KEYS_PER_THREAD = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++)
+    {
+        threads.emplace_back([this, t]()
+        {
+            for (int i = 0; i < KEYS_PER_THREAD; i++)
+            {
+                int key = t * KEYS_PER_THREAD + i;
+                map.add(key, key);
+                map.contains(key - 1);
+            }
+
+            for (int i = 0; i < KEYS_PER_THREAD; i += 2)
+            {
+                map.remove(t * KEYS_PER_THREAD + i);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(map.getSize(), NUM_THREADS * KEYS_PER_THREAD / 2);
+    for (int key = 0; key < NUM_THREADS * KEYS_PER_THREAD; key++)
+    {
+        EXPECT_EQ(map.contains(key), key % 2 == 1);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
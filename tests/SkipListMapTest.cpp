@@ -0,0 +1,300 @@
+#include "SkipListMap.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SkipListMapTest : public ::testing::Test
+{
+protected:
+    SkipListMap<int, int> map;
+
+    SkipListMapTest()
+    {
+
+    }
+
+    ~SkipListMapTest()
+    {
+
+    }
+};
+
+TEST_F(SkipListMapTest, SimpleTest)
+{
+    ASSERT_TRUE(map.isEmpty());
+
+    for (int i = 99; i >= 0; i--)
+    {
+        ASSERT_TRUE(map.add(i, i * i));
+    }
+    ASSERT_FALSE(map.add(5, 0));
+    ASSERT_EQ(map.getSize(), 100);
+
+    EXPECT_EQ(map.getValue(7), 49);
+    EXPECT_THROW(map.getValue(100), std::runtime_error);
+
+    int value = 0;
+    EXPECT_TRUE(map.tryGetValue(9, value));
+    EXPECT_EQ(value, 81);
+    EXPECT_FALSE(map.tryGetValue(-1, value));
+
+    ASSERT_TRUE(map.remove(9));
+    ASSERT_FALSE(map.remove(9));
+    ASSERT_FALSE(map.contains(9));
+    ASSERT_EQ(map.getSize(), 99);
+
+    map.clear();
+    ASSERT_TRUE(map.isEmpty());
+    ASSERT_FALSE(map.contains(0));
+
+    SkipListMap<std::string, int> words;
+    words.add("pear", 1);
+    words.add("apple", 2);
+    EXPECT_EQ(words.getValue("apple"), 2);
+}
+
+TEST_F(SkipListMapTest, RandomOperationsTest)
+{
+    std::map<int, int> expected;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> key(0, 999);
+
+    for (int i = 0; i < 50000; i++)
+    {
+        int k = key(rng);
+        switch (rng() % 3)
+        {
+        case 0:
+            ASSERT_EQ(map.remove(k), expected.erase(k) == 1);
+            break;
+        case 1:
+            ASSERT_EQ(map.add(k, i), expected.emplace(k, i).second);
+            break;
+        default:
+            ASSERT_EQ(map.contains(k), expected.count(k) == 1);
+        }
+    }
+
+    ASSERT_EQ(map.getSize(), static_cast<int>(expected.size()));
+    std::vector<std::pair<int, int>> visited;
+    map.forEach([&visited](const int& k, const int& v)
+    {
+        visited.emplace_back(k, v);
+    });
+    std::vector<std::pair<int, int>> entries(expected.begin(), expected.end());
+    EXPECT_EQ(visited, entries);
+}
+
+TEST_F(SkipListMapTest, RangeTest)
+{
+    for (int i = 0; i < 100; i += 2)
+    {
+        map.add(i, -i);
+    }
+
+    std::vector<int> keys;
+    auto record = [&keys](const int& k, const int&) { keys.push_back(k); };
+
+    map.forEachInRange(11, 20, record);
+    std::vector<int> expected = { 12, 14, 16, 18 };
+    EXPECT_EQ(keys, expected);
+
+    keys.clear();
+    map.forEachInRange(-5, 3, record);
+    expected = { 0, 2 };
+    EXPECT_EQ(keys, expected);
+
+    keys.clear();
+    map.forEachInRange(95, 200, record);
+    expected = { 96, 98 };
+    EXPECT_EQ(keys, expected);
+
+    keys.clear();
+    map.forEachInRange(50, 50, record);
+    EXPECT_TRUE(keys.empty());
+}
+
+/**
+ * Writers add and remove keys from a contended range while readers scan
+ * the map, which must always be in order and hold every key that never
+ * changes. Run under ThreadSanitizer with "make tsan".
+ */
+TEST_F(SkipListMapTest, ConcurrentTest)
+{
+    const int NUM_WRITERS = 4;
+    const int NUM_READERS = 2;
+    const int NUM_HOT_KEYS = 256;
+    const int NUM_OPERATIONS = 20000;
+
+    // multiples of 4 are always present, and never touched by the writers
+    int numStableKeys = 0;
+    for (int key = 0; key < NUM_HOT_KEYS; key += 4)
+    {
+        map.add(key, key);
+        numStableKeys++;
+    }
+
+    std::vector<std::atomic<int>> balances(NUM_HOT_KEYS);
+    std::atomic<int> numWritersDone(0);
+    std::atomic<bool> readerFailed(false);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < NUM_WRITERS; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 rng(t);
+            for (int i = 0; i < NUM_OPERATIONS; i++)
+            {
+                int key = rng() % NUM_HOT_KEYS;
+                if (key % 4 == 0)
+                {
+                    continue;
+                }
+
+                if (rng() % 2 == 0)
+                {
+                    if (map.add(key, key))
+                    {
+                        balances[key]++;
+                    }
+                }
+                else if (map.remove(key))
+                {
+                    balances[key]--;
+                }
+            }
+            numWritersDone++;
+        });
+    }
+
+    for (int t = 0; t < NUM_READERS; t++)
+    {
+        threads.emplace_back([&]()
+        {
+            while (numWritersDone.load() < NUM_WRITERS)
+            {
+                int previous = -1;
+                int numStableSeen = 0;
+                map.forEach([&](const int& k, const int& v)
+                {
+                    if (k <= previous || v != k)
+                    {
+                        readerFailed = true;
+                    }
+                    previous = k;
+                    numStableSeen += (k % 4 == 0);
+                });
+
+                if (numStableSeen != numStableKeys)
+                {
+                    readerFailed = true;
+                }
+
+                int numInRange = 0;
+                map.forEachInRange(100, 140, [&](const int& k, const int&)
+                {
+                    if (k < 100 || k >= 140)
+                    {
+                        readerFailed = true;
+                    }
+                    numInRange += (k % 4 == 0);
+                });
+                if (numInRange != 10)
+                {
+                    readerFailed = true;
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_FALSE(readerFailed.load());
+    int numPresent = numStableKeys;
+    for (int key = 0; key < NUM_HOT_KEYS; key++)
+    {
+        if (key % 4 == 0)
+        {
+            ASSERT_TRUE(map.contains(key));
+            continue;
+        }
+
+        int balance = balances[key].load();
+        ASSERT_TRUE(balance == 0 || balance == 1);
+        ASSERT_EQ(map.contains(key), balance == 1);
+        numPresent += balance;
+    }
+    EXPECT_EQ(map.getSize(), numPresent);
+}
+
+/**
+ * Writers remove and re-add keys whose values are heap-allocated strings
+ * while readers look them up through the Dictionary interface. Each lookup
+ * copies the value while its node is still protected, so it never reads a
+ * freed string.
+ */
+TEST(SkipListMapConcurrentTest, GetValueTest)
+{
+    const int NUM_KEYS = 64;
+    const int NUM_OPERATIONS = 20000;
+    SkipListMap<int, std::string> strings;
+    for (int key = 0; key < NUM_KEYS; key++)
+    {
+        strings.add(key, std::string(100, 'a' + key % 26));
+    }
+
+    std::atomic<bool> writerDone(false);
+    std::atomic<bool> readerFailed(false);
+    std::thread writer([&]()
+    {
+        std::mt19937 rng(1);
+        for (int i = 0; i < NUM_OPERATIONS; i++)
+        {
+            int key = rng() % NUM_KEYS;
+            strings.remove(key);
+            strings.add(key, std::string(100, 'a' + key % 26));
+        }
+        writerDone = true;
+    });
+
+    std::thread reader([&]()
+    {
+        const Dictionary<int, std::string>& dictionary = strings;
+        std::mt19937 rng(2);
+        while (!writerDone.load())
+        {
+            int key = rng() % NUM_KEYS;
+            try
+            {
+                std::string value = dictionary.getValue(key);
+                if (value != std::string(100, 'a' + key % 26))
+                {
+                    readerFailed = true;
+                }
+            }
+            catch (const std::runtime_error&)
+            {
+                // the key was between its removal and re-adding
+            }
+        }
+    });
+
+    writer.join();
+    reader.join();
+    EXPECT_FALSE(readerFailed.load());
+    EXPECT_EQ(strings.getSize(), NUM_KEYS);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+#include "SplayTree.h"
+#include "Entry.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+class SplayTreeTest : public ::testing::Test
+{
+protected:
+    SplayTree<int>* tree;
+
+    SplayTreeTest()
+    {
+        tree = new SplayTree<int>();
+    }
+
+    ~SplayTreeTest()
+    {
+        delete tree;
+    }
+
+    /**
+     * @return The item at the root of the tree.
+     */
+    int getRoot()
+    {
+        return *tree->preorder().begin();
+    }
+};
+
+TEST_F(SplayTreeTest, SimpleTest)
+{
+    EXPECT_TRUE(tree->empty());
+    EXPECT_FALSE(tree->contains(0));
+    EXPECT_FALSE(tree->remove(0));
+
+    tree->add(2);
+    tree->add(4);
+    tree->add(3);
+    tree->add(1);
+    tree->add(0);
+    EXPECT_FALSE(tree->add(3));
+    EXPECT_EQ(tree->getNumNodes(), 5);
+
+    std::vector<int> expected = { 0, 1, 2, 3, 4 };
+    EXPECT_TRUE(std::equal(tree->begin(), tree->end(), expected.begin(),
+                           expected.end()));
+    EXPECT_EQ(tree->getItem(4), 4);
+    EXPECT_THROW(tree->getItem(5), std::runtime_error);
+
+    EXPECT_TRUE(tree->remove(2));
+    EXPECT_FALSE(tree->contains(2));
+    EXPECT_FALSE(tree->remove(2));
+    EXPECT_EQ(tree->getNumNodes(), 4);
+
+    tree->clear();
+    EXPECT_TRUE(tree->empty());
+    EXPECT_EQ(tree->getNumNodes(), 0);
+}
+
+TEST_F(SplayTreeTest, SplayTest)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        tree->add(i);
+        EXPECT_EQ(getRoot(), i);
+    }
+
+    // sorted insertion leaves a path of length n, and a lookup at its far
+    // end roughly halves it
+    EXPECT_EQ(tree->getTreeHeight(), 100);
+    EXPECT_TRUE(tree->contains(0));
+    EXPECT_EQ(getRoot(), 0);
+    EXPECT_LE(tree->getTreeHeight(), 52);
+
+    // an unsuccessful search splays the last item on its path
+    EXPECT_FALSE(tree->contains(1000));
+    EXPECT_EQ(getRoot(), 99);
+
+    EXPECT_TRUE(tree->remove(99));
+    EXPECT_EQ(getRoot(), 98);
+}
+
+TEST_F(SplayTreeTest, RandomOperationsTest)
+{
+    std::set<int> expected;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> key(0, 999);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        int item = key(rng);
+        switch (rng() % 3)
+        {
+        case 0:
+            ASSERT_EQ(tree->remove(item), expected.erase(item) == 1);
+            break;
+        case 1:
+            ASSERT_EQ(tree->add(item), expected.insert(item).second);
+            break;
+        default:
+            ASSERT_EQ(tree->contains(item), expected.count(item) == 1);
+        }
+
+        if (i % 100 == 0)
+        {
+            ASSERT_EQ(tree->getNumNodes(), static_cast<int>(expected.size()));
+            ASSERT_TRUE(std::equal(tree->begin(), tree->end(),
+                                   expected.begin(), expected.end()));
+        }
+    }
+}
+
+TEST_F(SplayTreeTest, DeepTreeTest)
+{
+    // deep enough to overflow the call stack if splaying recursed
+    const int NUM_ITEMS = 1000000;
+    for (int i = 0; i < NUM_ITEMS; i++)
+    {
+        tree->add(i);
+    }
+
+    EXPECT_TRUE(tree->contains(0));
+    EXPECT_TRUE(tree->contains(NUM_ITEMS / 2));
+    EXPECT_TRUE(tree->remove(1));
+    EXPECT_EQ(tree->getNumNodes(), NUM_ITEMS - 1);
+
+    SplayTree<int> copy(*tree);
+    EXPECT_EQ(copy.getNumNodes(), NUM_ITEMS - 1);
+}
+
+TEST_F(SplayTreeTest, FindTest)
+{
+    SplayTree<Entry<std::string, int>> entries;
+    entries.add(Entry<std::string, int>("pear", 3));
+    entries.add(Entry<std::string, int>("apple", 1));
+    entries.add(Entry<std::string, int>("fig", 2));
+
+    Entry<std::string, int>* entryPtr = entries.findItem(std::string("apple"));
+    ASSERT_NE(entryPtr, nullptr);
+    EXPECT_EQ(entryPtr->getValue(), 1);
+    entryPtr->setValue(10);
+    EXPECT_EQ(entries.findItem(std::string("apple"))->getValue(), 10);
+    EXPECT_EQ(entries.findItem(std::string("kiwi")), nullptr);
+}
+
+TEST_F(SplayTreeTest, CopyTest)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        tree->add(i);
+    }
+
+    SplayTree<int> copy(*tree);
+    copy.remove(5);
+    EXPECT_TRUE(tree->contains(5));
+    EXPECT_FALSE(copy.contains(5));
+
+    *tree = copy;
+    EXPECT_FALSE(tree->contains(5));
+    EXPECT_EQ(tree->getNumNodes(), 9);
+
+    SplayTree<int> arenaTree;
+    arenaTree.useArena(64);
+    for (int i = 0; i < 1000; i++)
+    {
+        arenaTree.add(i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        EXPECT_TRUE(arenaTree.remove(i));
+    }
+    EXPECT_EQ(arenaTree.getNumNodes(), 500);
+    EXPECT_TRUE(SplayTree<int>(arenaTree).usesArena());
+
+    SplayTree<int> assigned;
+    assigned.add(-1);
+    assigned = arenaTree;
+    EXPECT_TRUE(assigned.usesArena());
+    EXPECT_EQ(assigned.getNumNodes(), 500);
+    EXPECT_TRUE(assigned.contains(999));
+    EXPECT_FALSE(assigned.contains(-1));
+    assigned = SplayTree<int>();
+    EXPECT_FALSE(assigned.usesArena());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
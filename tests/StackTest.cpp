@@ -1,5 +1,6 @@
 #include "Stack.h"
 #include "gtest/gtest.h"
+#include <stdexcept>
 
 class StackTest : public ::testing::Test 
 {
@@ -44,6 +45,52 @@ TEST_F(StackTest, Test1)
    ASSERT_TRUE(stack.empty());
 }
 
+TEST_F(StackTest, AssignTest)
+{
+   stack.push(0);
+   stack.push(1);
+
+   Stack<int> other;
+   other.push(5);
+   other = stack;
+   ASSERT_EQ(other.top(), 1);
+   ASSERT_TRUE(other.pop());
+   ASSERT_EQ(other.top(), 0);
+
+   // assigning a stack to itself keeps its items
+   Stack<int>& self = stack;
+   stack = self;
+   ASSERT_EQ(stack.top(), 1);
+}
+
+TEST(DequeStackTest, Test1)
+{
+   Stack<int, Deque<int>> stack;
+   ASSERT_TRUE(stack.empty());
+   ASSERT_THROW(stack.top(), std::range_error);
+   ASSERT_FALSE(stack.pop());
+
+   for (int i = 0; i < 1000; i++)
+   {
+      stack.push(i);
+   }
+   ASSERT_EQ(stack.top(), 999);
+
+   Stack<int, Deque<int>> stackCopy(stack);
+   for (int i = 999; i >= 0; i--)
+   {
+      ASSERT_EQ(stack.top(), i);
+      ASSERT_TRUE(stack.pop());
+   }
+   ASSERT_TRUE(stack.empty());
+   ASSERT_EQ(stackCopy.top(), 999);
+
+   stack = stackCopy;
+   stackCopy.clear();
+   ASSERT_TRUE(stackCopy.empty());
+   ASSERT_EQ(stack.top(), 999);
+}
+
 int main(int argc, char** argv)
 {
    ::testing::InitGoogleTest(&argc, argv);
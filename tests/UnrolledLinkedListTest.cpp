@@ -0,0 +1,187 @@
+#include "UnrolledLinkedList.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class UnrolledLinkedListTest : public ::testing::Test
+{
+protected:
+    // small blocks, so that a few items exercise splitting and merging
+    UnrolledLinkedList<int, 4>* list;
+
+    UnrolledLinkedListTest()
+    {
+        list = new UnrolledLinkedList<int, 4>();
+    }
+
+    ~UnrolledLinkedListTest()
+    {
+        delete list;
+    }
+};
+
+TEST_F(UnrolledLinkedListTest, SimpleTest)
+{
+    ASSERT_TRUE(list->empty());
+
+    for (int i = 1; i <= 10; i++)
+    {
+        list->add(i);
+    }
+
+    ASSERT_EQ(list->size(), 10);
+    EXPECT_EQ(list->getNumBlocks(), 3);
+    EXPECT_EQ(list->get(0), 1);
+    EXPECT_EQ(list->get(9), 10);
+    EXPECT_THROW(list->get(10), std::out_of_range);
+    EXPECT_TRUE(list->contains(7));
+    EXPECT_FALSE(list->contains(11));
+
+    EXPECT_TRUE(list->remove(1));
+    EXPECT_TRUE(list->remove(10));
+    EXPECT_FALSE(list->remove(10));
+    EXPECT_EQ(list->toVector(), std::vector<int>({ 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+    list->clear();
+    EXPECT_TRUE(list->empty());
+    EXPECT_EQ(list->getNumBlocks(), 0);
+}
+
+TEST_F(UnrolledLinkedListTest, InsertTest)
+{
+    EXPECT_THROW(list->insert(1, 0), std::out_of_range);
+
+    list->insert(0, 3);
+    list->insert(0, 1);
+    list->insert(1, 2);
+    list->insert(3, 5);
+    list->insert(3, 4);
+    list->insert(0, 0);
+    EXPECT_EQ(list->toVector(), std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(list->getNumBlocks(), 2);
+
+    // insert before every item while iterating, then append
+    for (auto it = list->begin(); it != list->end(); ++it)
+    {
+        it = list->insert(it, -*it);
+        ++it;
+    }
+    UnrolledLinkedList<int, 4>::iterator last = list->insert(list->end(), 6);
+    EXPECT_EQ(*last, 6);
+    EXPECT_EQ(list->toVector(), std::vector<int>({ 0, 0, -1, 1, -2, 2, -3, 3,
+                                                   -4, 4, -5, 5, 6 }));
+}
+
+TEST_F(UnrolledLinkedListTest, RandomOperationsTest)
+{
+    std::mt19937 random(11);
+    std::vector<int> reference;
+    for (int i = 0; i < 20000; i++)
+    {
+        int item = random() % 200;
+        switch (random() % 4)
+        {
+        case 0:
+            list->add(item);
+            reference.push_back(item);
+            break;
+        case 1:
+        {
+            int index = random() % (reference.size() + 1);
+            list->insert(index, item);
+            reference.insert(reference.begin() + index, item);
+            break;
+        }
+        case 2:
+        {
+            auto position = std::find(reference.begin(), reference.end(),
+                                      item);
+            bool found = position != reference.end();
+            if (found)
+            {
+                reference.erase(position);
+            }
+            ASSERT_EQ(list->remove(item), found);
+            break;
+        }
+        default:
+            ASSERT_EQ(list->contains(item),
+                      std::find(reference.begin(), reference.end(), item) !=
+                      reference.end());
+            break;
+        }
+
+        ASSERT_EQ(list->size(), (int) reference.size());
+        if (i % 1000 == 0)
+        {
+            ASSERT_EQ(list->toVector(), reference);
+        }
+    }
+
+    EXPECT_EQ(list->toVector(), reference);
+    EXPECT_EQ(std::vector<int>(list->begin(), list->end()), reference);
+    // merging keeps blocks at least half full on average
+    EXPECT_LE(list->getNumBlocks(), (list->size() + 1) / 2 + 1);
+}
+
+TEST_F(UnrolledLinkedListTest, IteratorTest)
+{
+    EXPECT_TRUE(list->begin() == list->end());
+
+    for (int i = 1; i <= 9; i++)
+    {
+        list->add(i);
+    }
+
+    for (int& item : *list)
+    {
+        item *= 10;
+    }
+
+    const UnrolledLinkedList<int, 4>& constList = *list;
+    UnrolledLinkedList<int, 4>::const_iterator it = constList.end();
+    EXPECT_EQ(*--it, 90);
+    EXPECT_EQ(*--it, 80);
+    for (int i = 0; i < 7; i++)
+    {
+        --it;
+    }
+    EXPECT_TRUE(it == constList.begin());
+    EXPECT_EQ(*it, 10);
+}
+
+TEST_F(UnrolledLinkedListTest, StringTest)
+{
+    // no default constructor is needed, and every item is destroyed
+    UnrolledLinkedList<std::string> strings;
+    for (int i = 0; i < 1000; i++)
+    {
+        strings.add(std::to_string(i));
+    }
+    strings.insert(500, "middle");
+    EXPECT_EQ(strings.get(500), "middle");
+    EXPECT_EQ(strings.get(501), "500");
+    EXPECT_TRUE(strings.remove("0"));
+
+    UnrolledLinkedList<std::string> copy(strings);
+    strings.clear();
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_TRUE(copy.contains("999"));
+
+    std::vector<std::string> vec = copy.intoVector();
+    EXPECT_EQ(vec.size(), 1000u);
+    EXPECT_EQ(vec.front(), "1");
+    EXPECT_TRUE(copy.empty());
+
+    copy = strings;
+    EXPECT_TRUE(copy.empty());
+}
+
+int main (int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,8 +1,17 @@
 #include "ArrayList.h"
 #include "LinkedList.h"
+#include "ThreadPool.h"
 #include "gtest/gtest.h"
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
 
 class ListTest : public ::testing::Test 
 {
@@ -98,6 +107,647 @@ TEST_F(ListTest, ClearTest)
 	ASSERT_TRUE(list.empty());
 }
 
+TEST_F(ListTest, IteratorTest)
+{
+	EXPECT_TRUE(list.begin() == list.end());
+
+	for (int i = 1; i <= 5; i++)
+	{
+		list.add(i);
+	}
+
+	for (int& item : list)
+	{
+		item *= 2;
+	}
+
+	const LinkedList<int>& constList = list;
+	EXPECT_EQ(std::vector<int>(constList.begin(), constList.end()),
+		std::vector<int>({ 2, 4, 6, 8, 10 }));
+
+	LinkedList<int>::const_iterator it = list.end();
+	EXPECT_EQ(*--it, 10);
+	EXPECT_EQ(*--it, 8);
+	EXPECT_TRUE(it != list.begin());
+
+	list.remove(6);
+	EXPECT_EQ(std::vector<int>(list.begin(), list.end()), list.toVector());
+}
+
+TEST_F(ListTest, EndIteratorTest)
+{
+	// the end iterator follows the tail of the list, even when it was taken
+	// while the list was empty
+	LinkedList<int>::iterator end = list.end();
+	list.add(1);
+	LinkedList<int>::iterator it = end;
+	EXPECT_EQ(*--it, 1);
+
+	list.add(2);
+	it = end;
+	EXPECT_EQ(*--it, 2);
+
+	list.remove(2);
+	it = end;
+	EXPECT_EQ(*--it, 1);
+	EXPECT_TRUE(it == list.begin());
+
+	list.remove(1);
+	EXPECT_TRUE(end == list.begin());
+}
+
+TEST_F(ListTest, IntoVectorTest)
+{
+	LinkedList<std::string> strings;
+	strings.add("first");
+	strings.add("second");
+
+	std::vector<std::string> vec = strings.intoVector();
+	EXPECT_EQ(vec, std::vector<std::string>({ "first", "second" }));
+	EXPECT_TRUE(strings.empty());
+	EXPECT_TRUE(strings.begin() == strings.end());
+
+	strings.add("third");
+	EXPECT_EQ(strings.toVector(), std::vector<std::string>({ "third" }));
+}
+
+TEST(ArrayListAccessTest, DataTest)
+{
+	ArrayList<int> list(2);
+	EXPECT_TRUE(list.begin() == list.end());
+
+	for (int i = 1; i <= 5; i++)
+	{
+		list.add(i);
+	}
+
+	int sum = 0;
+	for (int item : list)
+	{
+		sum += item;
+	}
+	EXPECT_EQ(sum, 15);
+
+	list.data()[0] = 10;
+	const ArrayList<int>& constList = list;
+	EXPECT_EQ(std::vector<int>(constList.data(),
+		constList.data() + constList.size()),
+		std::vector<int>({ 10, 2, 3, 4, 5 }));
+	EXPECT_EQ(std::vector<int>(constList.begin(), constList.end()),
+		list.toVector());
+}
+
+TEST(ArrayListAccessTest, IntoVectorTest)
+{
+	ArrayList<std::string> list;
+	list.add("first");
+	list.add("second");
+
+	std::vector<std::string> vec = list.intoVector();
+	EXPECT_EQ(vec, std::vector<std::string>({ "first", "second" }));
+	EXPECT_TRUE(list.empty());
+
+	list.add("third");
+	EXPECT_EQ(list.toVector(), std::vector<std::string>({ "third" }));
+}
+
+template <class T>
+class ArrayListSearchTest : public ::testing::Test
+{
+
+};
+
+typedef ::testing::Types<int8_t, uint16_t, int32_t, uint64_t, float, double,
+	std::string> SearchTypes;
+TYPED_TEST_SUITE(ArrayListSearchTest, SearchTypes);
+
+template <class T>
+T makeItem(int n)
+{
+	return static_cast<T>(n);
+}
+
+template <>
+std::string makeItem<std::string>(int n)
+{
+	return std::to_string(n);
+}
+
+TYPED_TEST(ArrayListSearchTest, IndexOfTest)
+{
+	// every position, in lists of every length around the vector widths
+	for (int size = 0; size <= 140; size++)
+	{
+		ArrayList<TypeParam> list;
+		for (int i = 0; i < size; i++)
+		{
+			list.add(makeItem<TypeParam>(i % 100 + 1));
+		}
+
+		for (int i = 0; i < size && i < 100; i++)
+		{
+			ASSERT_EQ(list.indexOf(makeItem<TypeParam>(i + 1)), i);
+			ASSERT_TRUE(list.contains(makeItem<TypeParam>(i + 1)));
+		}
+		ASSERT_EQ(list.indexOf(makeItem<TypeParam>(0)), -1);
+		ASSERT_FALSE(list.contains(makeItem<TypeParam>(101)));
+	}
+}
+
+TYPED_TEST(ArrayListSearchTest, CountTest)
+{
+	ArrayList<TypeParam> list;
+	EXPECT_EQ(list.count(makeItem<TypeParam>(1)), 0);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		list.add(makeItem<TypeParam>(i % 7));
+	}
+
+	EXPECT_EQ(list.count(makeItem<TypeParam>(0)), 143);
+	EXPECT_EQ(list.count(makeItem<TypeParam>(6)), 142);
+	EXPECT_EQ(list.count(makeItem<TypeParam>(7)), 0);
+
+	list.remove(makeItem<TypeParam>(0));
+	EXPECT_EQ(list.count(makeItem<TypeParam>(0)), 142);
+}
+
+TYPED_TEST(ArrayListSearchTest, IndexOfAnyTest)
+{
+	ArrayList<TypeParam> list;
+	EXPECT_EQ(list.indexOfAny({ makeItem<TypeParam>(1) }), -1);
+
+	for (int i = 0; i < 100; i++)
+	{
+		list.add(makeItem<TypeParam>(i));
+	}
+
+	EXPECT_EQ(list.indexOfAny({}), -1);
+	EXPECT_EQ(list.indexOfAny({ makeItem<TypeParam>(70),
+		makeItem<TypeParam>(35), makeItem<TypeParam>(99) }), 35);
+	EXPECT_EQ(list.indexOfAny({ makeItem<TypeParam>(99) }), 99);
+	EXPECT_EQ(list.indexOfAny({ makeItem<TypeParam>(100),
+		makeItem<TypeParam>(101) }), -1);
+}
+
+TEST(ArrayListFloatTest, SpecialValuesTest)
+{
+	// the same as comparing with ==
+	ArrayList<double> list;
+	for (int i = 0; i < 20; i++)
+	{
+		list.add(std::numeric_limits<double>::quiet_NaN());
+	}
+	list.add(-0.0);
+
+	EXPECT_EQ(list.indexOf(std::numeric_limits<double>::quiet_NaN()), -1);
+	EXPECT_EQ(list.count(std::numeric_limits<double>::quiet_NaN()), 0);
+	EXPECT_EQ(list.indexOf(0.0), 20);
+}
+
+TEST(SimdSearchTest, InstructionSetTest)
+{
+	// each instruction set the processor supports, whichever is dispatched to
+	std::vector<int16_t> items;
+	for (int i = 0; i < 1000; i++)
+	{
+		items.push_back(static_cast<int16_t>(i % 300));
+	}
+	int16_t targets[] = { 299, 250 };
+	int numItems = static_cast<int>(items.size());
+
+	EXPECT_EQ(scalarIndexOf(items.data(), numItems, (int16_t) 250), 250);
+	EXPECT_EQ(scalarCount(items.data(), numItems, (int16_t) 250), 3);
+	EXPECT_EQ(scalarIndexOfAny(items.data(), numItems, targets, 2), 250);
+
+#ifdef SIMD_SEARCH_X86
+	if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+	{
+		EXPECT_EQ(sse42IndexOf(items.data(), numItems, (int16_t) 250), 250);
+		EXPECT_EQ(sse42Count(items.data(), numItems, (int16_t) 250), 3);
+		EXPECT_EQ(sse42IndexOfAny(items.data(), numItems, targets, 2), 250);
+		EXPECT_EQ(sse42IndexOf(items.data(), numItems, (int16_t) 300), -1);
+	}
+
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+	{
+		EXPECT_EQ(avx2IndexOf(items.data(), numItems, (int16_t) 250), 250);
+		EXPECT_EQ(avx2Count(items.data(), numItems, (int16_t) 250), 3);
+		EXPECT_EQ(avx2IndexOfAny(items.data(), numItems, targets, 2), 250);
+		EXPECT_EQ(avx2IndexOf(items.data(), numItems, (int16_t) 300), -1);
+	}
+#endif
+}
+
+TEST(ArrayListRemoveTest, RemoveIfTest)
+{
+	ArrayList<int> list;
+	for (int i = 0; i < 1000; i++)
+	{
+		list.add(i);
+	}
+
+	EXPECT_EQ(list.removeIf([](const int& item) { return item % 3 == 0; }),
+		334);
+	EXPECT_EQ(list.removeIf([](const int& item) { return item < 0; }), 0);
+	ASSERT_EQ(list.size(), 666);
+
+	std::vector<int> vec = list.toVector();
+	for (int i = 0; i < 666; i++)
+	{
+		EXPECT_EQ(vec[i], i / 2 * 3 + i % 2 + 1);
+	}
+
+	EXPECT_EQ(list.retainIf([](const int& item) { return item < 10; }), 660);
+	EXPECT_EQ(list.toVector(), std::vector<int>({ 1, 2, 4, 5, 7, 8 }));
+
+	EXPECT_EQ(list.removeAll({ 8, 1, 100 }), 2);
+	EXPECT_EQ(list.toVector(), std::vector<int>({ 2, 4, 5, 7 }));
+
+	EXPECT_EQ(list.retainIf([](const int&) { return false; }), 4);
+	EXPECT_TRUE(list.empty());
+	EXPECT_EQ(list.removeAll({ 1 }), 0);
+
+	for (int i = 0; i < 1000; i++)
+	{
+		list.add(i % 100);
+	}
+	EXPECT_EQ(list.removeAll({ 90, 0, 10, 99 }), 40);
+	vec = list.toVector();
+	ASSERT_EQ(vec.size(), 960);
+	EXPECT_EQ(vec[0], 1);
+	EXPECT_EQ(vec[8], 9);
+	EXPECT_EQ(vec[9], 11);
+	EXPECT_EQ(vec[95], 98);
+	EXPECT_EQ(vec[96], 1);
+}
+
+TEST(ArrayListRemoveTest, RemoveAllSortedTest)
+{
+	// more items than REMOVE_ALL_SCAN_LIMIT, so they are looked up in a
+	// hash set, or in a sorted copy for pairs, which have no std::hash
+	ArrayList<int> list;
+	std::vector<int> removed;
+	for (int i = 0; i < 10000; i++)
+	{
+		list.add(i % 1000);
+		if (i % 1000 % 3 == 0 && i < 1000)
+		{
+			removed.push_back(999 - i);
+		}
+	}
+	removed.push_back(-5);
+	removed.push_back(removed[0]);
+	int scanLimit = ArrayList<int>::REMOVE_ALL_SCAN_LIMIT;
+	ASSERT_GT(static_cast<int>(removed.size()), scanLimit);
+
+	EXPECT_EQ(list.removeAll(removed), 3340);
+	std::vector<int> vec = list.toVector();
+	ASSERT_EQ(vec.size(), 6660);
+	for (int i = 0; i < 6660; i++)
+	{
+		EXPECT_EQ(vec[i], (i % 666) / 2 * 3 + i % 2 + 1);
+	}
+
+	ArrayList<double> doubles;
+	std::vector<double> removedDoubles = { std::nan("") };
+	for (int i = 0; i < 100; i++)
+	{
+		doubles.add(i * 0.5);
+		removedDoubles.push_back(i);
+	}
+	doubles.add(std::nan(""));
+	doubles.add(-0.0);
+
+	EXPECT_EQ(doubles.removeAll(removedDoubles), 51);
+	std::vector<double> doubleVec = doubles.toVector();
+	ASSERT_EQ(doubleVec.size(), 51);
+	EXPECT_EQ(doubleVec[0], 0.5);
+	EXPECT_EQ(doubleVec[49], 49.5);
+	EXPECT_TRUE(std::isnan(doubleVec[50]));
+
+	ArrayList<std::string> strings;
+	std::vector<std::string> removedStrings;
+	for (int i = 0; i < 100; i++)
+	{
+		strings.add(std::to_string(i));
+		removedStrings.push_back(std::to_string(i + 50));
+	}
+
+	EXPECT_EQ(strings.removeAll(removedStrings), 50);
+	EXPECT_EQ(strings.toVector().back(), "49");
+
+	ArrayList<std::pair<int, int>> pairs;
+	std::vector<std::pair<int, int>> removedPairs;
+	for (int i = 0; i < 100; i++)
+	{
+		pairs.add(std::make_pair(i % 10, i / 10));
+		removedPairs.push_back(std::make_pair(99 - i, i % 5));
+	}
+
+	EXPECT_EQ(pairs.removeAll(removedPairs), 10);
+	EXPECT_EQ(pairs.size(), 90);
+	EXPECT_FALSE(pairs.contains(std::make_pair(9, 0)));
+	EXPECT_TRUE(pairs.contains(std::make_pair(9, 1)));
+}
+
+TEST(ArrayListRemoveTest, SwapRemoveTest)
+{
+	ArrayList<std::string> list;
+	list.add("a");
+	list.add("b");
+	list.add("c");
+	list.add("d");
+
+	EXPECT_FALSE(list.swapRemove(-1));
+	EXPECT_FALSE(list.swapRemove(4));
+
+	EXPECT_TRUE(list.swapRemove(1));
+	EXPECT_EQ(list.toVector(), std::vector<std::string>({ "a", "d", "c" }));
+	EXPECT_TRUE(list.swapRemove(2));
+	EXPECT_EQ(list.toVector(), std::vector<std::string>({ "a", "d" }));
+	EXPECT_TRUE(list.swapRemove(0));
+	EXPECT_TRUE(list.swapRemove(0));
+	EXPECT_TRUE(list.empty());
+}
+
+/**
+ * Counts how often items are copied rather than moved.
+ */
+struct CopyCounter
+{
+	static int numCopies;
+	int value;
+
+	CopyCounter(int value = 0) : value(value) { }
+	CopyCounter(const CopyCounter& other) : value(other.value) { numCopies++; }
+	CopyCounter(CopyCounter&& other) : value(other.value) { }
+
+	CopyCounter& operator=(const CopyCounter& other)
+	{
+		value = other.value;
+		numCopies++;
+		return *this;
+	}
+
+	CopyCounter& operator=(CopyCounter&& other)
+	{
+		value = other.value;
+		return *this;
+	}
+
+	bool operator==(const CopyCounter& other) const
+	{
+		return value == other.value;
+	}
+};
+
+int CopyCounter::numCopies = 0;
+
+TEST(ArrayListRemoveTest, MoveTest)
+{
+	ArrayList<CopyCounter> list(4);
+	for (int i = 0; i < 100; i++)
+	{
+		list.add(CopyCounter(i));
+	}
+
+	std::vector<CopyCounter> removed = { CopyCounter(7) };
+	CopyCounter::numCopies = 0;
+	EXPECT_EQ(list.removeIf([](const CopyCounter& item)
+	{
+		return item.value % 2 == 0;
+	}), 50);
+	EXPECT_TRUE(list.swapRemove(0));
+	EXPECT_TRUE(list.remove(CopyCounter(5)));
+	EXPECT_EQ(list.removeAll(removed), 1);
+	for (int i = 0; i < 100; i++)
+	{
+		list.add(CopyCounter(i));
+	}
+
+	// only add copies, once per item
+	EXPECT_EQ(CopyCounter::numCopies, 100);
+	EXPECT_EQ(list.size(), 147);
+}
+
+template <class T>
+class ArrayListSortTest : public ::testing::Test
+{
+
+};
+
+typedef ::testing::Types<int8_t, uint16_t, int32_t, int64_t, uint64_t,
+	double, std::string> SortTypes;
+TYPED_TEST_SUITE(ArrayListSortTest, SortTypes);
+
+TYPED_TEST(ArrayListSortTest, SortTest)
+{
+	// a pool of several threads and a small grain size, so that even short
+	// lists are split between tasks
+	ThreadPool pool(4);
+	std::mt19937 random(42);
+	for (int numItems : { 0, 1, 2, 100, 255, 256, 1000, 5000 })
+	{
+		std::vector<TypeParam> items;
+		for (int i = 0; i < numItems; i++)
+		{
+			items.push_back(makeItem<TypeParam>(
+				static_cast<int>(random() % 2000) - 1000));
+		}
+
+		ArrayList<TypeParam> list;
+		ArrayList<TypeParam> parallelList;
+		ArrayList<TypeParam> descendingList;
+		for (const TypeParam& item : items)
+		{
+			list.add(item);
+			parallelList.add(item);
+			descendingList.add(item);
+		}
+
+		list.sort();
+		parallelList.parallelSort(std::less<TypeParam>(), pool, 64);
+		descendingList.parallelSort(std::greater<TypeParam>(), pool, 64);
+
+		std::sort(items.begin(), items.end());
+		EXPECT_EQ(list.toVector(), items);
+		EXPECT_EQ(parallelList.toVector(), items);
+		std::reverse(items.begin(), items.end());
+		EXPECT_EQ(descendingList.toVector(), items);
+	}
+}
+
+TEST(ArrayListSortTest, RadixSortTest)
+{
+	// keys which differ only in their high bytes, and the extreme values
+	ThreadPool pool(4);
+	std::vector<int64_t> items;
+	for (int i = 0; i < 1000; i++)
+	{
+		items.push_back((static_cast<int64_t>(i * 7919 % 1000) - 500) * (int64_t(1) << 40));
+	}
+	items.push_back(std::numeric_limits<int64_t>::min());
+	items.push_back(std::numeric_limits<int64_t>::max());
+	items.push_back(0);
+
+	ArrayList<int64_t> list;
+	ArrayList<int64_t> parallelList;
+	for (int64_t item : items)
+	{
+		list.add(item);
+		parallelList.add(item);
+	}
+
+	list.sort();
+	parallelList.parallelSort(std::less<int64_t>(), pool, 64);
+	std::sort(items.begin(), items.end());
+	EXPECT_EQ(list.toVector(), items);
+	EXPECT_EQ(parallelList.toVector(), items);
+}
+
+TEST_F(ListTest, SortTest)
+{
+	list.sort();
+	EXPECT_TRUE(list.empty());
+
+	std::mt19937 random(42);
+	std::vector<int> items;
+	for (int i = 0; i < 1000; i++)
+	{
+		items.push_back(static_cast<int>(random() % 100));
+		list.add(items.back());
+	}
+
+	list.sort();
+	std::sort(items.begin(), items.end());
+	EXPECT_EQ(list.toVector(), items);
+
+	// the prev pointers and the tail are relinked as well
+	std::vector<int> backward;
+	for (LinkedList<int>::iterator it = list.end(); it != list.begin(); )
+	{
+		--it;
+		backward.push_back(*it);
+	}
+	EXPECT_TRUE(std::equal(backward.rbegin(), backward.rend(),
+		items.begin(), items.end()));
+	list.add(1000);
+	EXPECT_EQ(*--list.end(), 1000);
+
+	list.sort(std::greater<int>());
+	EXPECT_EQ(*list.begin(), 1000);
+	EXPECT_TRUE(list.remove(1000));
+	std::reverse(items.begin(), items.end());
+	EXPECT_EQ(list.toVector(), items);
+}
+
+TEST(LinkedListSortTest, StableTest)
+{
+	// sort by key only; items with equal keys keep the order they were added
+	LinkedList<std::pair<int, int>> list;
+	std::vector<std::pair<int, int>> items;
+	for (int i = 0; i < 500; i++)
+	{
+		items.push_back(std::make_pair(i * 37 % 10, i));
+		list.add(items.back());
+	}
+
+	auto byKey = [](const std::pair<int, int>& first,
+		const std::pair<int, int>& second)
+	{
+		return first.first < second.first;
+	};
+	list.sort(byKey);
+	std::stable_sort(items.begin(), items.end(), byKey);
+	EXPECT_EQ(list.toVector(), items);
+}
+
+TEST(MemoryUsageTest, AllocatedBytesTest)
+{
+#if defined(__GLIBC__) && defined(__LP64__)
+	// an 8 byte header, rounded up to 16 bytes, and at least 32 bytes
+	EXPECT_EQ(getAllocatedBytes(1), 32u);
+	EXPECT_EQ(getAllocatedBytes(24), 32u);
+	EXPECT_EQ(getAllocatedBytes(25), 48u);
+	EXPECT_EQ(getAllocatedBytes(1 << 20) % 4096, 0u);
+#endif
+	EXPECT_GE(getAllocatedBytes(100), 100u);
+
+	MemoryUsage usage;
+	addAllocation(usage, 100);
+	EXPECT_EQ(usage.payloadBytes, 0u);
+	EXPECT_EQ(usage.overheadBytes, getAllocatedBytes(100) - 100);
+}
+
+TEST(ArrayListMemoryTest, ShrinkToFitTest)
+{
+	ArrayList<int> list(10);
+	for (int i = 0; i < 4; i++)
+	{
+		list.add(i);
+	}
+
+	MemoryUsage usage = list.memoryUsage();
+	EXPECT_EQ(usage.payloadBytes, 4 * sizeof(int));
+	EXPECT_EQ(usage.slackBytes, 6 * sizeof(int));
+	EXPECT_GE(usage.overheadBytes, sizeof(list));
+
+	list.shrinkToFit();
+	EXPECT_EQ(list.memoryUsage().slackBytes, 0u);
+	EXPECT_EQ(list.toVector(), std::vector<int>({ 0, 1, 2, 3 }));
+	list.add(4);
+	EXPECT_EQ(list.memoryUsage().slackBytes, 3 * sizeof(int));
+
+	// an empty array grows again
+	list.clear();
+	list.shrinkToFit();
+	EXPECT_EQ(list.memoryUsage().getTotalBytes(),
+		list.memoryUsage().overheadBytes);
+	list.add(5);
+	EXPECT_EQ(list.toVector(), std::vector<int>({ 5 }));
+}
+
+TEST(ArrayListMemoryTest, OwnedMemoryTest)
+{
+	const std::string LONG_STRING(100, 'x');
+	ArrayList<std::string> list(4);
+	list.add("short");
+	list.add(LONG_STRING);
+
+	// the long string's buffer is payload, the short one is inside the item
+	MemoryUsage usage = list.memoryUsage();
+	EXPECT_GE(usage.payloadBytes, 2 * sizeof(std::string) + 101);
+	EXPECT_LT(usage.payloadBytes, 2 * sizeof(std::string) + 200);
+	EXPECT_EQ(usage.slackBytes, 2 * sizeof(std::string));
+
+	// cleared items keep their buffers until they are overwritten
+	list.clear();
+	usage = list.memoryUsage();
+	EXPECT_EQ(usage.payloadBytes, 0u);
+	EXPECT_GE(usage.slackBytes, 4 * sizeof(std::string) + 101);
+
+	list.shrinkToFit();
+	EXPECT_EQ(list.memoryUsage().slackBytes, 0u);
+}
+
+TEST_F(ListTest, MemoryUsageTest)
+{
+	MemoryUsage usage = list.memoryUsage();
+	EXPECT_EQ(usage.getTotalBytes(), sizeof(list));
+
+	for (int i = 0; i < 3; i++)
+	{
+		list.add(i);
+	}
+
+	usage = list.memoryUsage();
+	EXPECT_EQ(usage.payloadBytes, 3 * sizeof(int));
+	EXPECT_EQ(usage.slackBytes, 0u);
+	EXPECT_GE(usage.overheadBytes,
+		sizeof(list) + 3 * (sizeof(Node<int>) - sizeof(int)));
+}
+
 int main(int argc, char** argv) 
 {
 	::testing::InitGoogleTest(&argc, argv);